@@ -1,35 +1,84 @@
 #include "app/core/App.hpp"
+#include "app/core/StationManager.hpp"
 #include "gui/MainFrame.hpp"
-#include "hw/HardwareFactory.hpp"
+#include "services/Tracer.hpp"
+
+#include <algorithm>
 
 wxIMPLEMENT_APP(App);
 
+App::~App() = default;   // StationManager unvollständig im Header
+
 bool App::OnInit() {
     if (!wxApp::OnInit())
         return false;
 
     LoadConfig();
 
-    hardware = MakeHardware(MakeConfigView(config_software), config_hardware);
+    // Opt-in: Chrome-Trace der gesamten Sitzung
+    if (wxGetEnv("SOSESTA_TRACE", &trace_path_) && !trace_path_.empty()) {
+        Tracer::Instance().SetEnabled(true);
+        Tracer::Instance().SetThreadName("gui");
+    }
+
+    // Lokaler Prometheus-Endpunkt; ein Fehler (Port belegt) ist nicht fatal
+    if (config_software.metrics_port > 0 || !config_software.metrics_socket.empty()) {
+        MetricsServer::Options mo;
+        mo.port        = config_software.metrics_port;
+        mo.unix_socket = config_software.metrics_socket;
+        std::string err;
+        if (!metrics_server_.Start(mo, &err))
+            wxLogWarning("Metrics-Endpunkt nicht gestartet: %s", wxString::FromUTF8(err));
+    }
 
-    main_frame_ = new MainFrame(nullptr, config_software);
-    
-    main_frame_->AttachHardware(hardware);
+    // Stationen teilen Erfassungs-Pool und Schreib-Thread; ohne Pool
+    // startet jede Station ihren eigenen Erfassungsthread
+    stations_ = std::make_unique<StationManager>();
+    std::string warn, err;
+    const bool pool_ok = stations_->Start(config_software, &warn, &err);
+#if !defined(USE_MOCK)
+    // Reale Hardware: alle Stationen bekämen dieselbe config_hardware und
+    // damit dieselben Geräte (I2C-Bus, Relais-GPIOs, RedLab) → nur eine
+    if (station_count_ > 1) {
+        if (!warn.empty()) warn += "; ";
+        warn += "SOSESTA_STATIONS=" + std::to_string(station_count_)
+              + " ignoriert: reale Hardware erlaubt nur eine Station";
+        station_count_ = 1;
+    }
+#endif
+    for (int i = 0; i < station_count_; ++i) {
+        const std::string tag = station_count_ > 1 ? "s" + std::to_string(i + 1) : std::string();
+        Station& st = stations_->Add("Station " + std::to_string(i + 1), tag, config_software, config_hardware);
+        if (!pool_ok)
+            st.logger.Log("Erfassung", wxString::FromUTF8("Erfassungs-Pool nicht gestartet: " + err), "ERROR");
+        else if (!warn.empty())
+            st.logger.Log("Erfassung", wxString::FromUTF8(warn), "WARN");
+    }
+
+    main_frame_ = new MainFrame(nullptr, *stations_);
+    stations_->StartAll();
     main_frame_->Show(true);
     return true;
 }
 
 int App::OnExit() {
     SaveConfig();
-    if (hardware) {
-        hardware->Shutdown();
-        hardware.reset();
+    metrics_server_.Stop();
+    stations_.reset();   // Zyklen abmelden, Hardware herunterfahren
+    if (!trace_path_.empty()) {
+        Tracer::Instance().WriteChromeJson(trace_path_.ToStdString());
     }
     return wxApp::OnExit();
 }
 
 void App::LoadConfig() {
     // Defaultwerte verwenden
+
+    // Mehrere Stationen (nur mit Mock; reale Hardware: OnInit begrenzt auf eine)
+    wxString n;
+    long v = 0;
+    if (wxGetEnv("SOSESTA_STATIONS", &n) && n.ToLong(&v) && v > 0)
+        station_count_ = static_cast<int>(std::min(v, 16L));
 }
 
 void App::SaveConfig() {
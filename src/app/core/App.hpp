@@ -5,11 +5,14 @@
 #include "config/ConfigHardware.hpp"
 #include "config/ConfigSoftware.hpp"
 #include "app/core/State.hpp"   
+#include "services/MetricsServer.hpp"
 
-namespace sosesta { namespace hw { struct IHardware; } }
+class StationManager;
 
 class App : public wxApp {
 public:
+    ~App() override;
+
     bool OnInit() override;
     int  OnExit() override;
 
@@ -20,11 +23,15 @@ public:
     void StopTest();
 
 private:
+    // Vorlage für alle Stationen (jede Station erhält eine eigene Kopie)
     ConfigHardware config_hardware;
     ConfigSoftware config_software;
 
     State state;
 
-    std::shared_ptr<sosesta::hw::IHardware> hardware;
+    int station_count_ = 1;   // SOSESTA_STATIONS=<n>
+    std::unique_ptr<StationManager> stations_;
+    MetricsServer metrics_server_;
+    wxString trace_path_; // SOSESTA_TRACE=<datei>: Trace beim Beenden schreiben
     class MainFrame* main_frame_ = nullptr;
 };
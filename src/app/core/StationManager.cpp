@@ -0,0 +1,91 @@
+#include "app/core/StationManager.hpp"
+#include "hw/HardwareFactory.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+StationManager::~StationManager() {
+    StopAll();
+    stations_.clear();   // TestRunner leeren ihre Writer-Aufträge selbst
+    stream_.Stop();
+    writer_.Stop();
+    pool_.Stop();
+}
+
+bool StationManager::Start(const ConfigSoftware& cfg, std::string* warn, std::string* err) {
+    AcquisitionPool::Options o;
+    o.workers     = std::max(1, cfg.acq_workers);
+    o.rt_priority = cfg.acq_rt_priority;
+    o.cpu         = cfg.acq_cpu;
+    o.lock_memory = cfg.acq_mlock;
+    if (!pool_.Start(o, warn, err)) return false;
+    writer_.Start(static_cast<size_t>(std::max(1, cfg.persist_queue)));
+
+    if (!cfg.stream_socket.empty()) {
+        LiveStreamServer::Options so;
+        so.socket_path    = cfg.stream_socket;
+        so.client_buffer  = static_cast<size_t>(std::max(16, cfg.stream_client_kb)) * 1024;
+        so.keyframe_every = std::max(1, cfg.stream_keyframe);
+        std::string serr;
+        if (!stream_.Start(so, &serr) && warn) {
+            if (!warn->empty()) *warn += "; ";
+            *warn += "Live-Datenstrom nicht gestartet: " + serr;
+        }
+    }
+    return true;
+}
+
+Station& StationManager::Add(const std::string& name, const std::string& tag,
+                             const ConfigSoftware& software, const ConfigHardware& hardware) {
+    auto st = std::make_unique<Station>();
+    st->name         = name;
+    st->tag          = tag;
+    st->software     = software;
+    st->hardware_cfg = hardware;
+    st->hardware     = MakeHardware(MakeConfigView(st->software), st->hardware_cfg);
+
+    st->runner = std::make_unique<TestRunner>(st->software, st->logger);
+    st->runner->SetHardware(st->hardware);
+    st->runner->SetPool(&pool_);
+    st->runner->SetWriter(&writer_);
+    st->runner->SetMetricsStation(static_cast<int>(stations_.size()));
+    st->runner->SetStream(&stream_, static_cast<int>(stations_.size()));
+
+    if (st->software.journal_events) {
+        const std::filesystem::path dir(st->software.archive_dir);
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        const std::string file = "ereignisse" + (tag.empty() ? std::string() : "_" + tag) + ".journal";
+
+        EventJournal::Options jo;
+        jo.max_delay_ms = static_cast<std::uint32_t>(std::max(1, st->software.journal_sync_ms));
+        jo.max_batch    = static_cast<size_t>(std::max(1, st->software.journal_sync_events));
+        std::string err;
+        std::vector<EventJournal::Replayed> replay;
+        if (!st->journal.Open((dir / file).string(), jo, &replay, &err)) {
+            st->logger.Log("Journal", wxString::FromUTF8("Ereignis-Journal nicht geöffnet: " + err), "ERROR");
+        } else if (!replay.empty()) {
+            // Ereignisse der letzten Sitzung (auch nach Absturz/Stromausfall) zurück ins Log
+            for (auto& r : replay) {
+                r.rec.serial   = st->logger.Intern(r.serial);
+                r.rec.text     = r.rec.kind == EventKind::Message ? st->logger.AddText(r.text)
+                                                                  : st->logger.Intern(r.text);
+                r.rec.category = st->logger.Intern(r.category);
+                st->logger.Record(r.rec);
+            }
+            st->logger.Log("Journal", wxString::Format(wxString::FromUTF8("%zu Ereignisse aus dem Journal wiederhergestellt"),
+                                                       replay.size()), "INFO");
+        }
+    }
+
+    stations_.push_back(std::move(st));
+    return *stations_.back();
+}
+
+void StationManager::StartAll() {
+    for (auto& st : stations_) st->runner->Start();
+}
+
+void StationManager::StopAll() {
+    for (auto& st : stations_) st->runner->Stop();
+}
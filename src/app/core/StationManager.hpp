@@ -0,0 +1,75 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "config/ConfigHardware.hpp"
+#include "config/ConfigSoftware.hpp"
+#include "services/AcquisitionPool.hpp"
+#include "services/EventJournal.hpp"
+#include "services/LiveStreamServer.hpp"
+#include "services/LoggerService.hpp"
+#include "services/PersistenceWriter.hpp"
+#include "services/TestRunner.hpp"
+
+namespace sosesta { namespace hw { struct IHardware; } }
+
+// Eine Prüfstation: eigene Konfiguration, Hardware, Protokoll und Ablauf
+struct Station {
+    std::string    name;           // Reitertext
+    std::string    tag;            // Suffix der Sitzungsdateien, leer = keins
+    ConfigSoftware software;
+    ConfigHardware hardware_cfg;
+    std::shared_ptr<sosesta::hw::IHardware> hardware;
+    LoggerService  logger;         // Ereignisse aus dem Journal schon enthalten
+    EventJournal   journal;        // Ereignis-Log auf Platte (zeigt in logger-Strings)
+    std::unique_ptr<TestRunner> runner;   // referenziert software + logger
+};
+
+/**
+ * Mehrere unabhängige Prüfstationen in einem Prozess.
+ *
+ * Jede Station hat eigene Konfiguration, Hardware und Lebenszyklus
+ * (Start/Stop, Archiv, Bericht). Geteilt werden nur der Erfassungs-Pool
+ * (AcquisitionPool, statt eines Threads je Station), der Schreib-Thread
+ * (PersistenceWriter) und der Live-Datenstrom (LiveStreamServer, Station
+ * = Index). Metrics, StageProfiler und Tracer bleiben global;
+ * Metrics führt Zyklus- und Kanalwerte je Station (Label station).
+ *
+ * Reale Hardware braucht je Station eigene Geräte (RedLab-Seriennummern,
+ * I2C-Bus, Relais-GPIOs) in hardware_cfg; App legt ohne Mock daher nur
+ * eine Station an.
+ */
+class StationManager {
+public:
+    StationManager() = default;
+    ~StationManager();
+
+    StationManager(const StationManager&) = delete;
+    StationManager& operator=(const StationManager&) = delete;
+
+    // Pool + Writer (+ Live-Datenstrom) starten; Worker/Echtzeit-Optionen
+    // aus cfg. Ein nicht gestarteter Datenstrom ist nur eine Warnung.
+    bool Start(const ConfigSoftware& cfg, std::string* warn = nullptr, std::string* err = nullptr);
+
+    // Station anlegen (Hardware über MakeHardware); vor StartAll()
+    Station& Add(const std::string& name, const std::string& tag,
+                 const ConfigSoftware& software, const ConfigHardware& hardware);
+
+    size_t   Count() const { return stations_.size(); }
+    Station& At(size_t i) { return *stations_.at(i); }
+
+    void StartAll();   // Hardware initialisieren, Zyklen anmelden
+    void StopAll();    // abmelden, Hardware herunterfahren
+
+    AcquisitionPool&   Pool()   { return pool_; }
+    PersistenceWriter& Writer() { return writer_; }
+    LiveStreamServer&  Stream() { return stream_; }
+
+private:
+    // Pool/Writer zuerst: überleben die Stationen
+    AcquisitionPool   pool_;
+    PersistenceWriter writer_;
+    LiveStreamServer  stream_;
+    std::vector<std::unique_ptr<Station>> stations_;
+};
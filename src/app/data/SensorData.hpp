@@ -16,12 +16,24 @@ struct SensorData {
     bool present    = false;
     bool supply_ok  = false;
     bool signal_ok  = false;
+    bool current_ok = false;   // Strom im Präsenzfenster
 
-    // Fehlerzähler
+    // Fehlerzähler: Wechsel ok → nicht ok des zugehörigen Status
     int supply_error_counter  = 0;
     int signal_error_counter  = 0;
     int current_error_counter = 0;
 
+    // Gerätefehler (RetryBackoff): Werte stammen aus einem älteren Zyklus
+    bool          stale       = false;
+    std::uint32_t retry_count = 0;   // Fehlversuche gesamt (INA + DAQ)
+    std::uint64_t stale_ms    = 0;   // Dauer des Veraltet-Zustands
+
+    // Relais-Phase des eigenen Paars (RelayScheduler): Flanken seit
+    // Prüfstart, ungerade = EIN; setzt der TestRunner je Zyklus
+    std::uint32_t relay_phase = 0;
+
     // Zeit
     std::uint64_t timestamp_ms = 0;
 };
+
+inline bool RelayOn(const SensorData& s) { return (s.relay_phase & 1u) != 0; }
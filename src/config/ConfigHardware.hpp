@@ -3,6 +3,7 @@
 #include <array>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 // Alle plattformspezifischen Hardware-Parameter zentral.
 
@@ -15,7 +16,10 @@ struct ConfigHardware {
 
     // ── INA219-Strom-/Spannungssensor ──────────────────────────────────────
     struct INA219 {
-        std::string calibration    = "16V_400mA"; // Kalibrierprofil
+        std::string calibration    = "16V_400mA"; // Kalibrierprofil, siehe kIna219Profiles (32V_2A, 32V_1A, 16V_400mA);
+                                                   // leer = aus shunt_ohm/max_current_A berechnen
+        double      shunt_ohm      = 0.1;         // Shunt auf der Platine
+        double      max_current_A  = 0.4;         // erwarteter Höchststrom (bestimmt die Auflösung)
         int         retries        = 3;
         double      retry_delay_s  = 0.1;
     } ina219;
@@ -24,6 +28,11 @@ struct ConfigHardware {
     struct RedLab {
         int    reconnect_retries   = 3;
         double reconnect_delay_s   = 0.5;
+
+        // Mehrere Geräte (RedLabGroup): Seriennummern in Kanalreihenfolge;
+        // leer = ein Gerät wie bisher
+        std::vector<std::string> serials;
+        int    channels_per_device = 8;
     } redlab;
 
     // ── Status-LED / WS281x (falls genutzt) ───────────────────────────────
@@ -1,5 +1,15 @@
 #pragma once
 #include <array>
+#include <string>
+
+// Filterstufe je Messgröße (FilterBank): Überabtastung + Dezimierung
+// kind: "none", "boxcar", "cic", "median", "iir"
+struct SignalFilterConfig {
+    std::string kind       = "none";
+    int         oversample = 1;     // Rohwerte je Auswertezyklus
+    int         cic_order  = 3;
+    double      iir_alpha  = 0.2;
+};
 
 // Laufzeit-/Prüfparameter, änderbar via GUI
 struct ConfigSoftware {
@@ -7,6 +17,12 @@ struct ConfigSoftware {
     int test_interval_sec  = 10;    // Prüfintervall
     int test_duration_sec  = 3600;  // Gesamtdauer
 
+    // Relaispaare versetzt schalten (RelayScheduler): Paar i bei
+    // i·test_interval_sec/4 – verteilt Einschaltstrom und Auswertung;
+    // false = alle Paare gemeinsam. Intervall je Paar, 0 = test_interval_sec
+    bool               relay_stagger = true;
+    std::array<int,4>  relay_interval_sec { 0, 0, 0, 0 };
+
     // Schwellen
     std::array<double,2> redlab_pos_threshold       {  2.0,  5.0 };
     std::array<double,2> redlab_neg_threshold       { -5.0, -2.0 };
@@ -15,6 +31,69 @@ struct ConfigSoftware {
 
     // Für das Mock-Präsenzmodell
     double max_current_mA = 25.0;
+
+    // Filter vor der Auswertung (gegen Schwellen-Flattern durch Rauschen)
+    SignalFilterConfig filter_redlab;
+    SignalFilterConfig filter_bus;
+    SignalFilterConfig filter_current;
+
+    // Erfassungsthread (AcquisitionLoop): fester Takt auf absoluten Deadlines,
+    // unabhängig vom GUI-Timer. acq_thread = false → Zyklus im GUI-Takt wie bisher.
+    bool acq_thread       = true;
+    int  acq_period_us    = 50000;  // Erfassungsperiode (≥ 100 µs)
+    int  acq_rt_priority  = 0;      // 1..99 → SCHED_FIFO (braucht CAP_SYS_NICE)
+    int  acq_cpu          = -1;     // ≥ 0 → Thread an diesen Kern binden
+    bool acq_mlock        = false;  // mlockall gegen Page-Faults im Zyklus
+    // Mehrere Stationen (StationManager): alle Zyklen teilen sich einen Pool;
+    // Echtzeit-Optionen oben gelten dann für dessen Worker (aus Station 1)
+    int  acq_workers      = 2;      // Worker im AcquisitionPool
+    int  persist_queue    = 4096;   // Schreibaufträge, darüber verwerfen
+
+    // Adaptive Abtastung (SamplingScheduler): kritische Kanäle öfter,
+    // stabile/leere seltener lesen – innerhalb eines Buszeit-Budgets
+    bool   adaptive_sampling     = false;
+    double sample_budget_us      = 0.0;   // Buszeit je Zyklus, 0 = unbegrenzt
+    int    sample_max_period     = 8;     // stabile Kanäle: höchstens jeden n-ten Zyklus
+    double sample_near_fraction  = 0.1;   // „nah an Schwelle“: Abstand < Anteil der Fensterbreite
+    int    sample_hot_cycles     = 20;    // nach Zustandswechsel so lange jeden Zyklus lesen
+
+    // Übergangsmessung (TransitionCapture): jeder Relais-Wechsel startet ein
+    // Schnellerfassungsfenster; Anstieg/Einschwingen/Überschwingen je Kanal
+    // landen im Ereignis-Log. Rate wird auf das Hardware-Maximum begrenzt.
+    bool   capture_transitions = false;
+    double capture_rate_hz     = 10000.0;
+    double capture_pre_ms      = 2.0;
+    double capture_post_ms     = 30.0;
+    double capture_settle_band = 0.05;    // Anteil des Sprungs
+
+    // Sitzungsarchiv (*.ssa, SessionArchive): jeder Prüflauf Start→Stop
+    // wird komprimiert mit Zeitindex aufgezeichnet
+    bool        archive_sessions = true;
+    std::string archive_dir      = "archiv";
+    int         archive_chunk_ms = 10000;   // Chunk-Dauer = Suchraster
+    bool        archive_arrow    = true;    // bei Stop zusätzlich *.arrow (Feather v2)
+
+    // Verlauf im Speicher (HistoryRing) für Plots/Auswertung über lange
+    // Läufe: 7 Byte je Kanal-Sample, es gilt die engere Grenze
+    bool   history_enabled     = true;
+    double history_retention_h = 72.0;   // 0 = nur Speichergrenze
+    int    history_max_mb      = 128;    // 0 = nur Zeitgrenze
+
+    // Ereignis-Journal (EventJournal, <archive_dir>/ereignisse.journal):
+    // jedes Ereignis absturzsicher auf Platte, nach Neustart zurück ins Log
+    bool journal_events      = true;
+    int  journal_sync_ms     = 100;   // Group Commit: spätestens nach …
+    int  journal_sync_events = 64;    // … bzw. ab so vielen Ereignissen
+
+    // Prometheus-Endpunkt (GET /metrics), nur 127.0.0.1; 0 = aus
+    int         metrics_port = 9105;
+    std::string metrics_socket;     // gesetzt → Unix-Socket statt TCP
+
+    // Live-Datenstrom (LiveStreamServer): Frames + Ereignisse binär an
+    // externe Werkzeuge; leer = aus
+    std::string stream_socket;
+    int         stream_client_kb = 256;   // Sendepuffer je Abonnent
+    int         stream_keyframe  = 100;   // Schlüsselbild spätestens alle n Frames
 };
 
 // „View“ für Hardware/Mock (nur lesbar benötigte Felder)
@@ -30,6 +109,10 @@ struct ConfigSoftwareView {
     // Optional: Mock kann auch Präsenzgrenzen kennen
     std::array<double,2> presence_current_threshold{};
     double max_current_mA = 0.0;
+
+    SignalFilterConfig filter_redlab;
+    SignalFilterConfig filter_bus;
+    SignalFilterConfig filter_current;
 };
 
 inline ConfigSoftwareView MakeConfigView(const ConfigSoftware& c) {
@@ -42,5 +125,8 @@ inline ConfigSoftwareView MakeConfigView(const ConfigSoftware& c) {
     v.supply_voltage_threshold   = c.supply_voltage_threshold;
     v.presence_current_threshold = c.presence_current_threshold;
     v.max_current_mA             = c.max_current_mA;
+    v.filter_redlab              = c.filter_redlab;
+    v.filter_bus                 = c.filter_bus;
+    v.filter_current             = c.filter_current;
     return v;
 }
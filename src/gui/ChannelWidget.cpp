@@ -149,6 +149,16 @@ void ChannelWidget::UpdateFrom(const SensorData& d){
     else if (d.redlab_V != 0.0f)     { c = LedCircle::Color::Orange; text = wxString::FromUTF8("Warnung"); }
     else                             { c = LedCircle::Color::Red;    text = wxString::FromUTF8("Fehler"); }
 
+    // Gerät im Backoff: Werte stammen aus einem älteren Zyklus
+    if (d.stale) {
+        text += wxString::FromUTF8(" (veraltet)");
+        status_->SetToolTip(wxString::Format(wxString::FromUTF8("veraltet seit %.1f s, %u Wiederholungen"),
+                                             d.stale_ms / 1000.0, d.retry_count));
+    } else {
+        status_->SetToolTip(d.retry_count ? wxString::Format(wxString::FromUTF8("%u Wiederholungen"), d.retry_count)
+                                          : wxString());
+    }
+
     status_->SetLabel(text);
     status_->SetForegroundColour(
         c==LedCircle::Color::Green ? wxColour(0,160,0) :
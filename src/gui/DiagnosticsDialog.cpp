@@ -0,0 +1,109 @@
+#include "gui/DiagnosticsDialog.hpp"
+#include "services/StageProfiler.hpp"
+#include "services/Tracer.hpp"
+#include <wx/filedlg.h>
+
+DiagnosticsDialog::DiagnosticsDialog(wxWindow* parent)
+: wxDialog(parent, wxID_ANY, wxString::FromUTF8("Diagnose – Stufenlatenzen"),
+           wxDefaultPosition, wxSize(760, 520), wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER)
+{
+    auto* root = new wxBoxSizer(wxVERTICAL);
+
+    view_ = new wxDataViewListCtrl(this, wxID_ANY, wxDefaultPosition, wxDefaultSize,
+                                   wxDV_ROW_LINES | wxDV_VERT_RULES);
+    view_->AppendTextColumn("Stufe",         wxDATAVIEW_CELL_INERT, 130, wxALIGN_LEFT);
+    view_->AppendTextColumn("Kanal",         wxDATAVIEW_CELL_INERT, 60,  wxALIGN_RIGHT);
+    view_->AppendTextColumn("Anzahl",        wxDATAVIEW_CELL_INERT, 90,  wxALIGN_RIGHT);
+    view_->AppendTextColumn(wxString::FromUTF8("p50 [µs]"),   wxDATAVIEW_CELL_INERT, 90, wxALIGN_RIGHT);
+    view_->AppendTextColumn(wxString::FromUTF8("p99 [µs]"),   wxDATAVIEW_CELL_INERT, 90, wxALIGN_RIGHT);
+    view_->AppendTextColumn(wxString::FromUTF8("p99.9 [µs]"), wxDATAVIEW_CELL_INERT, 90, wxALIGN_RIGHT);
+    view_->AppendTextColumn(wxString::FromUTF8("max [µs]"),   wxDATAVIEW_CELL_INERT, 90, wxALIGN_RIGHT);
+
+    auto* buttons = new wxBoxSizer(wxHORIZONTAL);
+    per_ch_ = new wxCheckBox(this, wxID_ANY, wxString::FromUTF8("je Kanal"));
+    per_ch_->SetValue(true);
+    auto* refresh = new wxButton(this, wxID_ANY, wxString::FromUTF8("Aktualisieren"));
+    auto* reset   = new wxButton(this, wxID_ANY, wxString::FromUTF8("Zurücksetzen"));
+    auto* dump    = new wxButton(this, wxID_ANY, wxString::FromUTF8("Speichern…"));
+    auto* close   = new wxButton(this, wxID_CANCEL, wxString::FromUTF8("Schließen"));
+
+    // Chrome-Trace (Perfetto)
+    auto* trace_row = new wxBoxSizer(wxHORIZONTAL);
+    trace_ = new wxCheckBox(this, wxID_ANY, wxString::FromUTF8("Trace aufzeichnen"));
+    trace_->SetValue(Tracer::Instance().Enabled());
+    auto* save_trace = new wxButton(this, wxID_ANY, wxString::FromUTF8("Trace speichern…"));
+    trace_row->Add(trace_, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 12);
+    trace_row->Add(save_trace, 0);
+    buttons->Add(per_ch_, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 12);
+    buttons->Add(refresh, 0, wxRIGHT, 6);
+    buttons->Add(reset,   0, wxRIGHT, 6);
+    buttons->Add(dump,    0, wxRIGHT, 6);
+    buttons->AddStretchSpacer();
+    buttons->Add(close,   0);
+
+    root->Add(view_,   1, wxEXPAND | wxALL, 6);
+    root->Add(trace_row, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 6);
+    root->Add(buttons, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 6);
+    SetSizer(root);
+
+    per_ch_->Bind(wxEVT_CHECKBOX, [this](wxCommandEvent&){ Refill(); });
+    refresh->Bind(wxEVT_BUTTON,   [this](wxCommandEvent&){ Refill(); });
+    reset->Bind(wxEVT_BUTTON,     [this](wxCommandEvent&){ StageProfiler::Instance().Reset(); Refill(); });
+    dump->Bind(wxEVT_BUTTON,      &DiagnosticsDialog::OnDump, this);
+    trace_->Bind(wxEVT_CHECKBOX,  [this](wxCommandEvent&){ Tracer::Instance().SetEnabled(trace_->GetValue()); });
+    save_trace->Bind(wxEVT_BUTTON, &DiagnosticsDialog::OnSaveTrace, this);
+
+    Refill();
+}
+
+void DiagnosticsDialog::Refill(){
+    view_->DeleteAllItems();
+    const auto& prof = StageProfiler::Instance();
+    const bool  per_channel = per_ch_->GetValue();
+
+    auto addRow = [this](Stage s, const wxString& ch, const LatencyHistogram::Summary& sum){
+        wxVector<wxVariant> row;
+        row.push_back(wxVariant(wxString::FromUTF8(StageName(s))));
+        row.push_back(wxVariant(ch));
+        row.push_back(wxVariant(wxString::Format("%llu", static_cast<unsigned long long>(sum.count))));
+        row.push_back(wxVariant(wxString::Format("%.1f", sum.p50_ns  / 1e3)));
+        row.push_back(wxVariant(wxString::Format("%.1f", sum.p99_ns  / 1e3)));
+        row.push_back(wxVariant(wxString::Format("%.1f", sum.p999_ns / 1e3)));
+        row.push_back(wxVariant(wxString::Format("%.1f", sum.max_ns  / 1e3)));
+        view_->AppendItem(row);
+    };
+
+    for (int si = 0; si < static_cast<int>(Stage::Count); ++si) {
+        const Stage s = static_cast<Stage>(si);
+        const auto tot = prof.Total(s).Summarize();
+        if (tot.count == 0) continue;
+        addRow(s, "alle", tot);
+        if (!per_channel) continue;
+        for (int ch = 0; ch < StageProfiler::kMaxChannels; ++ch) {
+            const auto cs = prof.Channel(s, ch).Summarize();
+            if (cs.count) addRow(s, wxString::Format("%d", ch + 1), cs);
+        }
+    }
+}
+
+void DiagnosticsDialog::OnDump(wxCommandEvent&){
+    wxFileDialog dlg(this, wxString::FromUTF8("Latenzen speichern"), "", "stage_latency.txt",
+                     "Textdateien (*.txt)|*.txt", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (dlg.ShowModal() != wxID_OK) return;
+
+    std::string err;
+    if (!StageProfiler::Instance().DumpToFile(dlg.GetPath().ToStdString(), &err)) {
+        wxMessageBox(wxString::FromUTF8(err.c_str()), "Fehler", wxICON_ERROR | wxOK, this);
+    }
+}
+
+void DiagnosticsDialog::OnSaveTrace(wxCommandEvent&){
+    wxFileDialog dlg(this, wxString::FromUTF8("Trace speichern (Perfetto / chrome://tracing)"), "", "sosesta_trace.json",
+                     "JSON (*.json)|*.json", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (dlg.ShowModal() != wxID_OK) return;
+
+    std::string err;
+    if (!Tracer::Instance().WriteChromeJson(dlg.GetPath().ToStdString(), &err)) {
+        wxMessageBox(wxString::FromUTF8(err.c_str()), "Fehler", wxICON_ERROR | wxOK, this);
+    }
+}
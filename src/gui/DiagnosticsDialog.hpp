@@ -0,0 +1,18 @@
+#pragma once
+#include <wx/wx.h>
+#include <wx/dataview.h>
+
+// Zeigt die Stufen-Latenzen (StageProfiler) als Tabelle: p50/p99/p99.9/max je Stufe und Kanal.
+class DiagnosticsDialog : public wxDialog {
+public:
+    explicit DiagnosticsDialog(wxWindow* parent);
+
+private:
+    void Refill();
+    void OnDump(wxCommandEvent&);
+    void OnSaveTrace(wxCommandEvent&);
+
+    wxDataViewListCtrl* view_     = nullptr;
+    wxCheckBox*         per_ch_   = nullptr;
+    wxCheckBox*         trace_    = nullptr;
+};
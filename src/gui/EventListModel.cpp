@@ -0,0 +1,75 @@
+#include "gui/EventListModel.hpp"
+
+namespace {
+constexpr size_t kResetAbove = 256;   // mehr neue Zeilen → Reset statt Einzelmeldungen
+}
+
+EventListModel::EventListModel(const LoggerService& log)
+: wxDataViewVirtualListModel(static_cast<unsigned int>(log.Events().size()))
+, log_(log)
+, seen_(log.Events().size())
+, shown_(log.Events().size())
+{}
+
+void EventListModel::Announce(size_t before, size_t after) {
+    if (after < before || after - before > kResetAbove) {
+        Reset(static_cast<unsigned int>(after));
+    } else {
+        for (size_t i = before; i < after; ++i) RowAppended();
+    }
+    shown_ = after;
+}
+
+void EventListModel::Sync() {
+    const auto& ev = log_.Events();
+    const size_t n = ev.size();
+    if (n == seen_) return;
+
+    if (!Filtered()) {
+        seen_ = n;
+        Announce(shown_, n);
+        return;
+    }
+
+    const bool cleared = n < seen_;
+    if (cleared) {
+        hits_.clear();
+        seen_ = 0;
+    }
+    const auto& entries = log_.Entries();
+    for (size_t i = seen_; i < n; ++i)
+        if (filter_.Matches(entries[ev[i]], log_.Strings())) hits_.push_back(static_cast<std::uint32_t>(i));
+    seen_ = n;
+    if (cleared) {
+        Reset(static_cast<unsigned int>(hits_.size()));
+        shown_ = hits_.size();
+    } else {
+        Announce(shown_, hits_.size());
+    }
+}
+
+void EventListModel::SetFilter(EventFilter f) {
+    filter_ = std::move(f);
+    hits_.clear();
+    if (Filtered()) log_.Query(filter_, hits_);
+    seen_  = log_.Events().size();
+    shown_ = Filtered() ? hits_.size() : seen_;
+    Reset(static_cast<unsigned int>(shown_));
+}
+
+void EventListModel::GetValueByRow(wxVariant& v, unsigned int row, unsigned int col) const {
+    const auto& idx = log_.Events();
+    const size_t pos = Filtered() ? (row < hits_.size() ? hits_[row] : idx.size()) : row;
+    if (pos >= idx.size()) { v = wxString(); return; }
+    const LoggerService::Entry& e = log_.Entries()[idx[pos]];
+    switch (col) {
+        case ColTime:     v = log_.Time(e); break;
+        case ColChannel:  v = wxString::Format("%d", e.channel + 1); break;   // 1..8
+        case ColSerial:   v = log_.Serial(e); break;
+        case ColKind:     v = log_.Kind(e); break;
+        case ColDetail:   v = log_.Detail(e); break;
+        case ColRelay:    v = log_.Relay(e); break;
+        case ColSeverity: v = LoggerService::Severity(e); break;
+        default:          v = wxString(); break;
+    }
+}
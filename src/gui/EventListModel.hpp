@@ -0,0 +1,39 @@
+#pragma once
+#include <wx/dataview.h>
+#include <cstdint>
+#include <vector>
+
+#include "services/LoggerService.hpp"
+
+// Ereignis-Log als virtuelles Listenmodell über LoggerService::Events():
+// keine Zeilenkopien, Texte entstehen nur für sichtbare Zeilen beim Zeichnen.
+// Mit Filter zeigt es nur die Treffer (Zeilenliste aus dem EventIndex);
+// neue Ereignisse werden in Sync() einzeln geprüft.
+class EventListModel : public wxDataViewVirtualListModel {
+public:
+    enum Column { ColTime, ColChannel, ColSerial, ColKind, ColDetail, ColRelay, ColSeverity, ColCount };
+
+    explicit EventListModel(const LoggerService& log);
+
+    // neue bzw. gelöschte Ereignisse an die Ansicht melden (GUI-Thread)
+    void Sync();
+
+    // Filter setzen (leer = alle); Trefferliste über den Index, dann Reset
+    void SetFilter(EventFilter f);
+    bool Filtered() const { return !filter_.Empty(); }
+    size_t Rows() const { return shown_; }
+
+    unsigned int GetColumnCount() const override { return ColCount; }
+    wxString GetColumnType(unsigned int) const override { return "string"; }
+    void GetValueByRow(wxVariant& v, unsigned int row, unsigned int col) const override;
+    bool SetValueByRow(const wxVariant&, unsigned int, unsigned int) override { return false; }
+
+private:
+    void Announce(size_t before, size_t after);
+
+    const LoggerService&       log_;
+    EventFilter                filter_;
+    std::vector<std::uint32_t> hits_;    // Positionen in Events() (nur mit Filter)
+    size_t                     seen_  = 0;   // geprüfte Ereignisse
+    size_t                     shown_ = 0;   // gemeldete Zeilen
+};
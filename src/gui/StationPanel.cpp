@@ -0,0 +1,624 @@
+#include "gui/StationPanel.hpp"
+#include "app/core/StationManager.hpp"
+#include "gui/ConfigEditor.hpp"
+#include "gui/DiagnosticsDialog.hpp"
+#include "hw/IHardware.hpp"
+#include "services/Metrics.hpp"
+#include "services/StageProfiler.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
+
+#include <wx/numdlg.h>
+#include <wx/sizer.h>
+#include <wx/filefn.h>
+#include <wx/statline.h>
+#include <wx/datetime.h>
+#include <wx/filename.h>
+#include <wx/time.h>
+#include <algorithm>
+#include <initializer_list>
+
+namespace {
+// Ereignis ohne Text: Zahlen in v[] (Bedeutung je Art, siehe EventKind)
+LoggerService::Entry MakeEvent(EventKind kind, Metrics::Severity sev, int ch,
+                               std::initializer_list<double> v = {}) {
+    LoggerService::Entry e;
+    e.kind     = kind;
+    e.severity = static_cast<std::uint8_t>(sev);
+    e.channel  = static_cast<std::int8_t>(ch);
+    size_t k = 0;
+    for (const double x : v) if (k < std::size(e.v)) e.v[k++] = static_cast<float>(x);
+    return e;
+}
+} // namespace
+
+wxBEGIN_EVENT_TABLE(StationPanel, wxPanel)
+    EVT_TIMER(1000, StationPanel::OnUiTick)
+wxEND_EVENT_TABLE()
+
+StationPanel::StationPanel(wxWindow* parent, Station& station)
+: wxPanel(parent, wxID_ANY)
+, station_(station)
+, cfg_(station.software)
+, logger_(station.logger)
+, exporter_(logger_)
+, test_runner_(*station.runner)
+, ui_timer_(this, 1000)
+{
+    // Kanalzahl der Station (TestRunner), nicht fest 8
+    const size_t n = static_cast<size_t>(test_runner_.Channels());
+    channels.assign(n, nullptr);
+    serial_numbers_.resize(n);
+    prev_supply_ok_.assign(n, false);
+    prev_signal_ok_.assign(n, false);
+    prev_current_ok_.assign(n, false);
+
+    auto* root = new wxBoxSizer(wxVERTICAL);
+
+    auto* cfgp = new wxPanel(this);
+    BuildConfigDisplay(cfgp);
+    root->Add(cfgp, 0, wxEXPAND|wxALL, 6);
+
+    channels_panel_ = new wxPanel(this);
+    BuildChannels(channels_panel_);
+    root->Add(channels_panel_, 1, wxEXPAND|wxLEFT|wxRIGHT, 6);
+
+    auto* ctrl = new wxPanel(this);
+    BuildControls(ctrl);
+    root->Add(ctrl, 0, wxEXPAND|wxALL, 6);
+
+    auto* err = new wxPanel(this);
+    BuildErrors(err);
+    root->Add(err, 2, wxEXPAND|wxALL, 6);
+
+    SetSizer(root);
+
+    test_duration_sec_ = cfg_.test_duration_sec;
+    ui_timer_.Start(std::max(50, cfg_.update_interval_ms));
+}
+
+void StationPanel::BuildConfigDisplay(wxWindow* parent) {
+    auto* s = new wxBoxSizer(wxHORIZONTAL);
+    auto* box = new wxStaticBoxSizer(wxVERTICAL, parent, wxString::FromUTF8("Aktuelle Konfiguration"));
+
+    // eine Zeile Text
+    cfg_text_line1_ = new wxStaticText(parent, wxID_ANY, "");
+    RefreshConfigLabel();
+
+    // Buttons rechts
+    auto* btnRow = new wxBoxSizer(wxHORIZONTAL);
+    edit_btn_ = new wxButton(parent, wxID_ANY, wxString::FromUTF8("⚙️ Schwellen bearbeiten"));
+    edit_btn_->Bind(wxEVT_BUTTON, [this](wxCommandEvent&){ OpenConfigEditor(); });
+
+    font_btn_ = new wxButton(parent, wxID_ANY, wxString::FromUTF8("🔤 Schriftgröße…"));
+    font_btn_->Bind(wxEVT_BUTTON, &StationPanel::OnChangeFont, this);
+
+    diag_btn_ = new wxButton(parent, wxID_ANY, wxString::FromUTF8("🩺 Diagnose…"));
+    diag_btn_->Bind(wxEVT_BUTTON, [this](wxCommandEvent&){ OpenDiagnostics(); });
+
+    btnRow->Add(edit_btn_, 0, wxRIGHT, 8);
+    btnRow->Add(font_btn_, 0, wxRIGHT, 8);
+    btnRow->Add(diag_btn_, 0);
+
+    // links (nur 1 Zeile), rechts (Buttons)
+    auto* row = new wxBoxSizer(wxHORIZONTAL);
+    row->Add(cfg_text_line1_, 1, wxALIGN_CENTER_VERTICAL | wxRIGHT, 8);
+    row->Add(btnRow, 0, wxALIGN_CENTER_VERTICAL);
+
+    box->Add(row, 0, wxEXPAND | wxALL, 8);
+    s->Add(box, 1, wxEXPAND | wxALL, 0);
+    parent->SetSizerAndFit(s);
+
+    // Wrap bei Größenänderung
+    parent->Bind(wxEVT_SIZE, [this](wxSizeEvent& e){
+        e.Skip();
+        if (!cfg_text_line1_) return;
+        int total = cfg_text_line1_->GetParent()->GetClientSize().GetWidth();
+        int wrapW = std::max(200, total - 260); // Platz für Buttons berücksichtigen
+        cfg_text_line1_->Wrap(wrapW);
+    });
+}
+
+
+void StationPanel::RefreshConfigLabel(){
+    const auto& c = cfg_;
+    if (cfg_text_line1_)
+        cfg_text_line1_->SetLabel(
+            wxString::FromUTF8("Dauer: ") << wxString::Format("%.1f h    ", c.test_duration_sec / 3600.0)
+            << wxString::FromUTF8("Maximalstrom: ") << wxString::Format("%.1f mA    ", c.max_current_mA)
+            << wxString::FromUTF8("PosSchwelle: ") << wxString::Format("[%.2f, %.2f] V    ", c.redlab_pos_threshold[0], c.redlab_pos_threshold[1])
+            << wxString::FromUTF8("NegSchwelle: ") << wxString::Format("[%.2f, %.2f] V    ", c.redlab_neg_threshold[0], c.redlab_neg_threshold[1])
+            << wxString::FromUTF8("Präsenzspannung: ") << wxString::Format("[%.2f, %.2f] mA    ", c.presence_current_threshold[0], c.presence_current_threshold[1])
+            << wxString::FromUTF8("Versorgung: ") << wxString::Format("[%.2f, %.2f] V", c.supply_voltage_threshold[0], c.supply_voltage_threshold[1])
+        );
+}
+
+
+
+// ───────────────────────────────────────────
+// Schriftgröße ändern (rekursiv)
+void StationPanel::OnChangeFont(wxCommandEvent&) {
+    int currentPt = 10;
+    if (cfg_text_line1_) currentPt = std::max(6, cfg_text_line1_->GetFont().GetPointSize());
+
+    wxNumberEntryDialog dlg(this,
+        wxString::FromUTF8("Neue Schriftgröße in Punkt (6–32):"),
+        wxString::FromUTF8("Schriftgröße"),
+        wxString::FromUTF8("Schriftgröße ändern"),
+        currentPt, 6, 32);
+
+    if (dlg.ShowModal() == wxID_OK) {
+        ChangeFontSize(dlg.GetValue());
+    }
+}
+
+void StationPanel::ChangeFontSize(int ptSize) {
+    SetFontSizeRecursive(this, ptSize);
+    Layout();
+    Refresh();
+}
+
+void StationPanel::SetFontSizeRecursive(wxWindow* win, int ptSize) {
+    if (!win) return;
+    wxFont f = win->GetFont();
+    if (f.IsOk()) {
+        f.SetPointSize(ptSize);
+        win->SetFont(f);
+    }
+    for (wxWindowList::compatibility_iterator node = win->GetChildren().GetFirst();
+         node; node = node->GetNext())
+    {
+        wxWindow* child = node->GetData();
+        SetFontSizeRecursive(child, ptSize);
+    }
+}
+
+void StationPanel::BuildChannels(wxWindow* parent){
+    // bis 8 Kanäle je Zeile
+    const int n    = static_cast<int>(channels.size());
+    const int cols = std::clamp(n, 1, 8);
+    auto* grid = new wxGridSizer((n + cols - 1) / cols, cols, 6, 6);
+    for (int i = 0; i < n; ++i) {
+        auto* pane  = new wxPanel(parent);
+        auto* sizer = new ChannelWidget(pane, i, on_toggle_pair_, serial_numbers_);
+        channels[i] = sizer;
+        pane->SetSizer(sizer);
+        grid->Add(pane, 1, wxEXPAND);
+    }
+    parent->SetSizer(grid);
+}
+
+void StationPanel::BuildErrors(wxWindow* parent){
+    auto* root = new wxBoxSizer(wxVERTICAL);
+    auto* box  = new wxStaticBoxSizer(wxVERTICAL, parent, wxString::FromUTF8("Ereignis-Log (Fehlerübersicht)"));
+
+    // Toolbar
+    auto* toolbar = new wxBoxSizer(wxHORIZONTAL);
+    btn_err_export_ = new wxButton(parent, wxID_ANY, "CSV exportieren");
+    btn_err_clear_  = new wxButton(parent, wxID_ANY, "Leeren");
+    toolbar->Add(btn_err_export_, 0, wxRIGHT, 6);
+    toolbar->Add(btn_err_clear_,  0, wxRIGHT, 6);
+    toolbar->AddStretchSpacer();
+
+    // Filter (EventIndex): Auswahl wirkt sofort, Textfelder mit Enter
+    auto* filter = new wxBoxSizer(wxHORIZONTAL);
+    wxArrayString ch_items;
+    ch_items.Add(wxString::FromUTF8("Alle Kanäle"));
+    for (size_t i = 1; i <= channels.size(); ++i) ch_items.Add(wxString::Format("Kanal %zu", i));
+    flt_channel_ = new wxChoice(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, ch_items);
+    const wxString sev_items[] = { "Alle", "ab INFO", "ab WARN", "ERROR" };
+    flt_severity_ = new wxChoice(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, 4, sev_items);
+    const wxString kind_items[] = { "Alle Arten", "Versorgung", "Signal", "Strom", "Sensor Erkannt",
+                                    wxString::FromUTF8("Übergang") };
+    flt_kind_ = new wxChoice(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, 6, kind_items);
+    const wxString time_items[] = { "Gesamt", "Letzte Stunde", "Letzte 24 h" };
+    flt_time_ = new wxChoice(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, 3, time_items);
+    for (auto* c : {flt_channel_, flt_severity_, flt_kind_, flt_time_}) {
+        c->SetSelection(0);
+        c->Bind(wxEVT_CHOICE, [this](wxCommandEvent&){ ApplyEventFilter(); });
+    }
+    flt_serial_ = new wxTextCtrl(parent, wxID_ANY, "", wxDefaultPosition, wxSize(110, -1), wxTE_PROCESS_ENTER);
+    flt_serial_->SetHint("SN (exakt)");
+    flt_text_ = new wxTextCtrl(parent, wxID_ANY, "", wxDefaultPosition, wxSize(140, -1), wxTE_PROCESS_ENTER);
+    flt_text_->SetHint("Suche");
+    for (auto* t : {flt_serial_, flt_text_})
+        t->Bind(wxEVT_TEXT_ENTER, [this](wxCommandEvent&){ ApplyEventFilter(); });
+    flt_info_ = new wxStaticText(parent, wxID_ANY, "");
+    for (wxWindow* w : std::initializer_list<wxWindow*>{flt_channel_, flt_severity_, flt_kind_, flt_time_, flt_serial_, flt_text_})
+        filter->Add(w, 0, wxRIGHT|wxALIGN_CENTER_VERTICAL, 6);
+    filter->Add(flt_info_, 0, wxALIGN_CENTER_VERTICAL);
+
+    // Tabelle (inkl. SN); Zeilen = logger_.Events(), Text erst beim Zeichnen.
+    // Virtuelles Modell: chronologisch, ohne Spaltensortierung.
+    error_view_ = new wxDataViewCtrl(parent, wxID_ANY,
+        wxDefaultPosition, wxDefaultSize, wxDV_ROW_LINES|wxDV_VERT_RULES|wxDV_MULTIPLE);
+    event_model_ = new EventListModel(logger_);
+    error_view_->AssociateModel(event_model_.get());
+    using M = EventListModel;
+    error_view_->AppendTextColumn("Zeit",      M::ColTime,     wxDATAVIEW_CELL_INERT, 150, wxALIGN_LEFT,  wxDATAVIEW_COL_RESIZABLE);
+    error_view_->AppendTextColumn("Kanal",     M::ColChannel,  wxDATAVIEW_CELL_INERT, 60,  wxALIGN_RIGHT, wxDATAVIEW_COL_RESIZABLE);
+    error_view_->AppendTextColumn("SN",        M::ColSerial,   wxDATAVIEW_CELL_INERT, 110, wxALIGN_LEFT,  wxDATAVIEW_COL_RESIZABLE);
+    error_view_->AppendTextColumn("Art",       M::ColKind,     wxDATAVIEW_CELL_INERT, 110, wxALIGN_LEFT,  wxDATAVIEW_COL_RESIZABLE);
+    error_view_->AppendTextColumn("Detail",    M::ColDetail,   wxDATAVIEW_CELL_INERT, 320, wxALIGN_LEFT,  wxDATAVIEW_COL_RESIZABLE);
+    error_view_->AppendTextColumn("Relais",    M::ColRelay,    wxDATAVIEW_CELL_INERT, 70,  wxALIGN_CENTER,wxDATAVIEW_COL_RESIZABLE);
+    error_view_->AppendTextColumn("Severity",  M::ColSeverity, wxDATAVIEW_CELL_INERT, 90,  wxALIGN_LEFT,  wxDATAVIEW_COL_RESIZABLE);
+
+    // Events
+    btn_err_export_->Bind(wxEVT_BUTTON, [this](wxCommandEvent&){ ExportErrorsCSV(); });
+    btn_err_clear_->Bind(wxEVT_BUTTON,  [this](wxCommandEvent&){
+        logger_.Clear();
+        event_model_->Sync();
+        std::string err;
+        if (!station_.journal.Clear(&err))
+            wxLogWarning("%s", wxString::FromUTF8(("Ereignis-Journal nicht geleert: " + err).c_str()));
+    });
+
+    box->Add(toolbar, 0, wxEXPAND|wxALL, 4);
+    box->Add(filter, 0, wxEXPAND|wxLEFT|wxRIGHT|wxBOTTOM, 4);
+    box->Add(error_view_, 1, wxEXPAND|wxLEFT|wxRIGHT|wxBOTTOM, 4);
+    root->Add(box, 1, wxEXPAND|wxALL, 0);
+    parent->SetSizer(root);
+}
+
+void StationPanel::BuildControls(wxWindow* parent){
+    auto* s = new wxBoxSizer(wxHORIZONTAL);
+    btn_toggle_  = new wxButton(parent, wxID_ANY, wxString::FromUTF8("🔁 Relais toggeln"));
+    btn_start_   = new wxButton(parent, wxID_ANY, wxString::FromUTF8("▶️ Start Test"));
+    btn_stop_    = new wxButton(parent, wxID_ANY, wxString::FromUTF8("⏹ Stop Test"));
+    btn_archive_ = new wxButton(parent, wxID_ANY, wxString::FromUTF8("📂 Archiv öffnen"));
+    timer_label_ = new wxStaticText(parent, wxID_ANY, "00:00:00");
+
+    btn_stop_->Enable(false);
+
+    btn_toggle_->Bind(wxEVT_BUTTON, &StationPanel::OnToggle, this);
+    btn_start_->Bind(wxEVT_BUTTON, &StationPanel::OnStart, this);
+    btn_stop_->Bind(wxEVT_BUTTON, &StationPanel::OnStop, this);
+    btn_archive_->Bind(wxEVT_BUTTON, &StationPanel::OnArchive, this);
+
+    s->Add(btn_toggle_, 0, wxRIGHT, 6);
+    s->Add(btn_start_, 0, wxRIGHT, 6);
+    s->Add(btn_stop_, 0, wxRIGHT, 6);
+    s->Add(btn_archive_, 0, wxRIGHT, 6);
+    s->AddStretchSpacer();
+    s->Add(timer_label_, 0, wxALIGN_CENTER_VERTICAL);
+
+    parent->SetSizer(s);
+}
+
+void StationPanel::OnToggle(wxCommandEvent&){
+    if (wxMessageBox(wxString::FromUTF8("Relais manuell toggeln? Nur bei Bedarf."),
+                     "Sicherheitsabfrage", wxYES_NO|wxICON_WARNING) != wxYES)
+        return;
+
+    // manuell: alle Paare gemeinsam umlegen (Anzeige folgt im UI-Tick)
+    test_runner_.ToggleRelays();
+}
+
+void StationPanel::OnStart(wxCommandEvent&){
+    test_running_ = true;
+    start_ts_ = std::chrono::system_clock::now();
+    test_duration_sec_ = cfg_.test_duration_sec;
+
+    btn_start_->Enable(false);
+    btn_stop_->Enable(true);
+    btn_toggle_->Enable(false);
+    btn_archive_->Enable(false);
+    for(auto* w : channels) if (w) w->DisableSerialInput();
+
+    // Sitzung: archiv/sitzung_JJJJMMTT_hhmmss[_tag].ssa + _bericht.csv
+    const wxString dir = wxString::FromUTF8(cfg_.archive_dir.c_str());
+    wxFileName::Mkdir(dir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    wxString name = "sitzung_" + wxDateTime::Now().Format("%Y%m%d_%H%M%S");
+    if (!station_.tag.empty()) name << "_" << wxString::FromUTF8(station_.tag.c_str());   // mehrere Stationen
+    session_base_ = wxFileName(dir, name).GetFullPath();
+
+    test_runner_.BeginReport(serial_numbers_);
+
+    if (cfg_.archive_sessions) {
+        const wxString path = session_base_ + ".ssa";
+        std::string err;
+        if (test_runner_.BeginArchive(std::string(path.utf8_str()), &err))
+            logger_.Log("Archiv", wxString::FromUTF8("Aufzeichnung nach ") + path, "INFO");
+        else
+            wxLogWarning("%s", wxString::FromUTF8(("Sitzungsarchiv nicht angelegt: " + err).c_str()));
+    }
+
+    // Relaispaare schalten versetzt nach Zeitplan (Paar 0 sofort EIN)
+    test_runner_.StartRelaySchedule();
+}
+
+void StationPanel::OnStop(wxCommandEvent&){
+    test_running_ = false;
+    btn_start_->Enable(true);
+    btn_stop_->Enable(false);
+    btn_toggle_->Enable(true);
+    btn_archive_->Enable(true);
+    test_runner_.StopRelaySchedule();
+
+    TestRunner::ArchiveInfo info;
+    std::string err;
+    if (test_runner_.EndArchive(&info, &err)) {
+        if (!info.path.empty())
+            logger_.Log("Archiv", wxString::FromUTF8(info.path.c_str())
+                        + wxString::Format(": %llu Zyklen, %.1f kB",
+                                           static_cast<unsigned long long>(info.samples), info.bytes / 1024.0), "INFO");
+    } else {
+        wxLogWarning("%s", wxString::FromUTF8(("Sitzungsarchiv unvollständig: " + err).c_str()));
+    }
+
+    // Archiv zusätzlich als Arrow-Datei (pandas/polars, ohne Parsen); läuft
+    // im Hintergrund, Abschlussmeldung im UI-Takt (UpdateArrowExport)
+    if (cfg_.archive_arrow && !info.path.empty() && info.samples > 0) {
+        const wxString arrow = session_base_ + ".arrow";
+        err.clear();
+        if (!test_runner_.BeginArrowExport(info.path, std::string(arrow.utf8_str()), &err))
+            wxLogWarning("%s", wxString::FromUTF8(("Arrow-Export nicht gestartet: " + err).c_str()));
+    }
+
+    // Bericht liegt fertig vor – nur noch serialisieren
+    const wxString report = session_base_ + "_bericht.csv";
+    err.clear();
+    if (test_runner_.EndReport(std::string(report.utf8_str()), &err))
+        logger_.Log("Bericht", report, "OK");
+    else
+        wxLogWarning("%s", wxString::FromUTF8(("Prüfbericht nicht geschrieben: " + err).c_str()));
+}
+
+void StationPanel::OnArchive(wxCommandEvent&){
+    // Archivordner (*.ssa), falls schon angelegt; sonst Arbeitsverzeichnis
+    wxString path = wxString::FromUTF8(cfg_.archive_dir.c_str());
+    if (!wxDirExists(path)) path = wxGetCwd();
+    else path = wxFileName::DirName(path).GetFullPath();
+#ifdef __WXMSW__
+    ::wxExecute("explorer \"" + path + "\"");
+#elif defined(__WXOSX__)
+    ::wxExecute("open \"" + path + "\"");
+#else
+    ::wxExecute("xdg-open \"" + path + "\"");
+#endif
+}
+
+void StationPanel::OnUiTick(wxTimerEvent&){
+    // neue Sensorwerte holen (mit Erfassungsthread liefert Sensors() nur den letzten Stand)
+    if (!test_runner_.LoopActive()) test_runner_.Step();
+
+    ScopedStageTimer t(Stage::GuiUpdate);
+    UpdateChannels();
+    UpdateRelays();
+    UpdateErrors();
+    UpdateTransitions();
+    UpdateArrowExport();
+    UpdateHardwareErrors();
+    event_model_->Sync();
+    UpdateFilterInfo();
+    UpdateTimer();
+}
+
+void StationPanel::UpdateArrowExport(){
+    TestRunner::ArrowExportInfo r;
+    while (test_runner_.TakeArrowExport(&r)) {
+        if (r.ok)
+            logger_.Log("Archiv", wxString::FromUTF8(r.path.c_str())
+                        + wxString::Format(": %llu Zeilen", static_cast<unsigned long long>(r.rows)), "INFO");
+        else
+            logger_.Log("Archiv", wxString::FromUTF8(("Arrow-Export fehlgeschlagen: " + r.err).c_str()), "ERROR");
+    }
+}
+
+void StationPanel::UpdateHardwareErrors(){
+    if (!station_.hardware) return;
+    std::string err;
+    while (station_.hardware->TakeError(&err))
+        logger_.Log("Hardware", wxString::FromUTF8(err.c_str()), "ERROR");
+}
+
+void StationPanel::UpdateRelays(){
+    const std::uint32_t mask = test_runner_.RelayMask();
+    if (mask == relay_mask_) return;
+    relay_mask_ = mask;
+    for (size_t i = 0; i < channels.size(); ++i)
+        if (channels[i]) channels[i]->SetRelayState((mask >> (i / 2)) & 1u);
+}
+
+void StationPanel::UpdateChannels(){
+    const auto& vec = test_runner_.Sensors();
+    const size_t n = std::min(vec.size(), channels.size());
+    for(size_t i=0;i<n;++i){
+        if (channels[i]) channels[i]->UpdateFrom(vec[i]);
+    }
+}
+
+// Änderungen (OK↔Fehler) erkennen und protokollieren
+void StationPanel::UpdateErrors(){
+    SOSESTA_TRACE_SCOPE("StationPanel::UpdateErrors");
+    const auto& S = test_runner_.Sensors();
+    if (S.empty()) return;
+
+    // Schwellwerte aus Config
+    const auto& c = cfg_;
+
+    if (!prev_init_){
+        for (size_t i=0;i<S.size() && i<prev_supply_ok_.size();++i){
+            prev_supply_ok_[i] = S[i].supply_ok;
+            prev_signal_ok_[i] = S[i].signal_ok;
+            // current_ok aus Stromfenster abgeleitet
+            const bool cur_ok = (S[i].current_mA >= c.presence_current_threshold[0] &&
+                                 S[i].current_mA <= c.presence_current_threshold[1]);
+            prev_current_ok_[i]= cur_ok;
+        }
+        prev_init_ = true;
+        return;
+    }
+
+    using K = EventKind;
+    using Sev = Metrics::Severity;
+    for (size_t i=0;i<S.size() && i<prev_supply_ok_.size();++i){
+        const auto& s = S[i];
+        const int ch = int(i);
+
+        // Versorgung
+        if (s.supply_ok != prev_supply_ok_[i]){
+            if (!s.supply_ok){
+                LogEvent(MakeEvent(K::SupplyFail, Sev::Error, ch,
+                         {s.bus_V, c.supply_voltage_threshold[0], c.supply_voltage_threshold[1]}));
+            } else {
+                LogEvent(MakeEvent(K::SupplyOk, Sev::Ok, ch));
+            }
+            prev_supply_ok_[i] = s.supply_ok;
+        }
+
+        // Signal (RedLab)
+        if (s.signal_ok != prev_signal_ok_[i]){
+            if (!s.signal_ok){
+                LogEvent(MakeEvent(K::SignalFail, Sev::Error, ch,
+                         {s.redlab_V,
+                          c.redlab_neg_threshold[0], c.redlab_neg_threshold[1],
+                          c.redlab_pos_threshold[0], c.redlab_pos_threshold[1]}));
+            } else {
+                LogEvent(MakeEvent(K::SignalOk, Sev::Ok, ch));
+            }
+            prev_signal_ok_[i] = s.signal_ok;
+        }
+
+        // Strom → current_ok ableiten
+        const bool current_ok_now = (s.current_mA >= c.presence_current_threshold[0] &&
+                                     s.current_mA <= c.presence_current_threshold[1]);
+        if (current_ok_now != prev_current_ok_[i]){
+            if (!current_ok_now){
+                LogEvent(MakeEvent(K::CurrentFail, Sev::Error, ch,
+                         {s.current_mA, c.presence_current_threshold[0], c.presence_current_threshold[1]}));
+            } else {
+                LogEvent(MakeEvent(K::CurrentOk, Sev::Ok, ch));
+            }
+            prev_current_ok_[i] = current_ok_now;
+        }
+
+        // Präsenz (optional Hinweis)
+        if (!s.present){
+            LogEvent(MakeEvent(K::NotDetected, Sev::Warn, ch));
+        }
+    }
+}
+
+// Ergebnisse der Übergangsmessung (Relais-Wechsel) ins Ereignis-Log
+void StationPanel::UpdateTransitions(){
+    const auto results = test_runner_.TakeTransitions();
+    if (results.empty()) return;
+
+    for (const auto& r : results){
+        if (r.channel < 0 || r.channel >= static_cast<int>(channels.size())) continue;
+        // nicht eingeschwungen bzw. 90 % nie erreicht → auffällig
+        const auto sev = (r.settle_us < 0.0 || r.rise_us < 0.0) ? Metrics::Severity::Warn : Metrics::Severity::Info;
+        auto e = MakeEvent(EventKind::Transition, sev, r.channel,
+                           {r.from, r.to, r.rise_us, r.settle_us, r.overshoot_pct});
+        e.text = logger_.Intern(TransitionCapture::QuantityName(r.quantity));
+        e.aux  = r.quantity == TransitionCapture::Quantity::Signal ? 1 : 0;   // Volt statt mA
+        LogEvent(e);
+    }
+}
+
+void StationPanel::UpdateTimer(){
+    if (!test_running_){
+        timer_label_->SetLabel("00:00:00");
+        return;
+    }
+    auto now = std::chrono::system_clock::now();
+    auto end = start_ts_ + std::chrono::seconds(test_duration_sec_);
+    if (now >= end){
+        timer_label_->SetLabel("00:00:00");
+        wxCommandEvent evt;
+        OnStop(evt);
+        return;
+    }
+    auto remaining = std::chrono::duration_cast<std::chrono::seconds>(end-now).count();
+    int h = static_cast<int>(remaining / 3600);
+    int m = static_cast<int>((remaining % 3600) / 60);
+    int s = static_cast<int>(remaining % 60);
+    timer_label_->SetLabel(wxString::Format("%02d:%02d:%02d", h,m,s));
+}
+
+void StationPanel::LogEvent(LoggerService::Entry e)
+{
+    e.t_ns  = LoggerService::NowNs();
+    e.relay = static_cast<std::uint8_t>(test_runner_.RelayMask());   // Bit i = Paar i
+    if (e.channel >= 0 && e.channel < static_cast<int>(serial_numbers_.size()))
+        e.serial = logger_.Intern(serial_numbers_[size_t(e.channel)]);   // vorhanden → ohne Allokation
+    logger_.Record(e);
+
+    Metrics::Instance().OnEvent(static_cast<Metrics::Severity>(e.severity));
+    if (test_runner_.Streaming()) {
+        char detail[256];
+        const size_t n = EventFormat::Detail(e, logger_.Strings(), detail, sizeof(detail));
+        test_runner_.PublishEvent(e.channel, e.severity, EventFormat::KindName(e.kind), std::string_view(detail, n));
+    }
+
+    // absturzsicher: Journal-Thread sichert gesammelt (Group Commit)
+    const StringPool& str = logger_.Strings();
+    station_.journal.Append({ e, &str.Get(e.serial), &str.Get(e.text), &str.Get(e.category) });
+}
+
+void StationPanel::ApplyEventFilter(){
+    SOSESTA_TRACE_SCOPE("StationPanel::ApplyEventFilter");
+    EventQuery q;
+    if (const int c = flt_channel_->GetSelection(); c > 0) q.channel = c - 1;
+    if (const int s = flt_severity_->GetSelection(); s > 0)
+        q.severities = EventQuery::SeverityAtLeast(static_cast<std::uint8_t>(s));   // 1 = INFO … 3 = ERROR
+    auto bit = [](EventKind k) { return 1u << static_cast<unsigned>(k); };
+    switch (flt_kind_->GetSelection()) {
+        case 1: q.kinds = bit(EventKind::SupplyFail)  | bit(EventKind::SupplyOk);  break;
+        case 2: q.kinds = bit(EventKind::SignalFail)  | bit(EventKind::SignalOk);  break;
+        case 3: q.kinds = bit(EventKind::CurrentFail) | bit(EventKind::CurrentOk); break;
+        case 4: q.kinds = bit(EventKind::NotDetected); break;
+        case 5: q.kinds = bit(EventKind::Transition);  break;
+        default: break;
+    }
+    if (const int t = flt_time_->GetSelection(); t > 0)
+        q.t_from_ns = LoggerService::NowNs() - (t == 1 ? 3600ull : 86400ull) * 1000000000ull;
+    q.serial = std::string(flt_serial_->GetValue().Trim().Trim(false).utf8_str());
+    q.text   = std::string(flt_text_->GetValue().Trim().Trim(false).utf8_str());
+
+    const std::uint64_t t0 = sosesta::util::MonoNs();
+    event_model_->SetFilter(EventFilter(std::move(q), logger_.Strings()));
+    filter_ms_ = static_cast<double>(sosesta::util::MonoNs() - t0) / 1e6;
+    UpdateFilterInfo();
+}
+
+void StationPanel::UpdateFilterInfo(){
+    const wxString label = event_model_->Filtered()
+        ? wxString::Format("%zu von %zu (%.1f ms)", event_model_->Rows(), logger_.Events().size(), filter_ms_)
+        : wxString();
+    if (label != flt_info_->GetLabel()) flt_info_->SetLabel(label);
+}
+
+void StationPanel::ExportErrorsCSV(){
+    SOSESTA_TRACE_SCOPE("StationPanel::ExportErrorsCSV");
+    wxFileDialog dlg(this, wxString::FromUTF8("Ereignisse exportieren"), "", "ereignis_log.csv",
+        "CSV Dateien (*.csv)|*.csv|Arrow/Feather (*.arrow)|*.arrow", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
+    if (dlg.ShowModal()!=wxID_OK) return;
+
+    // CSV: Texte entstehen erst hier (UTF-8 mit BOM, Excel-freundlich);
+    // Arrow: typisierte Spalten für pandas/polars
+    const std::string path(dlg.GetPath().utf8_str());
+    std::string err;
+    const bool ok = dlg.GetFilterIndex() == 1 || dlg.GetPath().Lower().EndsWith(".arrow")
+        ? logger_.ExportEventsArrow(path, &err)
+        : logger_.ExportEventsCsv(path, &err);
+    if (!ok)
+        wxMessageBox(wxString::FromUTF8(("Datei konnte nicht geschrieben werden.\n" + err).c_str()), "Fehler", wxICON_ERROR);
+}
+
+void StationPanel::OpenConfigEditor(){
+    ConfigEditorDlg dlg(this, cfg_);
+    if (dlg.ShowModal() == wxID_OK) {
+        test_runner_.ApplyConfig();   // Erfassungszyklus sieht die neuen Werte ab dem nächsten Zyklus
+        RefreshConfigLabel();
+        // ggf. Timer neu starten, falls Intervall geändert
+        if (ui_timer_.IsRunning()) ui_timer_.Stop();
+        ui_timer_.Start(std::max(50, cfg_.update_interval_ms));
+    }
+}
+
+void StationPanel::OpenDiagnostics(){
+    DiagnosticsDialog dlg(this);
+    dlg.ShowModal();
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include <wx/wx.h>
+#include <wx/timer.h>
+#include <wx/dataview.h>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+
+#include "config/ConfigSoftware.hpp"
+#include "services/LoggerService.hpp"
+#include "services/CsvExporter.hpp"
+#include "services/TestRunner.hpp"
+#include "app/data/SensorData.hpp"
+#include "gui/ChannelWidget.hpp"
+#include "gui/EventListModel.hpp"
+
+struct Station;
+
+// Bedienoberfläche einer Station (eine Notebook-Seite im MainFrame)
+class StationPanel : public wxPanel {
+public:
+    StationPanel(wxWindow* parent, Station& station);
+
+private:
+    // Aufbau
+    void BuildConfigDisplay(wxWindow* parent);
+    void BuildChannels(wxWindow* parent);
+    void BuildErrors(wxWindow* parent);
+    void BuildControls(wxWindow* parent);
+    void RefreshConfigLabel();
+
+    // Handlers
+    void OnToggle(wxCommandEvent&);
+    void OnStart(wxCommandEvent&);
+    void OnStop(wxCommandEvent&);
+    void OnArchive(wxCommandEvent&);
+    void OnUiTick(wxTimerEvent&);
+    void OnChangeFont(wxCommandEvent&);
+    void OpenConfigEditor();
+    void OpenDiagnostics();
+
+    // Helpers
+    void ChangeFontSize(int ptSize);
+    static void SetFontSizeRecursive(wxWindow* win, int ptSize);
+
+    // Updates
+    void UpdateChannels();
+    void UpdateRelays();
+    void UpdateErrors();
+    void UpdateTimer();
+    void UpdateTransitions();
+    void UpdateArrowExport();   // fertige Arrow-Exporte melden
+    void UpdateHardwareErrors();   // Gerätefehler (Init, Reconnect) ins Log
+
+    // Logging: e mit Art, Kanal, Severity und Zahlen; Zeit, Relais und SN
+    // ergänzt LogEvent (kein Text, keine Allokation)
+    void LogEvent(LoggerService::Entry e);
+    void ExportErrorsCSV();
+    void ApplyEventFilter();   // Filterleiste → EventListModel (über EventIndex)
+    void UpdateFilterInfo();
+
+private:
+    // Konfiguration + Dienste gehören der Station (StationManager)
+    Station&        station_;
+    ConfigSoftware& cfg_;
+    LoggerService&  logger_;
+    CsvExporter     exporter_;
+    TestRunner&     test_runner_;     // liefert Sensors() und Step()
+
+    // "Aktuelle Konfiguration" über zwei Zeilen
+    wxStaticText* cfg_text_line1_ = nullptr;
+
+    wxButton* edit_btn_ = nullptr;
+    wxButton* font_btn_ = nullptr; // Schriftgröße…
+    wxButton* diag_btn_ = nullptr; // Diagnose (Stufenlatenzen)
+
+    wxPanel* channels_panel_ = nullptr;
+
+    // ChannelWidget ist bei dir ein Control mit Signatur:
+    // ChannelWidget(wxWindow*, int, std::function<bool(int)>, std::vector<std::string>&)
+    std::vector<ChannelWidget*> channels;   // je Kanal der Station
+
+    // Ereignis-Log (tabellarisch, virtuell über logger_)
+    wxDataViewCtrl*                 error_view_ = nullptr;
+    wxObjectDataPtr<EventListModel> event_model_;
+    wxButton *btn_toggle_ = nullptr, *btn_start_ = nullptr, *btn_stop_ = nullptr, *btn_archive_ = nullptr;
+    wxButton *btn_err_export_ = nullptr, *btn_err_clear_ = nullptr;
+    // Filterleiste über dem Ereignis-Log
+    wxChoice   *flt_channel_ = nullptr, *flt_severity_ = nullptr, *flt_kind_ = nullptr, *flt_time_ = nullptr;
+    wxTextCtrl *flt_serial_  = nullptr, *flt_text_ = nullptr;
+    wxStaticText* flt_info_  = nullptr;
+    double        filter_ms_ = 0.0;   // Dauer der letzten Abfrage
+    wxStaticText* timer_label_ = nullptr;
+
+    // Test-/UI-Status
+    bool test_running_ = false;
+    std::uint32_t relay_mask_ = 0;   // angezeigter Relaisstand (Bit i = Paar i)
+    std::chrono::system_clock::time_point start_ts_{};
+    int test_duration_sec_ = 0;
+    wxString session_base_;   // archiv/sitzung_JJJJMMTT_hhmmss (ohne Endung)
+
+    // Timer (IDs wie in deiner Vorlage)
+    wxTimer ui_timer_;
+
+    // Zustands-Tracking (Kipp-Punkte)
+    std::vector<bool> prev_supply_ok_;
+    std::vector<bool> prev_signal_ok_;
+    std::vector<bool> prev_current_ok_;
+    bool prev_init_ = false;
+
+    // einfache SN-Liste, falls ChannelWidget eine Anzeige erwartet
+    std::vector<std::string> serial_numbers_;
+
+    // Relay-Paarlabel für ChannelWidget (falls genutzt)
+    std::vector<std::string> relay_labels_ { "K0/1", "K2/3", "K4/5", "K6/7" };
+
+    // Callback für optionales Paar-Schalten aus ChannelWidget (hier Dummy)
+    std::function<bool(int)> on_toggle_pair_ =
+        [this](int /*pairIdx*/){ /* optional: einzelnes Paar schalten */ return false; };
+
+    wxDECLARE_EVENT_TABLE();
+};
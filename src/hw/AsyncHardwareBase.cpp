@@ -0,0 +1,195 @@
+// src/hw/AsyncHardwareBase.cpp
+#include "hw/AsyncHardwareBase.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace sosesta::hw
+{
+
+// ── FramePool ─────────────────────────────────────────────
+
+FramePool::FramePool(size_t frames, int channels)
+    : frames_(std::max<size_t>(frames, 1))
+{
+    free_.reserve(frames_.size());
+    for (auto& f : frames_) {
+        f.ch.resize(static_cast<size_t>(std::max(channels, 1)));
+        for (size_t i = 0; i < f.ch.size(); ++i) f.ch[i].channel = static_cast<int>(i);
+        free_.push_back(&f);
+    }
+}
+
+Frame* FramePool::Acquire() {
+    std::lock_guard<std::mutex> lk(m_);
+    if (free_.empty()) return nullptr;
+    Frame* f = free_.back();
+    free_.pop_back();
+    return f;
+}
+
+void FramePool::Release(Frame* f) {
+    if (!f) return;
+    std::lock_guard<std::mutex> lk(m_);
+    free_.push_back(f);   // Kapazität reicht: nie mehr Frames als vorbelegt
+}
+
+size_t FramePool::Free() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return free_.size();
+}
+
+// ── AsyncHardwareBase ─────────────────────────────────────
+
+AsyncHardwareBase::AsyncHardwareBase(int channels, AsyncOptions opt)
+    : channels_(std::max(channels, 1))
+    , pool_(opt.frames, channels_)
+{
+    const size_t q = std::max<size_t>(opt.queue_depth, 1);
+    requests_.buf.resize(q);
+    // je Leseauftrag bis zu zwei Abschlüsse
+    done_.buf.resize(2 * q + pool_.Capacity());
+}
+
+AsyncHardwareBase::~AsyncHardwareBase() {
+    StopAsync();   // Ableitung hat das bereits getan; hier nur zur Sicherheit
+}
+
+void AsyncHardwareBase::StartAsync() {
+    std::lock_guard<std::mutex> lk(m_);
+    if (running_) return;
+    stop_    = false;
+    running_ = true;
+    worker_  = std::thread([this] { Run(); });
+}
+
+void AsyncHardwareBase::StopAsync() {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (!running_) return;
+        stop_ = true;
+    }
+    req_cv_.notify_all();
+    done_cv_.notify_all();
+    worker_.join();
+
+    std::lock_guard<std::mutex> lk(m_);
+    running_ = false;
+    requests_.head = requests_.count = 0;
+    while (!done_.Empty()) pool_.Release(done_.Pop().frame);
+}
+
+std::uint64_t AsyncHardwareBase::Enqueue(Request r) {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (!running_ || stop_ || requests_.Full()) {
+            astats_.rejected.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+        r.id        = next_id_++;
+        r.submit_ns = sosesta::util::MonoNs();
+        requests_.Push(r);
+    }
+    astats_.submitted.fetch_add(1, std::memory_order_relaxed);
+    req_cv_.notify_one();
+    return r.id;
+}
+
+std::uint64_t AsyncHardwareBase::SubmitRead(std::uint32_t channel_mask) {
+    const std::uint32_t all = channels_ >= 32 ? ~0u : ((1u << channels_) - 1u);
+    channel_mask &= all;
+    if (channel_mask == 0) return 0;
+    Request r;
+    r.kind = Completion::Kind::Read;
+    r.mask = channel_mask;
+    return Enqueue(r);
+}
+
+std::uint64_t AsyncHardwareBase::SubmitRelay(int relay, bool state) {
+    Request r;
+    r.kind  = Completion::Kind::Actuator;
+    r.relay = relay;
+    r.state = state;
+    return Enqueue(r);
+}
+
+size_t AsyncHardwareBase::Poll(Completion* out, size_t max, std::uint64_t timeout_ns) {
+    if (!out || max == 0) return 0;
+    std::unique_lock<std::mutex> lk(m_);
+    if (done_.Empty() && timeout_ns > 0)
+        done_cv_.wait_for(lk, std::chrono::nanoseconds(timeout_ns), [this] { return !done_.Empty() || stop_; });
+    size_t n = 0;
+    while (n < max && !done_.Empty()) out[n++] = done_.Pop();
+    lk.unlock();
+    if (n) done_cv_.notify_all();   // Worker wartet evtl. auf Platz
+    return n;
+}
+
+void AsyncHardwareBase::Complete(const Completion& c) {
+    std::unique_lock<std::mutex> lk(m_);
+    // Empfänger holt nicht ab: Worker bremst statt Ergebnisse zu verwerfen
+    done_cv_.wait(lk, [this] { return !done_.Full() || stop_; });
+    if (stop_) { pool_.Release(c.frame); return; }
+    done_.Push(c);
+    lk.unlock();
+    astats_.completed.fetch_add(1, std::memory_order_relaxed);
+    done_cv_.notify_all();
+}
+
+void AsyncHardwareBase::Run() {
+    Tracer::Instance().SetThreadName("hw-async");
+    for (;;) {
+        Request r;
+        {
+            std::unique_lock<std::mutex> lk(m_);
+            req_cv_.wait(lk, [this] { return stop_ || !requests_.Empty(); });
+            if (stop_) return;
+            r = requests_.Pop();
+        }
+
+        Completion c;
+        c.kind      = r.kind;
+        c.request   = r.id;
+        c.submit_ns = r.submit_ns;
+
+        if (r.kind == Completion::Kind::Actuator) {
+            SOSESTA_TRACE_SCOPE("hw.Actuate", r.relay);
+            c.group   = DeviceGroup::Relay;
+            c.target  = r.relay;
+            c.state   = r.state;
+            c.ok      = Actuate(r.relay, r.state);
+            c.done_ns = sosesta::util::MonoNs();
+            Complete(c);
+            continue;
+        }
+
+        for (const DeviceGroup g : { DeviceGroup::Ina, DeviceGroup::Daq }) {
+            c.group = g;
+            c.frame = pool_.Acquire();
+            if (!c.frame) {
+                // Empfänger hält alle Frames: Gruppe auslassen, aber melden
+                astats_.no_frame.fetch_add(1, std::memory_order_relaxed);
+                c.ok      = false;
+                c.done_ns = sosesta::util::MonoNs();
+                Complete(c);
+                continue;
+            }
+            Frame& f    = *c.frame;
+            f.request   = r.id;
+            f.group     = g;
+            f.mask      = r.mask;
+            f.submit_ns = r.submit_ns;
+            {
+                SOSESTA_TRACE_SCOPE(g == DeviceGroup::Ina ? "hw.ReadGroup.Ina" : "hw.ReadGroup.Daq");
+                f.ok_mask = ReadGroup(g, r.mask, f.ch.data());
+            }
+            f.done_ns = c.done_ns = sosesta::util::MonoNs();
+            c.ok = f.ok_mask == r.mask;
+            Complete(c);
+        }
+    }
+}
+
+} // namespace sosesta::hw
@@ -0,0 +1,102 @@
+// src/hw/AsyncHardwareBase.hpp
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "hw/IAsyncHardware.hpp"
+
+namespace sosesta::hw
+{
+
+struct AsyncOptions {
+    size_t frames      = 16;   // FramePool (je Leseauftrag ein Frame je Gruppe)
+    size_t queue_depth = 32;   // offene Aufträge
+};
+
+struct AsyncStats {
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> rejected{0};      // Warteschlange voll / nicht gestartet
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> no_frame{0};      // Gruppe ohne freien Frame übersprungen
+};
+
+/**
+ * @brief Gemeinsamer Unterbau für IAsyncHardware.
+ *
+ * Ein Worker-Thread arbeitet die Aufträge ab und ruft dafür die
+ * gerätespezifischen ReadGroup()/Actuate() der Ableitung; die Gruppen
+ * eines Leseauftrags laufen nacheinander (INA, dann DAQ) und melden
+ * jeweils sofort. Warteschlangen sind feste Ringe, Frames kommen aus dem
+ * FramePool – im Betrieb keine Allokation.
+ *
+ * Ableitungen rufen StartAsync() in Initialize() und StopAsync() in
+ * Shutdown() und im eigenen Destruktor (der Worker ruft ihre Methoden).
+ */
+class AsyncHardwareBase : public IAsyncHardware
+{
+public:
+    explicit AsyncHardwareBase(int channels, AsyncOptions opt = {});
+    ~AsyncHardwareBase() override;
+
+    std::uint64_t SubmitRead(std::uint32_t channel_mask) override;
+    std::uint64_t SubmitRelay(int relay, bool state) override;
+    size_t Poll(Completion* out, size_t max, std::uint64_t timeout_ns = 0) override;
+    void Release(Frame* frame) override { pool_.Release(frame); }
+
+    const AsyncStats& GetAsyncStats() const { return astats_; }
+    const FramePool&  Frames() const { return pool_; }
+
+protected:
+    /// Gruppe g für Kanäle aus mask lesen, Ergebnisse nach out[ch];
+    /// Rückgabe = Kanäle mit frischem Wert. Nur vom Worker gerufen.
+    virtual std::uint32_t ReadGroup(DeviceGroup g, std::uint32_t mask, SensorData* out) = 0;
+
+    /// Aktor schalten (-1 = alle); Nur vom Worker gerufen.
+    virtual bool Actuate(int relay, bool state) = 0;
+
+    void StartAsync();
+    void StopAsync();   // offene Aufträge verfallen, ungeholte Frames zurück in den Pool
+
+private:
+    struct Request {
+        Completion::Kind kind  = Completion::Kind::Read;
+        std::uint64_t    id    = 0;
+        std::uint32_t    mask  = 0;
+        int              relay = -1;
+        bool             state = false;
+        std::uint64_t    submit_ns = 0;
+    };
+
+    // Ring fester Größe (kein Wachstum)
+    template <typename T>
+    struct Ring {
+        std::vector<T> buf;
+        size_t head = 0, count = 0;
+        bool Full() const { return count == buf.size(); }
+        bool Empty() const { return count == 0; }
+        void Push(const T& v) { buf[(head + count++) % buf.size()] = v; }
+        T Pop() { T v = buf[head]; head = (head + 1) % buf.size(); --count; return v; }
+    };
+
+    std::uint64_t Enqueue(Request r);
+    void Run();
+    void Complete(const Completion& c);   // wartet bei vollem Ring
+
+    const int               channels_;
+    FramePool               pool_;
+    std::mutex              m_;
+    std::condition_variable req_cv_;    // neue Aufträge / Stopp
+    std::condition_variable done_cv_;   // neue Abschlüsse / Platz im Ring
+    Ring<Request>           requests_;
+    Ring<Completion>        done_;
+    std::uint64_t           next_id_ = 1;
+    bool                    running_ = false;
+    bool                    stop_    = false;
+    std::thread             worker_;
+    AsyncStats              astats_;
+};
+
+} // namespace sosesta::hw
@@ -0,0 +1,240 @@
+// AsyncHardwareBase: Reihenfolge und Inhalt der Abschlüsse, feste
+// Warteschlangen (Ablehnung statt Wachstum), FramePool-Erschöpfung, Stopp.
+#include "hw/AsyncHardwareBase.hpp"
+#include "util/TestCheck.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+using namespace sosesta::hw;
+
+namespace {
+
+constexpr int           kChannels = 4;
+constexpr std::uint64_t kWaitNs   = 2'000'000'000ull;
+
+// Gerät ohne Hardware: INA liefert Kanalnummer, DAQ scheitert an Kanal 2;
+// Hold() hält den Worker in ReadGroup()/Actuate() fest
+class FakeHardware : public AsyncHardwareBase {
+public:
+    explicit FakeHardware(AsyncOptions opt = {}) : AsyncHardwareBase(kChannels, opt) {}
+    ~FakeHardware() override { Open(); StopAsync(); }
+
+    void Start() { StartAsync(); }
+    void Stop()  { StopAsync(); }
+
+    void Hold() { std::lock_guard<std::mutex> lk(m_); held_ = true; }
+    void Open() { { std::lock_guard<std::mutex> lk(m_); held_ = false; } cv_.notify_all(); }
+    // wartet, bis der Worker im Gerät steht
+    bool WaitEntered(int n) {
+        std::unique_lock<std::mutex> lk(m_);
+        return cv_.wait_for(lk, std::chrono::seconds(2), [&] { return entered_ >= n; });
+    }
+
+    std::vector<std::pair<int, bool>> actuated;
+
+protected:
+    std::uint32_t ReadGroup(DeviceGroup g, std::uint32_t mask, SensorData* out) override {
+        Gate();
+        std::uint32_t ok = 0;
+        for (int ch = 0; ch < kChannels; ++ch) {
+            if (!(mask & (1u << ch))) continue;
+            if (g == DeviceGroup::Ina) out[ch].bus_V = ch;
+            else if (ch != 2) out[ch].redlab_V = -ch;
+            else continue;
+            ok |= 1u << ch;
+        }
+        return ok;
+    }
+
+    bool Actuate(int relay, bool state) override {
+        Gate();
+        actuated.emplace_back(relay, state);
+        return relay < 4;
+    }
+
+private:
+    void Gate() {
+        std::unique_lock<std::mutex> lk(m_);
+        ++entered_;
+        cv_.notify_all();
+        cv_.wait(lk, [&] { return !held_; });
+    }
+
+    std::mutex              m_;
+    std::condition_variable cv_;
+    bool                    held_    = false;
+    int                     entered_ = 0;
+};
+
+// genau n Abschlüsse abholen (mit Zeitlimit)
+std::vector<Completion> Collect(FakeHardware& hw, size_t n) {
+    std::vector<Completion> out;
+    Completion buf[8];
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (out.size() < n && std::chrono::steady_clock::now() < end) {
+        const size_t k = hw.Poll(buf, std::min<size_t>(8, n - out.size()), kWaitNs / 20);
+        out.insert(out.end(), buf, buf + k);
+    }
+    return out;
+}
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestReadCompletions() {
+    FakeHardware hw;
+    CHECK(hw.SubmitRead(0b1111) == 0);   // nicht gestartet
+    CHECK(hw.GetAsyncStats().rejected.load() == 1);
+
+    hw.Start();
+    CHECK(hw.SubmitRead(0) == 0);
+    CHECK(hw.SubmitRead(1u << 10) == 0);   // nur Kanäle außerhalb
+    const std::uint64_t id = hw.SubmitRead(0b0111 | (1u << 10));
+    CHECK(id != 0);
+
+    const auto c = Collect(hw, 2);
+    REQUIRE(c.size() == 2);
+    CHECK(c[0].group == DeviceGroup::Ina);   // INA meldet vor DAQ
+    CHECK(c[1].group == DeviceGroup::Daq);
+    for (const auto& x : c) {
+        CHECK(x.kind == Completion::Kind::Read);
+        CHECK(x.request == id);
+        REQUIRE(x.frame != nullptr);
+        CHECK(x.frame->request == id);
+        CHECK(x.frame->mask == 0b0111);
+        CHECK(x.frame->ch.size() == kChannels);
+        CHECK(x.frame->done_ns >= x.frame->submit_ns);
+    }
+    CHECK(c[0].ok && c[0].frame->ok_mask == 0b0111);
+    CHECK(c[0].frame->ch[1].bus_V == 1.0);
+    CHECK(!c[1].ok && c[1].frame->ok_mask == 0b0011);   // Kanal 2 gescheitert
+    CHECK(c[1].frame->ch[1].redlab_V == -1.0);
+
+    CHECK(hw.Frames().Free() == hw.Frames().Capacity() - 2);
+    for (const auto& x : c) hw.Release(x.frame);
+    CHECK(hw.Frames().Free() == hw.Frames().Capacity());
+    CHECK(hw.GetAsyncStats().completed.load() == 2);
+}
+
+void TestRelayAndOrder() {
+    FakeHardware hw;
+    hw.Start();
+    const auto a = hw.SubmitRelay(1, true);
+    const auto b = hw.SubmitRead(0b0001);
+    const auto d = hw.SubmitRelay(7, false);
+    CHECK(a != 0 && a < b && b < d);
+
+    const auto c = Collect(hw, 4);
+    REQUIRE(c.size() == 4);
+    CHECK(c[0].request == a && c[0].kind == Completion::Kind::Actuator);
+    CHECK(c[0].group == DeviceGroup::Relay && c[0].target == 1 && c[0].state && c[0].ok);
+    CHECK(c[0].frame == nullptr);
+    CHECK(c[1].request == b && c[2].request == b);
+    CHECK(c[3].request == d && !c[3].ok);   // Relais 7 gibt es nicht
+    hw.Release(c[1].frame);
+    hw.Release(c[2].frame);
+    REQUIRE(hw.actuated.size() == 2);
+    CHECK(hw.actuated[1] == std::make_pair(7, false));
+}
+
+void TestQueueFullRejects() {
+    AsyncOptions opt;
+    opt.queue_depth = 3;
+    FakeHardware hw(opt);
+    hw.Start();
+    hw.Hold();
+    CHECK(hw.SubmitRelay(0, true) != 0);
+    REQUIRE(hw.WaitEntered(1));   // Worker hängt, Warteschlange ist leer
+
+    for (int i = 0; i < 3; ++i) CHECK(hw.SubmitRead(0b0001) != 0);
+    CHECK(hw.SubmitRead(0b0001) == 0);   // voll: ablehnen, nicht wachsen
+    CHECK(hw.SubmitRelay(0, false) == 0);
+    CHECK(hw.GetAsyncStats().rejected.load() == 2);
+
+    hw.Open();
+    const auto c = Collect(hw, 1 + 3 * 2);
+    CHECK(c.size() == 7);
+    for (const auto& x : c) hw.Release(x.frame);
+    CHECK(hw.SubmitRead(0b0001) != 0);   // wieder Platz
+}
+
+void TestFramePoolExhausted() {
+    AsyncOptions opt;
+    opt.frames = 2;
+    FakeHardware hw(opt);
+    hw.Start();
+    hw.SubmitRead(0b0011);
+    hw.SubmitRead(0b0011);
+
+    // Empfänger hält beide Frames des ersten Auftrags: zweiter ohne Frame
+    const auto c = Collect(hw, 4);
+    REQUIRE(c.size() == 4);
+    CHECK(c[0].frame && c[1].frame);
+    CHECK(!c[2].frame && !c[2].ok);
+    CHECK(!c[3].frame && !c[3].ok);
+    CHECK(hw.GetAsyncStats().no_frame.load() == 2);
+    hw.Release(c[0].frame);
+    hw.Release(c[1].frame);
+    CHECK(hw.Frames().Free() == 2);
+}
+
+void TestStopReturnsFrames() {
+    FakeHardware hw;
+    hw.Start();
+    for (int i = 0; i < 5; ++i) hw.SubmitRead(0b1111);
+    // warten, bis alles erledigt ist, aber nichts abholen
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (hw.GetAsyncStats().completed.load() < 10 && std::chrono::steady_clock::now() < end)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    CHECK(hw.Frames().Free() == hw.Frames().Capacity() - 10);
+
+    hw.Stop();
+    CHECK(hw.Frames().Free() == hw.Frames().Capacity());
+    CHECK(hw.SubmitRead(0b0001) == 0);
+    Completion c;
+    CHECK(hw.Poll(&c, 1) == 0);
+
+    hw.Start();   // erneut startbar
+    CHECK(hw.SubmitRead(0b0001) != 0);
+    const auto r = Collect(hw, 2);
+    CHECK(r.size() == 2);
+    for (const auto& x : r) hw.Release(x.frame);
+}
+
+void TestBackpressureLosesNothing() {
+    // Abschluss-Ring klein, Empfänger langsam: Worker bremst, nichts geht verloren
+    AsyncOptions opt;
+    opt.queue_depth = 2;
+    opt.frames      = 4;
+    FakeHardware hw(opt);
+    hw.Start();
+
+    constexpr int kReads = 300;
+    int submitted = 0;
+    std::uint64_t last_id = 0;
+    size_t got = 0;
+    bool ordered = true;
+    Completion buf[3];
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((submitted < kReads || got < 2u * kReads) && std::chrono::steady_clock::now() < end) {
+        if (submitted < kReads && hw.SubmitRead(0b0001) != 0) ++submitted;
+        const size_t n = hw.Poll(buf, 3, submitted == kReads ? kWaitNs / 100 : 0);
+        for (size_t i = 0; i < n; ++i) {
+            ordered = ordered && buf[i].request >= last_id;
+            last_id = buf[i].request;
+            hw.Release(buf[i].frame);
+        }
+        got += n;
+    }
+    CHECK(submitted == kReads);
+    CHECK(got == 2u * kReads);
+    CHECK(ordered);
+    CHECK(hw.GetAsyncStats().completed.load() == 2u * kReads);
+    CHECK(hw.Frames().Free() == hw.Frames().Capacity());
+}
+
+} // namespace
+
+TEST_MAIN(TestReadCompletions, TestRelayAndOrder, TestQueueFullRejects, TestFramePoolExhausted,
+          TestStopReturnsFrames, TestBackpressureLosesNothing)
@@ -0,0 +1,145 @@
+#include "hw/FilterBank.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace sosesta::hw
+{
+
+FilterSpec FilterSpec::From(const SignalFilterConfig& c)
+{
+    FilterSpec s;
+    if      (c.kind == "boxcar") s.kind = Kind::Boxcar;
+    else if (c.kind == "cic")    s.kind = Kind::Cic;
+    else if (c.kind == "median") s.kind = Kind::Median;
+    else if (c.kind == "iir")    s.kind = Kind::Iir;
+    s.oversample = s.kind == Kind::None ? 1 : c.oversample;
+    s.cic_order  = c.cic_order;
+    s.iir_alpha  = c.iir_alpha;
+    return s;
+}
+
+void FilterBank::Configure(int channels, const FilterSpec& spec)
+{
+    spec_     = spec;
+    channels_ = std::max(0, channels);
+    n_        = std::clamp(spec.oversample, 1, 4096);
+    spec_.cic_order = std::clamp(spec.cic_order, 1, 5);
+    spec_.iir_alpha = std::clamp(spec.iir_alpha, 1e-6, 1.0);
+    spec_.full_scale = std::clamp(std::fabs(spec.full_scale), 1e-3, 1e9);
+    if (spec_.kind == FilterSpec::Kind::Cic) {
+        // Ausgang bis full_scale·kCicScale·n^M (plus Vorzeichen) muss in int64 passen
+        const int in_bits   = static_cast<int>(std::ceil(std::log2(spec_.full_scale * kCicScale))) + 1;
+        const int grow_bits = static_cast<int>(std::ceil(std::log2(static_cast<double>(n_))));
+        if (grow_bits > 0)
+            spec_.cic_order = std::clamp((63 - in_bits) / grow_bits, 1, spec_.cic_order);
+    }
+    Reset();
+}
+
+void FilterBank::Reset()
+{
+    const size_t c = static_cast<size_t>(channels_);
+    integ_.assign(c * static_cast<size_t>(spec_.cic_order), 0);
+    comb_.assign(c * static_cast<size_t>(spec_.cic_order), 0);
+    y_.assign(c, 0.0);
+    iir_init_ = false;
+    scratch_.resize(static_cast<size_t>(n_));
+}
+
+void FilterBank::Process(const double* raw, double* out)
+{
+    switch (spec_.kind) {
+        case FilterSpec::Kind::Boxcar: Boxcar(raw, out); return;
+        case FilterSpec::Kind::Cic:    Cic(raw, out);    return;
+        case FilterSpec::Kind::Median: Median(raw, out); return;
+        case FilterSpec::Kind::Iir:    Iir(raw, out);    return;
+        case FilterSpec::Kind::None:   break;
+    }
+    // ohne Filter: jüngster Rohwert
+    const double* last = raw + static_cast<size_t>(n_ - 1) * static_cast<size_t>(channels_);
+    std::copy(last, last + channels_, out);
+}
+
+// Mittelwert über n_ Rohwerte
+void FilterBank::Boxcar(const double* raw, double* out) const
+{
+    const int C = channels_;
+    for (int c = 0; c < C; ++c) out[c] = 0.0;
+    for (int k = 0; k < n_; ++k) {
+        const double* row = raw + static_cast<size_t>(k) * static_cast<size_t>(C);
+        for (int c = 0; c < C; ++c) out[c] += row[c];
+    }
+    const double inv = 1.0 / n_;
+    for (int c = 0; c < C; ++c) out[c] *= inv;
+}
+
+// Hogenauer-CIC: M Integratoren mit Rohrate, Dezimierung um n_, M Kämme mit Ausgaberate.
+// Festkomma in uint64: Überläufe der Integratoren heben sich in den Kämmen auf.
+void FilterBank::Cic(const double* raw, double* out)
+{
+    const int    C = channels_;
+    const int    M = spec_.cic_order;
+    const size_t cs = static_cast<size_t>(C);
+    const double fs = spec_.full_scale;
+
+    for (int k = 0; k < n_; ++k) {
+        const double* row = raw + static_cast<size_t>(k) * cs;
+        std::uint64_t* i0 = integ_.data();
+        for (int c = 0; c < C; ++c)
+            i0[c] += static_cast<std::uint64_t>(std::llround(std::clamp(row[c], -fs, fs) * kCicScale));
+        for (int m = 1; m < M; ++m) {
+            std::uint64_t*       cur  = integ_.data() + static_cast<size_t>(m) * cs;
+            const std::uint64_t* prev = integ_.data() + static_cast<size_t>(m - 1) * cs;
+            for (int c = 0; c < C; ++c) cur[c] += prev[c];
+        }
+    }
+
+    const double gain = std::pow(static_cast<double>(n_), M) * kCicScale;
+    const std::uint64_t* last = integ_.data() + static_cast<size_t>(M - 1) * cs;
+    for (int c = 0; c < C; ++c) {
+        std::uint64_t v = last[c];
+        for (int m = 0; m < M; ++m) {
+            std::uint64_t& d = comb_[static_cast<size_t>(m) * cs + static_cast<size_t>(c)];
+            const std::uint64_t y = v - d;
+            d = v;
+            v = y;
+        }
+        out[c] = static_cast<double>(static_cast<std::int64_t>(v)) / gain;
+    }
+}
+
+// Median der n_ Rohwerte je Kanal (robust gegen einzelne Ausreißer)
+void FilterBank::Median(const double* raw, double* out)
+{
+    const size_t cs = static_cast<size_t>(channels_);
+    const size_t n  = static_cast<size_t>(n_);
+    for (size_t c = 0; c < cs; ++c) {
+        for (size_t k = 0; k < n; ++k) scratch_[k] = raw[k * cs + c];
+        auto mid = scratch_.begin() + static_cast<std::ptrdiff_t>(n / 2);
+        std::nth_element(scratch_.begin(), mid, scratch_.begin() + static_cast<std::ptrdiff_t>(n));
+        double m = *mid;
+        if (n % 2 == 0) m = 0.5 * (m + *std::max_element(scratch_.begin(), mid));
+        out[c] = m;
+    }
+}
+
+// Einpoliger Tiefpass mit Rohrate; Ausgang = Zustand nach dem letzten Rohwert
+void FilterBank::Iir(const double* raw, double* out)
+{
+    const int    C = channels_;
+    const double a = spec_.iir_alpha;
+    int k0 = 0;
+    if (!iir_init_) {
+        std::copy(raw, raw + C, y_.begin());
+        iir_init_ = true;
+        k0 = 1;
+    }
+    double* y = y_.data();
+    for (int k = k0; k < n_; ++k) {
+        const double* row = raw + static_cast<size_t>(k) * static_cast<size_t>(C);
+        for (int c = 0; c < C; ++c) y[c] += a * (row[c] - y[c]);
+    }
+    std::copy(y_.begin(), y_.end(), out);
+}
+
+} // namespace sosesta::hw
@@ -0,0 +1,72 @@
+// src/hw/FilterBank.hpp
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "config/ConfigSoftware.hpp"
+
+namespace sosesta::hw
+{
+
+/// Filter/Dezimierung einer Messgröße (RedLab-Signal, Bus-V, Strom)
+struct FilterSpec {
+    enum class Kind { None, Boxcar, Cic, Median, Iir };
+    Kind   kind       = Kind::None;
+    int    oversample = 1;     ///< Rohwerte je Auswertezyklus (Dezimierungsfaktor)
+    int    cic_order  = 3;     ///< CIC: Anzahl Integrator-/Kammstufen (1..5)
+    double iir_alpha  = 0.2;   ///< IIR: y += α·(x − y) je Rohwert
+    double full_scale = 4000;  ///< CIC: größter Rohwert-Betrag (V bzw. mA), bestimmt die Bitbreite
+
+    /// Aus der Konfiguration; unbekannte Art → None
+    static FilterSpec From(const SignalFilterConfig& c);
+};
+
+/**
+ * @brief Dezimierende Filterstufe für einen Block von Kanälen.
+ *
+ * Process() bekommt oversample × channels Rohwerte, zeilenweise je
+ * Abtastzeitpunkt (Kanal läuft innen – dieselbe Anordnung wie ulAInScan),
+ * und liefert einen Wert je Kanal. Alle Kerne laufen in der inneren
+ * Schleife über die Kanäle, damit der Compiler über Kanäle vektorisiert.
+ *
+ * Zustand (CIC, IIR) bleibt über Aufrufe erhalten; CIC braucht nach Reset()
+ * cic_order Aufrufe zum Einschwingen. Der CIC-Ausgang wächst um
+ * cic_order·log2(oversample) Bit; passt das mit full_scale nicht in 63 Bit,
+ * senkt Configure() die Ordnung (CicOrder()), Rohwerte werden auf
+ * ±full_scale begrenzt.
+ */
+class FilterBank
+{
+public:
+    FilterBank() = default;
+    FilterBank(int channels, const FilterSpec& spec) { Configure(channels, spec); }
+
+    void Configure(int channels, const FilterSpec& spec);
+    void Reset();
+
+    int  Channels() const   { return channels_; }
+    int  Oversample() const { return n_; }
+    int  CicOrder() const   { return spec_.cic_order; }
+    bool Active() const     { return spec_.kind != FilterSpec::Kind::None; }
+
+    void Process(const double* raw, double* out);
+
+private:
+    void Boxcar(const double* raw, double* out) const;
+    void Cic(const double* raw, double* out);
+    void Median(const double* raw, double* out);
+    void Iir(const double* raw, double* out);
+
+    static constexpr double kCicScale = 1e6;  ///< Festkomma für CIC (1 µV bzw. 1 µA Auflösung)
+
+    FilterSpec spec_;
+    int        channels_ = 0;
+    int        n_ = 1;
+
+    std::vector<std::uint64_t> integ_;   ///< CIC: [stufe][kanal], Überlauf modulo 2^64 gewollt
+    std::vector<std::uint64_t> comb_;    ///< CIC: letzter Wert je Kammstufe
+    std::vector<double>        y_;       ///< IIR-Zustand
+    bool                       iir_init_ = false;
+    std::vector<double>        scratch_; ///< Median: Werte eines Kanals
+};
+
+} // namespace sosesta::hw
@@ -0,0 +1,171 @@
+// FilterBank: Kerne gegen einfache Referenzen, Zustand über Aufrufe,
+// CIC-Ordnung bei großer Dezimierung und Rohwerten am Rand.
+#include "hw/FilterBank.hpp"
+#include "util/TestCheck.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+using namespace sosesta::hw;
+
+namespace {
+
+constexpr int C = 3;
+
+FilterSpec Spec(FilterSpec::Kind k, int n) {
+    FilterSpec s;
+    s.kind       = k;
+    s.oversample = n;
+    return s;
+}
+
+// raw[k * C + c]: Kanal läuft innen
+std::vector<double> Block(int n, std::mt19937& g, double mean, double sigma) {
+    std::normal_distribution<double> d(mean, sigma);
+    std::vector<double> r(static_cast<size_t>(n * C));
+    for (auto& v : r) v = d(g);
+    return r;
+}
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestNoneAndBoxcar() {
+    std::mt19937 g(1);
+    double out[C];
+
+    FilterBank none(C, Spec(FilterSpec::Kind::None, 4));
+    CHECK(!none.Active());
+    CHECK(none.Oversample() == 4);
+    const auto raw = Block(4, g, 1.0, 0.5);
+    none.Process(raw.data(), out);
+    for (int c = 0; c < C; ++c) CHECK(out[c] == raw[static_cast<size_t>(3 * C + c)]);   // jüngster Rohwert
+
+    FilterBank box(C, Spec(FilterSpec::Kind::Boxcar, 16));
+    const auto r2 = Block(16, g, 2.0, 0.1);
+    box.Process(r2.data(), out);
+    for (int c = 0; c < C; ++c) {
+        double m = 0;
+        for (int k = 0; k < 16; ++k) m += r2[static_cast<size_t>(k * C + c)];
+        CHECK_NEAR(out[c], m / 16, 1e-12);
+    }
+}
+
+void TestCicMatchesMovingAverage() {
+    // CIC der Ordnung M = M-fach kaskadierter gleitender Mittelwert über n,
+    // dezimiert; nach M Blöcken eingeschwungen
+    constexpr int n = 8, M = 3, kBlocks = 12;
+    FilterSpec s = Spec(FilterSpec::Kind::Cic, n);
+    s.cic_order = M;
+    FilterBank f(C, s);
+    CHECK(f.CicOrder() == M);
+
+    std::mt19937 g(2);
+    std::vector<std::vector<double>> x(C);   // Rohfolge je Kanal
+    std::vector<std::array<double, C>> y;
+    for (int b = 0; b < kBlocks; ++b) {
+        const auto raw = Block(n, g, b < 6 ? 100.0 : -50.0, 3.0);
+        for (int k = 0; k < n; ++k)
+            for (int c = 0; c < C; ++c) x[c].push_back(raw[static_cast<size_t>(k * C + c)]);
+        std::array<double, C> out{};
+        f.Process(raw.data(), out.data());
+        y.push_back(out);
+    }
+
+    for (int c = 0; c < C; ++c) {
+        // Referenz: M-mal Boxcar der Länge n (Vorgeschichte 0), an Blockenden abgetastet
+        std::vector<double> v = x[c];
+        for (int m = 0; m < M; ++m) {
+            std::vector<double> w(v.size());
+            double acc = 0;
+            for (size_t i = 0; i < v.size(); ++i) {
+                acc += v[i];
+                if (i >= n) acc -= v[i - n];
+                w[i] = acc / n;
+            }
+            v = std::move(w);
+        }
+        for (int b = M; b < kBlocks; ++b)
+            CHECK_NEAR(y[static_cast<size_t>(b)][static_cast<size_t>(c)], v[static_cast<size_t>((b + 1) * n - 1)], 1e-5);
+    }
+}
+
+void TestCicOrderLimitedByWordSize() {
+    // 4000 · 1e6 braucht 33 Bit; n = 4096 wächst 12 Bit je Stufe → höchstens 2 Stufen
+    FilterSpec s = Spec(FilterSpec::Kind::Cic, 4096);
+    s.cic_order  = 5;
+    s.full_scale = 4000;
+    FilterBank f(1, s);
+    CHECK(f.CicOrder() == 2);
+    CHECK(f.Oversample() == 4096);
+
+    // Vollausschlag und darüber (begrenzt) ohne Überlauf
+    std::vector<double> raw(4096, 1e9);
+    double out = 0;
+    for (int i = 0; i < 4; ++i) f.Process(raw.data(), &out);
+    CHECK_NEAR(out, 4000.0, 1e-6);
+    std::fill(raw.begin(), raw.end(), -4000.0);
+    for (int i = 0; i < 4; ++i) f.Process(raw.data(), &out);
+    CHECK_NEAR(out, -4000.0, 1e-6);
+
+    // kleine Dezimierung: gewünschte Ordnung bleibt, Grenzen greifen
+    s.oversample = 4;
+    f.Configure(1, s);
+    CHECK(f.CicOrder() == 5);
+    s.cic_order  = 0;
+    s.oversample = 100000;
+    f.Configure(1, s);
+    CHECK(f.CicOrder() == 1);
+    CHECK(f.Oversample() == 4096);
+}
+
+void TestMedianRejectsSpikes() {
+    FilterBank odd(C, Spec(FilterSpec::Kind::Median, 5));
+    FilterBank even(C, Spec(FilterSpec::Kind::Median, 4));
+    std::vector<double> raw(static_cast<size_t>(5 * C), 1.0);
+    raw[0] = 1000.0;             // Ausreißer Kanal 0
+    raw[1 * C + 1] = -1000.0;    // Ausreißer Kanal 1
+    double out[C];
+    odd.Process(raw.data(), out);
+    for (int c = 0; c < C; ++c) CHECK(out[c] == 1.0);
+
+    const double r4[4 * C] = { 1, 5, 0,  2, 6, 0,  3, 7, 0,  40, 8, 9 };
+    even.Process(r4, out);
+    CHECK(out[0] == 2.5);   // Mittel der beiden mittleren Werte
+    CHECK(out[1] == 6.5);
+    CHECK(out[2] == 0.0);
+}
+
+void TestIirStateAndReset() {
+    FilterSpec s = Spec(FilterSpec::Kind::Iir, 4);
+    s.iir_alpha = 0.5;
+    FilterBank f(1, s);
+    double out = 0;
+    const double a[4] = { 8, 8, 8, 8 };
+    f.Process(a, &out);
+    CHECK(out == 8.0);   // Start mit dem ersten Rohwert
+    const double b[4] = { 0, 0, 0, 0 };
+    f.Process(b, &out);
+    CHECK(out == 0.5);   // 8 · 0.5^4, Zustand über den Aufruf hinweg
+    f.Reset();
+    f.Process(b, &out);
+    CHECK(out == 0.0);
+}
+
+void TestFromConfig() {
+    SignalFilterConfig c;
+    c.kind = "cic";
+    c.oversample = 16;
+    c.cic_order  = 4;
+    FilterSpec s = FilterSpec::From(c);
+    CHECK(s.kind == FilterSpec::Kind::Cic && s.oversample == 16 && s.cic_order == 4);
+    c.kind = "unbekannt";
+    s = FilterSpec::From(c);
+    CHECK(s.kind == FilterSpec::Kind::None && s.oversample == 1);
+}
+
+} // namespace
+
+TEST_MAIN(TestNoneAndBoxcar, TestCicMatchesMovingAverage, TestCicOrderLimitedByWordSize,
+          TestMedianRejectsSpikes, TestIirStateAndReset, TestFromConfig)
@@ -8,11 +8,14 @@
 
 std::shared_ptr<sosesta::hw::IHardware> MakeHardware(
     const ConfigSoftwareView& cfg_view,
-    const ConfigHardware&     /*hw_cfg*/)
+    const ConfigHardware&     hw_cfg)
 {
 #if defined(USE_MOCK)
-    return std::make_shared<sosesta::hw::MockHardware>(cfg_view);
+    sosesta::hw::MockOptions opt;
+    opt.ina_retry = sosesta::hw::RetryPolicy::From(hw_cfg.ina219.retries, hw_cfg.ina219.retry_delay_s);
+    opt.daq_retry = sosesta::hw::RetryPolicy::From(hw_cfg.redlab.reconnect_retries, hw_cfg.redlab.reconnect_delay_s);
+    return std::make_shared<sosesta::hw::MockHardware>(cfg_view, opt);
 #else
-    return std::make_shared<sosesta::hw::RealHardware>(/* cfg_view, hw_cfg */);
+    return std::make_shared<sosesta::hw::RealHardware>(cfg_view, hw_cfg);
 #endif
 }
@@ -0,0 +1,127 @@
+// src/hw/IAsyncHardware.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "app/data/SensorData.hpp"
+
+namespace sosesta::hw
+{
+
+/// Gerätegruppen mit eigenem Bus; jede liefert Teilergebnisse für sich
+enum class DeviceGroup : std::uint8_t {
+    Ina   = 0,   // I2C: MUX + INA219 (bus_V, current_mA, power_mW)
+    Daq   = 1,   // USB: RedLab (redlab_V)
+    Relay = 2,   // GPIO: Aktoren
+};
+
+/**
+ * @brief Teilergebnis einer Gerätegruppe für einen Leseauftrag.
+ *
+ * ch ist vorbelegt (ein Eintrag je Kanal). Gültig sind nur die Felder
+ * der Gruppe (MergeGroup) in Kanälen aus mask; ok_mask sagt, welche davon
+ * frisch gelesen wurden (Rest: alter Wert, stale gesetzt).
+ */
+struct Frame {
+    std::uint64_t           request   = 0;
+    DeviceGroup             group     = DeviceGroup::Ina;
+    std::uint32_t           mask      = 0;
+    std::uint32_t           ok_mask   = 0;
+    std::uint64_t           submit_ns = 0;   // util::MonoNs()
+    std::uint64_t           done_ns   = 0;
+    std::vector<SensorData> ch;
+};
+
+/// Fester Vorrat an Frames; Acquire/Release ohne Allokation, thread-sicher
+class FramePool {
+public:
+    FramePool(size_t frames, int channels);
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    Frame* Acquire();            // nullptr = erschöpft
+    void   Release(Frame* f);
+    size_t Free() const;
+    size_t Capacity() const { return frames_.size(); }
+
+private:
+    std::vector<Frame>  frames_;
+    std::vector<Frame*> free_;
+    mutable std::mutex  m_;
+};
+
+/// Abschluss eines Auftrags (Lesen je Gruppe bzw. Aktor-Befehl)
+struct Completion {
+    enum class Kind : std::uint8_t { Read, Actuator };
+    Kind          kind      = Kind::Read;
+    DeviceGroup   group     = DeviceGroup::Ina;
+    bool          ok        = false;
+    std::uint64_t request   = 0;
+    Frame*        frame     = nullptr;   // Read: gehört dem Empfänger bis Release(); nullptr = kein Frame frei
+    int           target    = -1;        // Actuator: Relais-Index, -1 = alle
+    bool          state     = false;
+    std::uint64_t submit_ns = 0;
+    std::uint64_t done_ns   = 0;         // Actuator: Zeitpunkt der Schaltflanke
+};
+
+/**
+ * @brief Asynchrone Ergänzung zu IHardware für gepipelinete Abläufe.
+ *
+ * SubmitRead() stellt einen Leseauftrag für eine Kanalmenge ein; jede
+ * Gerätegruppe meldet ihr Teilergebnis als eigenen Completion, sobald sie
+ * fertig ist (INA-Werte stehen bereit, während der DAQ noch liest). Frames
+ * stammen aus einem vorbelegten FramePool und gehen per Release() zurück.
+ * Aktor-Befehle liefern den Zeitpunkt, zu dem sie ausgeführt wurden.
+ *
+ * Aufträge werden in Einstellreihenfolge abgearbeitet. Nicht gleichzeitig
+ * mit dem synchronen IHardware-Zyklus desselben Geräts verwenden.
+ */
+class IAsyncHardware
+{
+public:
+    virtual ~IAsyncHardware() = default;
+
+    /// Kanäle als Bitmaske (Bit ch); 0 = abgelehnt (Warteschlange voll, nicht initialisiert)
+    virtual std::uint64_t SubmitRead(std::uint32_t channel_mask) = 0;
+
+    /// Relais schalten (-1 = alle); 0 = abgelehnt
+    virtual std::uint64_t SubmitRelay(int relay, bool state) = 0;
+
+    /// Bis zu max Abschlüsse abholen; wartet höchstens timeout_ns auf den ersten
+    virtual size_t Poll(Completion* out, size_t max, std::uint64_t timeout_ns = 0) = 0;
+
+    /// Frame eines Read-Abschlusses zurückgeben
+    virtual void Release(Frame* frame) = 0;
+};
+
+/// Felder der Gruppe g von src nach dst übernehmen (Teil-Frames zusammensetzen)
+inline void MergeGroup(DeviceGroup g, const SensorData& src, SensorData& dst)
+{
+    switch (g) {
+        case DeviceGroup::Ina:
+            dst.bus_V                 = src.bus_V;
+            dst.current_mA            = src.current_mA;
+            dst.power_mW              = src.power_mW;
+            dst.present               = src.present;
+            dst.supply_ok             = src.supply_ok;
+            dst.current_ok            = src.current_ok;
+            dst.supply_error_counter  = src.supply_error_counter;
+            dst.current_error_counter = src.current_error_counter;
+            break;
+        case DeviceGroup::Daq:
+            dst.redlab_V             = src.redlab_V;
+            dst.signal_ok            = src.signal_ok;
+            dst.signal_error_counter = src.signal_error_counter;
+            break;
+        case DeviceGroup::Relay:
+            return;
+    }
+    dst.channel      = src.channel;
+    dst.stale        = src.stale;
+    dst.retry_count  = src.retry_count;
+    dst.stale_ms     = src.stale_ms;
+    dst.timestamp_ms = src.timestamp_ms;
+}
+
+} // namespace sosesta::hw
@@ -1,7 +1,9 @@
 // src/hw/IHardware.hpp
 #pragma once
+#include <string>
 #include <vector>
 #include "app/data/SensorData.hpp"
+#include "hw/IAsyncHardware.hpp"
 
 namespace sosesta::hw
 {
@@ -27,6 +29,27 @@ public:
     /// Liest alle Sensordaten in den übergebenen Vektor
     virtual void UpdateSensors(std::vector<SensorData>& sensors) = 0;
 
+    /// Liest nur Kanäle mit mask[ch] == true, übrige behalten ihre Werte
+    /// (leere Maske = alle). Standard: voller Zyklus über UpdateSensors().
+    virtual void UpdateChannels(std::vector<SensorData>& sensors, const std::vector<bool>& mask)
+    {
+        (void)mask;
+        UpdateSensors(sensors);
+    }
+
+    /// Schnellpfad für Übergangsmessungen: nur RedLab-Spannung und Strom
+    /// aller Kanäle, ohne Auswertung, Filter und Fehlerzähler.
+    /// false = nicht unterstützt bzw. Lesefehler.
+    virtual bool SampleTransient(std::vector<double>& redlab_V, std::vector<double>& current_mA)
+    {
+        (void)redlab_V;
+        (void)current_mA;
+        return false;
+    }
+
+    /// Höchste Rate des Schnellpfads in Hz (0 = keiner vorhanden)
+    virtual double TransientMaxRateHz() const { return 0.0; }
+
     /// Schaltet ein bestimmtes Relais ein/aus
     virtual void ToggleRelay(int channel, bool state) = 0;
 
@@ -35,6 +58,17 @@ public:
 
     /// Schaltet alle Relais aus
     virtual void TurnAllRelaysOff() = 0;
+
+    /// Nächster Gerätefehler (Initialisierung, Reconnect) für das Log;
+    /// false = keiner offen. Thread-sicher, blockiert nicht auf Geräte.
+    virtual bool TakeError(std::string* err)
+    {
+        (void)err;
+        return false;
+    }
+
+    /// Asynchrone Batch-Schnittstelle (nullptr = nur synchron)
+    virtual IAsyncHardware* Async() { return nullptr; }
 };
 
 } // namespace sosesta::hw
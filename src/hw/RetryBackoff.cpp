@@ -0,0 +1,32 @@
+#include "hw/RetryBackoff.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace sosesta::hw
+{
+
+void RetryBackoff::OnSuccess()
+{
+    stale_       = false;
+    consecutive_ = 0;
+}
+
+void RetryBackoff::OnFailure(std::uint64_t now_ns)
+{
+    if (!stale_) {
+        stale_          = true;
+        stale_since_ns_ = now_ns;
+    }
+    ++retries_;
+    // Policy kann direkt gesetzt sein: Schiebeweite begrenzen, Wartezeit
+    // vor dem Schieben kappen (kein Überlauf), Summe sättigen
+    const int max_k = std::clamp(policy_.max_doublings, 0, RetryPolicy::kMaxDoublings);
+    const int k     = static_cast<int>(std::min<std::uint32_t>(consecutive_, static_cast<std::uint32_t>(max_k)));
+    ++consecutive_;
+    const std::uint64_t cap   = policy_.max_delay_ns;
+    const std::uint64_t delay = policy_.base_delay_ns > (cap >> k) ? cap : policy_.base_delay_ns << k;
+    constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+    next_attempt_ns_ = delay > kMax - now_ns ? kMax : now_ns + delay;
+}
+
+} // namespace sosesta::hw
@@ -0,0 +1,64 @@
+// src/hw/RetryBackoff.hpp
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+namespace sosesta::hw
+{
+
+/// Parameter für RetryBackoff (aus ConfigHardware: retries/retry_delay_s)
+struct RetryPolicy {
+    static constexpr int kMaxDoublings = 30;   ///< Obergrenze für max_doublings (Schiebeweite)
+
+    std::uint64_t base_delay_ns = 100'000'000;    ///< Wartezeit nach dem ersten Fehler
+    int           max_doublings = 3;              ///< Wartezeit verdoppelt sich höchstens so oft
+    std::uint64_t max_delay_ns  = 60'000'000'000; ///< Wartezeit wird hier gekappt
+
+    static RetryPolicy From(int retries, double delay_s) {
+        RetryPolicy p;
+        const double max_s = static_cast<double>(p.max_delay_ns) / 1e9;
+        p.base_delay_ns = delay_s > 0.0 ? static_cast<std::uint64_t>(std::min(delay_s, max_s) * 1e9) : 0;
+        p.max_doublings = std::clamp(retries, 0, kMaxDoublings);
+        return p;
+    }
+};
+
+/**
+ * @brief Nicht blockierende Wiederholung je Gerät/Kanal über Zyklen hinweg.
+ *
+ * Statt im Zyklus zu warten und erneut zu versuchen, wird ein fehlgeschlagenes
+ * Gerät als "stale" markiert und erst nach Ablauf der Backoff-Zeit wieder
+ * angesprochen (base · 2^k, k ≤ max_doublings, höchstens max_delay_ns). Bis dahin kostet es keine
+ * Buszeit; alle anderen Kanäle laufen mit vollem Takt weiter.
+ */
+class RetryBackoff
+{
+public:
+    explicit RetryBackoff(RetryPolicy p = {}) : policy_(p) {}
+
+    void SetPolicy(const RetryPolicy& p) { policy_ = p; }
+
+    /// Darf das Gerät jetzt angesprochen werden?
+    bool ShouldAttempt(std::uint64_t now_ns) const { return !stale_ || now_ns >= next_attempt_ns_; }
+
+    void OnSuccess();
+    void OnFailure(std::uint64_t now_ns);
+
+    bool          Stale() const { return stale_; }
+    std::uint32_t Retries() const { return retries_; }          ///< Fehlversuche gesamt
+    std::uint32_t ConsecutiveFailures() const { return consecutive_; }
+    std::uint64_t StaleForNs(std::uint64_t now_ns) const {
+        return stale_ && now_ns > stale_since_ns_ ? now_ns - stale_since_ns_ : 0;
+    }
+    std::uint64_t NextAttemptNs() const { return next_attempt_ns_; }
+
+private:
+    RetryPolicy   policy_;
+    bool          stale_ = false;
+    std::uint32_t consecutive_ = 0;
+    std::uint32_t retries_ = 0;
+    std::uint64_t stale_since_ns_ = 0;
+    std::uint64_t next_attempt_ns_ = 0;
+};
+
+} // namespace sosesta::hw
@@ -1,29 +1,146 @@
 #include "hw/mock/MockHardware.hpp"
+#include "services/StageProfiler.hpp"
+#include "util/Clock.hpp"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <thread>
 #include <cassert>
 
 namespace sosesta { namespace hw {
 
+namespace {
+enum AsyncMode : std::uint8_t { kNormal = 0, kDropout = 1, kStuck = 2 };
+}
+
 MockHardware::MockHardware(const ConfigSoftwareView& cfg, MockOptions opt)
-    : cfg_(cfg)
+    : AsyncHardwareBase(opt.num_channels)
+    , cfg_(cfg)
     , opt_(opt)
     , rng_(opt.seed)
+    , lat_rng_(opt.seed ^ 0x9E3779B9u)
+    , fault_rng_(opt.seed ^ 0x85EBCA6Bu)
+    , ina_rng_(opt_.seed ^ 0xC2B2AE35u)
+    , daq_rng_(opt_.seed ^ 0x27D4EB2Fu)
+    , async_last_(static_cast<size_t>(opt_.num_channels))
+    , async_mode_(static_cast<size_t>(opt_.num_channels), kNormal)
+    , faults_(static_cast<size_t>(opt_.num_channels))
+    , ina_retry_(static_cast<size_t>(opt_.num_channels), RetryBackoff(opt_.ina_retry))
+    , daq_ch_retry_(static_cast<size_t>(opt_.num_channels), RetryBackoff(opt_.daq_retry))
+    , daq_retry_(opt_.daq_retry)
     , relay_state_(static_cast<size_t>(opt_.num_relays), false) // alle Relais AUS
-{}
+    , relay_change_ns_(static_cast<size_t>(opt_.num_relays), 0)
+    , transient_rng_(opt_.seed ^ 0x7A3Du)
+{
+    // full_scale: Messbereich der Größe (INA219 bis 26 V / 3,2 A, RedLab ±10 V)
+    auto setup = [this](Quantity& q, const SignalFilterConfig& fc, double full_scale) {
+        FilterSpec spec = FilterSpec::From(fc);
+        spec.full_scale = full_scale;
+        q.filter.Configure(opt_.num_channels, spec);
+        q.raw.assign(static_cast<size_t>(q.filter.Oversample() * opt_.num_channels), 0.0);
+        q.out.assign(static_cast<size_t>(opt_.num_channels), 0.0);
+    };
+    setup(q_bus_,  cfg_.filter_bus,     32.0);
+    setup(q_cur_,  cfg_.filter_current, 3200.0);
+    setup(q_red_,  cfg_.filter_redlab,  10.0);
+    setup(aq_bus_, cfg_.filter_bus,     32.0);
+    setup(aq_cur_, cfg_.filter_current, 3200.0);
+    setup(aq_red_, cfg_.filter_redlab,  10.0);
+    for (size_t ch = 0; ch < async_last_.size(); ++ch) async_last_[ch].channel = static_cast<int>(ch);
+}
+
+MockHardware::~MockHardware() {
+    StopAsync();   // Worker ruft ReadGroup()/Actuate() dieses Objekts
+}
+
+void MockHardware::DrawRaw(Quantity& q, int ch, double mean, double sigma,
+                           std::normal_distribution<double>& n, std::mt19937& g) {
+    const int C = opt_.num_channels;
+    for (int k = 0; k < q.filter.Oversample(); ++k)
+        q.raw[static_cast<size_t>(k * C + ch)] = mean + n(g) * sigma;
+}
 
 void MockHardware::Initialize() {
-    initialized_ = true;
+    {
+        std::lock_guard<std::mutex> lk(dev_mtx_);
+        initialized_ = true;
+    }
+    StartAsync();
 }
 
 void MockHardware::Shutdown() {
+    StopAsync();
+    std::lock_guard<std::mutex> lk(dev_mtx_);
     initialized_ = false;
 }
 
+// ── Latenz-/Fehlermodell ──────────────────────────────────
+
+double MockHardware::DrawLatencyUs(const MockLatency& lat) {
+    double us = 0.0;
+    switch (lat.dist) {
+        case MockLatency::Dist::None:    return 0.0;
+        case MockLatency::Dist::Fixed:   us = lat.mean_us; break;
+        case MockLatency::Dist::Uniform: us = lat.mean_us + (2.0 * u01_(lat_rng_) - 1.0) * lat.jitter_us; break;
+        case MockLatency::Dist::Normal:  us = lat.mean_us + n01_(lat_rng_) * lat.jitter_us; break;
+        case MockLatency::Dist::LogNormal: {
+            const double sigma = lat.mean_us > 0.0 ? lat.jitter_us / lat.mean_us : 0.0;
+            us = lat.mean_us * std::exp(sigma * n01_(lat_rng_));
+            break;
+        }
+    }
+    return std::max(0.0, us);
+}
+
+void MockHardware::SpendUs(double us, std::unique_lock<std::mutex>* lk) {
+    if (us <= 0.0) return;
+    stats_.simulated_us += us;
+    if (lk) lk->unlock();
+
+    // Grob schlafen, den Rest aktiv warten: sleep_for allein ist für
+    // Latenzen < 100 µs viel zu ungenau.
+    using clock = std::chrono::steady_clock;
+    const auto end = clock::now() + std::chrono::nanoseconds(static_cast<long long>(us * 1000.0));
+    if (us > 200.0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long long>(us) - 100));
+    }
+    while (clock::now() < end) { /* spin */ }
+    if (lk) lk->lock();
+}
+
+void MockHardware::Simulate(const MockLatency& lat, std::unique_lock<std::mutex>* lk) {
+    SpendUs(DrawLatencyUs(lat), lk);
+}
+
+bool MockHardware::CurrentOk(double mA) const {
+    return mA >= cfg_.presence_current_threshold[0] && mA <= cfg_.presence_current_threshold[1];
+}
+
+bool MockHardware::Chance(double p) {
+    if (!opt_.inject_faults || p <= 0.0) return false;
+    return u01_(fault_rng_) < p;
+}
+
 void MockHardware::UpdateSensors(std::vector<SensorData>& sensors) {
+    UpdateChannels(sensors, {});
+}
+
+void MockHardware::UpdateChannels(std::vector<SensorData>& sensors, const std::vector<bool>& mask) {
+    std::lock_guard<std::mutex> lk(dev_mtx_);
     if (!initialized_) return;
 
     sensors.resize(static_cast<size_t>(opt_.num_channels));
+    ++stats_.cycles;
+
+    const MockFaults& F = opt_.faults;
+
+    // DAQ-Reconnect-Sturm: solange aktiv, scheitert jeder DAQ-Read
+    if (storm_left_ == 0 && Chance(F.storm_prob)) {
+        storm_left_ = std::max(1, F.storm_cycles);
+        ++stats_.storms;
+    }
+    const bool daq_down = storm_left_ > 0;
+    const std::uint64_t now_ns = sosesta::util::MonoNs();
 
     // Hilfswerte aus Konfig:
     const double bus_mid   = 0.5 * (cfg_.supply_voltage_threshold[0] + cfg_.supply_voltage_threshold[1]);
@@ -31,59 +148,407 @@ void MockHardware::UpdateSensors(std::vector<SensorData>& sensors) {
     const double red_mid_p = 0.5 * (cfg_.redlab_pos_threshold[0] + cfg_.redlab_pos_threshold[1]);
     const double red_mid_n = 0.5 * (cfg_.redlab_neg_threshold[0] + cfg_.redlab_neg_threshold[1]);
 
+    // Rohwerte aller Kanäle ziehen (immer, damit die Rauschfolge unabhängig
+    // von Fehlern und Maske bleibt), dann blockweise filtern/dezimieren
+    for (int ch = 0; ch < opt_.num_channels; ++ch) {
+        const bool on = relay_state_[static_cast<size_t>(ch / 2)];
+        DrawRaw(q_bus_, ch, bus_mid, opt_.bus_sigma_V, n_bus_, rng_);
+        DrawRaw(q_cur_, ch, on ? 0.6 * cur_max : 0.05 * cur_max, opt_.current_sigma_mA, n_cur_, rng_);
+        DrawRaw(q_red_, ch, on ? red_mid_p : red_mid_n, opt_.redlab_sigma_V, n_red_, rng_);
+    }
+    for (Quantity* q : {&q_bus_, &q_cur_, &q_red_}) q->filter.Process(q->raw.data(), q->out.data());
+
     for (int ch = 0; ch < opt_.num_channels; ++ch) {
-        auto& s = sensors[static_cast<size_t>(ch)];
+        auto& s  = sensors[static_cast<size_t>(ch)];
+        auto& fs = faults_[static_cast<size_t>(ch)];
         s.channel = ch; // wichtig für GUI (Relaiszuordnung ch/2)
 
-        // Relaispaar bestimmen (0..num_relays-1)
-        const int  relay_idx = ch / 2;
-        const bool on        = relay_state_[static_cast<size_t>(relay_idx)];
-
-        // Busspannung
-        const double bus_noise = n_bus_(rng_) * opt_.bus_sigma_V;
-        s.bus_V = std::max(0.0, bus_mid + bus_noise);
-
-        // Strom (einfaches Modell)
-        const double cur_noise = n_cur_(rng_) * opt_.current_sigma_mA;
-        s.current_mA = std::clamp((on ? 0.6 * cur_max : 0.05 * cur_max) + cur_noise, 0.0, cur_max);
-
-        // RedLab (umschalten zwischen +/− Bereich)
-        const double red_noise = n_red_(rng_) * opt_.redlab_sigma_V;
-        s.redlab_V = (on ? red_mid_p : red_mid_n) + red_noise;
-
-        // Status
-        s.present   = s.current_mA >= (0.2 * cur_max);
-        s.supply_ok = (s.bus_V   >= cfg_.supply_voltage_threshold[0] &&
-                       s.bus_V   <= cfg_.supply_voltage_threshold[1]);
-        s.signal_ok = (s.redlab_V >= cfg_.redlab_neg_threshold[0] &&
-                       s.redlab_V <= cfg_.redlab_pos_threshold[1]);
-
-        // Fehlerzähler (simple Logik)
-        if (!s.supply_ok) ++s.supply_error_counter;
-        if (!s.signal_ok) ++s.signal_error_counter;
-        if (s.current_mA < cfg_.presence_current_threshold[0] ||
-            s.current_mA > cfg_.presence_current_threshold[1]) {
-            ++s.current_error_counter;
+        const double bus_raw = q_bus_.out[static_cast<size_t>(ch)];
+        const double cur_raw = q_cur_.out[static_cast<size_t>(ch)];
+        const double red_raw = q_red_.out[static_cast<size_t>(ch)];
+
+        // Vom Scheduler ausgelassen: kein Buszugriff, Werte bleiben stehen
+        // (Rohwerte oben trotzdem gezogen → gleiche Folge wie im Vollzyklus)
+        if (static_cast<size_t>(ch) < mask.size() && !mask[static_cast<size_t>(ch)]) continue;
+
+        // Neue Fehler würfeln (nur wenn Kanal gerade fehlerfrei)
+        if (fs.stuck_left == 0 && fs.dropout_left == 0) {
+            if (Chance(F.dropout_prob)) {
+                fs.dropout_left = std::max(1, F.dropout_cycles);
+                ++stats_.dropout_events;
+            } else if (Chance(F.stuck_prob)) {
+                fs.stuck_left  = std::max(1, F.stuck_cycles);
+                fs.stuck_value = s;
+                ++stats_.stuck_events;
+            }
+        }
+
+        // MUX-Kanal wählen
+        {
+            ScopedStageTimer t(Stage::MuxSelect, ch);
+            Simulate(opt_.mux_select);
+        }
+
+        // INA219 lesen (Bus-V, Strom, Leistung); Timeout bricht beim ersten Register ab
+        // Im Backoff wird das Gerät gar nicht angesprochen (keine Buszeit)
+        auto& ina_rt = ina_retry_[static_cast<size_t>(ch)];
+        bool ina_ok = ina_rt.ShouldAttempt(now_ns);
+        if (!ina_ok) {
+            ++stats_.backoff_skips;
+        } else if (Chance(F.timeout_prob)) {
+            ScopedStageTimer t(Stage::InaBusV, ch);
+            SpendUs(F.timeout_us);
+            ++stats_.ina_timeouts;
+            ina_ok = false;
+            ina_rt.OnFailure(now_ns);
+        } else {
+            for (Stage reg : {Stage::InaBusV, Stage::InaCurrent, Stage::InaPower}) {
+                ScopedStageTimer t(reg, ch);
+                Simulate(opt_.ina_read);
+            }
+            ina_rt.OnSuccess();
         }
 
+        // RedLab lesen
+        auto& daq_rt = daq_ch_retry_[static_cast<size_t>(ch)];
+        bool daq_ok = daq_retry_.ShouldAttempt(now_ns) && daq_rt.ShouldAttempt(now_ns);
+        if (!daq_ok) {
+            ++stats_.backoff_skips;
+        } else {
+            ScopedStageTimer t(Stage::DaqRead, ch);
+            if (daq_down) {
+                // ein Reconnect-Versuch, dann Gerät in den Backoff
+                SpendUs(F.storm_reconnect_us);
+                ++stats_.reconnects;
+                daq_ok = false;
+                daq_retry_.OnFailure(now_ns);
+            } else if (Chance(F.timeout_prob)) {
+                SpendUs(F.timeout_us);
+                ++stats_.daq_timeouts;
+                daq_ok = false;
+                daq_rt.OnFailure(now_ns);
+            } else {
+                Simulate(opt_.daq_read);
+                daq_retry_.OnSuccess();
+                daq_rt.OnSuccess();
+            }
+        }
+
+        // Veraltet-Status für GUI/Metriken
+        s.stale       = ina_rt.Stale() || daq_rt.Stale() || daq_retry_.Stale();
+        s.retry_count = ina_rt.Retries() + daq_rt.Retries() + daq_retry_.Retries();
+        s.stale_ms    = std::max({ina_rt.StaleForNs(now_ns), daq_rt.StaleForNs(now_ns),
+                                  daq_retry_.StaleForNs(now_ns)}) / 1000000ull;
+
+        if (fs.dropout_left > 0) {
+            // Sensor fehlt: alles liest 0
+            --fs.dropout_left;
+            s.bus_V      = 0.0;
+            s.current_mA = 0.0;
+            s.redlab_V   = 0.0;
+        } else if (fs.stuck_left > 0) {
+            // Stuck-at: letzter Wert vor dem Fehler bleibt stehen
+            --fs.stuck_left;
+            s.bus_V      = fs.stuck_value.bus_V;
+            s.current_mA = fs.stuck_value.current_mA;
+            s.redlab_V   = fs.stuck_value.redlab_V;
+        } else {
+            // Bei Timeout bleibt der alte Wert stehen (wie RealHardware)
+            if (ina_ok) {
+                // Busspannung
+                s.bus_V = std::max(0.0, bus_raw);
+
+                // Strom (einfaches Modell)
+                s.current_mA = std::clamp(cur_raw, 0.0, cur_max);
+            }
+            if (daq_ok) {
+                // RedLab (umschalten zwischen +/− Bereich)
+                s.redlab_V = red_raw;
+            }
+        }
+
+        ScopedStageTimer eval_timer(Stage::Evaluate, ch);
+
+        // Status; Fehlerzähler steigen beim Wechsel ok → nicht ok (wie RealHardware)
+        const bool supply_ok = (s.bus_V   >= cfg_.supply_voltage_threshold[0] &&
+                                s.bus_V   <= cfg_.supply_voltage_threshold[1]);
+        const bool signal_ok = (s.redlab_V >= cfg_.redlab_neg_threshold[0] &&
+                                s.redlab_V <= cfg_.redlab_pos_threshold[1]);
+        const bool current_ok = CurrentOk(s.current_mA);
+        if (s.supply_ok && !supply_ok)   ++s.supply_error_counter;
+        if (s.signal_ok && !signal_ok)   ++s.signal_error_counter;
+        if (s.current_ok && !current_ok) ++s.current_error_counter;
+        s.present    = s.current_mA >= (0.2 * cur_max);
+        s.supply_ok  = supply_ok;
+        s.signal_ok  = signal_ok;
+        s.current_ok = current_ok;
+
         // Zeitstempel
         s.timestamp_ms = static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::steady_clock::now().time_since_epoch()).count());
     }
+
+    if (storm_left_ > 0) --storm_left_;
+
+    // LED-Strip aktualisieren
+    ScopedStageTimer led_timer(Stage::LedShow);
+    Simulate(opt_.led_show);
+}
+
+void MockHardware::SetRelay(size_t idx, bool state) {
+    if (relay_state_[idx] == state) return;
+    relay_state_[idx]     = state;
+    relay_change_ns_[idx] = sosesta::util::MonoNs();
 }
 
 void MockHardware::ToggleRelay(int channel_pair, bool state) {
     if (channel_pair < 0 || channel_pair >= opt_.num_relays) return;
-    relay_state_[static_cast<size_t>(channel_pair)] = state;
+    std::lock_guard<std::mutex> lk(dev_mtx_);
+    SetRelay(static_cast<size_t>(channel_pair), state);
 }
 
 void MockHardware::TurnAllRelaysOn() {
-    std::fill(relay_state_.begin(), relay_state_.end(), true);
+    std::lock_guard<std::mutex> lk(dev_mtx_);
+    for (size_t i = 0; i < relay_state_.size(); ++i) SetRelay(i, true);
 }
 
 void MockHardware::TurnAllRelaysOff() {
-    std::fill(relay_state_.begin(), relay_state_.end(), false);
+    std::lock_guard<std::mutex> lk(dev_mtx_);
+    for (size_t i = 0; i < relay_state_.size(); ++i) SetRelay(i, false);
+}
+
+bool MockHardware::SampleTransient(std::vector<double>& redlab_V, std::vector<double>& current_mA) {
+    std::lock_guard<std::mutex> lk(dev_mtx_);
+    if (!initialized_) return false;
+    const size_t C = static_cast<size_t>(opt_.num_channels);
+    redlab_V.resize(C);
+    current_mA.resize(C);
+
+    const double cur_max   = cfg_.max_current_mA;
+    const double red_mid_p = 0.5 * (cfg_.redlab_pos_threshold[0] + cfg_.redlab_pos_threshold[1]);
+    const double red_mid_n = 0.5 * (cfg_.redlab_neg_threshold[0] + cfg_.redlab_neg_threshold[1]);
+    const std::uint64_t now = sosesta::util::MonoNs();
+    constexpr double kTwoPi = 6.283185307179586;
+
+    for (size_t ch = 0; ch < C; ++ch) {
+        const size_t r  = ch / 2;
+        const bool   on = relay_state_[r];
+        const double red_to   = on ? red_mid_p : red_mid_n;
+        const double red_from = on ? red_mid_n : red_mid_p;
+        const double cur_to   = on ? 0.6 * cur_max : 0.05 * cur_max;
+        const double cur_from = on ? 0.05 * cur_max : 0.6 * cur_max;
+
+        double red = red_to, cur = cur_to;
+        if (relay_change_ns_[r] != 0) {
+            const double t_us = static_cast<double>(now - relay_change_ns_[r]) / 1e3;
+            const double e_s  = opt_.signal_tau_us > 0.0 ? std::exp(-t_us / opt_.signal_tau_us) : 0.0;
+            const double e_c  = opt_.current_tau_us > 0.0 ? std::exp(-t_us / opt_.current_tau_us) : 0.0;
+            red = red_to + (red_from - red_to) * e_s * std::cos(kTwoPi * opt_.signal_ring_hz * t_us * 1e-6);
+            cur = cur_to + (cur_from - cur_to) * e_c;
+        }
+        redlab_V[ch]   = red + n_transient_(transient_rng_) * opt_.transient_sigma_V;
+        current_mA[ch] = std::clamp(cur + n_transient_(transient_rng_) * opt_.transient_sigma_mA, 0.0, cur_max);
+    }
+    return true;
+}
+
+// ── Asynchroner Pfad ──────────────────────────────────────
+// Gleiches Geräte-, Latenz- und Fehlermodell wie UpdateChannels(), aber
+// je Gerätegruppe getrennt: INA (MUX + Register) und DAQ melden einzeln.
+// Die simulierte Latenz läuft ohne dev_mtx_ (wie echte Busse, die Relais
+// nicht blockieren); Zustand wird nur unter der Sperre gelesen/geändert.
+
+std::uint32_t MockHardware::ReadGroup(DeviceGroup g, std::uint32_t mask, SensorData* out) {
+    std::unique_lock<std::mutex> lk(dev_mtx_);
+    if (!initialized_) return 0;
+    switch (g) {
+        case DeviceGroup::Ina: return ReadIna(mask, out, lk);
+        case DeviceGroup::Daq: return ReadDaq(mask, out, lk);
+        case DeviceGroup::Relay: break;
+    }
+    return 0;
+}
+
+bool MockHardware::Actuate(int relay, bool state) {
+    std::lock_guard<std::mutex> lk(dev_mtx_);
+    if (!initialized_) return false;
+    if (relay < 0) {
+        for (size_t i = 0; i < relay_state_.size(); ++i) SetRelay(i, state);
+        return true;
+    }
+    if (relay >= opt_.num_relays) return false;
+    SetRelay(static_cast<size_t>(relay), state);
+    return true;
+}
+
+std::uint32_t MockHardware::ReadIna(std::uint32_t mask, SensorData* out,
+                                    std::unique_lock<std::mutex>& lk) {
+    ++stats_.cycles;
+    const MockFaults& F = opt_.faults;
+    const std::uint64_t now_ns = sosesta::util::MonoNs();
+    const double bus_mid = 0.5 * (cfg_.supply_voltage_threshold[0] + cfg_.supply_voltage_threshold[1]);
+    const double cur_max = cfg_.max_current_mA;
+
+    for (int ch = 0; ch < opt_.num_channels; ++ch) {
+        const bool on = relay_state_[static_cast<size_t>(ch / 2)];
+        DrawRaw(aq_bus_, ch, bus_mid, opt_.bus_sigma_V, n_bus_, ina_rng_);
+        DrawRaw(aq_cur_, ch, on ? 0.6 * cur_max : 0.05 * cur_max, opt_.current_sigma_mA, n_cur_, ina_rng_);
+    }
+    for (Quantity* q : {&aq_bus_, &aq_cur_}) q->filter.Process(q->raw.data(), q->out.data());
+
+    std::uint32_t ok_mask = 0;
+    for (int ch = 0; ch < opt_.num_channels; ++ch) {
+        if (!(mask & (1u << ch))) continue;
+        const size_t i = static_cast<size_t>(ch);
+        auto& s  = async_last_[i];
+        auto& fs = faults_[i];
+
+        // Fehlerbild für diesen Auftrag festlegen (DAQ-Gruppe übernimmt es)
+        if (fs.stuck_left == 0 && fs.dropout_left == 0) {
+            if (Chance(F.dropout_prob)) {
+                fs.dropout_left = std::max(1, F.dropout_cycles);
+                ++stats_.dropout_events;
+            } else if (Chance(F.stuck_prob)) {
+                fs.stuck_left  = std::max(1, F.stuck_cycles);
+                fs.stuck_value = s;
+                ++stats_.stuck_events;
+            }
+        }
+        async_mode_[i] = kNormal;
+        if (fs.dropout_left > 0)    { --fs.dropout_left; async_mode_[i] = kDropout; }
+        else if (fs.stuck_left > 0) { --fs.stuck_left;   async_mode_[i] = kStuck; }
+
+        {
+            ScopedStageTimer t(Stage::MuxSelect, ch);
+            Simulate(opt_.mux_select, &lk);
+        }
+
+        auto& ina_rt = ina_retry_[i];
+        bool ina_ok = ina_rt.ShouldAttempt(now_ns);
+        if (!ina_ok) {
+            ++stats_.backoff_skips;
+        } else if (Chance(F.timeout_prob)) {
+            ScopedStageTimer t(Stage::InaBusV, ch);
+            SpendUs(F.timeout_us, &lk);
+            ++stats_.ina_timeouts;
+            ina_ok = false;
+            ina_rt.OnFailure(now_ns);
+        } else {
+            for (Stage reg : {Stage::InaBusV, Stage::InaCurrent, Stage::InaPower}) {
+                ScopedStageTimer t(reg, ch);
+                Simulate(opt_.ina_read, &lk);
+            }
+            ina_rt.OnSuccess();
+        }
+
+        if (async_mode_[i] == kDropout) {
+            s.bus_V = s.current_mA = 0.0;
+        } else if (async_mode_[i] == kStuck) {
+            s.bus_V      = fs.stuck_value.bus_V;
+            s.current_mA = fs.stuck_value.current_mA;
+        } else if (ina_ok) {
+            s.bus_V      = std::max(0.0, aq_bus_.out[i]);
+            s.current_mA = std::clamp(aq_cur_.out[i], 0.0, cur_max);
+        }
+        s.power_mW = s.bus_V * s.current_mA;
+
+        auto& daq_rt  = daq_ch_retry_[i];
+        s.stale       = ina_rt.Stale() || daq_rt.Stale() || daq_retry_.Stale();
+        s.retry_count = ina_rt.Retries() + daq_rt.Retries() + daq_retry_.Retries();
+        s.stale_ms    = std::max({ina_rt.StaleForNs(now_ns), daq_rt.StaleForNs(now_ns),
+                                  daq_retry_.StaleForNs(now_ns)}) / 1000000ull;
+
+        ScopedStageTimer eval_timer(Stage::Evaluate, ch);
+        const bool supply_ok = (s.bus_V >= cfg_.supply_voltage_threshold[0] &&
+                                s.bus_V <= cfg_.supply_voltage_threshold[1]);
+        const bool current_ok = CurrentOk(s.current_mA);
+        if (s.supply_ok && !supply_ok)   ++s.supply_error_counter;
+        if (s.current_ok && !current_ok) ++s.current_error_counter;
+        s.present    = s.current_mA >= (0.2 * cur_max);
+        s.supply_ok  = supply_ok;
+        s.current_ok = current_ok;
+        s.timestamp_ms = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+
+        out[i] = s;
+        if (ina_ok) ok_mask |= 1u << ch;
+    }
+    return ok_mask;
+}
+
+std::uint32_t MockHardware::ReadDaq(std::uint32_t mask, SensorData* out,
+                                    std::unique_lock<std::mutex>& lk) {
+    const MockFaults& F = opt_.faults;
+    if (storm_left_ == 0 && Chance(F.storm_prob)) {
+        storm_left_ = std::max(1, F.storm_cycles);
+        ++stats_.storms;
+    }
+    const bool daq_down = storm_left_ > 0;
+    const std::uint64_t now_ns = sosesta::util::MonoNs();
+    const double red_mid_p = 0.5 * (cfg_.redlab_pos_threshold[0] + cfg_.redlab_pos_threshold[1]);
+    const double red_mid_n = 0.5 * (cfg_.redlab_neg_threshold[0] + cfg_.redlab_neg_threshold[1]);
+
+    for (int ch = 0; ch < opt_.num_channels; ++ch) {
+        const bool on = relay_state_[static_cast<size_t>(ch / 2)];
+        DrawRaw(aq_red_, ch, on ? red_mid_p : red_mid_n, opt_.redlab_sigma_V, n_red_, daq_rng_);
+    }
+    aq_red_.filter.Process(aq_red_.raw.data(), aq_red_.out.data());
+
+    std::uint32_t ok_mask = 0;
+    for (int ch = 0; ch < opt_.num_channels; ++ch) {
+        if (!(mask & (1u << ch))) continue;
+        const size_t i = static_cast<size_t>(ch);
+        auto& s = async_last_[i];
+
+        auto& daq_rt = daq_ch_retry_[i];
+        bool daq_ok = daq_retry_.ShouldAttempt(now_ns) && daq_rt.ShouldAttempt(now_ns);
+        if (!daq_ok) {
+            ++stats_.backoff_skips;
+        } else {
+            ScopedStageTimer t(Stage::DaqRead, ch);
+            if (daq_down) {
+                SpendUs(F.storm_reconnect_us, &lk);
+                ++stats_.reconnects;
+                daq_ok = false;
+                daq_retry_.OnFailure(now_ns);
+            } else if (Chance(F.timeout_prob)) {
+                SpendUs(F.timeout_us, &lk);
+                ++stats_.daq_timeouts;
+                daq_ok = false;
+                daq_rt.OnFailure(now_ns);
+            } else {
+                Simulate(opt_.daq_read, &lk);
+                daq_retry_.OnSuccess();
+                daq_rt.OnSuccess();
+            }
+        }
+
+        if (async_mode_[i] == kDropout)    s.redlab_V = 0.0;
+        else if (async_mode_[i] == kStuck) s.redlab_V = faults_[i].stuck_value.redlab_V;
+        else if (daq_ok)                   s.redlab_V = aq_red_.out[i];
+
+        auto& ina_rt  = ina_retry_[i];
+        s.stale       = ina_rt.Stale() || daq_rt.Stale() || daq_retry_.Stale();
+        s.retry_count = ina_rt.Retries() + daq_rt.Retries() + daq_retry_.Retries();
+        s.stale_ms    = std::max({ina_rt.StaleForNs(now_ns), daq_rt.StaleForNs(now_ns),
+                                  daq_retry_.StaleForNs(now_ns)}) / 1000000ull;
+
+        ScopedStageTimer eval_timer(Stage::Evaluate, ch);
+        const bool signal_ok = (s.redlab_V >= cfg_.redlab_neg_threshold[0] &&
+                                s.redlab_V <= cfg_.redlab_pos_threshold[1]);
+        if (s.signal_ok && !signal_ok) ++s.signal_error_counter;
+        s.signal_ok = signal_ok;
+        s.timestamp_ms = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+
+        out[i] = s;
+        if (daq_ok) ok_mask |= 1u << ch;
+    }
+    if (storm_left_ > 0) --storm_left_;
+    return ok_mask;
 }
 
 }} // namespace sosesta::hw
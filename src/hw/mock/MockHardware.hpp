@@ -1,13 +1,40 @@
 #pragma once
 #include <vector>
 #include <random>
+#include <cstdint>
+#include <mutex>
 
 #include "hw/IHardware.hpp"
+#include "hw/AsyncHardwareBase.hpp"
+#include "hw/FilterBank.hpp"
+#include "hw/RetryBackoff.hpp"
 #include "config/ConfigSoftware.hpp"
 #include "app/data/SensorData.hpp"
 
 namespace sosesta { namespace hw {
 
+// Latenzmodell einer simulierten Geräteoperation (MUX-Select, INA-Read, ...).
+// None = kostet nichts (bisheriges Verhalten).
+struct MockLatency {
+    enum class Dist { None, Fixed, Uniform, Normal, LogNormal };
+    Dist   dist      = Dist::None;
+    double mean_us   = 0.0;   // Mittelwert (LogNormal: Median)
+    double jitter_us = 0.0;   // Uniform: ±jitter, Normal: Sigma, LogNormal: jitter/mean = Sigma von ln(t)
+};
+
+// Fehlerbilder; Wahrscheinlichkeiten pro Kanal und Zyklus (Storm: pro Zyklus).
+struct MockFaults {
+    double timeout_prob       = 0.0;     // INA- bzw. DAQ-Read läuft in Timeout, Wert bleibt alt
+    double timeout_us         = 20000.0; // Dauer eines Timeouts
+    double stuck_prob         = 0.0;     // Messwerte frieren ein (stuck-at)
+    int    stuck_cycles       = 50;
+    double dropout_prob       = 0.0;     // Sensor verschwindet (alles 0, nicht präsent)
+    int    dropout_cycles     = 10;
+    double storm_prob         = 0.0;     // DAQ trennt sich, Reconnect-Sturm
+    int    storm_cycles       = 20;
+    double storm_reconnect_us = 5000.0;  // Kosten je Reconnect-Versuch
+};
+
 // Freier Options-Typ (nicht mehr verschachtelt), damit Default-Argument {} problemlos funktioniert.
 struct MockOptions {
     unsigned seed             = 42;
@@ -16,22 +43,83 @@ struct MockOptions {
     double   bus_sigma_V      = 0.05;
     double   current_sigma_mA = 0.8;
     double   redlab_sigma_V   = 3.0;
-    bool     inject_faults    = true;
+    bool     inject_faults    = true;         // schaltet 'faults' scharf
+
+    // Latenzen je simulierter Operation
+    MockLatency mux_select;
+    MockLatency ina_read;     // je Registerzugriff (Bus-V, Strom, Leistung)
+    MockLatency daq_read;
+    MockLatency led_show;
+
+    MockFaults  faults;
+
+    // Sprungantwort nach Relais-Wechsel (nur Schnellpfad SampleTransient):
+    // Signal als gedämpfte Schwingung, Strom als Tiefpass 1. Ordnung
+    double transient_rate_hz    = 20000.0; // max. Rate des Schnellpfads
+    double signal_tau_us        = 400.0;
+    double signal_ring_hz       = 600.0;   // 0 = kein Überschwingen
+    double current_tau_us       = 1500.0;
+    double transient_sigma_V    = 0.02;    // Rauschen im Schnellpfad
+    double transient_sigma_mA   = 0.05;
+
+    // Wiederholung nach Gerätefehlern (Factory setzt sie aus ConfigHardware)
+    RetryPolicy ina_retry = RetryPolicy::From(3, 0.1);
+    RetryPolicy daq_retry = RetryPolicy::From(3, 0.5);
+};
+
+// Zähler für Auswertung von Stresstests (nur lesend nach außen)
+struct MockStats {
+    std::uint64_t cycles         = 0;
+    std::uint64_t ina_timeouts   = 0;
+    std::uint64_t daq_timeouts   = 0;
+    std::uint64_t stuck_events   = 0;
+    std::uint64_t dropout_events = 0;
+    std::uint64_t storms         = 0;
+    std::uint64_t reconnects     = 0;
+    std::uint64_t backoff_skips  = 0;   // Zugriffe, die wegen Backoff entfallen sind
+    double        simulated_us   = 0.0; // Summe aller simulierten Latenzen
 };
 
-struct MockHardware : IHardware {
+struct MockHardware : IHardware, AsyncHardwareBase {
     explicit MockHardware(const ConfigSoftwareView& cfg,
                           MockOptions opt = {});   // <— Default-Argument funktioniert jetzt sauber
+    ~MockHardware() override;
 
     // IHardware
     void Initialize() override;
     void Shutdown() override;
     void UpdateSensors(std::vector<SensorData>& sensors) override;
+    void UpdateChannels(std::vector<SensorData>& sensors, const std::vector<bool>& mask) override;
     void ToggleRelay(int channel_pair, bool state) override; // 0..(num_relays-1)
     void TurnAllRelaysOn() override;
     void TurnAllRelaysOff() override;
+    bool SampleTransient(std::vector<double>& redlab_V, std::vector<double>& current_mA) override;
+    double TransientMaxRateHz() const override { return opt_.transient_rate_hz; }
+    IAsyncHardware* Async() override { return this; }
+
+    const MockStats& Stats() const { return stats_; }
+
+protected:
+    // AsyncHardwareBase (Worker-Thread)
+    std::uint32_t ReadGroup(DeviceGroup g, std::uint32_t mask, SensorData* out) override;
+    bool Actuate(int relay, bool state) override;
 
 private:
+    // Fehlerzustand je Kanal (Restzyklen > 0 = aktiv)
+    struct ChannelFault {
+        int        stuck_left   = 0;
+        int        dropout_left = 0;
+        SensorData stuck_value{};
+    };
+
+    double DrawLatencyUs(const MockLatency& lat);
+    // lk gesetzt: Gerätesperre während der Wartezeit freigeben (Worker),
+    // damit Relais und synchroner Zyklus nicht an der Latenz hängen
+    void   Simulate(const MockLatency& lat, std::unique_lock<std::mutex>* lk = nullptr);
+    void   SpendUs(double us, std::unique_lock<std::mutex>* lk = nullptr);
+    bool   Chance(double p);
+    bool   CurrentOk(double mA) const;   // Strom im Präsenzfenster
+
     ConfigSoftwareView cfg_;
     MockOptions        opt_;
     bool               initialized_ = false;
@@ -41,8 +129,52 @@ private:
     std::normal_distribution<double> n_cur_{0.0, 1.0};
     std::normal_distribution<double> n_red_{0.0, 1.0};
 
+    // Eigene Generatoren für Latenz/Fehler: Messrauschen bleibt bei gleichem
+    // Seed identisch, egal ob Latenzen/Fehler aktiv sind.
+    std::mt19937 lat_rng_;
+    std::mt19937 fault_rng_;
+    std::uniform_real_distribution<double> u01_{0.0, 1.0};
+    std::normal_distribution<double>       n01_{0.0, 1.0};
+
+    // Überabtastung + Filter je Messgröße; Rohwerte [abtastung][kanal]
+    struct Quantity {
+        FilterBank          filter;
+        std::vector<double> raw;
+        std::vector<double> out;
+    };
+    void DrawRaw(Quantity& q, int ch, double mean, double sigma,
+                 std::normal_distribution<double>& n, std::mt19937& g);
+    Quantity q_bus_, q_cur_, q_red_;
+
+    // Asynchroner Pfad: eigene Rauschquellen und Filterzustände, damit die
+    // synchrone Folge bei gleichem Seed unverändert bleibt; je Gruppe ein
+    // eigener Generator (ausgelassene DAQ-Gruppe verschiebt INA nicht)
+    std::uint32_t ReadIna(std::uint32_t mask, SensorData* out, std::unique_lock<std::mutex>& lk);
+    std::uint32_t ReadDaq(std::uint32_t mask, SensorData* out, std::unique_lock<std::mutex>& lk);
+    Quantity     aq_bus_, aq_cur_, aq_red_;
+    std::mt19937 ina_rng_;
+    std::mt19937 daq_rng_;
+    std::vector<SensorData>   async_last_;   // Stand je Kanal über Aufträge hinweg
+    std::vector<std::uint8_t> async_mode_;   // Fehlerbild des laufenden Auftrags (INA → DAQ)
+
+    // Sync-Zyklus, Relais und Worker teilen sich Zustand und Generatoren
+    std::mutex dev_mtx_;
+
+    std::vector<ChannelFault> faults_;
+    std::vector<RetryBackoff> ina_retry_;     // je Kanal
+    std::vector<RetryBackoff> daq_ch_retry_;  // je Kanal (einzelner ulAIn)
+    RetryBackoff              daq_retry_;     // Gerät (Reconnect)
+    int       storm_left_ = 0;
+    MockStats stats_;
+
     // 4 Relais (für 8 Kanäle als Paare)
     std::vector<bool> relay_state_;
+
+    // Zeitpunkt des letzten Wechsels je Relais (0 = nie) für die Sprungantwort
+    void SetRelay(size_t idx, bool state);
+    std::vector<std::uint64_t> relay_change_ns_;
+    std::mt19937 transient_rng_;
+    std::normal_distribution<double> n_transient_{0.0, 1.0};
 };
 
 }} // namespace sosesta::hw
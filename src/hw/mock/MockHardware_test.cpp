@@ -0,0 +1,225 @@
+// MockHardware: Fehlermodell (Ausfall, Timeout mit Backoff, Erholung),
+// Statistik und Fehlerzähler; ohne Fehler reproduzierbar je Seed.
+#include "hw/mock/MockHardware.hpp"
+#include "util/TestCheck.hpp"
+
+#include <chrono>
+
+using namespace sosesta::hw;
+
+namespace {
+
+constexpr int C = 8;
+
+ConfigSoftwareView Cfg() {
+    return MakeConfigView(ConfigSoftware{});
+}
+
+// Relais EIN: Strom (0,6 · max) im Präsenzfenster, Signal ruhig
+MockOptions Opt() {
+    MockOptions o;
+    o.num_channels   = C;
+    o.redlab_sigma_V = 0.01;
+    return o;
+}
+
+bool Zero(const SensorData& s) {
+    return s.bus_V == 0.0 && s.current_mA == 0.0 && s.redlab_V == 0.0 && !s.present;
+}
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestDropoutAndRecovery() {
+    constexpr int kCycles = 400, kLen = 4;
+    MockOptions o = Opt();
+    o.faults.dropout_prob   = 0.05;
+    o.faults.dropout_cycles = kLen;
+    MockHardware hw(Cfg(), o);
+    hw.Initialize();
+    hw.TurnAllRelaysOn();
+
+    std::vector<SensorData> s;
+    std::vector<std::vector<bool>> zero(C);
+    bool healthy = true;
+    for (int k = 0; k < kCycles; ++k) {
+        hw.UpdateSensors(s);
+        REQUIRE(s.size() == C);
+        for (int ch = 0; ch < C; ++ch) {
+            const SensorData& d = s[static_cast<size_t>(ch)];
+            zero[ch].push_back(Zero(d));
+            // außerhalb eines Ausfalls: normale, gültige Werte
+            if (!Zero(d)) healthy = healthy && d.present && d.supply_ok && d.current_ok && d.signal_ok;
+        }
+    }
+    CHECK(healthy);
+
+    // Ausfälle dauern genau dropout_cycles; direkt folgende verschmelzen
+    std::uint64_t events = 0;
+    int runs_after_ok = 0, runs = 0;
+    bool lengths = true;
+    for (int ch = 0; ch < C; ++ch) {
+        for (int k = 0; k < kCycles;) {
+            if (!zero[ch][k]) { ++k; continue; }
+            const int start = k;
+            while (k < kCycles && zero[ch][k]) ++k;
+            const int len = k - start;
+            if (k < kCycles) lengths = lengths && len % kLen == 0;
+            events += static_cast<std::uint64_t>((len + kLen - 1) / kLen);
+            ++runs;
+            if (start > 0) ++runs_after_ok;
+        }
+    }
+    CHECK(lengths);
+    CHECK(runs > C);   // Kanäle erholen sich und fallen erneut aus
+    CHECK(hw.Stats().dropout_events == events);
+    CHECK(hw.Stats().cycles == kCycles);
+
+    // Zähler: je Wechsel ok → Ausfall einmal (Versorgung und Strom), Signal
+    // bleibt im Fenster (0 V liegt zwischen den Schwellen)
+    int supply = 0, current = 0, signal = 0;
+    for (const auto& d : s) {
+        supply  += d.supply_error_counter;
+        current += d.current_error_counter;
+        signal  += d.signal_error_counter;
+    }
+    CHECK(supply == runs_after_ok);
+    CHECK(current == runs_after_ok);
+    CHECK(signal == 0);
+    hw.Shutdown();
+}
+
+void TestTimeoutBackoff() {
+    // jeder Zugriff läuft in Timeout; lange Wartezeit → danach nur Backoff
+    MockOptions o = Opt();
+    o.faults.timeout_prob = 1.0;
+    o.faults.timeout_us   = 1.0;
+    o.ina_retry = RetryPolicy::From(3, 60.0);
+    o.daq_retry = RetryPolicy::From(3, 60.0);
+    MockHardware hw(Cfg(), o);
+    hw.Initialize();
+
+    std::vector<SensorData> s;
+    for (int k = 0; k < 5; ++k) hw.UpdateSensors(s);
+    const MockStats& st = hw.Stats();
+    CHECK(st.ina_timeouts == C);
+    CHECK(st.daq_timeouts == C);
+    CHECK(st.backoff_skips == 2u * C * 4);
+    for (const auto& d : s) {
+        CHECK(d.stale);
+        CHECK(d.retry_count == 2);
+        CHECK(d.bus_V == 0.0 && d.redlab_V == 0.0);   // nie gelesen, Wert bleibt
+    }
+    hw.Shutdown();
+}
+
+void TestTimeoutRecovery() {
+    // ohne Wartezeit: jeder Zyklus versucht erneut, Erfolg hebt stale auf
+    MockOptions o = Opt();
+    o.faults.timeout_prob = 0.3;
+    o.faults.timeout_us   = 1.0;
+    o.ina_retry = RetryPolicy::From(3, 0.0);
+    o.daq_retry = RetryPolicy::From(3, 0.0);
+    MockHardware hw(Cfg(), o);
+    hw.Initialize();
+    hw.TurnAllRelaysOn();
+
+    std::vector<SensorData> s;
+    int stale = 0, recovered = 0;
+    std::vector<bool> was(C, false);
+    for (int k = 0; k < 200; ++k) {
+        hw.UpdateSensors(s);
+        for (int ch = 0; ch < C; ++ch) {
+            const bool now = s[static_cast<size_t>(ch)].stale;
+            stale     += now;
+            recovered += was[static_cast<size_t>(ch)] && !now;
+            was[static_cast<size_t>(ch)] = now;
+        }
+    }
+    CHECK(stale > 0);
+    CHECK(recovered > 0);
+    CHECK(hw.Stats().backoff_skips == 0);
+
+    // Fehlversuche je Kanal summieren sich zu allen Timeouts
+    std::uint64_t retries = 0;
+    for (const auto& d : s) retries += d.retry_count;
+    CHECK(retries == hw.Stats().ina_timeouts + hw.Stats().daq_timeouts);
+    hw.Shutdown();
+}
+
+void TestStormAndLatency() {
+    MockOptions o = Opt();
+    o.faults.storm_prob         = 1.0;
+    o.faults.storm_cycles       = 3;
+    o.faults.storm_reconnect_us = 1.0;
+    o.daq_retry = RetryPolicy::From(3, 0.0);
+    o.mux_select = { MockLatency::Dist::Fixed, 20.0, 0.0 };
+    MockHardware hw(Cfg(), o);
+    hw.Initialize();
+
+    std::vector<SensorData> s;
+    for (int k = 0; k < 6; ++k) hw.UpdateSensors(s);
+    const MockStats& st = hw.Stats();
+    CHECK(st.storms == 2);                 // Sturm endet, der nächste beginnt
+    CHECK(st.reconnects == 6u * C);        // DAQ nie erreichbar
+    CHECK(st.daq_timeouts == 0);
+    CHECK_NEAR(st.simulated_us, 6.0 * C * (20.0 + 1.0), 1e-9);
+    for (const auto& d : s) CHECK(d.stale);
+    hw.Shutdown();
+}
+
+void TestNoFaultsReproducible() {
+    MockOptions o = Opt();
+    o.inject_faults       = false;   // Wahrscheinlichkeiten bleiben wirkungslos
+    o.faults.dropout_prob = 1.0;
+    o.faults.timeout_prob = 1.0;
+    MockHardware a(Cfg(), o), b(Cfg(), o);
+    a.Initialize();
+    b.Initialize();
+
+    std::vector<SensorData> sa, sb;
+    bool same = true;
+    for (int k = 0; k < 50; ++k) {
+        a.UpdateSensors(sa);
+        b.UpdateSensors(sb);
+        for (int ch = 0; ch < C; ++ch) {
+            const auto& x = sa[static_cast<size_t>(ch)];
+            const auto& y = sb[static_cast<size_t>(ch)];
+            same = same && x.bus_V == y.bus_V && x.current_mA == y.current_mA && x.redlab_V == y.redlab_V;
+        }
+    }
+    CHECK(same);
+    const MockStats& st = a.Stats();
+    CHECK(st.dropout_events == 0 && st.ina_timeouts == 0 && st.daq_timeouts == 0 && st.backoff_skips == 0);
+    for (const auto& d : sa) CHECK(!d.stale && d.bus_V > 0.0);
+    a.Shutdown();
+    b.Shutdown();
+}
+
+void TestAsyncDropout() {
+    MockOptions o = Opt();
+    o.faults.dropout_prob   = 1.0;
+    o.faults.dropout_cycles = 1;
+    MockHardware hw(Cfg(), o);
+    hw.Initialize();
+    IAsyncHardware* async = hw.Async();
+    REQUIRE(async != nullptr);
+    REQUIRE(async->SubmitRead(0xFFu) != 0);
+
+    Completion c[2];
+    size_t n = 0;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (n < 2 && std::chrono::steady_clock::now() < end) n += async->Poll(c + n, 2 - n, 50'000'000ull);
+    REQUIRE(n == 2);
+    for (const auto& x : c) {
+        REQUIRE(x.frame != nullptr);
+        for (const auto& d : x.frame->ch) CHECK(Zero(d));
+        async->Release(x.frame);
+    }
+    CHECK(hw.Stats().dropout_events == C);   // DAQ-Gruppe übernimmt das Fehlerbild der INA-Gruppe
+    hw.Shutdown();
+}
+
+} // namespace
+
+TEST_MAIN(TestDropoutAndRecovery, TestTimeoutBackoff, TestTimeoutRecovery, TestStormAndLatency,
+          TestNoFaultsReproducible, TestAsyncDropout)
@@ -3,8 +3,11 @@
 #include "hw/real/mux/TCA9548A.hpp"
 #include "hw/real/power/INA219.hpp"
 #include "hw/real/power/MuxedIna219.hpp"
+#include "services/StageProfiler.hpp"
+#include "util/Clock.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <string>
 
 // ----- Kleiner Adapter, falls notwendig -----
@@ -25,6 +28,48 @@ private:
 
 static std::optional<RelaysAdapter> g_relays_adapter; // Lebenszeit an RealHardware binden
 
+static constexpr const char* kI2CDevice = "/dev/i2c-1";
+static constexpr uint8_t     kMuxAddr   = 0x70;
+static constexpr uint8_t     kInaAddr   = 0x40;
+static constexpr int         kMuxPorts  = 8;      // TCA9548A: ein INA219 je Port
+static constexpr int         kMaxChannels = 32;   // Kanalmaske von IAsyncHardware
+static constexpr size_t      kMaxErrors = 32;     // ungeholte Meldungen für TakeError()
+
+// ----- RedLab-Geräte aus ConfigHardware -----
+// Seriennummern in Kanalreihenfolge; leer = ein Gerät (erstes gefundenes)
+static std::vector<RedLabGroup::Device> RedLabDevices(const ConfigHardware::RedLab& rl) {
+    RedLabDAQ::Options base;
+    base.reconnect_retries = rl.reconnect_retries;
+    base.reconnect_delay_s = rl.reconnect_delay_s;
+
+    std::vector<RedLabGroup::Device> devs;
+    if (rl.serials.empty()) {
+        devs.push_back({ base, rl.channels_per_device });
+        return devs;
+    }
+    for (const auto& serial : rl.serials) {
+        RedLabGroup::Device d{ base, rl.channels_per_device };
+        d.opt.serial = serial;
+        devs.push_back(std::move(d));
+    }
+    return devs;
+}
+
+// Kanäle laut Konfiguration, unabhängig davon, welche Geräte sich verbinden
+int RealHardware::ChannelCount(const ConfigHardware& hw) {
+    const int devices = std::max<int>(1, static_cast<int>(hw.redlab.serials.size()));
+    return std::clamp(devices * hw.redlab.channels_per_device, 1, kMaxChannels);
+}
+
+// Kleinste PGA-Stufe, deren Shunt-Bereich den Maximalstrom fasst (feinste
+// Auflösung); passt keine, begrenzt Ina219Calibrate auf 320 mV (warning)
+static InaGain InaGainFor(const ConfigHardware::INA219& ic) {
+    const double shunt_V = ic.shunt_ohm * ic.max_current_A;
+    for (const InaGain g : { GAIN_1_40MV, GAIN_2_80MV, GAIN_4_160MV })
+        if (shunt_V <= ina219::GainVolts(g)) return g;
+    return GAIN_8_320MV;
+}
+
 // ----- LED Farbkodierung: 0..1 -> Grün bis Rot -----
 void RealHardware::SeverityToRGB(double sev01, uint8_t& r, uint8_t& g, uint8_t& b) {
     double s = std::clamp(sev01, 0.0, 1.0);
@@ -44,21 +89,25 @@ void RealHardware::UpdateLedsFromSeverity(const std::vector<double>& sev) {
         leds_.setPixel(i, r, g, b);
     }
     std::string err;
+    ScopedStageTimer t(Stage::LedShow);
     leds_.show(&err); // Fehler bei Bedarf loggen
 }
 
 // ----- Konstruktor / Destruktor -----
-RealHardware::RealHardware(const AppConfigView& cfg, int led_pin, int led_channel, int led_count)
-: cfg_(cfg),
+RealHardware::RealHardware(const AppConfigView& cfg, const ConfigHardware& hw, int led_pin, int led_channel, int led_count)
+: AsyncHardwareBase(ChannelCount(hw)),
+  cfg_(cfg),
+  hw_(hw),
   // RelayController: Pins aus AppConfig 
   relays_({ .chip_path="/dev/gpiochip0",
             .pins = {14, 15, 24, 23}, // ACHTUNG: 18 freigehalten für WS281x <<-- HARDWARE ÄNDERN
             .active_high = true,
             .initial_on = false,
             .consumer   = "sosesta-relay" }),
-  redlab_{},  // TODO: ggf. Konstruktor-Parameter
-  tca_{},     // TODO: ggf. Bus/Adresse
-  ina_{},     // TODO: Shunt/MaxCurrent konfigurieren, wenn nötig
+  redlab_{},
+  i2c_{},
+  tca_{},
+  ina_{},
   leds_({     // LEDStrip::Config
         .gpio_pin    = led_pin,
         .led_count   = led_count,
@@ -67,36 +116,89 @@ RealHardware::RealHardware(const AppConfigView& cfg, int led_pin, int led_channe
         .brightness  = 64,
         .strip_type  = WS2811_STRIP_GRB,
         .freq        = WS2811_TARGET_FREQ,
-        .channel_index = led_channel })
+        .channel_index = led_channel }),
+  channels_(ChannelCount(hw)),
+  ina_retry_(static_cast<size_t>(channels_),
+             sosesta::hw::RetryBackoff(sosesta::hw::RetryPolicy::From(hw.ina219.retries, hw.ina219.retry_delay_s))),
+  daq_retry_(static_cast<size_t>(channels_),
+             sosesta::hw::RetryBackoff(sosesta::hw::RetryPolicy::From(hw.redlab.reconnect_retries, hw.redlab.reconnect_delay_s))),
+  daq_connect_(sosesta::hw::RetryPolicy::From(hw.redlab.reconnect_retries, hw.redlab.reconnect_delay_s))
 {
-    sensors_.resize(kNumChannels);
-    for (int i = 0; i < kNumChannels; ++i) {
+    sensors_.resize(static_cast<size_t>(channels_));
+    for (int i = 0; i < channels_; ++i) {
         sensors_[i].channel = i;
     }
+    daq_valid_.assign(static_cast<size_t>(channels_), false);
+
+    // Filter/Dezimierung je Messgröße (wie MockHardware); full_scale =
+    // Messbereich (INA219 bis 26 V / 3,2 A, RedLab ±10 V)
+    auto setup = [this](Quantity& q, const SignalFilterConfig& fc, double full_scale) {
+        sosesta::hw::FilterSpec spec = sosesta::hw::FilterSpec::From(fc);
+        spec.full_scale = full_scale;
+        q.filter.Configure(channels_, spec);
+        q.raw.assign(static_cast<size_t>(q.filter.Oversample() * channels_), 0.0);
+        q.out.assign(static_cast<size_t>(channels_), 0.0);
+    };
+    setup(q_bus_,  cfg_.filter_bus,     32.0);
+    setup(q_cur_,  cfg_.filter_current, 3200.0);
+    setup(q_red_,  cfg_.filter_redlab,  10.0);
+    setup(aq_bus_, cfg_.filter_bus,     32.0);
+    setup(aq_cur_, cfg_.filter_current, 3200.0);
+    setup(aq_red_, cfg_.filter_redlab,  10.0);
 
     // --- Init Reihenfolge ---
     // 1) Relais (sicherer Grundzustand)
     {
         std::string err;
         if (!relays_.init(&err)) {
-            // TODO: Log/Fehlerbehandlung
+            ReportError("Relais", err);
         } else {
             relays_.setAll(false, nullptr);
         }
     }
 
-    // 2) TCA9548A, INA219
-    tca_.Init(); // TODO: Rückgabewert prüfen/loggen
-    ina_.Init(); // TODO: Rückgabewert prüfen/kalibrieren (shunt, max current)
+    // 2) TCA9548A, INA219: Shunt/Maximalstrom aus ConfigHardware; je Kanal
+    //    das Kalibrierprofil bzw. (ohne Profil) die daraus berechnete Kalibrierung
+    {
+        const auto& ic = hw_.ina219;
+        std::string err;
+        bool ok = i2c_.openDev(kI2CDevice, &err)
+               && tca_.init(&i2c_, kMuxAddr, &err)
+               && ina_.init(&i2c_, kInaAddr, static_cast<float>(ic.shunt_ohm),
+                            static_cast<float>(ic.max_current_A), &err);
+        for (int ch = 0; ok && ch < std::min(channels_, kMuxPorts); ++ch) {
+            ok = tca_.select(ch, &err)
+              && (ic.calibration.empty() ? ina_.configure(RANGE_32V, InaGainFor(ic), ADC_12BIT, ADC_12BIT, &err)
+                                         : ina_.applyProfile(ic.calibration, &err));
+        }
+        if (!ok) {
+            ReportError("INA219", err);   // INA-Kanäle bleiben stale, Backoff greift
+        } else if (ina_.warning()) {
+            ReportError("INA219", ina_.warning());
+        }
+        // Profile sind für einen festen Shunt gerechnet; anderer Shunt → falsche Ströme
+        if (const auto* p = FindIna219Profile(ic.calibration);
+            p && std::abs(p->shunt_ohms - ic.shunt_ohm) > 1e-6) {
+            ReportError("INA219", "Profil " + ic.calibration + " gilt für " + std::to_string(p->shunt_ohms)
+                                  + " Ohm, konfiguriert " + std::to_string(ic.shunt_ohm) + " Ohm");
+        }
+    }
 
-    // 3) RedLab DAQ verbinden
-    redlab_.Connect(); // TODO: Rückgabewert prüfen/loggen
+    // 3) RedLab DAQ verbinden (alle Geräte parallel); fehlende holt
+    //    ReadDaqFrame() im Backoff nach, die übrigen laufen schon
+    {
+        std::string err;
+        if (!redlab_.Connect(RedLabDevices(hw_.redlab), &err)) {
+            ReportError("RedLab", err);
+            daq_connect_.OnFailure(sosesta::util::MonoNs());
+        }
+    }
 
     // 4) LED-Strip initialisieren
     {
         std::string err;
         if (!leds_.init(&err)) {
-            // TODO: Log/Fehlerbehandlung
+            ReportError("LED-Strip", err);
         } else {
             leds_.clear();
             leds_.show();
@@ -105,9 +207,15 @@ RealHardware::RealHardware(const AppConfigView& cfg, int led_pin, int led_channe
 
     // Relais-Adapter anlegen (nur falls benötigt)
     g_relays_adapter.emplace(relays_);
+
+    // 5) Asynchroner Worker (Geräte sind bereit)
+    StartAsync();
 }
 
 RealHardware::~RealHardware() {
+    // Worker zuerst: er greift auf die Geräte zu
+    StopAsync();
+
     // LEDs aus
     std::string err;
     if (leds_.isInitialized()) {
@@ -125,6 +233,21 @@ RealHardware::~RealHardware() {
     leds_.shutdown();
 }
 
+// ----- Gerätefehler -----
+void RealHardware::ReportError(const std::string& what, const std::string& err) {
+    std::lock_guard<std::mutex> lock(err_mtx_);
+    if (errors_.size() >= kMaxErrors) errors_.pop_front();
+    errors_.push_back(what + ": " + err);
+}
+
+bool RealHardware::TakeError(std::string* err) {
+    std::lock_guard<std::mutex> lock(err_mtx_);
+    if (errors_.empty()) return false;
+    if (err) *err = std::move(errors_.front());
+    errors_.pop_front();
+    return true;
+}
+
 // ----- IRelays-Zugriff -----
 IRelays& RealHardware::Relays() {
     // Wenn dein RelayController bereits IRelays erbt/implementiert:
@@ -134,49 +257,68 @@ IRelays& RealHardware::Relays() {
 }
 
 // ----- Sensor-Update -----
+// Zwei Durchläufe: erst Rohwerte aller Kanäle lesen (oversample-fach),
+// dann blockweise filtern/dezimieren und auswerten
 void RealHardware::UpdateSensors() {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    std::vector<double> sev(kNumChannels, 0.0);
+    std::vector<double> sev(static_cast<size_t>(channels_), 0.0);
 
-    for (int ch = 0; ch < kNumChannels; ++ch) {
+    // Gemeinsame Scans über alle RedLab-Geräte für den ganzen Zyklus
+    const bool daq_ok = ReadDaqBlock(q_red_);
+
+    for (int ch = 0; ch < channels_; ++ch) {
         SensorData& s = sensors_[ch];
 
-        // --- TCA: Kanal selektieren ---
-        tca_.Select(ch); // TODO: Fehler prüfen
+        // --- TCA: Kanal selektieren (Fehler = INA-Lesefehler; ohne Port kein INA) ---
+        std::string err;
+        bool mux_ok;
+        {
+            ScopedStageTimer t(Stage::MuxSelect, ch);
+            mux_ok = ch < kMuxPorts && tca_.select(ch, &err);
+        }
 
-        // --- INA219 lesen ---
-        if (auto v = ina_.Read()) {
-            // erwartetes Format: tuple(bus_V, current_mA, power_mW)
-            s.bus_V      = std::get<0>(*v);
-            s.current_mA = std::get<1>(*v);
-            s.power_mW   = std::get<2>(*v);
+        // --- INA219 lesen (im Backoff übersprungen, alter Wert bleibt) ---
+        const std::uint64_t now_ns = sosesta::util::MonoNs();
+        auto& ina_rt = ina_retry_[ch];
+        bool ina_read = false;
+        if (ina_rt.ShouldAttempt(now_ns)) {
+            ina_read = mux_ok && ReadIna(ch, q_bus_, q_cur_, s, &err);
+            if (ina_read) ina_rt.OnSuccess();
+            else          ina_rt.OnFailure(now_ns);
+        }
+        if (!ina_read) {
+            Hold(q_bus_, ch, s.bus_V);
+            Hold(q_cur_, ch, s.current_mA);
         }
 
-        // --- RedLab lesen ---
-        if (auto v = redlab_.Read(ch)) {
-            s.redlab_V = *v;
+        // --- RedLab: Kanal gültig in allen Scans des Blocks ---
+        auto& daq_rt = daq_retry_[ch];
+        if (daq_rt.ShouldAttempt(now_ns)) {
+            if (daq_ok && daq_valid_[ch]) daq_rt.OnSuccess();
+            else                          daq_rt.OnFailure(now_ns);
         }
 
-        // --- Präsenzheuristik (wie von dir skizziert) ---
-        const bool voltage_ok = !(s.redlab_V >= 1.30 && s.redlab_V <= 1.60);
-        const bool current_ok = s.current_mA > 0.3;
-        s.present = voltage_ok || current_ok;
+        s.stale       = ina_rt.Stale() || daq_rt.Stale();
+        s.retry_count = ina_rt.Retries() + daq_rt.Retries();
+        s.stale_ms    = std::max(ina_rt.StaleForNs(now_ns), daq_rt.StaleForNs(now_ns)) / 1000000ull;
+    }
 
-        // --- Statusflags anhand Konfig ---
-        const bool supply_ok   = InRange(s.bus_V,        cfg_.supply_voltage_threshold);
-        const bool signal_ok   = InRange(s.redlab_V,     cfg_.redlab_neg_threshold)
-                              || InRange(s.redlab_V,     cfg_.redlab_pos_threshold);
-        const bool current_ok2 = InRange(s.current_mA,   cfg_.presence_current_threshold);
+    for (Quantity* q : {&q_bus_, &q_cur_, &q_red_}) q->filter.Process(q->raw.data(), q->out.data());
 
-        // --- Fehlerzähler: steigern bei ok->nicht ok ---
-        if (s.supply_ok  && !supply_ok)   ++s.supply_err_cnt;
-        if (s.signal_ok  && !signal_ok)   ++s.signal_err_cnt;
-        if (s.current_ok && !current_ok2) ++s.current_err_cnt;
+    for (int ch = 0; ch < channels_; ++ch) {
+        SensorData& s = sensors_[ch];
+        const size_t i = static_cast<size_t>(ch);
+        // frisch gelesen = letzter Versuch erfolgreich (sonst bleibt der alte Wert)
+        if (!ina_retry_[i].Stale()) {
+            s.bus_V      = q_bus_.out[i];
+            s.current_mA = q_cur_.out[i];
+        }
+        if (!daq_retry_[i].Stale()) s.redlab_V = q_red_.out[i];
 
-        s.supply_ok  = supply_ok;
-        s.signal_ok  = signal_ok;
-        s.current_ok = current_ok2;
+        ScopedStageTimer eval_timer(Stage::Evaluate, ch);
+        EvaluateIna(s);
+        EvaluateDaq(s);
 
         // --- Severity 0..1 für LED ---
         double sev_val = 0.0;
@@ -189,3 +331,173 @@ void RealHardware::UpdateSensors() {
     // --- LEDs aktualisieren ---
     UpdateLedsFromSeverity(sev);
 }
+
+// ----- Auswertung (synchroner Zyklus und Gruppen) -----
+// Statusflags anhand Konfig; Fehlerzähler steigen beim Wechsel ok → nicht ok
+void RealHardware::EvaluateIna(SensorData& s) const {
+    // Präsenzheuristik: Signal außerhalb des Leerlaufbands oder Strom fließt
+    const bool voltage_ok = !(s.redlab_V >= 1.30 && s.redlab_V <= 1.60);
+    s.present = voltage_ok || s.current_mA > 0.3;
+
+    const bool supply_ok  = InRange(s.bus_V,      cfg_.supply_voltage_threshold);
+    const bool current_ok = InRange(s.current_mA, cfg_.presence_current_threshold);
+    if (s.supply_ok  && !supply_ok)  ++s.supply_error_counter;
+    if (s.current_ok && !current_ok) ++s.current_error_counter;
+    s.supply_ok  = supply_ok;
+    s.current_ok = current_ok;
+}
+
+void RealHardware::EvaluateDaq(SensorData& s) const {
+    const bool signal_ok = InRange(s.redlab_V, cfg_.redlab_neg_threshold)
+                        || InRange(s.redlab_V, cfg_.redlab_pos_threshold);
+    if (s.signal_ok && !signal_ok) ++s.signal_error_counter;
+    s.signal_ok = signal_ok;
+}
+
+// ----- Asynchrone Gruppen -----
+// Lesen, Filtern, Gültigkeit und Auswertung der Felder, die MergeGroup() je
+// Gruppe übernimmt (INA: Versorgung/Strom/Präsenz, DAQ: Signal). Eigene
+// Filterzustände (aq_*): Aufträge kommen in anderem Takt als der Zyklus.
+std::uint32_t RealHardware::ReadGroup(sosesta::hw::DeviceGroup g, std::uint32_t mask, SensorData* out) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    const bool ina = g == sosesta::hw::DeviceGroup::Ina;
+    std::uint32_t ok_mask = 0;
+
+    // DAQ: gemeinsame Scans für alle angefragten Kanäle
+    const bool daq_ok = !ina && ReadDaqBlock(aq_red_);
+
+    for (int ch = 0; ch < channels_; ++ch) {
+        SensorData& s = sensors_[ch];
+        const bool wanted = (mask & (1u << ch)) != 0;
+        const std::uint64_t now_ns = sosesta::util::MonoNs();
+
+        if (ina) {
+            bool ina_read = false;
+            auto& ina_rt = ina_retry_[ch];
+            if (wanted && ina_rt.ShouldAttempt(now_ns)) {
+                std::string err;
+                bool mux_ok;
+                {
+                    ScopedStageTimer t(Stage::MuxSelect, ch);
+                    mux_ok = ch < kMuxPorts && tca_.select(ch, &err);
+                }
+                ina_read = mux_ok && ReadIna(ch, aq_bus_, aq_cur_, s, &err);
+                if (ina_read) ina_rt.OnSuccess();
+                else          ina_rt.OnFailure(now_ns);
+            }
+            if (ina_read) {
+                ok_mask |= 1u << ch;
+            } else {
+                Hold(aq_bus_, ch, s.bus_V);
+                Hold(aq_cur_, ch, s.current_mA);
+            }
+        } else if (wanted) {
+            auto& daq_rt = daq_retry_[ch];
+            if (daq_rt.ShouldAttempt(now_ns)) {
+                if (daq_ok && daq_valid_[ch]) {
+                    daq_rt.OnSuccess();
+                    ok_mask |= 1u << ch;
+                } else {
+                    daq_rt.OnFailure(now_ns);
+                }
+            }
+        }
+    }
+
+    if (ina) {
+        for (Quantity* q : {&aq_bus_, &aq_cur_}) q->filter.Process(q->raw.data(), q->out.data());
+    } else {
+        aq_red_.filter.Process(aq_red_.raw.data(), aq_red_.out.data());
+    }
+
+    for (int ch = 0; ch < channels_; ++ch) {
+        if (!(mask & (1u << ch))) continue;
+        SensorData& s = sensors_[ch];
+        const size_t i = static_cast<size_t>(ch);
+        const std::uint64_t now_ns = sosesta::util::MonoNs();
+        {
+            ScopedStageTimer t(Stage::Evaluate, ch);
+            if (ina) {
+                if (ok_mask & (1u << ch)) {
+                    s.bus_V      = aq_bus_.out[i];
+                    s.current_mA = aq_cur_.out[i];
+                }
+                EvaluateIna(s);
+            } else {
+                if (ok_mask & (1u << ch)) s.redlab_V = aq_red_.out[i];
+                EvaluateDaq(s);
+            }
+        }
+
+        auto& ina_rt = ina_retry_[i];
+        auto& daq_rt = daq_retry_[i];
+        s.stale       = ina_rt.Stale() || daq_rt.Stale();
+        s.retry_count = ina_rt.Retries() + daq_rt.Retries();
+        s.stale_ms    = std::max(ina_rt.StaleForNs(now_ns), daq_rt.StaleForNs(now_ns)) / 1000000ull;
+        out[ch] = s;
+    }
+    return ok_mask;
+}
+
+// Zeile k der Rohwerte: raw[k · Kanäle + ch]
+void RealHardware::Hold(Quantity& q, int ch, double v) const {
+    for (int k = 0; k < q.filter.Oversample(); ++k)
+        q.raw[static_cast<size_t>(k * channels_ + ch)] = v;
+}
+
+bool RealHardware::ReadIna(int ch, Quantity& bus, Quantity& cur, SensorData& s, std::string* err) {
+    const int n = std::max(bus.filter.Oversample(), cur.filter.Oversample());
+    for (int k = 0; k < n; ++k) {
+        float V = 0, I = 0;
+        { ScopedStageTimer t(Stage::InaBusV, ch);    if (!ina_.voltage(&V, err)) return false; }
+        { ScopedStageTimer t(Stage::InaCurrent, ch); if (!ina_.current(&I, err)) return false; }
+        if (k < bus.filter.Oversample()) bus.raw[static_cast<size_t>(k * channels_ + ch)] = V;
+        if (k < cur.filter.Oversample()) cur.raw[static_cast<size_t>(k * channels_ + ch)] = I;
+    }
+    float P = 0;   // Leistung ungefiltert, einmal je Zyklus
+    { ScopedStageTimer t(Stage::InaPower, ch); if (!ina_.power(&P, err)) return false; }
+    s.power_mW = P;
+    return true;
+}
+
+bool RealHardware::ReadDaqBlock(Quantity& red) {
+    std::fill(daq_valid_.begin(), daq_valid_.end(), true);
+    bool any = false;
+    for (int k = 0; k < red.filter.Oversample(); ++k) {
+        const bool ok = ReadDaqFrame();
+        any = any || ok;
+        for (int ch = 0; ch < channels_; ++ch) {
+            const size_t i = static_cast<size_t>(ch);
+            const bool valid = ok && i < frame_.valid.size() && frame_.valid[i];
+            red.raw[static_cast<size_t>(k * channels_ + ch)] = valid ? frame_.volts[i] : sensors_[i].redlab_V;
+            daq_valid_[i] = daq_valid_[i] && valid;
+        }
+    }
+    return any;
+}
+
+bool RealHardware::ReadDaqFrame() {
+    // fehlende Geräte nachverbinden; blockiert den Zyklus nur im Versuch selbst
+    if (redlab_.Missing() > 0) {
+        const std::uint64_t now_ns = sosesta::util::MonoNs();
+        if (daq_connect_.ShouldAttempt(now_ns)) {
+            std::string err;
+            if (redlab_.ConnectMissing(&err)) {
+                daq_connect_.OnSuccess();
+            } else {
+                if (!daq_connect_.Stale()) ReportError("RedLab", err);   // je Ausfall einmal
+                daq_connect_.OnFailure(now_ns);
+            }
+        }
+    }
+    if (!redlab_.IsConnected()) return false;
+    ScopedStageTimer t(Stage::DaqRead);
+    std::string err;
+    return redlab_.ReadFrame(&frame_, &err);   // Fehler einzelner Geräte: deren Kanäle !valid
+}
+
+bool RealHardware::Actuate(int relay, bool state) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (relay < 0) return relays_.setAll(state, nullptr);
+    return relays_.set(static_cast<size_t>(relay), state, nullptr);
+}
@@ -1,12 +1,20 @@
 #pragma once
 #include "IHardware.hpp"
 #include "relays/RelayController.hpp"
-#include "daq/RedLabDAQ.hpp"
+#include "daq/RedLabGroup.hpp"
+#include "i2c/I2CBus.hpp"
 #include "mux/TCA9548A.hpp"
-#include "power/INA219.h"
+#include "power/INA219.hpp"
 #include "leds/LEDStrip.hpp"
+#include "hw/RetryBackoff.hpp"
+#include "hw/AsyncHardwareBase.hpp"
+#include "hw/FilterBank.hpp"
+#include "config/ConfigHardware.hpp"
+#include <deque>
 #include <mutex>
 #include <optional>
+#include <string>
+#include <vector>
 
 /**
  * @brief Reale Hardware-Implementierung (Produktivbetrieb).
@@ -14,21 +22,27 @@
  * Kapselt:
  *  - TCA9548A I2C-Multiplexer (Kanaalselektion)
  *  - INA219 (Strom/Spannung/Leistung)
- *  - RedLab DAQ (Analogsignal)
+ *  - RedLab DAQ (Analogsignal; mehrere Geräte als RedLabGroup)
  *  - RelayController (GPIO-Relais via libgpiod)
  *  - LEDStrip (WS281x, Statusvisualisierung)
  *
+ * Kanalzahl aus ConfigHardware::redlab (Geräte × Kanäle je Gerät); INA219
+ * gibt es nur an den MUX-Ports 0..7.
+ *
  * Thread-safe: UpdateSensors() sperrt intern einen Mutex.
+ * Async(): INA- und DAQ-Gruppe melden getrennt (AsyncHardwareBase).
+ * Gerätefehler aus Init und Reconnect holt der Aufrufer mit TakeError().
  */
-class RealHardware : public IHardware {
+class RealHardware : public IHardware, public sosesta::hw::AsyncHardwareBase {
 public:
     /**
      * @param cfg           schreibgeschützter Config-View (Grenzwerte etc.)
+     * @param hw            Hardware-Parameter (INA219-Profil, RedLab-Seriennummern, ...)
      * @param led_pin       GPIO für WS281x (Default 18 empfohlen). Achtung: 10 (MOSI) nur mit SPI/PCM-Betriebsart!
      * @param led_channel   WS281x-Channel (0/1)
      * @param led_count     Anzahl LEDs am Strip
      */
-    RealHardware(const AppConfigView& cfg, int led_pin = 18, int led_channel = 0, int led_count = 8);
+    RealHardware(const AppConfigView& cfg, const ConfigHardware& hw, int led_pin = 18, int led_channel = 0, int led_count = 8);
     ~RealHardware() override;
 
     void UpdateSensors() override;
@@ -39,26 +53,79 @@ public:
     // Option B: Kleiner Adapter (siehe unten in der .cpp).
     IRelays& Relays() override;
 
+    sosesta::hw::IAsyncHardware* Async() override { return this; }
+    bool TakeError(std::string* err) override;
+
+    int Channels() const { return channels_; }
+
+protected:
+    // AsyncHardwareBase (Worker-Thread); teilt mtx_ mit UpdateSensors()
+    std::uint32_t ReadGroup(sosesta::hw::DeviceGroup g, std::uint32_t mask, SensorData* out) override;
+    bool Actuate(int relay, bool state) override;
+
 private:
     // --- Konfiguration ---
-    AppConfigView cfg_;
+    AppConfigView  cfg_;
+    ConfigHardware hw_;
 
     // --- HW-Komponenten ---
     RelayController relays_;
-    RedLabDAQ       redlab_;
+    RedLabGroup     redlab_;
+    I2CBus          i2c_;
     TCA9548A        tca_;
-    INA219Manager   ina_;
+    INA219          ina_;      // ein Baustein je MUX-Kanal, gleiche Adresse
     LEDStrip        leds_;
 
+    const int channels_;
+
+    // --- Wiederholung nach Gerätefehlern (über Zyklen, nicht blockierend) ---
+    std::vector<sosesta::hw::RetryBackoff> ina_retry_;    // je Kanal
+    std::vector<sosesta::hw::RetryBackoff> daq_retry_;    // je Kanal
+    sosesta::hw::RetryBackoff              daq_connect_;  // fehlende RedLab-Geräte nachverbinden
+
     // --- Daten & Schutz ---
     std::vector<SensorData> sensors_;
+    RedLabGroup::Frame frame_;        // letzter DAQ-Scan (alle Geräte)
+    std::vector<bool>  daq_valid_;    // je Kanal: gültig in allen Scans des Blocks
+
+    // --- Überabtastung + Filter je Messgröße; Rohwerte [abtastung][kanal] ---
+    struct Quantity {
+        sosesta::hw::FilterBank filter;
+        std::vector<double>     raw;
+        std::vector<double>     out;
+    };
+    Quantity q_bus_, q_cur_, q_red_;      // synchroner Zyklus
+    Quantity aq_bus_, aq_cur_, aq_red_;   // asynchrone Gruppen
     mutable std::mutex mtx_;
 
+    // --- Gerätefehler für TakeError() (eigener Mutex: mtx_ hält Gerätezugriffe) ---
+    void ReportError(const std::string& what, const std::string& err);
+    std::mutex              err_mtx_;
+    std::deque<std::string> errors_;   // höchstens kMaxErrors, älteste fallen weg
+
     // --- Hilfen ---
+    static int ChannelCount(const ConfigHardware& hw);
     static inline bool InRange(double v, const double range[2]) {
         return v >= range[0] && v <= range[1];
     }
 
+    // Statusflags und Fehlerzähler der INA- bzw. DAQ-Felder aus den Messwerten
+    void EvaluateIna(SensorData& s) const;
+    void EvaluateDaq(SensorData& s) const;
+
+    // INA219 des (bereits gewählten) MUX-Kanals oversample-fach lesen:
+    // Rohwerte nach bus/cur (Kanal ch), Leistung direkt nach s
+    bool ReadIna(int ch, Quantity& bus, Quantity& cur, SensorData& s, std::string* err);
+    // Kanal ohne frischen Wert: alle Abtastungen = v (Filter hält den Wert)
+    void Hold(Quantity& q, int ch, double v) const;
+
+    // Ein Scan über alle RedLab-Geräte nach frame_; true = mindestens ein Kanal gültig.
+    // Fehlende Geräte werden vorher im Backoff nachverbunden (daq_connect_).
+    bool ReadDaqFrame();
+    // Oversample() Scans nach red.raw (ungültige Kanäle halten ihren Wert),
+    // daq_valid_ gesetzt; true = mindestens ein Scan gelungen
+    bool ReadDaqBlock(Quantity& red);
+
     // LED-Hilfen
     static void SeverityToRGB(double sev01, uint8_t& r, uint8_t& g, uint8_t& b);
     void UpdateLedsFromSeverity(const std::vector<double>& sev);
@@ -0,0 +1,86 @@
+#include "DaqInventory.hpp"
+#include "services/Tracer.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+DaqInventory& DaqInventory::Instance() {
+    static DaqInventory inst;
+    return inst;
+}
+
+bool DaqInventory::Refresh(std::string* err) {
+    SOSESTA_TRACE_SCOPE("DaqInventory::Refresh");
+    std::scoped_lock enum_lk(enum_m_);
+
+    // Enumeration ohne Cache-Lock: Leser bekommen solange den alten Stand
+    const unsigned int MAX_DEVICES = 64;
+    std::vector<DaqDeviceDescriptor> descs(MAX_DEVICES);
+    unsigned int count = MAX_DEVICES;
+    const ULSTATUS st = ulGetDaqDeviceInventory(ANY_IFC, descs.data(), &count);
+    if (st != ERR_NO_ERROR) {
+        if (err) {
+            std::ostringstream oss;
+            oss << "RedLab: ulGetDaqDeviceInventory fehlgeschlagen: ULSTATUS=" << static_cast<long>(st);
+            *err = oss.str();
+        }
+        return false;
+    }
+    descs.resize(count);
+
+    std::scoped_lock lk(m_);
+    devices_ = std::move(descs);
+    loaded_  = true;
+    ++generation_;
+    return true;
+}
+
+bool DaqInventory::Devices(std::vector<DaqDeviceDescriptor>* out, uint64_t* generation, std::string* err) {
+    {
+        std::scoped_lock lk(m_);
+        if (loaded_) {
+            if (out) *out = devices_;
+            if (generation) *generation = generation_;
+            return true;
+        }
+    }
+    if (!Refresh(err)) return false;
+    std::scoped_lock lk(m_);
+    if (out) *out = devices_;
+    if (generation) *generation = generation_;
+    return true;
+}
+
+bool DaqInventory::StartHotplug(std::string* err) {
+    if (monitor_.IsRunning()) return true;
+    return monitor_.Start([this](const UsbHotplugMonitor::Event& ev) { OnHotplug(ev); },
+                          kMccVendorId, err);
+}
+
+void DaqInventory::StopHotplug() {
+    monitor_.Stop();
+}
+
+int DaqInventory::AddListener(Listener l) {
+    std::scoped_lock lk(listen_m_);
+    const int id = next_listener_++;
+    listeners_[id] = std::move(l);
+    return id;
+}
+
+void DaqInventory::RemoveListener(int id) {
+    std::scoped_lock lk(listen_m_);
+    listeners_.erase(id);
+}
+
+void DaqInventory::OnHotplug(const UsbHotplugMonitor::Event& ev) {
+    // Nach "add" braucht libusb einen Moment, bis das Gerät öffnungsbereit ist
+    if (ev.action == UsbHotplugMonitor::Event::Action::Add)
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    Refresh(nullptr); // läuft im Monitor-Thread, nie im Erfassungszyklus
+
+    std::scoped_lock lk(listen_m_);
+    for (auto& [id, l] : listeners_) l(ev);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ULDAQ
+#include <uldaq.h>
+
+#include "UsbHotplugMonitor.hpp"
+
+/**
+ * DaqInventory – zwischengespeichertes ULDAQ-Geräteverzeichnis
+ * - ulGetDaqDeviceInventory (USB-Enumeration, einige 100 ms) nur bei Bedarf:
+ *   beim ersten Zugriff und nach einem Hot-Plug-Ereignis
+ * - Hot-Plug über UsbHotplugMonitor (Netlink), gefiltert auf MCC-Geräte
+ * - Listener werden nach dem Auffrischen benachrichtigt (im Monitor-Thread)
+ * - Generation zählt jede Änderung; Aufrufer erkennen damit veraltete Kopien
+ */
+class DaqInventory {
+public:
+    static constexpr uint16_t kMccVendorId = 0x09DB; // Measurement Computing (RedLab)
+
+    using Listener = std::function<void(const UsbHotplugMonitor::Event&)>;
+
+    static DaqInventory& Instance();
+
+    // Verzeichnis neu einlesen (eine Enumeration)
+    bool Refresh(std::string* err = nullptr);
+
+    // Kopie aus dem Cache; beim ersten Aufruf wird einmal eingelesen
+    bool Devices(std::vector<DaqDeviceDescriptor>* out, uint64_t* generation = nullptr,
+                 std::string* err = nullptr);
+
+    uint64_t Generation() const { std::scoped_lock lk(m_); return generation_; }
+
+    // Hot-Plug-Überwachung (idempotent)
+    bool StartHotplug(std::string* err = nullptr);
+    void StopHotplug();
+
+    int  AddListener(Listener l);
+    void RemoveListener(int id);
+
+private:
+    DaqInventory() = default;
+    void OnHotplug(const UsbHotplugMonitor::Event& ev);
+
+    mutable std::mutex                 m_;       // schützt Cache
+    std::vector<DaqDeviceDescriptor>   devices_;
+    bool                               loaded_ = false;
+    uint64_t                           generation_ = 0;
+
+    std::mutex                         enum_m_;  // serialisiert Enumerationen
+    std::mutex                         listen_m_;
+    std::map<int, Listener>            listeners_;
+    int                                next_listener_ = 1;
+
+    UsbHotplugMonitor                  monitor_;
+};
@@ -1,4 +1,9 @@
 #include "RedLabDAQ.hpp"
+#include "DaqInventory.hpp"
+#include "hw/RetryBackoff.hpp"
+#include "services/StageProfiler.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
 
 #include <sstream>
 #include <cstring>
@@ -13,16 +18,8 @@ static std::string UldaqStatusToString(ULSTATUS st) {
     return oss.str();
 }
 
-int RedLabDAQ::PickDeviceIndex(const Options& opt, std::string* err) {
-    const unsigned int MAX_DEVICES = 64;
-    DaqDeviceDescriptor descs[MAX_DEVICES];
-    unsigned int count = MAX_DEVICES;
-
-    ULSTATUS st = ulGetDaqDeviceInventory(ANY_IFC, descs, &count);
-    if (st != ERR_NO_ERROR) {
-        SetErr(err, "RedLab: ulGetDaqDeviceInventory fehlgeschlagen: " + UldaqStatusToString(st));
-        return -1;
-    }
+int RedLabDAQ::PickDeviceIndex(const std::vector<DaqDeviceDescriptor>& descs, const Options& opt, std::string* err) {
+    const unsigned int count = static_cast<unsigned int>(descs.size());
     if (count == 0) {
         SetErr(err, "RedLab: kein ULDAQ-Gerät gefunden");
         return -1;
@@ -74,70 +71,205 @@ int RedLabDAQ::PickDeviceIndex(const Options& opt, std::string* err) {
 
 // ---- Public API -------------------------------------------------------------
 
-bool RedLabDAQ::Connect(const Options& opt, std::string* err) {
-    std::scoped_lock lk(m_);
-
-    Disconnect(); // sicherstellen, dass wir „clean“ starten
-
-    int picked = PickDeviceIndex(opt, err);
-    if (picked < 0) return false;
+bool RedLabDAQ::OpenHandle(const Options& opt, DaqDeviceHandle* out, std::string* uid, std::string* err) {
+    auto& inv = DaqInventory::Instance();
+    std::vector<DaqDeviceDescriptor> descs;
+    if (!inv.Devices(&descs, nullptr, err)) return false;
+
+    int picked = PickDeviceIndex(descs, opt, nullptr);
+    if (picked < 0) {
+        // Cache evtl. älter als das Gerät: genau einmal neu einlesen
+        if (!inv.Refresh(err) || !inv.Devices(&descs, nullptr, err)) return false;
+        picked = PickDeviceIndex(descs, opt, err);
+        if (picked < 0) return false;
+    }
 
-    const unsigned int MAX_DEVICES = 64;
-    DaqDeviceDescriptor descs[MAX_DEVICES];
-    unsigned int count = MAX_DEVICES;
-    ULSTATUS st = ulGetDaqDeviceInventory(ANY_IFC, descs, &count);
+    DaqDeviceHandle h = ulCreateDaqDevice(descs[static_cast<size_t>(picked)]);
+    if (!h) {
+        SetErr(err, "RedLab: ulCreateDaqDevice gab null Handle zurück");
+        return false;
+    }
+    const ULSTATUS st = ulConnectDaqDevice(h);
     if (st != ERR_NO_ERROR) {
-        last_status_ = st;
-        last_error_  = "ulGetDaqDeviceInventory fehlgeschlagen";
-        SetErr(err, last_error_ + ": " + UldaqStatusToString(st));
+        ulReleaseDaqDevice(h);
+        SetErr(err, "RedLab: ulConnectDaqDevice fehlgeschlagen: " + UldaqStatusToString(st));
         return false;
     }
+    *out = h;
+    if (uid) *uid = descs[static_cast<size_t>(picked)].UniqueId;
+    return true;
+}
 
-    device_index_  = picked;
-    single_ended_  = opt.single_ended;
-    range_         = opt.range;
+bool RedLabDAQ::IsConnectionLoss(ULSTATUS st) {
+    return st == ERR_DEAD_DEV || st == ERR_DEV_NOT_CONNECTED || st == ERR_DEV_NOT_FOUND;
+}
 
-    // Gerät erzeugen + verbinden
-    handle_ = ulCreateDaqDevice(descs[device_index_]);
-    if (!handle_) {
-        last_status_ = ERR_BAD_HANDLE;
-        last_error_  = "ulCreateDaqDevice gab null Handle zurück";
-        SetErr(err, last_error_);
-        return false;
-    }
+bool RedLabDAQ::Connect(const Options& opt, std::string* err) {
+    Disconnect(); // sicherstellen, dass wir „clean“ starten (eigener Lock)
+
+    DaqDeviceHandle h = 0;
+    std::string uid, e;
+    const bool ok = OpenHandle(opt, &h, &uid, &e);
+
+    {
+        std::scoped_lock lk(m_);
+        opt_          = opt;
+        single_ended_ = opt.single_ended;
+        range_        = opt.range;
+        if (!ok) {
+            last_status_ = ERR_BAD_HANDLE;
+            last_error_  = e;
+            SetErr(err, e);
+            return false;
+        }
 
-    st = ulConnectDaqDevice(handle_);
-    if (st != ERR_NO_ERROR) {
-        last_status_ = st;
-        last_error_  = "ulConnectDaqDevice fehlgeschlagen";
-        ulReleaseDaqDevice(handle_);
-        handle_ = nullptr;
-        SetErr(err, last_error_ + ": " + UldaqStatusToString(st));
-        return false;
+        handle_      = h;
+        uid_         = uid;
+        connected_   = true;
+        lost_        = false;
+        last_status_ = ERR_NO_ERROR;
+        last_error_.clear();
     }
 
-    connected_ = true;
-    last_status_ = ERR_NO_ERROR;
-    last_error_.clear();
+    // außerhalb von m_: der Hot-Plug-Listener nimmt m_ selbst
+    if (opt.auto_reconnect) StartAutoReconnect();
     return true;
 }
 
 void RedLabDAQ::Disconnect() {
-    if (!connected_ && !handle_) return;
+    StopAutoReconnect();
 
     std::scoped_lock lk(m_);
     if (handle_) {
         // Reihenfolge: erst trennen, dann freigeben
         ulDisconnectDaqDevice(handle_);
         ulReleaseDaqDevice(handle_);
-        handle_ = nullptr;
+        handle_ = 0;
     }
     connected_ = false;
+    lost_      = false;
     // defensiv: Zustand zurücksetzen
     last_status_ = ERR_NO_ERROR;
     last_error_.clear();
 }
 
+// ---- Auto-Reconnect -------------------------------------------------------
+
+void RedLabDAQ::MarkLost() const {
+    connected_ = false;
+    if (!lost_.exchange(true)) {
+        Tracer::Instance().Instant("RedLab verloren");
+        std::scoped_lock lk(rc_m_);
+        rc_cv_.notify_all();
+    }
+}
+
+void RedLabDAQ::StartAutoReconnect() {
+    // Hot-Plug ist optional: ohne Netlink bleibt der Backoff-Takt
+    auto& inv = DaqInventory::Instance();
+    inv.StartHotplug(nullptr);
+
+    {
+        std::scoped_lock lk(rc_m_);
+        rc_stop_    = false;
+        rc_hotplug_ = false;
+    }
+    rc_listener_ = inv.AddListener([this](const UsbHotplugMonitor::Event& ev) {
+        if (ev.action == UsbHotplugMonitor::Event::Action::Add) {
+            std::scoped_lock lk(rc_m_);
+            rc_hotplug_ = true;
+            rc_cv_.notify_all();
+        } else if (ev.action == UsbHotplugMonitor::Event::Action::Remove && connected_) {
+            // Ist unser Gerät noch im (frisch eingelesenen) Verzeichnis?
+            std::vector<DaqDeviceDescriptor> descs;
+            if (!DaqInventory::Instance().Devices(&descs)) return;
+            std::string uid;
+            { std::scoped_lock lk(m_); uid = uid_; }
+            const bool present = std::any_of(descs.begin(), descs.end(),
+                [&](const DaqDeviceDescriptor& d) { return uid == d.UniqueId; });
+            if (!present) MarkLost();
+        }
+    });
+    rc_thread_ = std::thread([this] { ReconnectLoop(); });
+}
+
+void RedLabDAQ::StopAutoReconnect() {
+    if (rc_listener_) {
+        DaqInventory::Instance().RemoveListener(rc_listener_);
+        rc_listener_ = 0;
+    }
+    {
+        std::scoped_lock lk(rc_m_);
+        rc_stop_ = true;
+        rc_cv_.notify_all();
+    }
+    if (rc_thread_.joinable()) rc_thread_.join();
+}
+
+void RedLabDAQ::ReconnectLoop() {
+    Tracer::Instance().SetThreadName("redlab-reconnect");
+    Options opt;
+    { std::scoped_lock lk(m_); opt = opt_; }
+    sosesta::hw::RetryBackoff backoff(
+        sosesta::hw::RetryPolicy::From(opt.reconnect_retries, opt.reconnect_delay_s));
+
+    std::unique_lock lk(rc_m_);
+    while (!rc_stop_) {
+        if (!lost_) {
+            rc_cv_.wait(lk, [this] { return rc_stop_ || lost_.load(); });
+            continue;
+        }
+
+        // verloren: auf Hot-Plug oder Ablauf des Backoffs warten
+        const uint64_t now = sosesta::util::MonoNs();
+        if (!rc_hotplug_ && !backoff.ShouldAttempt(now)) {
+            rc_cv_.wait_for(lk, std::chrono::nanoseconds(backoff.NextAttemptNs() - now),
+                            [this] { return rc_stop_ || rc_hotplug_; });
+            continue;
+        }
+        rc_hotplug_ = false;
+        lk.unlock();
+
+        // Enumeration + Connect ohne m_: Read() scheitert solange sofort
+        DaqDeviceHandle h = 0;
+        std::string uid, e;
+        bool ok;
+        {
+            SOSESTA_TRACE_SCOPE("RedLab Reconnect");
+            ok = OpenHandle(opt, &h, &uid, &e);
+        }
+
+        DaqDeviceHandle old = 0;
+        {
+            std::scoped_lock dlk(m_);
+            if (ok) {
+                old          = handle_;
+                handle_      = h;
+                uid_         = uid;
+                last_status_ = ERR_NO_ERROR;
+                last_error_.clear();
+                connected_   = true;
+                lost_        = false;
+            } else {
+                last_error_ = "Reconnect: " + e;
+            }
+        }
+        if (ok) {
+            backoff.OnSuccess();
+            ++reconnects_;
+            Tracer::Instance().Instant("RedLab verbunden");
+        } else {
+            backoff.OnFailure(sosesta::util::MonoNs());
+        }
+        if (old) {
+            // altes Handle außerhalb des Locks abräumen (kann bei totem USB dauern)
+            ulDisconnectDaqDevice(old);
+            ulReleaseDaqDevice(old);
+        }
+        lk.lock();
+    }
+}
+
 bool RedLabDAQ::SetRange(Options::Range r, std::string* /*err*/) {
     std::scoped_lock lk(m_);
     range_ = r;
@@ -148,7 +280,7 @@ std::optional<double> RedLabDAQ::Read(int ch, std::string* err) const {
     std::scoped_lock lk(m_);
 
     if (!connected_ || !handle_) {
-        SetErr(err, "RedLab: nicht verbunden");
+        SetErr(err, lost_ ? "RedLab: Verbindung verloren, Reconnect läuft" : "RedLab: nicht verbunden");
         return std::nullopt;
     }
 
@@ -219,13 +351,18 @@ bool RedLabDAQ::UldaqReadSingle(int ch, double* out_volt, std::string* err) cons
     // Wir nutzen ulAIn (Single-Shot). Der Messbereich wird hier übergeben.
     const ::Range urange = ToUldaqRange(range_);
 
-    ULSTATUS st = ulAIn(handle_, ch, urange, out_volt);
+    ULSTATUS st;
+    {
+        ScopedStageTimer t(Stage::DaqRead, ch);
+        st = ulAIn(handle_, ch, urange, out_volt);
+    }
     if (st != ERR_NO_ERROR) {
         last_status_ = st;
         std::ostringstream oss;
         oss << "ulAIn fehlgeschlagen: ch=" << ch << " " << UldaqStatusToString(st);
         last_error_ = oss.str();
         SetErr(err, last_error_);
+        if (IsConnectionLoss(st)) MarkLost(); // Reconnect-Thread übernimmt
         return false;
     }
     last_status_ = ERR_NO_ERROR;
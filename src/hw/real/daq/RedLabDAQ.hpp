@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <string>
 #include <optional>
+#include <thread>
 #include <vector>
 #include <mutex>
 
@@ -14,6 +18,10 @@
  * - Standard-Messbereich: ±5 V  (BIP5VOLTS)
  * - Thread-safe via Mutex
  * - Saubere Fehlerrückgabe & Diagnose
+ * - Geräteliste aus DaqInventory (Cache statt Enumeration je Connect)
+ * - Auto-Reconnect: geht das Gerät verloren, scheitert Read() sofort; ein
+ *   Hintergrundthread verbindet neu (Hot-Plug oder Backoff) und tauscht das
+ *   Handle unter kurzem Lock aus – der Erfassungszyklus wartet nie auf USB
  */
 class RedLabDAQ {
 public:
@@ -24,18 +32,29 @@ public:
         enum class Range { Bip10V, Bip5V, Uni5V, Uni10V };
         Range range = Range::Bip5V;    // Standard = ±5 V
         bool single_ended = true;      // In deinem Projekt: immer true
+
+        // Auto-Reconnect (Werte wie ConfigHardware::RedLab)
+        bool   auto_reconnect    = true;
+        int    reconnect_retries = 3;      // Backoff verdoppelt sich höchstens so oft
+        double reconnect_delay_s = 0.5;
     };
 
     RedLabDAQ() = default;
     ~RedLabDAQ() { Disconnect(); }
 
-    // Verbindung herstellen (wählt Gerät per serial/product_name oder fallback auf device_index)
+    RedLabDAQ(const RedLabDAQ&) = delete;
+    RedLabDAQ& operator=(const RedLabDAQ&) = delete;
+
+    // Verbindung herstellen (wählt Gerät per serial/product_name oder fallback auf device_index);
+    // startet bei opt.auto_reconnect den Reconnect-Thread
     bool Connect(const Options& opt, std::string* err = nullptr);
 
-    // Verbindung trennen (idempotent)
+    // Verbindung trennen (idempotent), beendet auch den Reconnect-Thread
     void Disconnect();
 
-    bool IsConnected() const { return connected_; }
+    bool IsConnected() const { return connected_.load(); }
+    bool IsLost() const { return lost_.load(); }       // Reconnect läuft
+    uint64_t reconnects() const { return reconnects_.load(); }
 
     // Bereich setzen (wirken bei ulAIn als Parameter; SetRange speichert nur lokal)
     bool SetRange(Options::Range r, std::string* err = nullptr);
@@ -55,15 +74,28 @@ private:
     bool UldaqReadSingle(int ch, double* out_volt, std::string* err) const;
     static void SetErr(std::string* err, const std::string& msg) { if (err) *err = msg; }
 
-    // Gerät auswählen (über Inventory) – gibt Index im Inventory zurück oder -1 bei Fehler
-    static int PickDeviceIndex(const Options& opt, std::string* err);
+    // Gerät auswählen (aus der Geräteliste) – gibt Index zurück oder -1 bei Fehler
+    static int PickDeviceIndex(const std::vector<DaqDeviceDescriptor>& descs, const Options& opt, std::string* err);
+
+    // Gerät suchen, erzeugen und verbinden – ohne m_ (darf lange dauern)
+    static bool OpenHandle(const Options& opt, DaqDeviceHandle* out, std::string* uid, std::string* err);
+    static bool IsConnectionLoss(ULSTATUS st);
+
+    void StartAutoReconnect();
+    void StopAutoReconnect();
+    void ReconnectLoop();
+    void MarkLost() const;
 
 private:
     // ULDAQ
-    DaqDeviceHandle handle_ = nullptr;
+    DaqDeviceHandle handle_ = 0;
 
     // Zustand
-    bool connected_ = false;
+    mutable std::atomic<bool> connected_{false};
+    mutable std::atomic<bool> lost_{false};
+    std::atomic<uint64_t> reconnects_{0};
+    Options opt_;
+    std::string uid_;              // UniqueId des verbundenen Geräts
     Options::Range range_ = Options::Range::Bip5V;
     int device_index_ = 0;
     bool single_ended_ = true; // dein Setup
@@ -74,4 +106,12 @@ private:
 
     // Thread-Schutz
     mutable std::mutex m_;
+
+    // Reconnect-Thread
+    mutable std::mutex              rc_m_;
+    mutable std::condition_variable rc_cv_;
+    std::thread                     rc_thread_;
+    bool                            rc_stop_ = false;
+    bool                            rc_hotplug_ = false;  // Gerät angesteckt → sofort versuchen
+    int                             rc_listener_ = 0;
 };
@@ -0,0 +1,202 @@
+#include "RedLabGroup.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
+
+#include <algorithm>
+#include <future>
+#include <set>
+
+bool RedLabGroup::Connect(const std::vector<Device>& devices, std::string* err) {
+    Disconnect();
+
+    if (devices.empty()) {
+        if (err) *err = "RedLabGroup: keine Geräte konfiguriert";
+        return false;
+    }
+    if (devices.size() > 1) {
+        std::set<std::string> seen;
+        for (const auto& d : devices) {
+            if (d.opt.serial.empty()) {
+                if (err) *err = "RedLabGroup: bei mehreren Geräten ist die Seriennummer Pflicht";
+                return false;
+            }
+            if (!seen.insert(d.opt.serial).second) {
+                if (err) *err = "RedLabGroup: Seriennummer doppelt: " + d.opt.serial;
+                return false;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> ws;
+    int next = 0;
+    for (const auto& d : devices) {
+        const int max_ch = d.opt.single_ended ? 8 : 4;
+        if (d.channels < 1 || d.channels > max_ch) {
+            if (err) *err = "RedLabGroup: Kanalzahl außerhalb (1.." + std::to_string(max_ch) + "): " + d.opt.serial;
+            return false;
+        }
+        auto w = std::make_unique<Worker>();
+        w->opt          = d.opt;
+        w->first_global = next;
+        for (int c = 0; c < d.channels; ++c) w->local.push_back(c);
+        next += d.channels;
+        ws.push_back(std::move(w));
+    }
+
+    {
+        std::scoped_lock lk(m_);
+        stop_    = false;
+        pending_ = 0;
+        gen_     = 0;   // Worker starten mit seen = 0; alter Zähler gäbe einen Scan ohne Auftrag
+    }
+    workers_        = std::move(ws);
+    total_channels_ = next;
+    connected_      = 0;
+    const bool all = ConnectWorkers(err);
+    for (auto& w : workers_) {
+        Worker* p = w.get();
+        p->th = std::thread([this, p] { WorkerLoop(p); });
+    }
+    return all;
+}
+
+bool RedLabGroup::ConnectMissing(std::string* err) {
+    if (workers_.empty()) { if (err) *err = "RedLabGroup: keine Geräte konfiguriert"; return false; }
+    return Missing() == 0 || ConnectWorkers(err);
+}
+
+bool RedLabGroup::ConnectWorkers(std::string* err) {
+    // Verbinden parallel: Inventory ist gecacht, ulConnectDaqDevice je Gerät einige 10 ms
+    std::vector<std::future<std::string>> fut;
+    for (auto& w : workers_) {
+        if (w->open) continue;
+        Worker* p = w.get();
+        fut.push_back(std::async(std::launch::async, [p] {
+            std::string e;
+            p->open = p->daq.Connect(p->opt, &e);
+            return p->open ? std::string() : e;
+        }));
+    }
+    std::string first_err;
+    for (auto& f : fut) {
+        const std::string e = f.get();
+        if (!e.empty() && first_err.empty()) first_err = e;
+    }
+    connected_ = static_cast<int>(std::count_if(workers_.begin(), workers_.end(),
+                                                [](const auto& w) { return w->open; }));
+    if (!first_err.empty()) {
+        if (err) *err = first_err;
+        return false;
+    }
+    return true;
+}
+
+void RedLabGroup::Disconnect() {
+    {
+        std::scoped_lock lk(m_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& w : workers_) {
+        if (w->th.joinable()) w->th.join();
+        w->daq.Disconnect();
+    }
+    workers_.clear();
+    total_channels_ = 0;
+    connected_      = 0;
+}
+
+bool RedLabGroup::Map(int global_ch, int* device, int* local_ch) const {
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        const Worker& w = *workers_[i];
+        const int n = static_cast<int>(w.local.size());
+        if (global_ch >= w.first_global && global_ch < w.first_global + n) {
+            if (device)   *device   = static_cast<int>(i);
+            if (local_ch) *local_ch = global_ch - w.first_global;
+            return true;
+        }
+    }
+    return false;
+}
+
+const RedLabDAQ* RedLabGroup::DeviceAt(int idx) const {
+    if (idx < 0 || static_cast<size_t>(idx) >= workers_.size()) return nullptr;
+    return &workers_[static_cast<size_t>(idx)]->daq;
+}
+
+void RedLabGroup::WorkerLoop(Worker* w) {
+    Tracer::Instance().SetThreadName("redlab-group");
+    uint64_t seen = 0;   // Connect() setzt gen_ vor dem Start auf 0
+    std::unique_lock lk(m_);
+    for (;;) {
+        start_cv_.wait(lk, [&] { return stop_ || gen_ != seen; });
+        if (stop_) return;
+        seen = gen_;
+        lk.unlock();
+
+        {
+            SOSESTA_TRACE_SCOPE("RedLabGroup::Scan", w->first_global);
+            w->err.clear();
+            w->t0_ns = sosesta::util::MonoNs();
+            if (w->open) {
+                w->ok = w->daq.ReadMany(w->local, &w->vals, &w->err);
+            } else {
+                w->ok  = false;
+                w->err = "RedLabGroup: nicht verbunden: " + w->opt.serial;
+            }
+            w->t1_ns = sosesta::util::MonoNs();
+        }
+
+        lk.lock();
+        if (--pending_ == 0) done_cv_.notify_one();
+    }
+}
+
+bool RedLabGroup::ReadFrame(Frame* out, std::string* err) {
+    if (!out) { if (err) *err = "RedLabGroup: ReadFrame(out) ist null"; return false; }
+    if (connected_ == 0) { if (err) *err = "RedLabGroup: nicht verbunden"; return false; }
+
+    // alle Geräte gleichzeitig loslassen, auf das langsamste warten
+    {
+        std::unique_lock lk(m_);
+        pending_ = static_cast<int>(workers_.size());
+        ++gen_;
+        start_cv_.notify_all();
+        done_cv_.wait(lk, [&] { return pending_ == 0; });
+    }
+
+    out->volts.assign(static_cast<size_t>(total_channels_), 0.0);
+    out->valid.assign(static_cast<size_t>(total_channels_), false);
+
+    std::string errs;
+    uint64_t mid_min = UINT64_MAX, mid_max = 0;
+    long double mid_sum = 0.0L;
+    int ok_devices = 0;
+    for (const auto& w : workers_) {
+        if (!w->ok) {
+            if (!errs.empty()) errs += "; ";
+            errs += w->err;
+            continue;
+        }
+        for (size_t i = 0; i < w->vals.size(); ++i) {
+            const size_t g = static_cast<size_t>(w->first_global) + i;
+            out->volts[g] = w->vals[i];
+            out->valid[g] = true;
+        }
+        const uint64_t mid = w->t0_ns + (w->t1_ns - w->t0_ns) / 2;
+        mid_min = std::min(mid_min, mid);
+        mid_max = std::max(mid_max, mid);
+        mid_sum += mid;
+        ++ok_devices;
+    }
+
+    if (ok_devices > 0) {
+        out->t_ns    = static_cast<uint64_t>(mid_sum / ok_devices);
+        out->skew_ns = mid_max - mid_min;
+    } else {
+        out->t_ns = sosesta::util::MonoNs();
+        out->skew_ns = 0;
+    }
+    if (!errs.empty() && err) *err = errs;
+    return ok_devices > 0;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "RedLabDAQ.hpp"
+
+/**
+ * RedLabGroup – mehrere RedLab-Geräte als ein gemeinsamer Kanalraum
+ * - Geräte per Seriennummer; globale Kanäle werden der Reihe nach auf
+ *   (Gerät, lokaler Kanal) abgebildet (Gerät 0: 0..n0-1, Gerät 1: n0.. usw.)
+ * - Je Gerät ein fester Worker-Thread; ReadFrame() startet alle gleichzeitig
+ *   und wartet auf den langsamsten → Zykluszeit ≈ ein Gerät, nicht die Summe
+ * - Frame enthält Zeitstempel (Mittel der Scan-Mitten) und den Versatz
+ *   zwischen den Geräten als Maß für die Gleichzeitigkeit
+ * - Teilbetrieb: fehlt ein Gerät beim Verbinden, laufen die übrigen; seine
+ *   Kanäle bleiben !valid, bis ConnectMissing() es nachholt (danach
+ *   übernimmt der Auto-Reconnect von RedLabDAQ)
+ */
+class RedLabGroup {
+public:
+    struct Device {
+        RedLabDAQ::Options opt;        // opt.serial muss gesetzt sein (außer bei nur einem Gerät)
+        int                channels = 8;
+    };
+
+    struct Frame {
+        std::vector<double> volts;     // je globalem Kanal
+        std::vector<bool>   valid;     // false = Gerät hat diesen Zyklus nicht geliefert
+        uint64_t            t_ns    = 0; // Mittel der Scan-Mitten (MonoNs-Zeitbasis)
+        uint64_t            skew_ns = 0; // größter Abstand zwischen zwei Scan-Mitten
+    };
+
+    RedLabGroup() = default;
+    ~RedLabGroup() { Disconnect(); }
+
+    RedLabGroup(const RedLabGroup&) = delete;
+    RedLabGroup& operator=(const RedLabGroup&) = delete;
+
+    // Alle Geräte verbinden (parallel). true = alle verbunden; sonst Fehler
+    // in *err, erreichbare Geräte bleiben verbunden (IsConnected()). Bei
+    // ungültiger Konfiguration bleibt die Gruppe leer.
+    bool Connect(const std::vector<Device>& devices, std::string* err = nullptr);
+    void Disconnect();
+
+    // Fehlende Geräte erneut verbinden (nicht parallel zu ReadFrame);
+    // true = jetzt alle verbunden
+    bool ConnectMissing(std::string* err = nullptr);
+
+    bool IsConnected() const { return connected_ > 0; }   // mindestens ein Gerät
+    int  Missing() const { return static_cast<int>(workers_.size()) - connected_; }
+    int  ChannelCount() const { return total_channels_; }   // laut Konfiguration, auch fehlende
+
+    // Globalen Kanal auflösen (false bei ungültigem Kanal)
+    bool Map(int global_ch, int* device, int* local_ch) const;
+
+    // Ein Scan über alle Geräte. true, wenn mindestens ein Gerät geliefert hat;
+    // Fehler einzelner Geräte stehen in *err, deren Kanäle sind !valid.
+    bool ReadFrame(Frame* out, std::string* err = nullptr);
+
+    // Einzelgerät (Diagnose, Reconnect-Status)
+    const RedLabDAQ* DeviceAt(int idx) const;
+
+private:
+    struct Worker {
+        RedLabDAQ           daq;
+        RedLabDAQ::Options  opt;         // für ConnectMissing()
+        bool                open = false; // Connect gelungen (Verlust danach: Auto-Reconnect)
+        int                 first_global = 0;
+        std::vector<int>    local;       // 0..channels-1
+        std::vector<double> vals;
+        bool                ok = false;
+        std::string         err;
+        uint64_t            t0_ns = 0, t1_ns = 0;
+        std::thread         th;
+    };
+
+    void WorkerLoop(Worker* w);
+    // Worker ohne Verbindung parallel verbinden; erster Fehler nach *err
+    bool ConnectWorkers(std::string* err);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    int                                  total_channels_ = 0;
+    int                                  connected_ = 0;   // Worker mit open
+
+    std::mutex              m_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t                gen_ = 0;      // je ReadFrame +1
+    int                     pending_ = 0;
+    bool                    stop_ = false;
+};
@@ -0,0 +1,111 @@
+#include "UsbHotplugMonitor.hpp"
+#include "services/Tracer.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#if defined(__linux__)
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// ---- Parser ----------------------------------------------------------------
+
+bool UsbHotplugMonitor::ParseUevent(const char* buf, size_t len, Event* out) {
+    if (!buf || !out || len == 0) return false;
+
+    Event ev;
+    bool is_usb = false, is_device = false;
+
+    // Felder sind NUL-getrennt; das erste ist "action@devpath"
+    size_t pos = 0;
+    while (pos < len) {
+        const std::string_view f(buf + pos, strnlen(buf + pos, len - pos));
+        pos += f.size() + 1;
+
+        if      (f == "ACTION=add")           ev.action = Event::Action::Add;
+        else if (f == "ACTION=remove")        ev.action = Event::Action::Remove;
+        else if (f == "SUBSYSTEM=usb")        is_usb = true;
+        else if (f == "DEVTYPE=usb_device")   is_device = true;
+        else if (f.substr(0, 8) == "DEVPATH=") ev.devpath = std::string(f.substr(8));
+        else if (f.substr(0, 8) == "PRODUCT=") {
+            // PRODUCT=<vid>/<pid>/<bcd> (hex, ohne führende Nullen)
+            const std::string p(f.substr(8));
+            char* end = nullptr;
+            ev.vendor_id = static_cast<uint16_t>(std::strtoul(p.c_str(), &end, 16));
+            if (end && *end == '/') ev.product_id = static_cast<uint16_t>(std::strtoul(end + 1, nullptr, 16));
+        }
+    }
+    if (!is_usb || !is_device) return false;
+    *out = std::move(ev);
+    return true;
+}
+
+// ---- Thread ----------------------------------------------------------------
+
+#if defined(__linux__)
+
+bool UsbHotplugMonitor::Start(Callback cb, uint16_t vendor_filter, std::string* err) {
+    Stop();
+
+    fd_ = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (fd_ < 0) {
+        if (err) *err = std::string("Hotplug: socket(NETLINK_KOBJECT_UEVENT): ") + std::strerror(errno);
+        return false;
+    }
+
+    sockaddr_nl addr{};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_pid    = 0;   // Kernel vergibt
+    addr.nl_groups = 1;   // Kernel-Uevents (nicht die von udevd)
+    if (::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0) {
+        if (err) *err = std::string("Hotplug: bind: ") + std::strerror(errno);
+        ::close(fd_); fd_ = -1;
+        return false;
+    }
+
+    cb_            = std::move(cb);
+    vendor_filter_ = vendor_filter;
+    running_       = true;
+    thread_        = std::thread([this] { Run(); });
+    return true;
+}
+
+void UsbHotplugMonitor::Stop() {
+    running_ = false;
+    if (thread_.joinable()) thread_.join();
+    if (fd_ >= 0) { ::close(fd_); fd_ = -1; }
+}
+
+void UsbHotplugMonitor::Run() {
+    Tracer::Instance().SetThreadName("usb-hotplug");
+    char buf[8192];
+    while (running_) {
+        pollfd p{fd_, POLLIN, 0};
+        if (::poll(&p, 1, 250) <= 0) continue;   // Stop()-Flag regelmäßig prüfen
+        const ssize_t n = ::recv(fd_, buf, sizeof buf, 0);
+        if (n <= 0) continue;
+
+        Event ev;
+        if (!ParseUevent(buf, static_cast<size_t>(n), &ev)) continue;
+        if (ev.action == Event::Action::Other) continue;
+        // "remove" trägt PRODUCT ebenfalls; ohne Vendor-Angabe trotzdem melden
+        if (vendor_filter_ && ev.vendor_id && ev.vendor_id != vendor_filter_) continue;
+        if (cb_) cb_(ev);
+    }
+}
+
+#else // ── ohne Netlink ────────────────────────────────────────────────────
+
+bool UsbHotplugMonitor::Start(Callback, uint16_t, std::string* err) {
+    if (err) *err = "Hotplug: nur unter Linux verfügbar";
+    return false;
+}
+void UsbHotplugMonitor::Stop() {}
+void UsbHotplugMonitor::Run() {}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+/**
+ * UsbHotplugMonitor – lauscht auf Kernel-Uevents (NETLINK_KOBJECT_UEVENT)
+ * und meldet An-/Abstecken von USB-Geräten.
+ * - Kein libudev nötig; nur Linux, sonst liefert Start() false
+ * - Optionaler Filter auf Vendor-ID (z. B. 0x09DB = Measurement Computing)
+ * - Callback läuft im Monitor-Thread
+ */
+class UsbHotplugMonitor {
+public:
+    struct Event {
+        enum class Action { Add, Remove, Other };
+        Action      action = Action::Other;
+        std::string devpath;          // /devices/platform/...
+        uint16_t    vendor_id  = 0;
+        uint16_t    product_id = 0;
+    };
+    using Callback = std::function<void(const Event&)>;
+
+    UsbHotplugMonitor() = default;
+    ~UsbHotplugMonitor() { Stop(); }
+
+    UsbHotplugMonitor(const UsbHotplugMonitor&) = delete;
+    UsbHotplugMonitor& operator=(const UsbHotplugMonitor&) = delete;
+
+    // vendor_filter = 0 → alle USB-Geräte
+    bool Start(Callback cb, uint16_t vendor_filter = 0, std::string* err = nullptr);
+    void Stop();
+    bool IsRunning() const { return running_.load(); }
+
+    // Eine Kernel-Uevent-Nachricht ("add@/devices/...\0KEY=VAL\0...") zerlegen.
+    // Liefert true nur für USB-Geräte (SUBSYSTEM=usb, DEVTYPE=usb_device).
+    static bool ParseUevent(const char* buf, size_t len, Event* out);
+
+private:
+    void Run();
+
+    Callback          cb_;
+    uint16_t          vendor_filter_ = 0;
+    int               fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread       thread_;
+};
@@ -0,0 +1,228 @@
+// i2c/EmulatedI2CBus.cpp
+#include "EmulatedI2CBus.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// ── TCA9548A ──────────────────────────────────────────────
+
+bool EmuTCA9548A::onWrite(const uint8_t* data, size_t len, double){
+    if (len != 1) return false;      // Control-Register ist genau 1 Byte
+    control_ = data[0];
+    return true;
+}
+
+bool EmuTCA9548A::onRead(uint8_t* data, size_t len, double){
+    std::fill(data, data + len, control_);
+    return true;
+}
+
+void EmuTCA9548A::attach(int ch, uint8_t addr, EmuI2CDevice* dev){
+    if (ch < 0 || ch > 7) return;
+    down_[static_cast<size_t>(ch)][addr] = dev;
+}
+
+// ── INA219 ────────────────────────────────────────────────
+
+namespace {
+constexpr uint8_t REG_CONFIG=0x00, REG_SHUNT=0x01, REG_BUS=0x02, REG_POWER=0x03, REG_CURRENT=0x04, REG_CAL=0x05;
+constexpr uint16_t CONFIG_DEFAULT = 0x399F; // 32V, /8, 12 Bit, Shunt+Bus kontinuierlich
+constexpr double   SHUNT_LSB_V    = 10e-6;
+constexpr double   BUS_LSB_V      = 4e-3;
+}
+
+double EmuINA219::ConversionUs(unsigned f){
+    f &= 0xF;
+    if (!(f & 0x8)) {
+        static constexpr double T[4] = {84.0, 148.0, 276.0, 532.0};
+        return T[f & 0x3];
+    }
+    static constexpr double A[8] = {532.0, 1060.0, 2130.0, 4260.0, 8510.0, 17020.0, 34050.0, 68100.0};
+    return A[f & 0x7];
+}
+
+void EmuINA219::reset(){
+    regs_.fill(0);
+    regs_[REG_CONFIG] = CONFIG_DEFAULT;
+    pointer_ = 0;
+    cnvr_ = ovf_ = false;
+    conv_running_ = true;   // nach Power-On/Reset läuft kontinuierlicher Modus
+    conv_start_us_ = 0.0;
+}
+
+void EmuINA219::latchConversion(){
+    const uint16_t cfg  = regs_[REG_CONFIG];
+    const unsigned mode = cfg & 0x7;
+    const unsigned pg   = (cfg >> 11) & 0x3;
+    const bool     brng = (cfg >> 13) & 0x1;
+
+    // Shunt (mode Bit 0)
+    if (mode & 0x1) {
+        const double range_V = 0.04 * double(1u << pg);
+        const double v       = current_A_ * shunt_ohms_;
+        const double clip    = std::clamp(v, -range_V, range_V);
+        ovf_ = std::fabs(v) > range_V;
+        regs_[REG_SHUNT] = static_cast<uint16_t>(static_cast<int16_t>(std::lround(clip / SHUNT_LSB_V)));
+    }
+
+    // Bus (mode Bit 1), Register: Bits 15..3 Wert, Bit 1 CNVR, Bit 0 OVF
+    if (mode & 0x2) {
+        const double full  = brng ? 32.0 : 16.0;
+        const long   count = std::lround(std::clamp(bus_V_, 0.0, full) / BUS_LSB_V);
+        regs_[REG_BUS] = static_cast<uint16_t>(std::min<long>(count, 0x1FFF) << 3);
+    }
+
+    // Current/Power nur mit Kalibrierung (Datenblatt Gl. 4 und 5)
+    const uint16_t cal = regs_[REG_CAL];
+    if (cal) {
+        const long shunt = static_cast<int16_t>(regs_[REG_SHUNT]);
+        long cur = (shunt * long(cal)) / 4096;
+        if (cur > 32767 || cur < -32768) { ovf_ = true; cur = std::clamp(cur, -32768L, 32767L); }
+        regs_[REG_CURRENT] = static_cast<uint16_t>(static_cast<int16_t>(cur));
+        const long bus = regs_[REG_BUS] >> 3;
+        long pwr = (std::labs(cur) * bus) / 5000;
+        if (pwr > 0xFFFF) { ovf_ = true; pwr = 0xFFFF; }
+        regs_[REG_POWER] = static_cast<uint16_t>(pwr);
+    }
+    cnvr_ = true;
+}
+
+void EmuINA219::convertUntil(double now_us){
+    if (!conv_running_) return;
+    const uint16_t cfg  = regs_[REG_CONFIG];
+    const unsigned mode = cfg & 0x7;
+    if (mode == 0 || mode == 4) { conv_running_ = false; return; } // Power-Down / ADC aus
+
+    double t = 0.0;
+    if (mode & 0x1) t += ConversionUs((cfg >> 3) & 0xF);
+    if (mode & 0x2) t += ConversionUs((cfg >> 7) & 0xF);
+    if (now_us < conv_start_us_ + t) return;
+
+    latchConversion();
+    if (mode & 0x4) {
+        // kontinuierlich: nächste Konvertierung im Raster weiterführen
+        const double k = std::floor((now_us - conv_start_us_) / t);
+        conv_start_us_ += k * t;
+    } else {
+        conv_running_ = false; // getriggert: genau eine Konvertierung
+    }
+}
+
+bool EmuINA219::onWrite(const uint8_t* data, size_t len, double now_us){
+    if (len == 0 || data[0] > REG_CAL) return false;
+    convertUntil(now_us);
+    pointer_ = data[0];
+    if (len == 1) return true;   // nur Pointer setzen (vor Lesezugriff)
+    if (len != 3) return false;
+
+    const uint16_t val = uint16_t((uint16_t(data[1]) << 8) | data[2]);
+    if (pointer_ == REG_CONFIG) {
+        if (val & 0x8000) { reset(); conv_start_us_ = now_us; return true; }
+        regs_[REG_CONFIG] = val;
+        cnvr_ = false;               // Schreiben der Mode-Bits löscht CNVR
+        conv_running_  = true;       // neue Konvertierung (getriggert oder kontinuierlich)
+        conv_start_us_ = now_us;
+        return true;
+    }
+    if (pointer_ == REG_CAL) {
+        regs_[REG_CAL] = val & 0xFFFE; // FS0 ist immer 0
+        return true;
+    }
+    return false; // Messregister sind read-only
+}
+
+bool EmuINA219::onRead(uint8_t* data, size_t len, double now_us){
+    convertUntil(now_us);
+    uint16_t v = regs_[pointer_];
+    if (pointer_ == REG_BUS) v = uint16_t((v & 0xFFF8) | (cnvr_ ? 0x2 : 0) | (ovf_ ? 0x1 : 0));
+    if (pointer_ == REG_POWER) cnvr_ = false; // Lesen von Power löscht CNVR
+    for (size_t i = 0; i < len; ++i) data[i] = (i % 2 == 0) ? uint8_t(v >> 8) : uint8_t(v & 0xFF);
+    return true;
+}
+
+// ── Bus ───────────────────────────────────────────────────
+
+EmulatedI2CBus::EmulatedI2CBus(EmuBusTiming timing) : timing_(timing) {
+    wall_t0_us_ = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void EmulatedI2CBus::attach(uint8_t addr, EmuI2CDevice* dev){ devices_[addr] = dev; }
+
+void EmulatedI2CBus::attachMux(uint8_t addr, EmuTCA9548A* mux){
+    devices_[addr] = mux;
+    muxes_.push_back(mux);
+}
+
+double EmulatedI2CBus::nowUs() const {
+    if (timing_.time_base == EmuBusTiming::TimeBase::Virtual) return virt_us_;
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now().time_since_epoch()).count() - wall_t0_us_;
+}
+
+bool EmulatedI2CBus::fail(const std::string& msg, std::string* err){
+    ++stats_.errors;
+    if (err) *err = msg;
+    return false;
+}
+
+void EmulatedI2CBus::spend(size_t payload_bytes){
+    // START + (Adresse + Daten) * 9 Takte (inkl. ACK) + STOP
+    const double bits = 2.0 + 9.0 * double(1 + payload_bytes);
+    const double us   = bits * 1e6 / timing_.clock_hz + timing_.per_call_us;
+    stats_.bus_time_us += us;
+    virt_us_ += us;
+    if (timing_.spin) {
+        const auto end = std::chrono::steady_clock::now() + std::chrono::nanoseconds(static_cast<long long>(us * 1000.0));
+        while (std::chrono::steady_clock::now() < end) { /* spin */ }
+    }
+}
+
+EmuI2CDevice* EmulatedI2CBus::route(std::string* err){
+    if (slave_ < 0) { fail("I2C: no slave address set", err); return nullptr; }
+    const uint8_t addr = uint8_t(slave_);
+    if (auto it = devices_.find(addr); it != devices_.end()) return it->second;
+
+    // hinter aktiven MUX-Kanälen suchen; mehrere Treffer = Adresskollision
+    EmuI2CDevice* hit = nullptr;
+    int hits = 0;
+    for (auto* mux : muxes_) {
+        for (int ch = 0; ch < 8; ++ch) {
+            if (!(mux->control() & (1u << ch))) continue;
+            const auto& d = mux->downstream(ch);
+            if (auto it = d.find(addr); it != d.end()) { hit = it->second; ++hits; }
+        }
+    }
+    if (hits > 1) { fail("I2C: address collision behind mux", err); return nullptr; }
+    if (!hit)     { fail("I2C: NACK (Remote I/O error)", err); return nullptr; }
+    return hit;
+}
+
+bool EmulatedI2CBus::setSlave(uint8_t addr, std::string* err){
+    if (slave_ == addr) return true;  // wie I2CBus: kein erneutes ioctl
+    ++stats_.syscalls;
+    if (addr > 0x7F) { slave_ = -1; return fail("ioctl(I2C_SLAVE):Invalid argument", err); }
+    ++stats_.slave_switches;
+    slave_ = addr;
+    return true;
+}
+
+bool EmulatedI2CBus::writeBytes(const uint8_t* d, size_t n, std::string* err){
+    ++stats_.syscalls; ++stats_.transactions;
+    EmuI2CDevice* dev = route(err);
+    if (!dev) { spend(0); return false; }
+    spend(n);
+    if (!dev->onWrite(d, n, nowUs())) return fail("write:Remote I/O error", err);
+    stats_.bytes_written += n;
+    return true;
+}
+
+bool EmulatedI2CBus::readBytes(uint8_t* d, size_t n, std::string* err){
+    ++stats_.syscalls; ++stats_.transactions;
+    EmuI2CDevice* dev = route(err);
+    if (!dev) { spend(0); return false; }
+    spend(n);
+    if (!dev->onRead(d, n, nowUs())) return fail("read:Remote I/O error", err);
+    stats_.bytes_read += n;
+    return true;
+}
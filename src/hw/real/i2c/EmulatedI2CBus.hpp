@@ -0,0 +1,117 @@
+// i2c/EmulatedI2CBus.hpp
+#pragma once
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "II2CBus.hpp"
+
+/**
+ * In-Prozess-Emulation von I2C-Bus, TCA9548A und INA219.
+ *
+ * Damit laufen die echten Treiber (TCA9548A, INA219, MuxedIna219) ohne
+ * /dev/i2c-* auf jedem Linux-Rechner; Syscall-/Transaktionszähler und
+ * modellierte Drahtzeit stehen über stats() zur Verfügung.
+ *
+ * Zeitbasis ist standardmäßig virtuell: jede Transaktion schiebt die Uhr um
+ * ihre Drahtzeit weiter (deterministisch). Mit TimeBase::Wall zählt die
+ * echte steady_clock, mit spin=true wird die Drahtzeit zusätzlich aktiv
+ * abgewartet.
+ */
+
+// Basisklasse für emulierte Slaves; now_us = Zeitbasis des Busses
+class EmuI2CDevice {
+public:
+    virtual ~EmuI2CDevice() = default;
+    // false = NACK
+    virtual bool onWrite(const uint8_t* data, size_t len, double now_us) = 0;
+    virtual bool onRead(uint8_t* data, size_t len, double now_us) = 0;
+};
+
+// TCA9548A: ein Control-Register, Bit i = Downstream-Kanal i aktiv
+class EmuTCA9548A : public EmuI2CDevice {
+public:
+    bool onWrite(const uint8_t* data, size_t len, double now_us) override;
+    bool onRead(uint8_t* data, size_t len, double now_us) override;
+
+    // Gerät hinter Kanal ch (0..7) anhängen (nicht besitzend)
+    void attach(int ch, uint8_t addr, EmuI2CDevice* dev);
+
+    uint8_t control() const { return control_; }
+    const std::map<uint8_t, EmuI2CDevice*>& downstream(int ch) const { return down_[static_cast<size_t>(ch)]; }
+
+private:
+    uint8_t control_ = 0x00; // Power-On: alle Kanäle aus
+    std::array<std::map<uint8_t, EmuI2CDevice*>, 8> down_{};
+};
+
+// INA219: Registermodell inkl. Kalibrierung, PGA-Überlauf, CNVR/OVF und Konvertierungszeit
+class EmuINA219 : public EmuI2CDevice {
+public:
+    explicit EmuINA219(double shunt_ohms = 0.1) : shunt_ohms_(shunt_ohms) { reset(); }
+
+    bool onWrite(const uint8_t* data, size_t len, double now_us) override;
+    bool onRead(uint8_t* data, size_t len, double now_us) override;
+
+    // Physikalischer Zustand am Messobjekt (wirkt ab der nächsten Konvertierung)
+    void setLoad(double bus_V, double current_A) { bus_V_ = bus_V; current_A_ = current_A; }
+
+    uint16_t reg(uint8_t r) const { return r < regs_.size() ? regs_[r] : 0; }
+
+    // Konvertierungszeit eines ADC-Feldes (BADC/SADC, 4 Bit) laut Datenblatt
+    static double ConversionUs(unsigned adc_field);
+
+private:
+    void reset();
+    void convertUntil(double now_us);
+    void latchConversion();
+
+    double shunt_ohms_;
+    double bus_V_ = 0.0, current_A_ = 0.0;
+
+    std::array<uint16_t, 6> regs_{};   // 0 Config .. 5 Calibration
+    uint8_t pointer_ = 0;
+    bool    cnvr_ = false, ovf_ = false;
+    double  conv_start_us_ = 0.0;      // Beginn der laufenden Konvertierung
+    bool    conv_running_  = false;
+};
+
+struct EmuBusTiming {
+    enum class TimeBase { Virtual, Wall };
+    double   clock_hz        = 100000.0; // 100 kHz Standard, 400 kHz Fast-Mode
+    double   per_call_us     = 0.0;      // Zusatz je Syscall (Kernel/Treiber-Overhead)
+    TimeBase time_base       = TimeBase::Virtual;
+    bool     spin            = false;    // Drahtzeit real abwarten
+};
+
+class EmulatedI2CBus : public II2CBus {
+public:
+    explicit EmulatedI2CBus(EmuBusTiming timing = {});
+
+    // Gerät direkt am Bus (z. B. TCA9548A @0x70) anhängen (nicht besitzend)
+    void attach(uint8_t addr, EmuI2CDevice* dev);
+    // Multiplexer am Bus anhängen; dessen Downstream-Geräte werden mit geroutet
+    void attachMux(uint8_t addr, EmuTCA9548A* mux);
+
+    bool setSlave(uint8_t addr, std::string* err=nullptr) override;
+    bool writeBytes(const uint8_t* data, size_t len, std::string* err=nullptr) override;
+    bool readBytes(uint8_t* data, size_t len, std::string* err=nullptr) override;
+
+    // Virtuelle Zeit vorspulen (z. B. Wartezeit zwischen Zyklen)
+    void advanceUs(double us) { virt_us_ += us; }
+    double nowUs() const;
+
+private:
+    EmuI2CDevice* route(std::string* err);
+    void spend(size_t payload_bytes);
+    bool fail(const std::string& msg, std::string* err);
+
+    EmuBusTiming timing_;
+    double       virt_us_ = 0.0;
+    double       wall_t0_us_ = 0.0;
+    int          slave_ = -1;
+
+    std::map<uint8_t, EmuI2CDevice*> devices_;
+    std::vector<EmuTCA9548A*>        muxes_;
+};
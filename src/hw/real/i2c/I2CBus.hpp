@@ -3,27 +3,26 @@
 #include <string>
 #include <cstdint>
 #include <vector>
+#include "II2CBus.hpp"
 
-class I2CBus {
+// Linux-Implementierung über /dev/i2c-*
+class I2CBus : public II2CBus {
 public:
     I2CBus() = default;
-    ~I2CBus();
+    ~I2CBus() override;
 
     bool openDev(const std::string& dev, std::string* err=nullptr);
     void closeDev();
 
-    bool setSlave(uint8_t addr, std::string* err=nullptr);
+    // Merkt sich die aktive Adresse: wiederholte Aufrufe kosten kein ioctl
+    bool setSlave(uint8_t addr, std::string* err=nullptr) override;
 
     // simple primitives
-    bool writeBytes(const uint8_t* data, size_t len, std::string* err=nullptr);
-    bool readBytes(uint8_t* data, size_t len, std::string* err=nullptr);
-
-    // helper: write register, read 16-bit big-endian
-    bool writeReg(uint8_t reg, std::string* err=nullptr);
-    bool readReg16BE(uint8_t reg, uint16_t* out, std::string* err=nullptr);
-    bool writeReg16BE(uint8_t reg, uint16_t val, std::string* err=nullptr);
+    bool writeBytes(const uint8_t* data, size_t len, std::string* err=nullptr) override;
+    bool readBytes(uint8_t* data, size_t len, std::string* err=nullptr) override;
 
 private:
     int fd_ = -1;
+    int slave_ = -1; // zuletzt per ioctl gesetzte Adresse
     std::string path_;
 };
@@ -0,0 +1,19 @@
+// i2c/II2CBus.cpp
+#include "II2CBus.hpp"
+
+bool II2CBus::writeReg(uint8_t reg, std::string* err){
+    return writeBytes(&reg, 1, err);
+}
+
+bool II2CBus::readReg16BE(uint8_t reg, uint16_t* out, std::string* err){
+    if(!writeReg(reg, err)) return false;
+    uint8_t b[2];
+    if(!readBytes(b,2,err)) return false;
+    *out = (uint16_t(b[0])<<8)|b[1];
+    return true;
+}
+
+bool II2CBus::writeReg16BE(uint8_t reg, uint16_t val, std::string* err){
+    uint8_t b[3] = {reg, uint8_t(val>>8), uint8_t(val&0xFF)};
+    return writeBytes(b,3,err);
+}
@@ -0,0 +1,40 @@
+// i2c/II2CBus.hpp
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Zähler pro Bus; Linux-Bus und Emulator zählen identisch, damit sich
+// Treiberpfade (INA219, TCA9548A, MuxedIna219) ohne Hardware vergleichen lassen.
+struct I2CBusStats {
+    uint64_t syscalls       = 0;   // open/ioctl/read/write (bzw. deren Äquivalent)
+    uint64_t transactions   = 0;   // I2C-Frames auf dem Draht (START..STOP)
+    uint64_t bytes_written  = 0;
+    uint64_t bytes_read     = 0;
+    uint64_t slave_switches = 0;   // echte I2C_SLAVE-Wechsel
+    uint64_t errors         = 0;
+    double   bus_time_us    = 0.0; // nur Emulator: modellierte Drahtzeit
+};
+
+// Abstrakter I2C-Bus. Primitive sind virtuell, die Register-Helfer bauen darauf auf.
+class II2CBus {
+public:
+    virtual ~II2CBus() = default;
+
+    virtual bool setSlave(uint8_t addr, std::string* err=nullptr) = 0;
+
+    // simple primitives
+    virtual bool writeBytes(const uint8_t* data, size_t len, std::string* err=nullptr) = 0;
+    virtual bool readBytes(uint8_t* data, size_t len, std::string* err=nullptr) = 0;
+
+    // helper: write register, read 16-bit big-endian
+    bool writeReg(uint8_t reg, std::string* err=nullptr);
+    bool readReg16BE(uint8_t reg, uint16_t* out, std::string* err=nullptr);
+    bool writeReg16BE(uint8_t reg, uint16_t val, std::string* err=nullptr);
+
+    const I2CBusStats& stats() const { return stats_; }
+    void resetStats() { stats_ = {}; }
+
+protected:
+    I2CBusStats stats_;
+};
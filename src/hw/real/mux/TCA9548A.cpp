@@ -1,8 +1,8 @@
 // hw/mux/TCA9548A.cpp
 #include "TCA9548A.hpp"
-#include "i2c/I2CBus.hpp"
+#include "i2c/II2CBus.hpp"
 
-bool TCA9548A::init(I2CBus* bus, uint8_t addr, std::string* err){
+bool TCA9548A::init(II2CBus* bus, uint8_t addr, std::string* err){
     bus_ = bus; addr_ = addr; last_mask_ = 0;
     if(!bus_){ if(err)*err="TCA9548A: null bus"; return false; }
     if(!bus_->setSlave(addr_, err)) return false;
@@ -0,0 +1,144 @@
+// hw/ina/Ina219Calibration.hpp
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Register/Bitfelder laut Datenblatt (SBOS448)
+enum InaRange { RANGE_16V=0, RANGE_32V=1 };
+enum InaGain  { GAIN_1_40MV=0, GAIN_2_80MV, GAIN_4_160MV, GAIN_8_320MV };
+enum InaAdc   { ADC_9BIT=0, ADC_10BIT, ADC_11BIT, ADC_12BIT=3,
+                ADC_2SAMP=9, ADC_4SAMP, ADC_8SAMP, ADC_16SAMP, ADC_32SAMP, ADC_64SAMP, ADC_128SAMP };
+
+namespace ina219 {
+
+inline constexpr uint8_t  REG_CONFIG=0x00, REG_SHUNT=0x01, REG_BUS=0x02, REG_POWER=0x03, REG_CURRENT=0x04, REG_CAL=0x05;
+inline constexpr uint16_t CONFIG_RESET = 1u << 15;
+inline constexpr uint16_t MODE_CONT_SH_BUS = 7;
+inline constexpr int      BRNG=13, PG0=11, BADC1=7, SADC1=3;
+inline constexpr double   CAL_FACTOR = 0.04096;
+inline constexpr uint16_t MAX_CAL    = 0xFFFE; // Bit 0 ist fest 0
+
+// Vollausschlag der Shunt-Spannung je PGA-Stufe
+constexpr double GainVolts(InaGain g) {
+    switch (g) {
+        case GAIN_1_40MV:  return 0.04;
+        case GAIN_2_80MV:  return 0.08;
+        case GAIN_4_160MV: return 0.16;
+        case GAIN_8_320MV: return 0.32;
+    }
+    return 0.0;
+}
+
+constexpr bool ValidAdc(InaAdc a) {
+    return (a >= ADC_9BIT && a <= ADC_12BIT) || (a >= ADC_2SAMP && a <= ADC_128SAMP);
+}
+
+} // namespace ina219
+
+// Fertig berechnete Kalibrierung: Registerwerte + LSBs für die Umrechnung.
+// error != nullptr → Kombination ungültig, Registerwerte unbrauchbar.
+// warning != nullptr → Eingabe begrenzt (wie früher zur Laufzeit), Werte brauchbar.
+struct Ina219Calibration {
+    uint16_t    cal    = 0;          // REG_CAL
+    uint16_t    config = 0;          // REG_CONFIG (kontinuierlich Shunt+Bus)
+    float       current_lsb_A = 0.f;
+    float       power_lsb_W   = 0.f;
+    float       shunt_ohms    = 0.f;
+    const char* error   = nullptr;
+    const char* warning = nullptr;
+
+    constexpr bool ok() const { return error == nullptr; }
+};
+
+// Gleiche Rechnung wie bisher zur Laufzeit (current_lsb = I_max / 32770,
+// untere Schranke durch MAX_CAL), jetzt constexpr und mit Prüfung. Ein
+// Maximalstrom über dem PGA-Bereich wird wie bisher auf diesen begrenzt
+// (warning), nur unbrauchbare Eingaben sind ein Fehler.
+constexpr Ina219Calibration Ina219Calibrate(double shunt_ohms, double max_expected_A,
+                                            InaRange vr, InaGain gain,
+                                            InaAdc bus_adc = ADC_12BIT, InaAdc shunt_adc = ADC_12BIT)
+{
+    using namespace ina219;
+    Ina219Calibration c;
+    c.shunt_ohms = static_cast<float>(shunt_ohms);
+
+    if (!(shunt_ohms > 0.0))     { c.error = "INA219: Shunt muss > 0 Ohm sein"; return c; }
+    if (!(max_expected_A > 0.0)) { c.error = "INA219: Maximalstrom muss > 0 A sein"; return c; }
+    if (vr != RANGE_16V && vr != RANGE_32V) { c.error = "INA219: ungültiger Busbereich"; return c; }
+    if (GainVolts(gain) == 0.0)  { c.error = "INA219: ungültige PGA-Stufe"; return c; }
+    if (!ValidAdc(bus_adc) || !ValidAdc(shunt_adc)) { c.error = "INA219: ungültige ADC-Einstellung"; return c; }
+
+    // Maximalstrom muss in den Shunt-Bereich der PGA-Stufe passen (Rundung: 1 ppm Toleranz)
+    const double max_possible_A = GainVolts(gain) / shunt_ohms;
+    double max_A = max_expected_A;
+    if (max_A > max_possible_A * (1.0 + 1e-6)) {
+        c.warning = "INA219: Maximalstrom übersteigt PGA-Bereich, auf diesen begrenzt";
+        max_A = max_possible_A;
+    }
+
+    double lsb = max_A / 32770.0;
+    const double min_lsb = CAL_FACTOR / (shunt_ohms * MAX_CAL);
+    if (lsb < min_lsb) lsb = min_lsb;
+
+    const double cal = CAL_FACTOR / (lsb * shunt_ohms);
+    if (cal < 1.0 || cal > MAX_CAL) { c.error = "INA219: Kalibrierwert außerhalb 1..0xFFFE"; return c; }
+
+    c.cal           = static_cast<uint16_t>(static_cast<uint16_t>(cal) & 0xFFFE);
+    c.current_lsb_A = static_cast<float>(lsb);
+    c.power_lsb_W   = static_cast<float>(lsb * 20.0);
+    c.config        = static_cast<uint16_t>((vr << BRNG) | (gain << PG0) | (bus_adc << BADC1)
+                                            | (shunt_adc << SADC1) | MODE_CONT_SH_BUS);
+    return c;
+}
+
+// Compile-Zeit-Variante: ungültige oder begrenzte Kombinationen brechen den
+// Build ab (Profile sollen genau das liefern, was im Namen steht).
+consteval Ina219Calibration Ina219CalibrateCT(double shunt_ohms, double max_expected_A,
+                                              InaRange vr, InaGain gain,
+                                              InaAdc bus_adc = ADC_12BIT, InaAdc shunt_adc = ADC_12BIT)
+{
+    const Ina219Calibration c = Ina219Calibrate(shunt_ohms, max_expected_A, vr, gain, bus_adc, shunt_adc);
+    if (!c.ok()) throw c.error;        // in consteval: Compile-Fehler mit Meldung im Diagnosetext
+    if (c.warning) throw c.warning;
+    return c;
+}
+
+// ── Standardprofile (ConfigHardware::INA219::calibration) ─────────────────
+struct Ina219Profile {
+    std::string_view  name;
+    Ina219Calibration cal;
+};
+
+inline constexpr std::array<Ina219Profile, 3> kIna219Profiles{{
+    { "32V_2A",    Ina219CalibrateCT(0.1, 2.0, RANGE_32V, GAIN_8_320MV) },
+    { "32V_1A",    Ina219CalibrateCT(0.1, 1.0, RANGE_32V, GAIN_8_320MV) },
+    { "16V_400mA", Ina219CalibrateCT(0.1, 0.4, RANGE_16V, GAIN_1_40MV)  },
+}};
+
+constexpr const Ina219Calibration* FindIna219Profile(std::string_view name) {
+    for (const auto& p : kIna219Profiles)
+        if (p.name == name) return &p.cal;
+    return nullptr;
+}
+
+static_assert(FindIna219Profile("16V_400mA") != nullptr, "Default-Profil fehlt");
+static_assert(FindIna219Profile("32V_2A")->config == 0x399F, "32V_2A: Config-Register");
+static_assert(Ina219Calibrate(0.1, 5.0, RANGE_32V, GAIN_8_320MV).cal
+              == Ina219Calibrate(0.1, 3.2, RANGE_32V, GAIN_8_320MV).cal,
+              "Maximalstrom über PGA-Bereich wird auf diesen begrenzt");
+
+// ── Startsequenz als Registertabelle ──────────────────────────────────────
+struct Ina219RegWrite {
+    uint8_t  reg;
+    uint16_t val;
+};
+
+// Reset → Kalibrierung → Konfiguration; für viele Geräte einfach je Adresse abspielen
+constexpr std::array<Ina219RegWrite, 3> Ina219StartupSequence(const Ina219Calibration& c) {
+    return {{
+        { ina219::REG_CONFIG, ina219::CONFIG_RESET },
+        { ina219::REG_CAL,    c.cal },
+        { ina219::REG_CONFIG, c.config },
+    }};
+}
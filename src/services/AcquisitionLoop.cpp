@@ -0,0 +1,109 @@
+#include "services/AcquisitionLoop.hpp"
+#include "services/Metrics.hpp"
+#include "services/StageProfiler.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#endif
+
+void AcquisitionLoop::SleepUntilNs(std::uint64_t deadline_ns) {
+#if defined(__linux__)
+    // MonoNs() = steady_clock = CLOCK_MONOTONIC unter Linux
+    timespec ts;
+    ts.tv_sec  = static_cast<time_t>(deadline_ns / 1'000'000'000ull);
+    ts.tv_nsec = static_cast<long>(deadline_ns % 1'000'000'000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+#else
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+        std::chrono::nanoseconds(deadline_ns)));
+#endif
+}
+
+void AcquisitionLoop::ApplyThreadOptions(std::thread& t, const Options& opt, std::string& warn) {
+    auto note = [&warn](const std::string& s) { if (!warn.empty()) warn += "; "; warn += s; };
+
+#if defined(__linux__)
+    if (opt.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        note(std::string("mlockall: ") + std::strerror(errno));
+    if (opt.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(opt.cpu, &set);
+        if (const int rc = pthread_setaffinity_np(t.native_handle(), sizeof set, &set))
+            note("CPU-Affinität " + std::to_string(opt.cpu) + ": " + std::strerror(rc));
+    }
+    if (opt.rt_priority > 0) {
+        sched_param sp{};
+        sp.sched_priority = opt.rt_priority;
+        if (const int rc = pthread_setschedparam(t.native_handle(), SCHED_FIFO, &sp))
+            note("SCHED_FIFO " + std::to_string(opt.rt_priority) + ": " + std::strerror(rc));
+    }
+#else
+    (void)t;
+    if (opt.lock_memory) note("mlockall nur unter Linux");
+    if (opt.cpu >= 0 || opt.rt_priority > 0) note("Echtzeit-Optionen nur unter Linux");
+#endif
+}
+
+bool AcquisitionLoop::Start(const Options& opt, Body body, std::string* warn, std::string* err) {
+    Stop();
+    if (opt.period_ns == 0) { if (err) *err = "Erfassungsperiode 0"; return false; }
+    if (!body)              { if (err) *err = "Erfassung ohne Zyklusfunktion"; return false; }
+
+    opt_  = opt;
+    body_ = std::move(body);
+    stats_.cycles = 0; stats_.overruns = 0; stats_.skipped_periods = 0; stats_.max_late_ns = 0;
+
+    running_ = true;
+    thread_ = std::thread([this] { Run(); });
+
+    std::string w;
+    ApplyThreadOptions(thread_, opt_, w);
+    if (warn) *warn = w;
+    return true;
+}
+
+void AcquisitionLoop::Stop() {
+    running_ = false;
+    if (thread_.joinable()) thread_.join();
+}
+
+void AcquisitionLoop::Run() {
+    Tracer::Instance().SetThreadName("acq");
+    const std::uint64_t period = opt_.period_ns;
+    std::uint64_t deadline = sosesta::util::MonoNs() + period;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        SleepUntilNs(deadline);
+        if (!running_.load(std::memory_order_relaxed)) break;
+
+        const std::uint64_t woke = sosesta::util::MonoNs();
+        const std::uint64_t late = woke > deadline ? woke - deadline : 0;
+        auto& prof = StageProfiler::Instance();
+        if (prof.Enabled()) prof.Record(Stage::Wakeup, -1, late);
+        if (late > stats_.max_late_ns.load(std::memory_order_relaxed))
+            stats_.max_late_ns.store(late, std::memory_order_relaxed);
+
+        body_(deadline);
+        stats_.cycles.fetch_add(1, std::memory_order_relaxed);
+
+        // nächster Rasterpunkt; verpasste überspringen statt nachholen
+        deadline += period;
+        const std::uint64_t now = sosesta::util::MonoNs();
+        if (now >= deadline) {
+            const std::uint64_t skip = (now - deadline) / period + 1;
+            deadline += skip * period;
+            stats_.overruns.fetch_add(1, std::memory_order_relaxed);
+            stats_.skipped_periods.fetch_add(skip, std::memory_order_relaxed);
+            Metrics::Instance().OnSkippedPeriods(skip);
+        }
+    }
+}
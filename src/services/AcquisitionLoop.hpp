@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+/**
+ * Erfassungsthread mit festem Takt auf absoluten Deadlines.
+ *
+ * Der Thread schläft per clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)
+ * bis zur nächsten Deadline; die Deadlines liegen auf einem festen Raster
+ * (t0 + k·Periode), daher summiert sich kein Fehler auf. Dauert ein Zyklus
+ * länger als eine Periode, werden die verpassten Rasterpunkte übersprungen
+ * statt nachgeholt – der Takt bleibt phasentreu.
+ *
+ * Die Verspätung jedes Aufwachens landet als Stage::Wakeup im
+ * StageProfiler (Jitter-Histogramm), Überläufe in Stats() und Metrics.
+ *
+ * Optional (Linux, dedizierter Pi-Kern): SCHED_FIFO, CPU-Affinität,
+ * mlockall. Fehlende Rechte sind kein Abbruchgrund; Start() liefert dann
+ * true und beschreibt die nicht gesetzten Optionen in *warn.
+ */
+class AcquisitionLoop {
+public:
+    struct Options {
+        std::uint64_t period_ns   = 50'000'000; // 50 ms
+        int           rt_priority = 0;          // 1..99 → SCHED_FIFO, 0 = normal
+        int           cpu         = -1;         // ≥ 0 → an diesen Kern binden
+        bool          lock_memory = false;      // mlockall(MCL_CURRENT|MCL_FUTURE)
+    };
+
+    struct Stats {
+        std::atomic<std::uint64_t> cycles{0};
+        std::atomic<std::uint64_t> overruns{0};        // Zyklen länger als eine Periode
+        std::atomic<std::uint64_t> skipped_periods{0}; // dadurch ausgelassene Rasterpunkte
+        std::atomic<std::uint64_t> max_late_ns{0};     // größte Weck-Verspätung
+    };
+
+    // deadline_ns = Soll-Zeitpunkt dieses Zyklus (MonoNs-Zeitbasis)
+    using Body = std::function<void(std::uint64_t deadline_ns)>;
+
+    AcquisitionLoop() = default;
+    ~AcquisitionLoop() { Stop(); }
+
+    AcquisitionLoop(const AcquisitionLoop&) = delete;
+    AcquisitionLoop& operator=(const AcquisitionLoop&) = delete;
+
+    bool Start(const Options& opt, Body body, std::string* warn = nullptr, std::string* err = nullptr);
+    void Stop();   // wartet höchstens eine Periode
+
+    bool IsRunning() const { return running_.load(); }
+    const Options& Opts() const { return opt_; }
+    const Stats& GetStats() const { return stats_; }
+
+    // Schläft bis zum absoluten Zeitpunkt (MonoNs-Zeitbasis)
+    static void SleepUntilNs(std::uint64_t deadline_ns);
+
+    // mlockall/Affinität/SCHED_FIFO für einen laufenden Thread (period_ns
+    // ungenutzt); nicht gesetzte Optionen werden an warn angehängt
+    static void ApplyThreadOptions(std::thread& t, const Options& opt, std::string& warn);
+
+private:
+    void Run();
+
+    Options           opt_;
+    Body              body_;
+    std::atomic<bool> running_{false};
+    std::thread       thread_;
+    Stats             stats_;
+};
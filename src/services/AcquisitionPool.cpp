@@ -0,0 +1,134 @@
+#include "services/AcquisitionPool.hpp"
+#include "services/Metrics.hpp"
+#include "services/StageProfiler.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+bool AcquisitionPool::Start(const Options& opt, std::string* warn, std::string* err) {
+    Stop();
+    if (opt.workers <= 0) { if (err) *err = "Erfassungs-Pool ohne Worker"; return false; }
+
+    opt_ = opt;
+    running_ = true;
+
+    AcquisitionLoop::Options rt;
+    rt.rt_priority = opt_.rt_priority;
+    rt.cpu         = opt_.cpu;
+    rt.lock_memory = opt_.lock_memory;
+
+    std::string w;
+    threads_.reserve(static_cast<size_t>(opt_.workers));
+    for (int i = 0; i < opt_.workers; ++i) {
+        threads_.emplace_back([this, i] { Run(i); });
+        std::string tw;
+        AcquisitionLoop::ApplyThreadOptions(threads_.back(), rt, tw);
+        rt.lock_memory = false;   // prozessweit, einmal genügt
+        if (!tw.empty() && w.empty()) w = tw;   // gleiche Meldung je Worker nur einmal
+    }
+    if (warn) *warn = w;
+    return true;
+}
+
+void AcquisitionPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_)
+        if (t.joinable()) t.join();
+    threads_.clear();
+}
+
+AcquisitionPool::JobId AcquisitionPool::Add(std::uint64_t period_ns, Body body, std::string* err) {
+    if (period_ns == 0) { if (err) *err = "Erfassungsperiode 0"; return kNoJob; }
+    if (!body)          { if (err) *err = "Erfassung ohne Zyklusfunktion"; return kNoJob; }
+
+    auto job = std::make_unique<Job>();
+    job->period_ns = period_ns;
+    job->next_ns   = sosesta::util::MonoNs() + period_ns;
+    job->body      = std::move(body);
+
+    JobId id;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        id = job->id = next_id_++;
+        jobs_.push_back(std::move(job));
+    }
+    cv_.notify_all();
+    return id;
+}
+
+void AcquisitionPool::Remove(JobId id) {
+    std::unique_lock<std::mutex> lk(m_);
+    auto it = std::find_if(jobs_.begin(), jobs_.end(), [id](const auto& j) { return j->id == id; });
+    if (it == jobs_.end()) return;
+    Job* job = it->get();
+    cv_.wait(lk, [job] { return !job->busy; });
+    // Zeiger in jobs_ kann sich beim Warten verschoben haben
+    jobs_.erase(std::find_if(jobs_.begin(), jobs_.end(), [job](const auto& j) { return j.get() == job; }));
+    lk.unlock();
+    cv_.notify_all();
+}
+
+const AcquisitionPool::Stats* AcquisitionPool::JobStats(JobId id) const {
+    std::lock_guard<std::mutex> lk(m_);
+    for (const auto& j : jobs_)
+        if (j->id == id) return &j->stats;
+    return nullptr;
+}
+
+AcquisitionPool::Job* AcquisitionPool::NextDue() {
+    Job* best = nullptr;
+    for (const auto& j : jobs_)
+        if (!j->busy && (!best || j->next_ns < best->next_ns)) best = j.get();
+    return best;
+}
+
+void AcquisitionPool::Run(int worker) {
+    Tracer::Instance().SetThreadName(("acq" + std::to_string(worker)).c_str());
+    std::unique_lock<std::mutex> lk(m_);
+
+    while (running_.load(std::memory_order_relaxed)) {
+        Job* job = NextDue();
+        if (!job) { cv_.wait(lk); continue; }
+
+        const std::uint64_t deadline = job->next_ns;
+        if (sosesta::util::MonoNs() < deadline) {
+            // MonoNs() = steady_clock; Jobliste kann sich beim Warten ändern
+            cv_.wait_until(lk, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline)));
+            continue;
+        }
+        job->busy = true;
+        lk.unlock();
+
+        const std::uint64_t woke = sosesta::util::MonoNs();
+        const std::uint64_t late = woke - deadline;
+        auto& prof = StageProfiler::Instance();
+        if (prof.Enabled()) prof.Record(Stage::Wakeup, -1, late);
+        if (late > job->stats.max_late_ns.load(std::memory_order_relaxed))
+            job->stats.max_late_ns.store(late, std::memory_order_relaxed);
+
+        job->body(deadline);
+        job->stats.cycles.fetch_add(1, std::memory_order_relaxed);
+
+        // nächster Rasterpunkt; verpasste überspringen statt nachholen
+        std::uint64_t next = deadline + job->period_ns;
+        const std::uint64_t now = sosesta::util::MonoNs();
+        if (now >= next) {
+            const std::uint64_t skip = (now - next) / job->period_ns + 1;
+            next += skip * job->period_ns;
+            job->stats.overruns.fetch_add(1, std::memory_order_relaxed);
+            job->stats.skipped_periods.fetch_add(skip, std::memory_order_relaxed);
+            Metrics::Instance().OnSkippedPeriods(skip);
+        }
+
+        lk.lock();
+        job->next_ns = next;
+        job->busy    = false;
+        cv_.notify_all();   // Remove() wartet ggf. auf diesen Job
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "services/AcquisitionLoop.hpp"
+
+/**
+ * Gemeinsamer Erfassungs-Pool für mehrere Prüfstationen.
+ *
+ * Statt eines Threads je Station teilen sich alle Stationen wenige
+ * Worker. Jede Station meldet einen periodischen Job an (Add); die
+ * Deadlines liegen wie in AcquisitionLoop auf einem festen Raster
+ * (t0 + k·Periode). Ein freier Worker nimmt den Job mit der frühesten
+ * fälligen Deadline. Ein Job läuft nie parallel zu sich selbst; ist er zur
+ * nächsten Deadline noch aktiv, werden die verpassten Rasterpunkte
+ * übersprungen und gezählt – der Takt bleibt phasentreu.
+ *
+ * Verspätungen landen als Stage::Wakeup im StageProfiler, Überläufe in
+ * JobStats und Metrics. Echtzeit-Optionen gelten für alle Worker.
+ */
+class AcquisitionPool {
+public:
+    struct Options {
+        int  workers     = 2;
+        int  rt_priority = 0;      // 1..99 → SCHED_FIFO, 0 = normal
+        int  cpu         = -1;     // ≥ 0 → alle Worker an diesen Kern binden
+        bool lock_memory = false;  // mlockall(MCL_CURRENT|MCL_FUTURE)
+    };
+
+    using Stats = AcquisitionLoop::Stats;
+    using Body  = AcquisitionLoop::Body;
+    using JobId = int;
+    static constexpr JobId kNoJob = -1;
+
+    AcquisitionPool() = default;
+    ~AcquisitionPool() { Stop(); }
+
+    AcquisitionPool(const AcquisitionPool&) = delete;
+    AcquisitionPool& operator=(const AcquisitionPool&) = delete;
+
+    bool Start(const Options& opt, std::string* warn = nullptr, std::string* err = nullptr);
+    void Stop();   // wartet auf laufende Jobs; angemeldete Jobs bleiben bis Remove()
+    bool IsRunning() const { return running_.load(); }
+    int  Workers() const { return static_cast<int>(threads_.size()); }
+
+    // Erste Deadline eine Periode nach dem Aufruf; kNoJob bei Fehler
+    JobId Add(std::uint64_t period_ns, Body body, std::string* err = nullptr);
+    // Abmelden; wartet, bis ein gerade laufender Zyklus beendet ist
+    void Remove(JobId id);
+
+    const Stats* JobStats(JobId id) const;   // nullptr = unbekannt
+
+private:
+    struct Job {
+        JobId         id        = kNoJob;
+        std::uint64_t period_ns = 0;
+        std::uint64_t next_ns   = 0;
+        Body          body;
+        bool          busy      = false;
+        Stats         stats;
+    };
+
+    void Run(int worker);
+    Job* NextDue();   // frühester freier Job; m_ gehalten
+
+    Options                  opt_;
+    mutable std::mutex       m_;
+    std::condition_variable  cv_;
+    std::atomic<bool>        running_{false};
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<Job>> jobs_;   // unique_ptr: Stats-Adresse bleibt stabil
+    JobId                    next_id_ = 0;
+};
@@ -0,0 +1,62 @@
+#include "services/ArrowExport.hpp"
+#include <vector>
+
+#include "services/ArrowIpcWriter.hpp"
+#include "services/SessionArchive.hpp"
+#include "services/Tracer.hpp"
+
+namespace {
+enum Col : size_t {
+    kTime, kChannel, kBus, kCurrent, kPower, kRedlab,
+    kPresent, kSupplyOk, kSignalOk, kStale,
+    kSupplyErr, kSignalErr, kCurrentErr, kRetry,
+};
+} // namespace
+
+bool ExportSessionArrow(const std::string& ssa_path, const std::string& arrow_path,
+                        std::uint64_t* rows, std::string* err)
+{
+    SOSESTA_TRACE_SCOPE("ExportSessionArrow");
+    using T = ArrowIpcWriter::Type;
+
+    SessionArchiveReader in;
+    if (!in.Open(ssa_path, err)) return false;
+
+    ArrowIpcWriter out;
+    const std::vector<ArrowIpcWriter::Field> schema = {
+        {"time", T::TimestampMs},  {"channel", T::Int8},
+        {"bus_V", T::Float64},     {"current_mA", T::Float64},
+        {"power_mW", T::Float64},  {"redlab_V", T::Float64},
+        {"present", T::Bool},      {"supply_ok", T::Bool},
+        {"signal_ok", T::Bool},    {"stale", T::Bool},
+        {"supply_error_counter", T::Int32}, {"signal_error_counter", T::Int32},
+        {"current_error_counter", T::Int32}, {"retry_count", T::UInt32},
+    };
+    if (!out.Open(arrow_path, schema, 65536, err)) return false;
+
+    std::vector<session_archive::Record> recs;
+    for (size_t i = 0; i < in.Index().size(); ++i) {
+        recs.clear();
+        if (!in.ReadChunk(i, -1, recs, err)) return false;
+        for (const auto& r : recs) {
+            const SensorData& s = r.data;
+            out.Col(kTime).Int(static_cast<std::int64_t>(r.t_ms));
+            out.Col(kChannel).Int(s.channel + 1);
+            out.Col(kBus).Float(s.bus_V);
+            out.Col(kCurrent).Float(s.current_mA);
+            out.Col(kPower).Float(s.power_mW);
+            out.Col(kRedlab).Float(s.redlab_V);
+            out.Col(kPresent).Bool(s.present);
+            out.Col(kSupplyOk).Bool(s.supply_ok);
+            out.Col(kSignalOk).Bool(s.signal_ok);
+            out.Col(kStale).Bool(s.stale);
+            out.Col(kSupplyErr).Int(s.supply_error_counter);
+            out.Col(kSignalErr).Int(s.signal_error_counter);
+            out.Col(kCurrentErr).Int(s.current_error_counter);
+            out.Col(kRetry).Int(s.retry_count);
+            if (!out.EndRow(err)) return false;
+        }
+    }
+    if (rows) *rows = out.Rows();
+    return out.Close(err);
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * Sitzungsarchiv (*.ssa) als Arrow-IPC-Datei (Feather v2) für pandas/polars:
+ * eine Zeile je Zyklus und Kanal (Langformat), native Spaltentypen:
+ *
+ *   time          timestamp[ms, UTC]
+ *   channel       int8 (1..8 wie im CSV)
+ *   bus_V, current_mA, power_mW, redlab_V          float64
+ *   present, supply_ok, signal_ok, stale           bool
+ *   supply_/signal_/current_error_counter           int32
+ *   retry_count   uint32
+ *
+ * Liest Chunk für Chunk und schreibt RecordBatches zu 64 Ki Zeilen – der
+ * Speicherbedarf hängt nicht von der Sitzungsdauer ab.
+ */
+bool ExportSessionArrow(const std::string& ssa_path, const std::string& arrow_path,
+                        std::uint64_t* rows = nullptr, std::string* err = nullptr);
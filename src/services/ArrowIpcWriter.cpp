@@ -0,0 +1,396 @@
+#include "services/ArrowIpcWriter.hpp"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+
+static_assert(std::endian::native == std::endian::little, "Arrow-IPC: nur Little-Endian");
+
+namespace {
+
+constexpr size_t kBodyAlign = 64;
+constexpr std::uint32_t kContinuation = 0xFFFFFFFFu;
+
+constexpr size_t RoundUp(size_t n, size_t a) { return (n + a - 1) / a * a; }
+
+/**
+ * Minimaler FlatBuffer-Builder (von hinten nach vorn wie das Original).
+ * Positionen zählen vom Pufferende; Kindobjekte (Strings, Vektoren,
+ * Tabellen) müssen vor der Tabelle entstehen, die sie referenziert.
+ */
+class Fb {
+public:
+    size_t Size() const { return buf_.size(); }
+
+    void Pad(size_t n) { buf_.insert(buf_.begin(), n, 0); }
+
+    // nach dem Einfügen von len Bytes liegt Size() auf align
+    void Align(size_t len, size_t align) {
+        min_align_ = std::max(min_align_, align);
+        Pad((align - (buf_.size() + len) % align) % align);
+    }
+
+    void Bytes(const void* p, size_t n) {
+        const auto* b = static_cast<const std::uint8_t*>(p);
+        buf_.insert(buf_.begin(), b, b + n);
+    }
+
+    template <class T> void Push(T v) { Bytes(&v, sizeof v); }
+
+    template <class T> void Scalar(T v) { Align(sizeof(T), sizeof(T)); Push(v); }
+
+    void Ref(size_t target) {
+        Align(4, 4);
+        Push(static_cast<std::uint32_t>(Size() + 4 - target));
+    }
+
+    size_t String(std::string_view s) {
+        Align(s.size() + 1, 4);
+        Pad(1);
+        Bytes(s.data(), s.size());
+        Push(static_cast<std::uint32_t>(s.size()));
+        return Size();
+    }
+
+    size_t Structs(const void* p, size_t count, size_t elem, size_t align) {
+        Align(count * elem, std::max<size_t>(align, 4));
+        Bytes(p, count * elem);
+        Push(static_cast<std::uint32_t>(count));
+        return Size();
+    }
+
+    size_t Refs(const std::vector<size_t>& targets) {
+        Align(targets.size() * 4 + 4, 4);
+        for (auto it = targets.rbegin(); it != targets.rend(); ++it)
+            Push(static_cast<std::uint32_t>(Size() + 4 - *it));
+        Push(static_cast<std::uint32_t>(targets.size()));
+        return Size();
+    }
+
+    // ── Tabellen ──
+    void Start() { slots_.clear(); start_ = Size(); }
+
+    template <class T> void Add(int id, T v) { Scalar(v); slots_.emplace_back(id, Size()); }
+    void AddRef(int id, size_t target) { Ref(target); slots_.emplace_back(id, Size()); }
+
+    size_t End() {
+        Align(4, 4);
+        Push<std::int32_t>(0);   // soffset zur vtable, unten gesetzt
+        const size_t table = Size();
+
+        int n = 0;
+        for (const auto& s : slots_) n = std::max(n, s.first + 1);
+        std::vector<std::uint16_t> vt(static_cast<size_t>(n), 0);
+        for (const auto& s : slots_) vt[static_cast<size_t>(s.first)] = static_cast<std::uint16_t>(table - s.second);
+
+        for (auto it = vt.rbegin(); it != vt.rend(); ++it) Push(*it);
+        Push(static_cast<std::uint16_t>(table - start_));
+        Push(static_cast<std::uint16_t>(4 + 2 * n));
+        const size_t vtable = Size();
+
+        const auto so = static_cast<std::int32_t>(vtable - table);
+        std::memcpy(&buf_[Size() - table], &so, sizeof so);
+        return table;
+    }
+
+    std::vector<std::uint8_t> Finish(size_t root) {
+        const size_t a = std::max<size_t>(min_align_, 4);
+        Pad((a - (Size() + 4) % a) % a);
+        Push(static_cast<std::uint32_t>(Size() + 4 - root));
+        return std::move(buf_);
+    }
+
+private:
+    std::vector<std::uint8_t> buf_;
+    size_t min_align_ = 1;
+    size_t start_ = 0;
+    std::vector<std::pair<int, size_t>> slots_;
+};
+
+// Arrow-Format (Schema.fbs / Message.fbs / File.fbs)
+enum : std::uint8_t { kTypeInt = 2, kTypeFloat = 3, kTypeUtf8 = 5, kTypeBool = 6, kTypeTimestamp = 10 };
+enum : std::uint8_t { kHeaderSchema = 1, kHeaderRecordBatch = 3 };
+constexpr std::int16_t kVersionV5 = 4;
+
+struct FieldNode { std::int64_t length, null_count; };
+struct BufferRef { std::int64_t offset, length; };
+struct FooterBlock { std::int64_t offset; std::int32_t meta_len; std::int32_t pad; std::int64_t body_len; };
+static_assert(sizeof(FieldNode) == 16 && sizeof(BufferRef) == 16 && sizeof(FooterBlock) == 24);
+
+size_t ValueBytes(ArrowIpcWriter::Type t) {
+    using T = ArrowIpcWriter::Type;
+    switch (t) {
+    case T::Int8:  case T::UInt8:                  return 1;
+    case T::Int32: case T::UInt32: case T::Float32: return 4;
+    case T::Int64: case T::UInt64: case T::Float64:
+    case T::TimestampMs: case T::TimestampNs:       return 8;
+    case T::Bool:  case T::Utf8:                   return 0;
+    }
+    return 0;
+}
+
+size_t TypeTable(Fb& fb, ArrowIpcWriter::Type t, std::uint8_t* type_id) {
+    using T = ArrowIpcWriter::Type;
+    size_t tz = 0;
+    if (t == T::TimestampMs || t == T::TimestampNs) tz = fb.String("UTC");
+
+    fb.Start();
+    switch (t) {
+    case T::Bool:    *type_id = kTypeBool; break;
+    case T::Utf8:    *type_id = kTypeUtf8; break;
+    case T::Float32: *type_id = kTypeFloat; fb.Add<std::int16_t>(0, 1); break;   // SINGLE
+    case T::Float64: *type_id = kTypeFloat; fb.Add<std::int16_t>(0, 2); break;   // DOUBLE
+    case T::TimestampMs:
+    case T::TimestampNs:
+        *type_id = kTypeTimestamp;
+        fb.Add<std::int16_t>(0, t == T::TimestampMs ? 1 : 3);   // MILLISECOND / NANOSECOND
+        fb.AddRef(1, tz);
+        break;
+    default: {
+        const bool is_signed = t == T::Int8 || t == T::Int32 || t == T::Int64;
+        *type_id = kTypeInt;
+        fb.Add<std::int32_t>(0, static_cast<std::int32_t>(ValueBytes(t) * 8));
+        fb.Add<std::uint8_t>(1, is_signed ? 1 : 0);
+        break;
+    }
+    }
+    return fb.End();
+}
+
+size_t SchemaTable(Fb& fb, const std::vector<ArrowIpcWriter::Field>& fields) {
+    std::vector<size_t> refs;
+    refs.reserve(fields.size());
+    for (const auto& f : fields) {
+        const size_t name     = fb.String(f.name);
+        std::uint8_t type_id  = 0;
+        const size_t type     = TypeTable(fb, f.type, &type_id);
+        const size_t children = fb.Refs({});   // Pflicht für Arrow C++, auch leer
+
+        fb.Start();
+        fb.AddRef(0, name);
+        fb.Add<std::uint8_t>(1, 0);          // nullable = false
+        fb.Add<std::uint8_t>(2, type_id);
+        fb.AddRef(3, type);
+        fb.AddRef(5, children);
+        refs.push_back(fb.End());
+    }
+    const size_t vec = fb.Refs(refs);
+
+    fb.Start();
+    fb.Add<std::int16_t>(0, 0);   // Little-Endian
+    fb.AddRef(1, vec);
+    return fb.End();
+}
+
+std::vector<std::uint8_t> MessageFb(std::uint8_t header_type, size_t header, Fb& fb, std::int64_t body_len) {
+    fb.Start();
+    fb.Add<std::int16_t>(0, kVersionV5);
+    fb.Add<std::uint8_t>(1, header_type);
+    fb.AddRef(2, header);
+    fb.Add<std::int64_t>(3, body_len);
+    return fb.Finish(fb.End());
+}
+
+} // namespace
+
+// ── Column ────────────────────────────────────────────────
+
+void ArrowIpcWriter::Column::Bool(bool v) {
+    if ((length & 7) == 0) data.push_back(0);
+    if (v) data.back() |= static_cast<std::uint8_t>(1u << (length & 7));
+    ++length;
+}
+
+void ArrowIpcWriter::Column::Int(std::int64_t v) {
+    const size_t n = ValueBytes(type);
+    const size_t at = data.size();
+    data.resize(at + n);
+    std::memcpy(&data[at], &v, n);   // Little-Endian: untere Bytes
+    ++length;
+}
+
+void ArrowIpcWriter::Column::Float(double v) {
+    const size_t at = data.size();
+    if (type == Type::Float32) {
+        const float f = static_cast<float>(v);
+        data.resize(at + sizeof f);
+        std::memcpy(&data[at], &f, sizeof f);
+    } else {
+        data.resize(at + sizeof v);
+        std::memcpy(&data[at], &v, sizeof v);
+    }
+    ++length;
+}
+
+void ArrowIpcWriter::Column::Str(std::string_view v) {
+    if (offsets.empty()) offsets.push_back(0);
+    data.insert(data.end(), v.begin(), v.end());
+    offsets.push_back(static_cast<std::int32_t>(data.size()));
+    ++length;
+}
+
+// ── ArrowIpcWriter ────────────────────────────────────────
+
+ArrowIpcWriter::~ArrowIpcWriter() {
+    if (f_) Close();
+}
+
+void ArrowIpcWriter::Fail() {
+    if (f_) std::fclose(f_);
+    f_ = nullptr;
+}
+
+bool ArrowIpcWriter::Write(const void* p, size_t n, std::string* err) {
+    if (n && std::fwrite(p, 1, n, f_) != n) {
+        if (err) *err = "Schreiben fehlgeschlagen: " + path_ + " (" + std::strerror(errno) + ")";
+        Fail();
+        return false;
+    }
+    pos_ += n;
+    return true;
+}
+
+bool ArrowIpcWriter::Pad(size_t n, std::string* err) {
+    static const std::uint8_t zeros[kBodyAlign] = {};
+    while (n) {
+        const size_t k = std::min(n, sizeof zeros);
+        if (!Write(zeros, k, err)) return false;
+        n -= k;
+    }
+    return true;
+}
+
+bool ArrowIpcWriter::Open(const std::string& path, std::vector<Field> schema,
+                          size_t batch_rows, std::string* err)
+{
+    if (f_) Close();
+    path_       = path;
+    fields_     = std::move(schema);
+    batch_rows_ = std::max<size_t>(batch_rows, 1);
+    pending_    = 0;
+    rows_       = 0;
+    pos_        = 0;
+    blocks_.clear();
+    cols_.assign(fields_.size(), Column{});
+    for (size_t i = 0; i < fields_.size(); ++i) cols_[i].type = fields_[i].type;
+
+    f_ = std::fopen(path.c_str(), "wb");
+    if (!f_) {
+        if (err) *err = "Datei kann nicht geöffnet werden: " + path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    static const char magic[8] = {'A', 'R', 'R', 'O', 'W', '1', 0, 0};
+    if (!Write(magic, sizeof magic, err)) return false;
+
+    Fb fb;
+    const size_t schema_tbl = SchemaTable(fb, fields_);
+    return WriteMessage(MessageFb(kHeaderSchema, schema_tbl, fb, 0), nullptr, err);
+}
+
+// Kapselung: 0xFFFFFFFF, Länge (auf 8 gerundet), FlatBuffer, Füllbytes
+bool ArrowIpcWriter::WriteMessage(const std::vector<std::uint8_t>& fb, Block* blk, std::string* err) {
+    const std::int32_t len = static_cast<std::int32_t>(RoundUp(fb.size(), 8));
+    if (blk) {
+        blk->offset   = static_cast<std::int64_t>(pos_);
+        blk->meta_len = len + 8;
+    }
+    return Write(&kContinuation, 4, err) && Write(&len, 4, err)
+        && Write(fb.data(), fb.size(), err) && Pad(static_cast<size_t>(len) - fb.size(), err);
+}
+
+bool ArrowIpcWriter::EndRow(std::string* err) {
+    if (!f_) return false;
+    ++rows_;
+    if (++pending_ < batch_rows_) return true;
+    return FlushBatch(err);
+}
+
+bool ArrowIpcWriter::FlushBatch(std::string* err) {
+    if (pending_ == 0) return true;
+
+    // Body-Layout: je Spalte Validity (leer, ohne Nullwerte), dann Offsets/Werte
+    std::vector<FieldNode> nodes;
+    std::vector<BufferRef> bufs;
+    std::vector<std::pair<const void*, size_t>> parts;   // (Daten, Länge) in Body-Reihenfolge
+    std::int64_t body = 0;
+    auto add = [&](const void* p, size_t n) {
+        bufs.push_back({body, static_cast<std::int64_t>(n)});
+        if (n) parts.emplace_back(p, n);
+        body += static_cast<std::int64_t>(RoundUp(n, kBodyAlign));
+    };
+    for (size_t i = 0; i < cols_.size(); ++i) {
+        Column& c = cols_[i];
+        if (c.length != pending_) {
+            if (err) *err = "Arrow: Spalte '" + fields_[i].name + "' hat " + std::to_string(c.length)
+                          + " statt " + std::to_string(pending_) + " Werte";
+            Fail();
+            return false;
+        }
+        nodes.push_back({static_cast<std::int64_t>(c.length), 0});
+        add(nullptr, 0);
+        if (c.type == Type::Utf8) add(c.offsets.data(), c.offsets.size() * sizeof(std::int32_t));
+        add(c.data.data(), c.data.size());
+    }
+
+    Fb fb;
+    const size_t buf_vec  = fb.Structs(bufs.data(), bufs.size(), sizeof(BufferRef), 8);
+    const size_t node_vec = fb.Structs(nodes.data(), nodes.size(), sizeof(FieldNode), 8);
+    fb.Start();
+    fb.Add<std::int64_t>(0, static_cast<std::int64_t>(pending_));
+    fb.AddRef(1, node_vec);
+    fb.AddRef(2, buf_vec);
+    const size_t batch = fb.End();
+
+    Block blk;
+    blk.body_len = body;
+    if (!WriteMessage(MessageFb(kHeaderRecordBatch, batch, fb, body), &blk, err)) return false;
+    for (const auto& [p, n] : parts)
+        if (!Write(p, n, err) || !Pad(RoundUp(n, kBodyAlign) - n, err)) return false;
+    blocks_.push_back(blk);
+
+    for (auto& c : cols_) {   // Kapazität bleibt für den nächsten Batch
+        c.length = 0;
+        c.data.clear();
+        c.offsets.clear();
+    }
+    pending_ = 0;
+    return true;
+}
+
+bool ArrowIpcWriter::Close(std::string* err) {
+    if (!f_) return false;
+    if (!FlushBatch(err)) return false;
+
+    // Ende des Datenstroms
+    const std::uint32_t eos[2] = {kContinuation, 0};
+    if (!Write(eos, sizeof eos, err)) return false;
+
+    // Footer: Schema + Blöcke der RecordBatches, danach Länge und Magic
+    std::vector<FooterBlock> fblocks;
+    fblocks.reserve(blocks_.size());
+    for (const auto& b : blocks_) fblocks.push_back({b.offset, b.meta_len, 0, b.body_len});
+
+    Fb fb;
+    const size_t schema_tbl = SchemaTable(fb, fields_);
+    const size_t batches    = fb.Structs(fblocks.data(), fblocks.size(), sizeof(FooterBlock), 8);
+    const size_t dicts      = fb.Structs(nullptr, 0, sizeof(FooterBlock), 8);
+    fb.Start();
+    fb.Add<std::int16_t>(0, kVersionV5);
+    fb.AddRef(1, schema_tbl);
+    fb.AddRef(2, dicts);
+    fb.AddRef(3, batches);
+    const auto footer = fb.Finish(fb.End());
+
+    const auto flen = static_cast<std::int32_t>(footer.size());
+    static const char magic[6] = {'A', 'R', 'R', 'O', 'W', '1'};
+    if (!Write(footer.data(), footer.size(), err) || !Write(&flen, 4, err) || !Write(magic, sizeof magic, err))
+        return false;
+
+    if (std::fclose(f_) != 0) {
+        f_ = nullptr;
+        if (err) *err = "Schließen fehlgeschlagen: " + path_;
+        return false;
+    }
+    f_ = nullptr;
+    return true;
+}
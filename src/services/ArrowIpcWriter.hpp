@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Schreiber für Arrow-IPC-Dateien (Feather v2, *.arrow) ohne Arrow-Bibliothek.
+ *
+ * Spalten mit festen Typen, ohne Nullwerte. Zeilen werden spaltenweise
+ * gepuffert und alle batch_rows als RecordBatch geschrieben (Speicher
+ * bleibt begrenzt); Close() schreibt Footer mit Batch-Index. pandas/polars
+ * lesen die Datei ohne Parsen und können sie per mmap einbinden.
+ *
+ * Metadaten (Schema, RecordBatch, Footer) werden als FlatBuffers von Hand
+ * kodiert; Puffer im Body sind auf 64 Byte ausgerichtet. Nur Little-Endian.
+ */
+class ArrowIpcWriter {
+public:
+    enum class Type : std::uint8_t {
+        Bool, Int8, UInt8, Int32, UInt32, Int64, UInt64, Float32, Float64,
+        TimestampMs, TimestampNs,   // UTC
+        Utf8,
+    };
+
+    struct Field {
+        std::string name;
+        Type        type = Type::Float64;
+    };
+
+    // Spaltenpuffer des laufenden Batches; Werte passend zum Typ anhängen
+    class Column {
+    public:
+        void Bool(bool v);
+        void Int(std::int64_t v);       // Int*/UInt*/Timestamp*
+        void Float(double v);           // Float32/Float64
+        void Str(std::string_view v);   // Utf8
+
+        Type   type   = Type::Float64;
+        size_t length = 0;
+        std::vector<std::uint8_t> data;      // Werte bzw. Bits bzw. UTF-8-Bytes
+        std::vector<std::int32_t> offsets;   // nur Utf8 (length + 1)
+    };
+
+    ArrowIpcWriter() = default;
+    ~ArrowIpcWriter();
+
+    ArrowIpcWriter(const ArrowIpcWriter&) = delete;
+    ArrowIpcWriter& operator=(const ArrowIpcWriter&) = delete;
+
+    bool Open(const std::string& path, std::vector<Field> schema,
+              size_t batch_rows = 65536, std::string* err = nullptr);
+
+    Column& Col(size_t i) { return cols_[i]; }
+
+    // Zeile abgeschlossen (alle Spalten befüllt); voller Batch → schreiben
+    bool EndRow(std::string* err = nullptr);
+
+    // Restbatch, Footer; ohne Close() ist die Datei unvollständig
+    bool Close(std::string* err = nullptr);
+
+    bool IsOpen() const { return f_ != nullptr; }
+    std::uint64_t Rows() const { return rows_; }
+    size_t Batches() const { return blocks_.size(); }
+    std::uint64_t BytesWritten() const { return pos_; }
+
+private:
+    struct Block {
+        std::int64_t offset     = 0;
+        std::int32_t meta_len   = 0;
+        std::int64_t body_len   = 0;
+    };
+
+    bool FlushBatch(std::string* err);
+    bool WriteMessage(const std::vector<std::uint8_t>& fb, Block* blk, std::string* err);
+    bool Write(const void* p, size_t n, std::string* err);
+    bool Pad(size_t n, std::string* err);
+    void Fail();
+
+    std::string          path_;
+    std::FILE*           f_ = nullptr;
+    std::vector<Field>   fields_;
+    std::vector<Column>  cols_;
+    size_t               batch_rows_ = 65536;
+    size_t               pending_    = 0;   // Zeilen im laufenden Batch
+    std::uint64_t        rows_       = 0;
+    std::uint64_t        pos_        = 0;
+    std::vector<Block>   blocks_;
+};
@@ -0,0 +1,223 @@
+// Arrow-IPC-Datei zurücklesen: Magic, Footer, Schema, RecordBatches und
+// Pufferinhalte über einen minimalen FlatBuffer-Leser (nur Lesen, ohne Arrow).
+#include "services/ArrowIpcWriter.hpp"
+#include "util/TestCheck.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+using Type = ArrowIpcWriter::Type;
+
+// ── FlatBuffer lesen (Tabellen, Vektoren, Strings) ────────
+struct Fb {
+    const std::uint8_t* base = nullptr;
+    size_t              size = 0;
+    bool                ok   = true;
+
+    template <class T> T Get(size_t at) {
+        T v{};
+        if (at + sizeof(T) > size) { ok = false; return v; }
+        std::memcpy(&v, base + at, sizeof(T));
+        return v;
+    }
+    size_t Deref(size_t at) { return at + Get<std::uint32_t>(at); }
+    size_t Root() { return Deref(0); }
+
+    // Position des Felds id in der Tabelle t; 0 = nicht gesetzt
+    size_t Field(size_t t, int id) {
+        const size_t vt = t - static_cast<size_t>(Get<std::int32_t>(t));
+        const auto vt_len = Get<std::uint16_t>(vt);
+        const size_t slot = 4 + 2 * static_cast<size_t>(id);
+        if (slot + 2 > vt_len) return 0;
+        const auto off = Get<std::uint16_t>(vt + slot);
+        return off ? t + off : 0;
+    }
+    template <class T> T Scalar(size_t t, int id, T def = T{}) {
+        const size_t f = Field(t, id);
+        return f ? Get<T>(f) : def;
+    }
+    size_t Table(size_t t, int id) { const size_t f = Field(t, id); return f ? Deref(f) : 0; }
+    // Vektor: (Anzahl, Position des ersten Elements)
+    std::pair<size_t, size_t> Vector(size_t t, int id) {
+        const size_t v = Table(t, id);
+        if (!v) return {0, 0};
+        return {Get<std::uint32_t>(v), v + 4};
+    }
+    std::string String(size_t t, int id) {
+        const size_t s = Table(t, id);
+        if (!s) return {};
+        const auto n = Get<std::uint32_t>(s);
+        if (s + 4 + n > size) { ok = false; return {}; }
+        return std::string(reinterpret_cast<const char*>(base + s + 4), n);
+    }
+};
+
+struct Buffer { std::int64_t offset, length; };
+
+struct Batch {
+    std::int64_t        length = 0;
+    std::vector<Buffer> buffers;
+    const std::uint8_t* body = nullptr;
+};
+
+struct ArrowFile {
+    std::vector<std::uint8_t> bytes;
+    std::vector<std::string>  names;
+    std::vector<Batch>        batches;
+    bool                      ok = false;
+};
+
+ArrowFile Parse(const std::string& path) {
+    ArrowFile a;
+    {
+        std::ifstream f(path, std::ios::binary);
+        a.bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    const auto& b = a.bytes;
+    if (b.size() < 8 + 10 || std::memcmp(b.data(), "ARROW1\0\0", 8) != 0
+        || std::memcmp(b.data() + b.size() - 6, "ARROW1", 6) != 0) return a;
+
+    std::int32_t flen = 0;
+    std::memcpy(&flen, b.data() + b.size() - 10, 4);
+    if (flen <= 0 || static_cast<size_t>(flen) + 18 > b.size()) return a;
+    Fb footer{ b.data() + b.size() - 10 - flen, static_cast<size_t>(flen) };
+    const size_t root   = footer.Root();
+    const size_t schema = footer.Table(root, 1);
+    const auto [nf, f0] = footer.Vector(schema, 1);
+    for (size_t i = 0; i < nf; ++i)
+        a.names.push_back(footer.String(footer.Deref(f0 + 4 * i), 0));
+
+    const auto [nb, b0] = footer.Vector(root, 3);
+    for (size_t i = 0; i < nb; ++i) {
+        // Block: i64 offset, i32 metaDataLength, 4 Füllbytes, i64 bodyLength
+        const auto off  = footer.Get<std::int64_t>(b0 + 24 * i);
+        const auto meta = footer.Get<std::int32_t>(b0 + 24 * i + 8);
+        const auto body = footer.Get<std::int64_t>(b0 + 24 * i + 16);
+        if (off < 0 || meta < 8 || static_cast<size_t>(off + meta + body) > b.size()) return a;
+        if (off % 8 != 0) return a;
+        std::uint32_t cont = 0;
+        std::memcpy(&cont, b.data() + off, 4);
+        if (cont != 0xFFFFFFFFu) return a;
+
+        Fb msg{ b.data() + off + 8, static_cast<size_t>(meta - 8) };
+        const size_t m = msg.Root();
+        if (msg.Scalar<std::uint8_t>(m, 1) != 3 || msg.Scalar<std::int64_t>(m, 3) != body) return a;
+        const size_t rb = msg.Table(m, 2);
+        Batch bt;
+        bt.length = msg.Scalar<std::int64_t>(rb, 0);
+        const auto [nbuf, p0] = msg.Vector(rb, 2);
+        for (size_t k = 0; k < nbuf; ++k)
+            bt.buffers.push_back({ msg.Get<std::int64_t>(p0 + 16 * k), msg.Get<std::int64_t>(p0 + 16 * k + 8) });
+        bt.body = b.data() + off + meta;
+        if (!msg.ok) return a;
+        a.batches.push_back(std::move(bt));
+    }
+    a.ok = footer.ok;
+    return a;
+}
+
+template <class T> T At(const Batch& b, size_t buf, size_t i) {
+    T v{};
+    std::memcpy(&v, b.body + b.buffers[buf].offset + i * sizeof(T), sizeof(T));
+    return v;
+}
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestRoundTrip() {
+    const std::string path = sosesta::test::TempPath("roundtrip.arrow");
+    ArrowIpcWriter w;
+    std::string err;
+    REQUIRE(w.Open(path, { {"t", Type::TimestampMs}, {"v", Type::Float64}, {"ok", Type::Bool},
+                           {"ch", Type::Int32}, {"sn", Type::Utf8} }, 7, &err));
+    constexpr int kRows = 20;
+    for (int i = 0; i < kRows; ++i) {
+        w.Col(0).Int(1'700'000'000'000 + i * 100);
+        w.Col(1).Float(0.5 * i - 3.0);
+        w.Col(2).Bool(i % 3 == 0);
+        w.Col(3).Int(-i);
+        w.Col(4).Str(std::string(static_cast<size_t>(i % 4), static_cast<char>('a' + i % 26)));
+        CHECK(w.EndRow(&err));
+    }
+    CHECK(w.Batches() == 2);   // 7 + 7, Rest beim Close()
+    CHECK(w.Close(&err));
+    CHECK(w.Rows() == kRows);
+
+    const ArrowFile a = Parse(path);
+    REQUIRE(a.ok);
+    CHECK((a.names == std::vector<std::string>{ "t", "v", "ok", "ch", "sn" }));
+    REQUIRE(a.batches.size() == 3);
+
+    int row = 0;
+    for (const Batch& b : a.batches) {
+        // je Spalte Validity (leer), Utf8 zusätzlich Offsets
+        REQUIRE(b.buffers.size() == 11);
+        for (const auto& buf : b.buffers) CHECK(buf.offset % 64 == 0);
+        CHECK(b.buffers[0].length == 0);
+        for (std::int64_t i = 0; i < b.length; ++i, ++row) {
+            const auto k = static_cast<size_t>(i);
+            CHECK(At<std::int64_t>(b, 1, k) == 1'700'000'000'000 + row * 100);
+            CHECK(At<double>(b, 3, k) == 0.5 * row - 3.0);
+            const bool bit = (b.body[b.buffers[5].offset + k / 8] >> (k % 8)) & 1;
+            CHECK(bit == (row % 3 == 0));
+            CHECK(At<std::int32_t>(b, 7, k) == -row);
+            const auto o0 = At<std::int32_t>(b, 9, k);
+            const auto o1 = At<std::int32_t>(b, 9, k + 1);
+            const std::string s(reinterpret_cast<const char*>(b.body + b.buffers[10].offset + o0),
+                                static_cast<size_t>(o1 - o0));
+            CHECK(s == std::string(static_cast<size_t>(row % 4), static_cast<char>('a' + row % 26)));
+        }
+    }
+    CHECK(row == kRows);
+    std::filesystem::remove(path);
+}
+
+void TestEmpty() {
+    const std::string path = sosesta::test::TempPath("empty.arrow");
+    ArrowIpcWriter w;
+    REQUIRE(w.Open(path, { {"x", Type::Float32} }));
+    CHECK(w.Close());
+    const ArrowFile a = Parse(path);
+    CHECK(a.ok);
+    CHECK(a.names.size() == 1);
+    CHECK(a.batches.empty());
+    std::filesystem::remove(path);
+}
+
+void TestColumnMismatch() {
+    const std::string path = sosesta::test::TempPath("mismatch.arrow");
+    ArrowIpcWriter w;
+    std::string err;
+    REQUIRE(w.Open(path, { {"a", Type::Int64}, {"b", Type::Int64} }, 4, &err));
+    w.Col(0).Int(1);   // Spalte b fehlt
+    CHECK(w.EndRow(&err));
+    CHECK(!w.Close(&err));
+    CHECK(!err.empty());
+    CHECK(!w.IsOpen());
+    CHECK(!Parse(path).ok);   // ohne Footer keine gültige Datei
+    std::filesystem::remove(path);
+}
+
+void TestTruncatedFile() {
+    const std::string path = sosesta::test::TempPath("trunc.arrow");
+    {
+        ArrowIpcWriter w;
+        REQUIRE(w.Open(path, { {"a", Type::UInt8} }, 2));
+        for (int i = 0; i < 5; ++i) { w.Col(0).Int(i); w.EndRow(); }
+        REQUIRE(w.Close());
+    }
+    const auto size = std::filesystem::file_size(path);
+    for (auto cut : { size - 1, size - 6, size / 2 }) {
+        std::filesystem::resize_file(path, cut);
+        CHECK(!Parse(path).ok);
+    }
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+TEST_MAIN(TestRoundTrip, TestEmpty, TestColumnMismatch, TestTruncatedFile)
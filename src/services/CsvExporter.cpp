@@ -1,4 +1,5 @@
 #include "services/CsvExporter.hpp"
+#include "services/Tracer.hpp"
 #include <wx/filedlg.h>
 #include <wx/ffile.h>
 #include <wx/msgdlg.h>
@@ -19,6 +20,8 @@ bool CsvExporter::ExportDataViewToCSV(wxWindow* parent,
 
     if (dlg.ShowModal() != wxID_OK) return false;
 
+    SOSESTA_TRACE_SCOPE("CsvExporter::ExportDataViewToCSV");
+
     wxFFile f(dlg.GetPath(), "wb");
     if (!f.IsOpened()) {
         if (parent) {
@@ -0,0 +1,197 @@
+#include "services/EventIndex.hpp"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+namespace {
+std::string Lower(std::string_view s) {
+    std::string r(s);
+    for (char& c : r) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return r;
+}
+
+bool ContainsLower(const std::string& hay, const std::string& needle_lower) {
+    auto it = std::search(hay.begin(), hay.end(), needle_lower.begin(), needle_lower.end(),
+                          [](char a, char b) {
+                              return std::tolower(static_cast<unsigned char>(a)) == b;
+                          });
+    return it != hay.end();
+}
+} // namespace
+
+// ── EventQuery ────────────────────────────────────────────
+
+bool EventQuery::Empty() const {
+    return channel == kAnyChannel && severities == 0 && kinds == 0 && serial.empty()
+        && text.empty() && t_from_ns == 0 && t_to_ns == 0;
+}
+
+std::uint32_t EventQuery::SeverityAtLeast(std::uint8_t min) {
+    return min >= 32 ? 0u : ~((1u << min) - 1u) & 0xFFu;
+}
+
+// ── EventFilter ───────────────────────────────────────────
+
+EventFilter::EventFilter(EventQuery q, const StringPool& pool)
+    : q_(std::move(q))
+    , empty_(q_.Empty())
+    , needle_(Lower(q_.text))
+{
+    text_hit_.assign(pool.Size(), 0);
+}
+
+std::uint32_t EventFilter::SerialId(const StringPool& pool) const {
+    // erst bei Bedarf (Seriennummer kann nach dem Filtern auftauchen)
+    if (serial_id_ == 0 && !q_.serial.empty()) serial_id_ = pool.Find(q_.serial);
+    return serial_id_;
+}
+
+bool EventFilter::NeedsRecord() const {
+    return q_.t_from_ns != 0 || q_.t_to_ns != 0 || !needle_.empty();
+}
+
+bool EventFilter::TextHit(std::uint32_t id, const StringPool& pool) const {
+    if (id == 0) return false;
+    if (id >= text_hit_.size()) text_hit_.resize(pool.Size(), 0);
+    if (id >= text_hit_.size()) return false;
+    auto& h = text_hit_[id];
+    if (h == 0) h = ContainsLower(pool.Get(id), needle_) ? 2 : 1;
+    return h == 2;
+}
+
+bool EventFilter::Matches(const EventRecord& e, const StringPool& pool) const {
+    if (empty_) return true;
+    if (q_.channel != EventQuery::kAnyChannel && e.channel != q_.channel) return false;
+    if (q_.severities && (e.severity >= 32 || !(q_.severities & (1u << e.severity)))) return false;
+    if (q_.kinds && !(q_.kinds & (1u << static_cast<unsigned>(e.kind)))) return false;
+    if (!q_.serial.empty()) {
+        const std::uint32_t id = SerialId(pool);
+        if (id == 0 || e.serial != id) return false;
+    }
+    if (q_.t_from_ns && e.t_ns < q_.t_from_ns) return false;
+    if (q_.t_to_ns && e.t_ns > q_.t_to_ns) return false;
+    if (!needle_.empty() && !TextHit(e.serial, pool) && !TextHit(e.text, pool) && !TextHit(e.category, pool))
+        return false;
+    return true;
+}
+
+// ── EventIndex ────────────────────────────────────────────
+
+void EventIndex::Set(Bitmap& b, std::uint32_t row) {
+    const size_t w = row >> 6;
+    if (b.size() <= w) b.resize(w + 1, 0);   // wächst amortisiert mit
+    b[w] |= 1ull << (row & 63);
+}
+
+std::uint64_t EventIndex::Word(const std::vector<Bitmap>& v, size_t value, size_t w) {
+    if (value >= v.size() || w >= v[value].size()) return 0;
+    return v[value][w];
+}
+
+void EventIndex::Add(const EventRecord& e) {
+    const auto row = static_cast<std::uint32_t>(rows_++);
+
+    const size_t ch = static_cast<size_t>(e.channel + 1);   // -1 → 0
+    if (by_channel_.size() <= ch) by_channel_.resize(ch + 1);
+    Set(by_channel_[ch], row);
+
+    if (by_severity_.size() <= e.severity) by_severity_.resize(size_t(e.severity) + 1);
+    Set(by_severity_[e.severity], row);
+
+    const size_t k = static_cast<size_t>(e.kind);
+    if (by_kind_.size() <= k) by_kind_.resize(k + 1);
+    Set(by_kind_[k], row);
+
+    if (e.serial != 0) by_serial_[e.serial].push_back(row);
+
+    const std::uint64_t bucket = e.t_ns - e.t_ns % kBucketNs;
+    if (buckets_.empty() || bucket > buckets_.back().first) buckets_.emplace_back(bucket, row);
+}
+
+void EventIndex::Clear() {
+    rows_ = 0;
+    by_channel_.clear();
+    by_severity_.clear();
+    by_kind_.clear();
+    by_serial_.clear();
+    buckets_.clear();
+}
+
+size_t EventIndex::MemoryBytes() const {
+    size_t n = buckets_.capacity() * sizeof(buckets_[0]);
+    for (const auto* v : {&by_channel_, &by_severity_, &by_kind_})
+        for (const auto& b : *v) n += b.capacity() * sizeof(std::uint64_t);
+    for (const auto& [id, p] : by_serial_) n += p.capacity() * sizeof(std::uint32_t) + 32;
+    return n;
+}
+
+std::pair<std::uint32_t, std::uint32_t> EventIndex::TimeRows(std::uint64_t from, std::uint64_t to) const {
+    std::uint32_t lo = 0, hi = static_cast<std::uint32_t>(rows_);
+    auto by_start = [](const std::pair<std::uint64_t, std::uint32_t>& b, std::uint64_t t) { return b.first < t; };
+    if (from != 0) {
+        // Eimer, der from enthält (bzw. letzter davor)
+        auto it = std::lower_bound(buckets_.begin(), buckets_.end(), from - from % kBucketNs + 1, by_start);
+        if (it != buckets_.begin()) lo = std::prev(it)->second;
+    }
+    if (to != 0) {
+        auto it = std::lower_bound(buckets_.begin(), buckets_.end(), to - to % kBucketNs + kBucketNs, by_start);
+        if (it != buckets_.end()) hi = it->second;
+    }
+    return {lo, std::max(lo, hi)};
+}
+
+void EventIndex::Query(const EventFilter& f,
+                       const std::vector<EventRecord>& entries,
+                       const std::vector<std::uint32_t>& events,
+                       const StringPool& pool,
+                       std::vector<std::uint32_t>& out) const
+{
+    out.clear();
+    const EventQuery& q = f.Query();
+    const size_t n = std::min(rows_, events.size());
+    auto [lo, hi] = TimeRows(q.t_from_ns, q.t_to_ns);
+    hi = std::min<std::uint32_t>(hi, static_cast<std::uint32_t>(n));
+    if (lo >= hi) return;
+
+    auto check = [&](std::uint32_t row) { return f.Matches(entries[events[row]], pool); };
+
+    // 1) Seriennummer: dünne Postings-Liste treibt, Rest am Datensatz prüfen
+    if (!q.serial.empty()) {
+        const std::uint32_t id = f.SerialId(pool);
+        auto it = id ? by_serial_.find(id) : by_serial_.end();
+        if (it == by_serial_.end()) return;
+        const auto& p = it->second;
+        for (auto r = std::lower_bound(p.begin(), p.end(), lo); r != p.end() && *r < hi; ++r)
+            if (check(*r)) out.push_back(*r);
+        return;
+    }
+
+    // 2) Bitmaps wortweise; ohne Kanal/Severity/Art-Filter ist jedes Wort voll
+    const bool by_ch   = q.channel != EventQuery::kAnyChannel;
+    const size_t ch    = static_cast<size_t>(q.channel + 1);
+    const bool rec     = f.NeedsRecord();
+    const size_t w_end = (static_cast<size_t>(hi) + 63) >> 6;
+    for (size_t w = lo >> 6; w < w_end; ++w) {
+        std::uint64_t m = ~0ull;
+        if (w == (lo >> 6))   m &= ~0ull << (lo & 63);
+        if (w == w_end - 1 && (hi & 63)) m &= ~0ull >> (64 - (hi & 63));
+        if (by_ch) m &= Word(by_channel_, ch, w);
+        if (m && q.severities) {
+            std::uint64_t any = 0;
+            for (size_t s = 0; s < std::min<size_t>(by_severity_.size(), 32); ++s)
+                if (q.severities & (1u << s)) any |= Word(by_severity_, s, w);
+            m &= any;
+        }
+        if (m && q.kinds) {
+            std::uint64_t any = 0;
+            for (size_t k = 0; k < by_kind_.size(); ++k)
+                if (q.kinds & (1u << k)) any |= Word(by_kind_, k, w);
+            m &= any;
+        }
+        while (m) {
+            const auto row = static_cast<std::uint32_t>((w << 6) + static_cast<size_t>(std::countr_zero(m)));
+            m &= m - 1;
+            if (!rec || check(row)) out.push_back(row);
+        }
+    }
+}
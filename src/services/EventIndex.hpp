@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "services/EventRecord.hpp"
+
+// Filter für das Ereignis-Log; leere Felder = keine Einschränkung
+struct EventQuery {
+    static constexpr int kAnyChannel = -2;
+
+    int           channel    = kAnyChannel;   // 0-basiert, -1 = ohne Kanal
+    std::uint32_t severities = 0;             // Bit i = Metrics::Severity i
+    std::uint32_t kinds      = 0;             // Bit i = EventKind i
+    std::string   serial;                     // exakt (Index)
+    std::string   text;                       // Teilstring in SN/Text/Kategorie, ohne Groß/Klein
+    std::uint64_t t_from_ns  = 0;             // 0 = offen
+    std::uint64_t t_to_ns    = 0;             // 0 = offen (inklusive)
+
+    bool Empty() const;
+
+    // Bits für „Severity ≥ min“ (z. B. WARN und ERROR)
+    static std::uint32_t SeverityAtLeast(std::uint8_t min);
+};
+
+// Vorbereiteter Filter: Seriennummer und Textsuche über Ids des
+// StringPools aufgelöst; neue Strings werden beim ersten Treffer
+// nachgeschlagen (Cache je Id). Nicht thread-sicher.
+class EventFilter {
+public:
+    EventFilter() = default;
+    EventFilter(EventQuery q, const StringPool& pool);
+
+    const EventQuery& Query() const { return q_; }
+    bool Empty() const { return empty_; }
+
+    // vollständige Prüfung eines Datensatzes (inkl. Zeit und Text)
+    bool Matches(const EventRecord& e, const StringPool& pool) const;
+
+    // Seriennummer als Pool-Id; 0 = keine Einschränkung bzw. unbekannt
+    std::uint32_t SerialId(const StringPool& pool) const;
+    bool NeedsRecord() const;   // Zeit oder Text: Datensatz muss gelesen werden
+
+private:
+    bool TextHit(std::uint32_t id, const StringPool& pool) const;
+
+    EventQuery  q_;
+    bool        empty_ = true;
+    std::string needle_;   // Kleinbuchstaben (ASCII)
+    mutable std::uint32_t             serial_id_ = 0;
+    mutable std::vector<std::uint8_t> text_hit_;   // je Pool-Id: 0 = offen, 1 = nein, 2 = ja
+};
+
+/**
+ * Sekundärindizes über die Ereignis-Zeilen des Loggers (Position in
+ * LoggerService::Events(), aufsteigend = Einfügereihenfolge).
+ *
+ *  - Kanal, Severity, Art: je Wert eine Bitmap (1 Bit je Zeile) – dicht
+ *    und klein (~3 Byte je Ereignis für alle drei), UND/ODER wortweise;
+ *  - Seriennummer: Postings-Liste je Pool-Id (viele Werte, dünn besetzt);
+ *  - Zeit: Eimer zu 60 s mit erster Zeile; die Zeitgrenzen werden damit
+ *    auf einen Zeilenbereich abgebildet und an den Rändern am Datensatz
+ *    genau geprüft (Einfügereihenfolge ≈ Zeitfolge).
+ *
+ * Query() treibt über die Postings der Seriennummer, sonst wortweise über
+ * die Bitmaps, und prüft Zeit/Text nur für Kandidaten. Add() ist O(1)
+ * amortisiert.
+ */
+class EventIndex {
+public:
+    static constexpr std::uint64_t kBucketNs = 60'000'000'000ull;
+
+    void Add(const EventRecord& e);   // Zeile = Rows() vor dem Aufruf
+    void Clear();
+    size_t Rows() const { return rows_; }
+    size_t MemoryBytes() const;
+
+    // Treffer als Zeilen (aufsteigend) nach out (wird ersetzt)
+    void Query(const EventFilter& f,
+               const std::vector<EventRecord>& entries,
+               const std::vector<std::uint32_t>& events,
+               const StringPool& pool,
+               std::vector<std::uint32_t>& out) const;
+
+private:
+    using Bitmap = std::vector<std::uint64_t>;
+
+    static void Set(Bitmap& b, std::uint32_t row);
+    static std::uint64_t Word(const std::vector<Bitmap>& v, size_t value, size_t w);
+    std::pair<std::uint32_t, std::uint32_t> TimeRows(std::uint64_t from, std::uint64_t to) const;
+
+    size_t              rows_ = 0;
+    std::vector<Bitmap> by_channel_;    // Wert = channel + 1
+    std::vector<Bitmap> by_severity_;
+    std::vector<Bitmap> by_kind_;
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> by_serial_;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> buckets_;   // (Eimer-Beginn, erste Zeile)
+};
@@ -0,0 +1,154 @@
+// EventIndex: Query() muss für jede Filterkombination genau die Zeilen
+// liefern, die EventFilter::Matches() über alle Zeilen findet.
+#include "services/EventIndex.hpp"
+#include "util/TestCheck.hpp"
+
+#include <random>
+
+namespace {
+
+constexpr std::uint64_t kT0 = 1'700'000'000'000'000'000ull;
+
+struct Log {
+    StringPool                 pool;
+    std::vector<EventRecord>   entries;   // auch Nicht-Ereignis-Zeilen
+    std::vector<std::uint32_t> events;    // Zeile → Eintrag
+    EventIndex                 index;
+};
+
+void Fill(Log& log, int rows) {
+    std::mt19937 g(3);
+    const char* serials[] = { "SN-1", "SN-2", "SN-3", "AB-77" };
+    const char* texts[]   = { "Versorgung zu niedrig", "Signal fehlt", "Relais klemmt", "" };
+    std::uint64_t t = kT0;
+    for (int i = 0; i < rows; ++i) {
+        // meist aufsteigend, über mehrere 60-s-Eimer; gelegentlich leicht zurück
+        t += g() % 4 == 0 ? 20'000'000'000ull : 500'000'000ull;
+        EventRecord e;
+        e.t_ns     = g() % 10 == 0 ? t - 300'000'000ull : t;
+        e.channel  = static_cast<std::int8_t>(static_cast<int>(g() % 9) - 1);
+        e.severity = static_cast<std::uint8_t>(g() % 4);
+        e.kind     = static_cast<EventKind>(g() % static_cast<unsigned>(EventKind::Count));
+        e.serial   = g() % 5 ? log.pool.Intern(serials[g() % 4]) : 0;
+        e.text     = log.pool.Intern(texts[g() % 4]);
+        e.category = log.pool.Intern(i % 2 ? "Prüfung" : "System");
+
+        log.entries.push_back(EventRecord{});   // Zeile ohne Ereignis dazwischen
+        log.events.push_back(static_cast<std::uint32_t>(log.entries.size()));
+        log.entries.push_back(e);
+        log.index.Add(e);
+    }
+}
+
+std::vector<std::uint32_t> Brute(const Log& log, const EventFilter& f) {
+    std::vector<std::uint32_t> r;
+    for (std::uint32_t row = 0; row < log.events.size(); ++row)
+        if (f.Matches(log.entries[log.events[row]], log.pool)) r.push_back(row);
+    return r;
+}
+
+bool Agrees(const Log& log, const EventQuery& q) {
+    EventFilter f(q, log.pool);
+    std::vector<std::uint32_t> got;
+    log.index.Query(f, log.entries, log.events, log.pool, got);
+    return got == Brute(log, f);
+}
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestQueriesMatchFilter() {
+    Log log;
+    Fill(log, 3000);
+    CHECK(log.index.Rows() == 3000);
+
+    std::vector<EventQuery> qs;
+    qs.emplace_back();   // leer: alles
+    {
+        EventQuery q; q.channel = 3; qs.push_back(q);
+        q.channel = -1; qs.push_back(q);   // ohne Kanal
+    }
+    {
+        EventQuery q; q.severities = EventQuery::SeverityAtLeast(2); qs.push_back(q);
+        q.kinds = (1u << static_cast<unsigned>(EventKind::SupplyFail)) |
+                  (1u << static_cast<unsigned>(EventKind::Transition));
+        qs.push_back(q);
+        q.channel = 5; qs.push_back(q);
+    }
+    {
+        EventQuery q; q.serial = "SN-2"; qs.push_back(q);
+        q.channel = 0; q.severities = 1u << 3; qs.push_back(q);
+        q = {}; q.serial = "unbekannt"; qs.push_back(q);
+    }
+    {
+        EventQuery q; q.text = "SIGNAL"; qs.push_back(q);   // ohne Groß/Klein
+        q.text = "ab-"; qs.push_back(q);                    // trifft Seriennummer
+        q.text = "prüf"; q.channel = 2; qs.push_back(q);    // trifft Kategorie
+    }
+    {
+        const std::uint64_t span = log.entries.back().t_ns - kT0;
+        EventQuery q; q.t_from_ns = kT0 + span / 3; qs.push_back(q);
+        q.t_to_ns = kT0 + span / 2; qs.push_back(q);
+        q.t_from_ns = 0; qs.push_back(q);
+        q.t_from_ns = kT0 + span / 3; q.t_to_ns = q.t_from_ns + 1; qs.push_back(q);
+        q.serial = "SN-1"; q.t_to_ns = kT0 + span; qs.push_back(q);
+        q = {}; q.t_from_ns = kT0 + 10 * span; qs.push_back(q);   // nach dem Ende
+    }
+
+    for (size_t i = 0; i < qs.size(); ++i) {
+        if (!Agrees(log, qs[i])) {
+            std::fprintf(stderr, "Abfrage %zu weicht ab\n", i);
+            CHECK(!"Query == Brute");
+        }
+    }
+
+    // Zufallsabfragen
+    std::mt19937 g(11);
+    const std::uint64_t span = log.entries.back().t_ns - kT0;
+    bool all = true;
+    for (int k = 0; k < 300; ++k) {
+        EventQuery q;
+        if (g() % 2) q.channel = static_cast<int>(g() % 9) - 1;
+        if (g() % 2) q.severities = g() % 16;
+        if (g() % 3 == 0) q.kinds = g() % (1u << static_cast<unsigned>(EventKind::Count));
+        if (g() % 4 == 0) q.serial = g() % 2 ? "SN-3" : "AB-77";
+        if (g() % 4 == 0) q.text = g() % 2 ? "relais" : "zu";
+        if (g() % 2) q.t_from_ns = kT0 + g() % span;
+        if (g() % 2) q.t_to_ns = kT0 + g() % span;
+        all = all && Agrees(log, q);
+    }
+    CHECK(all);
+}
+
+void TestClearAndIncremental() {
+    Log log;
+    Fill(log, 200);
+    log.index.Clear();
+    CHECK(log.index.Rows() == 0);
+    std::vector<std::uint32_t> out{ 1, 2, 3 };
+    log.index.Query(EventFilter(EventQuery{}, log.pool), log.entries, log.events, log.pool, out);
+    CHECK(out.empty());
+
+    // neu aufbauen, dabei Seriennummer erst nach dem Filter bekannt machen
+    EventQuery q;
+    q.serial = "SN-neu";
+    EventFilter f(q, log.pool);
+    for (std::uint32_t row = 0; row < log.events.size(); ++row) {
+        EventRecord& e = log.entries[log.events[row]];
+        if (row % 10 == 0) e.serial = log.pool.Intern("SN-neu");
+        log.index.Add(e);
+    }
+    log.index.Query(f, log.entries, log.events, log.pool, out);
+    CHECK(out.size() == 20);
+    CHECK(out == Brute(log, f));
+    CHECK(log.index.MemoryBytes() > 0);
+}
+
+void TestSeverityAtLeast() {
+    CHECK(EventQuery::SeverityAtLeast(0) == 0xFFu);
+    CHECK(EventQuery::SeverityAtLeast(2) == 0xFCu);
+    CHECK(EventQuery::SeverityAtLeast(40) == 0u);
+}
+
+} // namespace
+
+TEST_MAIN(TestQueriesMatchFilter, TestClearAndIncremental, TestSeverityAtLeast)
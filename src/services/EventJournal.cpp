@@ -0,0 +1,408 @@
+#include "services/EventJournal.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr char          kMagic[4]   = {'S', 'E', 'J', '1'};
+constexpr std::uint32_t kVersion    = 2;
+constexpr size_t        kHeaderSize = 8;
+constexpr std::uint32_t kMaxPayload = 1u << 20;   // Plausibilität beim Lesen
+
+std::string Errno(const char* what, const std::string& path) {
+    return std::string(what) + "(" + path + "): " + std::strerror(errno);
+}
+
+void PutU16(std::vector<std::uint8_t>& b, std::uint16_t v) {
+    b.push_back(static_cast<std::uint8_t>(v));
+    b.push_back(static_cast<std::uint8_t>(v >> 8));
+}
+void PutU32(std::vector<std::uint8_t>& b, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) b.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+void PutU64(std::vector<std::uint8_t>& b, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) b.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+void PutStr(std::vector<std::uint8_t>& b, const std::string& s) {
+    const size_t n = std::min<size_t>(s.size(), 0xFFFF);
+    PutU16(b, static_cast<std::uint16_t>(n));
+    b.insert(b.end(), s.begin(), s.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+void PutF32(std::vector<std::uint8_t>& b, float v) {
+    std::uint32_t u;
+    std::memcpy(&u, &v, 4);
+    PutU32(b, u);
+}
+
+std::uint64_t GetLE(const std::uint8_t* p, int bytes) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+    return v;
+}
+
+// Daten bis auf das Medium (nicht nur in den Page-Cache)
+bool SyncFile(std::FILE* f) {
+    if (std::fflush(f) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(f)) == 0;
+#elif defined(__APPLE__)
+    return fsync(fileno(f)) == 0;
+#else
+    return fdatasync(fileno(f)) == 0;
+#endif
+}
+bool WriteHeader(std::FILE* f) {
+    std::vector<std::uint8_t> head(kMagic, kMagic + 4);
+    PutU32(head, kVersion);
+    return std::fwrite(head.data(), 1, head.size(), f) == head.size() && SyncFile(f);
+}
+} // namespace
+
+std::uint32_t EventJournal::Crc32(const void* p, size_t n) {
+    static const auto table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    std::uint32_t c = 0xFFFFFFFFu;
+    const auto* b = static_cast<const std::uint8_t*>(p);
+    for (size_t i = 0; i < n; ++i) c = table[(c ^ b[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+void EventJournal::Encode(const Entry& e, std::vector<std::uint8_t>& out) {
+    const size_t at = out.size();
+    PutU32(out, 0);   // Länge/CRC nachtragen
+    PutU32(out, 0);
+    const size_t body = out.size();
+    const EventRecord& r = e.rec;
+    PutU64(out, r.t_ns);
+    for (const float v : r.v) PutF32(out, v);
+    for (const std::uint8_t b : { static_cast<std::uint8_t>(r.kind), r.severity,
+                                  static_cast<std::uint8_t>(r.channel), r.relay, r.aux })
+        out.push_back(b);
+    static const std::string empty;
+    for (const std::string* s : { e.serial, e.text, e.category })
+        PutStr(out, s ? *s : empty);
+
+    const auto len = static_cast<std::uint32_t>(out.size() - body);
+    const std::uint32_t crc = Crc32(out.data() + body, len);
+    for (int i = 0; i < 4; ++i) {
+        out[at + static_cast<size_t>(i)]     = static_cast<std::uint8_t>(len >> (8 * i));
+        out[at + 4 + static_cast<size_t>(i)] = static_cast<std::uint8_t>(crc >> (8 * i));
+    }
+}
+
+bool EventJournal::Decode(const std::uint8_t* p, size_t n, Replayed& e) {
+    constexpr size_t kFixed = 8 + 5 * 4 + 5;
+    if (n < kFixed) return false;
+    EventRecord& r = e.rec;
+    r = EventRecord{};
+    r.t_ns = GetLE(p, 8);
+    for (int i = 0; i < 5; ++i) {
+        const auto u = static_cast<std::uint32_t>(GetLE(p + 8 + 4 * i, 4));
+        std::memcpy(&r.v[i], &u, 4);
+    }
+    const std::uint8_t* b = p + 28;
+    if (b[0] >= static_cast<std::uint8_t>(EventKind::Count)) return false;
+    r.kind     = static_cast<EventKind>(b[0]);
+    r.severity = b[1];
+    r.channel  = static_cast<std::int8_t>(b[2]);
+    r.relay    = b[3];
+    r.aux      = b[4];
+    size_t off = kFixed;
+    for (std::string* s : { &e.serial, &e.text, &e.category }) {
+        if (off + 2 > n) return false;
+        const size_t len = static_cast<size_t>(GetLE(p + off, 2));
+        off += 2;
+        if (off + len > n) return false;
+        s->assign(reinterpret_cast<const char*>(p + off), len);
+        off += len;
+    }
+    return off == n;
+}
+
+bool EventJournal::ReadAll(std::FILE* f, std::vector<Replayed>* replay, off_t* good_end, std::string* err) {
+    std::uint8_t head[kHeaderSize];
+    if (std::fread(head, 1, kHeaderSize, f) != kHeaderSize) { *good_end = 0; return true; }   // leer/angefangen
+    if (std::memcmp(head, kMagic, 4) != 0) {
+        if (err) *err = "kein Ereignis-Journal (Kopf)";
+        return false;
+    }
+    if (GetLE(head + 4, 4) != kVersion) { *good_end = -1; return true; }   // älteres Format
+    *good_end = static_cast<off_t>(kHeaderSize);
+
+    std::vector<std::uint8_t> buf;
+    for (;;) {
+        std::uint8_t rh[8];
+        if (std::fread(rh, 1, 8, f) != 8) break;
+        const auto len = static_cast<std::uint32_t>(GetLE(rh, 4));
+        const auto crc = static_cast<std::uint32_t>(GetLE(rh + 4, 4));
+        if (len > kMaxPayload) break;
+        buf.resize(len);
+        if (std::fread(buf.data(), 1, len, f) != len) break;   // abgerissener Schreibvorgang
+        if (Crc32(buf.data(), len) != crc) break;
+
+        Replayed e;
+        if (!Decode(buf.data(), len, e)) break;
+        if (replay) replay->push_back(std::move(e));
+        *good_end += static_cast<off_t>(8 + len);
+    }
+    return true;
+}
+
+bool EventJournal::Open(const std::string& path, const Options& opt, std::vector<Replayed>* replay, std::string* err) {
+    Close();
+    opt_  = opt;
+    path_ = path;
+    last_err_.clear();
+
+    // Replay + Reparatur: alles nach dem letzten gültigen Datensatz verwerfen
+    off_t good_end = 0;
+    if (std::FILE* r = std::fopen(path.c_str(), "rb")) {
+        const bool ok = ReadAll(r, replay, &good_end, err);
+        fseeko(r, 0, SEEK_END);
+        const off_t size = ftello(r);
+        std::fclose(r);
+        if (!ok) return false;
+        if (good_end < 0) {
+            // anderes Format: beiseitelegen statt verwerfen, neu beginnen
+            std::error_code ec;
+            std::filesystem::rename(path, path + ".alt", ec);
+            if (ec) { if (err) *err = "Journal umbenennen (" + path + "): " + ec.message(); return false; }
+            good_end = 0;
+        } else if (size > good_end) {
+            std::error_code ec;
+            std::filesystem::resize_file(path, static_cast<std::uintmax_t>(good_end), ec);
+            if (ec) { if (err) *err = "Journal kürzen (" + path + "): " + ec.message(); return false; }
+        }
+    }
+
+    f_ = std::fopen(path.c_str(), "ab");
+    if (!f_) { if (err) *err = Errno("fopen", path); return false; }
+    if (good_end == 0) {
+        if (!WriteHeader(f_)) {
+            if (err) *err = Errno("Journal-Kopf", path);
+            std::fclose(f_); f_ = nullptr;
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        queue_.clear();
+        queued_seq_ = synced_seq_ = attempts_ = 0;
+        failed_   = false;
+        sync_req_ = false;
+        writing_  = false;
+        stop_     = false;
+        open_     = true;
+    }
+    thread_ = std::thread([this] { Run(); });
+    return true;
+}
+
+void EventJournal::Close() {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        stop_ = true;
+        open_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();   // Run() leert die Warteschlange
+    std::lock_guard<std::mutex> io(io_mtx_);
+    if (f_) { std::fclose(f_); f_ = nullptr; }
+}
+
+bool EventJournal::IsOpen() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return open_;
+}
+
+std::string EventJournal::LastError() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return last_err_;
+}
+
+void EventJournal::Append(Entry e) {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (!open_) return;
+        if (queue_.empty()) first_ns_ = sosesta::util::MonoNs();
+        queue_.push_back(std::move(e));
+        ++queued_seq_;
+    }
+    stats_.appended.fetch_add(1, std::memory_order_relaxed);
+    cv_.notify_one();
+}
+
+bool EventJournal::Sync() {
+    std::unique_lock<std::mutex> lk(m_);
+    if (!open_) return false;
+    const std::uint64_t target = queued_seq_;
+    const std::uint64_t tried  = attempts_;
+    sync_req_ = true;
+    cv_.notify_one();
+    done_cv_.wait(lk, [&] { return synced_seq_ >= target || (attempts_ > tried && failed_) || stop_; });
+    return synced_seq_ >= target;
+}
+
+bool EventJournal::Clear(std::string* err) {
+    bool closed = false;
+    {
+        // m_ bis nach dem neuen Kopf halten: kein Append() und kein neuer Batch
+        // landet zwischen Sicherung und Kürzen in der alten Datei
+        std::unique_lock<std::mutex> lk(m_);
+        if (!open_) return true;
+        const std::uint64_t target = queued_seq_;
+        const std::uint64_t tried  = attempts_;
+        sync_req_ = true;
+        cv_.notify_one();
+        done_cv_.wait(lk, [&] {
+            return ((synced_seq_ >= target || (attempts_ > tried && failed_)) && !writing_) || stop_;
+        });
+        // nicht Schreibbares wird mit dem Rest ohnehin verworfen
+        queue_.clear();
+        synced_seq_ = queued_seq_;
+        failed_     = false;
+
+        std::lock_guard<std::mutex> io(io_mtx_);   // f_ kann nach einem Schreibfehler zu sein
+
+        // Ersatzdatei mit Kopf, dann umbenennen: die Journaldatei ist nie kopflos
+        const std::string tmp = path_ + ".tmp";
+        std::string msg;
+        std::FILE* t = std::fopen(tmp.c_str(), "wb");
+        bool ok = t && WriteHeader(t);
+        if (t && std::fclose(t) != 0) ok = false;
+        if (!ok) {
+            msg = Errno("Journal-Kopf", tmp);
+            std::remove(tmp.c_str());
+        } else {
+            if (f_) std::fclose(f_);   // Windows: offene Datei lässt sich nicht ersetzen
+            f_ = nullptr;
+            std::error_code ec;
+            std::filesystem::rename(tmp, path_, ec);
+            if (ec) {
+                msg = "Journal ersetzen (" + path_ + "): " + ec.message();
+                std::remove(tmp.c_str());
+            }
+            f_ = std::fopen(path_.c_str(), "ab");   // neue bzw. unveränderte alte Datei
+            if (!f_) {
+                msg = Errno("fopen", path_);
+                closed = true;
+            }
+        }
+        if (msg.empty()) return true;
+
+        last_err_ = msg;
+        if (err) *err = msg;
+        if (closed) open_ = false;   // Append() verwirft ab jetzt
+    }
+    if (closed) Close();   // Writer beenden (nicht unter m_)
+    return false;
+}
+
+bool EventJournal::WriteBatch(const std::vector<Entry>& batch) {
+    // nach einem Fehler neu öffnen (Clear() kann f_ ebenfalls geschlossen haben)
+    if (!f_ && !(f_ = std::fopen(path_.c_str(), "ab"))) return false;
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(path_, ec);   // letzter Batch ist gesichert
+    if (ec) return false;
+
+    std::vector<std::uint8_t> buf;
+    buf.reserve(batch.size() * 64);
+    for (const auto& e : batch) Encode(e, buf);
+    if (std::fwrite(buf.data(), 1, buf.size(), f_) == buf.size() && SyncFile(f_)) return true;
+
+    // Teilweise geschriebenen Batch entfernen, sonst hielte Replay dort an und
+    // verlöre die Wiederholung dahinter; Puffer von stdio mit verwerfen
+    std::fclose(f_);
+    f_ = nullptr;
+    std::filesystem::resize_file(path_, size, ec);
+    return false;
+}
+
+void EventJournal::Run() {
+    Tracer::Instance().SetThreadName("journal");
+    std::vector<Entry> batch;
+    std::unique_lock<std::mutex> lk(m_);
+    for (;;) {
+        cv_.wait(lk, [this] { return stop_ || sync_req_ || !queue_.empty(); });
+
+        // Gruppe sammeln: bis max_batch, max_delay ab dem ersten Eintrag, Sync() oder Stopp
+        if (!stop_ && !sync_req_ && !queue_.empty()) {
+            const auto deadline = std::chrono::steady_clock::time_point(
+                std::chrono::nanoseconds(first_ns_ + std::uint64_t(opt_.max_delay_ms) * 1'000'000ull));
+            cv_.wait_until(lk, deadline, [this] {
+                return stop_ || sync_req_ || queue_.size() >= opt_.max_batch;
+            });
+        }
+
+        batch.swap(queue_);
+        const std::uint64_t seq = queued_seq_;
+        sync_req_ = false;
+        writing_  = !batch.empty();
+        const bool stopping = stop_;
+        lk.unlock();
+
+        bool ok = true;
+        std::string write_err;
+        if (!batch.empty()) {
+            SOSESTA_TRACE_SCOPE("EventJournal::Commit", static_cast<std::int32_t>(batch.size()));
+            const std::uint64_t t0 = sosesta::util::MonoNs();
+            {
+                std::lock_guard<std::mutex> io(io_mtx_);
+                ok = WriteBatch(batch);
+                if (!ok) write_err = Errno("Journal schreiben", path_);
+            }
+            const std::uint64_t us = (sosesta::util::MonoNs() - t0) / 1000;
+            stats_.syncs.fetch_add(1, std::memory_order_relaxed);
+            if (us > stats_.max_sync_us.load(std::memory_order_relaxed))
+                stats_.max_sync_us.store(us, std::memory_order_relaxed);
+            if (!ok) stats_.write_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        lk.lock();
+        if (!batch.empty()) {
+            ++attempts_;
+            failed_ = !ok;
+        }
+        if (ok) {
+            synced_seq_ = seq;
+        } else {
+            last_err_ = write_err;
+            if (stopping) {
+                // beim Schließen nicht endlos wiederholen
+                stats_.dropped.fetch_add(batch.size() + queue_.size(), std::memory_order_relaxed);
+                queue_.clear();
+            } else {
+                // vorn wieder einreihen (Reihenfolge bleibt), nach max_delay_ms erneut
+                batch.insert(batch.end(), std::make_move_iterator(queue_.begin()),
+                             std::make_move_iterator(queue_.end()));
+                queue_.swap(batch);
+                first_ns_ = sosesta::util::MonoNs();
+            }
+        }
+        batch.clear();
+        writing_ = false;
+        done_cv_.notify_all();
+        if (stopping && queue_.empty()) break;
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>   // off_t
+
+#include "services/EventRecord.hpp"
+
+/**
+ * Absturzsicheres Ereignis-Journal (Write-Ahead, nur Anhängen).
+ *
+ * Append() legt den Eintrag nur in eine Warteschlange; ein eigener Thread
+ * schreibt gesammelt und synchronisiert per fdatasync (Group Commit):
+ * spätestens max_delay_ms nach dem ersten ungesicherten Eintrag oder
+ * sobald max_batch Einträge warten. Bei Stromausfall gehen höchstens die
+ * Einträge dieses Fensters verloren, ohne fsync-Latenz je Ereignis.
+ *
+ * Datei
+ *   Kopf       'SEJ1', u32 Version (2)
+ *   Datensatz  u32 Länge, u32 CRC-32 (Nutzdaten), Nutzdaten:
+ *              u64 t_ns, 5 × f32 v, u8 Art, u8 Severity, i8 Kanal,
+ *              u8 Relais, u8 aux, 3 × (u16 Länge + UTF-8): SN, Text, Kategorie
+ *              (EventRecord mit aufgelösten Strings; Text erst beim Anzeigen)
+ *
+ * Open() liest vorhandene Datensätze zurück (Replay) und schneidet einen
+ * beim Absturz halb geschriebenen oder beschädigten Rest ab. Eine Datei
+ * in einem anderen Format wird nach <Pfad>.alt verschoben.
+ */
+class EventJournal {
+public:
+    // Append(): Zeiger auf internierte Strings (StringPool), die das Journal
+    // überleben – so kopiert der Aufrufer nichts auf den Heap
+    struct Entry {
+        EventRecord        rec;
+        const std::string* serial   = nullptr;
+        const std::string* text     = nullptr;
+        const std::string* category = nullptr;
+    };
+
+    // Replay: Strings aufgelöst, Ids in rec ohne Bedeutung
+    struct Replayed {
+        EventRecord rec;
+        std::string serial;
+        std::string text;
+        std::string category;
+    };
+
+    struct Options {
+        std::uint32_t max_delay_ms = 100;   // Fenster bis zur Sicherung
+        size_t        max_batch    = 64;    // früher sichern ab so vielen Einträgen
+    };
+
+    struct Stats {
+        std::atomic<std::uint64_t> appended{0};
+        std::atomic<std::uint64_t> syncs{0};
+        std::atomic<std::uint64_t> max_sync_us{0};
+        std::atomic<std::uint64_t> write_errors{0};
+        std::atomic<std::uint64_t> dropped{0};       // beim Schließen nicht schreibbar
+    };
+
+    EventJournal() = default;
+    ~EventJournal() { Close(); }
+
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&) = delete;
+
+    // replay: gültige Einträge aus der Datei (ohne abgeschnittenen Rest)
+    bool Open(const std::string& path, const Options& opt, std::vector<Replayed>* replay = nullptr,
+              std::string* err = nullptr);
+    void Close();   // schreibt und sichert die Warteschlange
+    bool IsOpen() const;
+
+    void Append(Entry e);                  // nie blockierend auf I/O
+    // Wartet, bis alles Bisherige gesichert ist; false, wenn der Schreibversuch
+    // scheitert (Einträge bleiben in der Warteschlange und werden wiederholt)
+    bool Sync();
+    // Journal leeren (nur Kopf bleibt): alles bis zum Aufruf wird gesichert und
+    // verworfen, Append() wartet solange. Neuer Kopf per Ersatzdatei + rename;
+    // scheitert das, bleibt die alte Datei gültig. Ist danach keine Datei
+    // offen, ist das Journal geschlossen (IsOpen() false, Fehler in *err).
+    bool Clear(std::string* err = nullptr);
+
+    const Stats& GetStats() const { return stats_; }
+    std::string  LastError() const;
+    const std::string& Path() const { return path_; }
+
+    // Format-Hilfen (auch für Werkzeuge)
+    static std::uint32_t Crc32(const void* p, size_t n);
+    static void Encode(const Entry& e, std::vector<std::uint8_t>& out);   // Datensatz inkl. Länge/CRC
+    static bool Decode(const std::uint8_t* p, size_t n, Replayed& e);     // nur Nutzdaten
+
+private:
+    void Run();
+    // io_mtx_ gehalten; bei Fehler wird die Datei auf den Stand davor gekürzt
+    bool WriteBatch(const std::vector<Entry>& batch);
+    static bool ReadAll(std::FILE* f, std::vector<Replayed>* replay, off_t* good_end, std::string* err);
+
+    Options      opt_;
+    std::string  path_;
+    std::FILE*   f_ = nullptr;
+
+    std::mutex              io_mtx_;     // Datei: Writer-Thread ↔ Clear()
+    mutable std::mutex      m_;          // Warteschlange + Zustand
+    std::condition_variable cv_;         // neue Einträge / Sync / Stopp
+    std::condition_variable done_cv_;    // Sync()
+    std::vector<Entry>      queue_;
+    std::uint64_t           first_ns_   = 0;   // erster ungesicherter Eintrag
+    std::uint64_t           queued_seq_ = 0;   // zuletzt angenommen
+    std::uint64_t           synced_seq_ = 0;   // zuletzt gesichert
+    std::uint64_t           attempts_   = 0;   // Schreibversuche (Sync(): neuer Versuch?)
+    bool                    failed_     = false;   // letzter Schreibversuch gescheitert
+    bool                    sync_req_   = false;
+    bool                    writing_    = false;   // Batch unterwegs (außerhalb m_)
+    bool                    stop_       = false;
+    bool                    open_       = false;
+    std::string             last_err_;
+    std::thread             thread_;
+    Stats                   stats_;
+};
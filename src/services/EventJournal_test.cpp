@@ -0,0 +1,291 @@
+// Ereignis-Journal: Replay nach Schließen, abgerissener/beschädigter Rest,
+// fremde Formate, gescheiterte Schreibversuche und Clear().
+#include "services/EventJournal.hpp"
+#include "util/TestCheck.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <csignal>
+#include <sys/resource.h>
+
+namespace {
+
+const std::string kSerial = "SN-4711";
+const std::string kText   = "Versorgung außerhalb";
+const std::string kCat    = "Prüfung";
+
+EventJournal::Entry Make(int i) {
+    EventJournal::Entry e;
+    e.rec.t_ns     = 1'700'000'000'000'000'000ull + static_cast<std::uint64_t>(i) * 1'000'000ull;
+    e.rec.kind     = static_cast<EventKind>(i % static_cast<int>(EventKind::Count));
+    e.rec.severity = static_cast<std::uint8_t>(i % 4);
+    e.rec.channel  = static_cast<std::int8_t>(i % 9 - 1);
+    e.rec.relay    = static_cast<std::uint8_t>(i % 16);
+    e.rec.aux      = static_cast<std::uint8_t>(i % 2);
+    for (int k = 0; k < 5; ++k) e.rec.v[k] = 0.25f * static_cast<float>(i + k);
+    e.serial   = &kSerial;
+    e.text     = i % 3 ? &kText : nullptr;
+    e.category = &kCat;
+    return e;
+}
+
+bool Same(const EventJournal::Replayed& r, int i) {
+    const auto e = Make(i);
+    bool ok = r.rec.t_ns == e.rec.t_ns && r.rec.kind == e.rec.kind && r.rec.severity == e.rec.severity
+           && r.rec.channel == e.rec.channel && r.rec.relay == e.rec.relay && r.rec.aux == e.rec.aux
+           && r.serial == kSerial && r.text == (e.text ? kText : "") && r.category == kCat;
+    for (int k = 0; k < 5; ++k) ok = ok && r.rec.v[k] == e.rec.v[k];
+    return ok;
+}
+
+EventJournal::Options Opt() {
+    EventJournal::Options o;
+    o.max_delay_ms = 1;
+    o.max_batch    = 8;
+    return o;
+}
+
+void AppendRange(EventJournal& j, int from, int to) {
+    for (int i = from; i < to; ++i) j.Append(Make(i));
+}
+
+std::vector<EventJournal::Replayed> Replay(const std::string& path, bool* ok = nullptr) {
+    EventJournal j;
+    std::vector<EventJournal::Replayed> r;
+    const bool o = j.Open(path, Opt(), &r);
+    if (ok) *ok = o;
+    return r;
+}
+
+std::uintmax_t Size(const std::string& path) { return std::filesystem::file_size(path); }
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestEncodeDecode() {
+    std::vector<std::uint8_t> b;
+    EventJournal::Encode(Make(5), b);
+    REQUIRE(b.size() > 8);
+    std::uint32_t len = 0, crc = 0;
+    std::memcpy(&len, b.data(), 4);
+    std::memcpy(&crc, b.data() + 4, 4);
+    CHECK(len == b.size() - 8);
+    CHECK(crc == EventJournal::Crc32(b.data() + 8, len));
+
+    EventJournal::Replayed r;
+    CHECK(EventJournal::Decode(b.data() + 8, len, r));
+    CHECK(Same(r, 5));
+    CHECK(!EventJournal::Decode(b.data() + 8, len - 3, r));   // Strings abgeschnitten
+
+    CHECK(EventJournal::Crc32("123456789", 9) == 0xCBF43926u);   // Prüfwert CRC-32/IEEE
+}
+
+void TestReplay() {
+    const std::string path = sosesta::test::TempPath("replay.sej");
+    {
+        EventJournal j;
+        std::vector<EventJournal::Replayed> r;
+        std::string err;
+        REQUIRE(j.Open(path, Opt(), &r, &err));
+        CHECK(r.empty());
+        AppendRange(j, 0, 100);
+        j.Sync();
+        CHECK(j.GetStats().appended.load() == 100);
+        AppendRange(j, 100, 150);
+    }   // Close() sichert den Rest
+
+    auto r = Replay(path);
+    REQUIRE(r.size() == 150);
+    bool same = true;
+    for (int i = 0; i < 150; ++i) same = same && Same(r[static_cast<size_t>(i)], i);
+    CHECK(same);
+
+    // Anhängen nach dem Wiederöffnen setzt die Folge fort
+    {
+        EventJournal j;
+        REQUIRE(j.Open(path, Opt()));
+        AppendRange(j, 150, 160);
+    }
+    r = Replay(path);
+    REQUIRE(r.size() == 160);
+    CHECK(Same(r.back(), 159));
+    std::filesystem::remove(path);
+}
+
+void TestTornTail() {
+    const std::string path = sosesta::test::TempPath("torn.sej");
+    {
+        EventJournal j;
+        REQUIRE(j.Open(path, Opt()));
+        AppendRange(j, 0, 20);
+    }
+    const auto full = Size(path);
+
+    // halb geschriebener letzter Datensatz
+    std::filesystem::resize_file(path, full - 5);
+    auto r = Replay(path);
+    CHECK(r.size() == 19);
+    CHECK(Size(path) < full - 5);   // Rest abgeschnitten
+
+    // Müll hinter dem letzten gültigen Datensatz
+    const auto good = Size(path);
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::app);
+        f << "\x10\x00\x00\x00garbage-garbage-garbage";
+    }
+    r = Replay(path);
+    CHECK(r.size() == 19);
+    CHECK(Size(path) == good);
+
+    // danach geschriebene Einträge schließen lückenlos an
+    {
+        EventJournal j;
+        REQUIRE(j.Open(path, Opt()));
+        AppendRange(j, 19, 25);
+    }
+    r = Replay(path);
+    REQUIRE(r.size() == 25);
+    bool same = true;
+    for (int i = 0; i < 25; ++i) same = same && Same(r[static_cast<size_t>(i)], i);
+    CHECK(same);
+    std::filesystem::remove(path);
+}
+
+void TestCorruptRecord() {
+    const std::string path = sosesta::test::TempPath("crc.sej");
+    {
+        EventJournal j;
+        REQUIRE(j.Open(path, Opt()));
+        AppendRange(j, 0, 10);
+    }
+    // Datensatz 4 verfälschen: Replay endet davor
+    std::vector<std::uint8_t> one;
+    EventJournal::Encode(Make(0), one);
+    std::vector<char> b;
+    {
+        std::ifstream f(path, std::ios::binary);
+        b.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    size_t off = 8;
+    for (int i = 0; i < 4; ++i) {
+        std::uint32_t len = 0;
+        std::memcpy(&len, b.data() + off, 4);
+        off += 8 + len;
+    }
+    b[off + 12] = static_cast<char>(b[off + 12] ^ 0x01);
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write(b.data(), static_cast<std::streamsize>(b.size()));
+    }
+    auto r = Replay(path);
+    CHECK(r.size() == 4);
+    CHECK(Size(path) == off);
+
+    // unplausible Länge
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::app);
+        const std::uint32_t h[2] = { 0xFFFFFFF0u, 0 };
+        f.write(reinterpret_cast<const char*>(h), sizeof h);
+    }
+    r = Replay(path);
+    CHECK(r.size() == 4);
+    std::filesystem::remove(path);
+}
+
+void TestForeignFiles() {
+    const std::string path = sosesta::test::TempPath("foreign.sej");
+
+    // fremde Datei: nicht anfassen, Fehler melden
+    {
+        std::ofstream f(path, std::ios::binary);
+        f << "not a journal at all";
+    }
+    EventJournal j;
+    std::string err;
+    CHECK(!j.Open(path, Opt(), nullptr, &err));
+    CHECK(!err.empty());
+    CHECK(Size(path) == 20);
+
+    // älteres Journal-Format: nach .alt, neu beginnen
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        const char h[8] = { 'S', 'E', 'J', '1', 1, 0, 0, 0 };
+        f.write(h, sizeof h);
+        f << "old payload";
+    }
+    std::error_code ec;
+    std::filesystem::remove(path + ".alt", ec);
+    std::vector<EventJournal::Replayed> r;
+    CHECK(j.Open(path, Opt(), &r, &err));
+    CHECK(r.empty());
+    CHECK(std::filesystem::exists(path + ".alt"));
+    j.Append(Make(1));
+    j.Close();
+    r = Replay(path);
+    REQUIRE(r.size() == 1);
+    CHECK(Same(r[0], 1));
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".alt");
+}
+
+void TestWriteFailureRetried() {
+    // Dateigrößengrenze des Prozesses lässt den Batch scheitern (EFBIG)
+    const std::string path = sosesta::test::TempPath("efbig.sej");
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit old{};
+    REQUIRE(getrlimit(RLIMIT_FSIZE, &old) == 0);
+    {
+        EventJournal j;
+        REQUIRE(j.Open(path, Opt()));
+        AppendRange(j, 0, 10);
+        CHECK(j.Sync());
+        const std::uintmax_t before = Size(path);
+
+        rlimit lim = old;
+        lim.rlim_cur = static_cast<rlim_t>(before + 100);   // knapp ein Datensatz
+        REQUIRE(setrlimit(RLIMIT_FSIZE, &lim) == 0);
+        AppendRange(j, 10, 30);
+        const bool synced = j.Sync();
+        CHECK(!synced);                           // nicht als gesichert gezählt
+        CHECK(j.GetStats().write_errors.load() >= 1);
+        CHECK(!j.LastError().empty());
+        CHECK(Size(path) == before);              // kein halber Batch in der Datei
+
+        REQUIRE(setrlimit(RLIMIT_FSIZE, &old) == 0);
+        CHECK(j.Sync());                          // Wiederholung gelingt
+        CHECK(j.GetStats().dropped.load() == 0);
+    }
+    const auto r = Replay(path);
+    REQUIRE(r.size() == 30);
+    bool same = true;
+    for (int i = 0; i < 30; ++i) same = same && Same(r[static_cast<size_t>(i)], i);
+    CHECK(same);
+    std::filesystem::remove(path);
+}
+
+void TestClear() {
+    const std::string path = sosesta::test::TempPath("clear.sej");
+    {
+        EventJournal j;
+        REQUIRE(j.Open(path, Opt()));
+        AppendRange(j, 0, 30);
+        std::string err;
+        CHECK(j.Clear(&err));
+        CHECK(j.IsOpen());
+        CHECK(Size(path) == 8);   // nur der Kopf
+        AppendRange(j, 30, 35);
+    }
+    auto r = Replay(path);
+    REQUIRE(r.size() == 5);
+    CHECK(Same(r.front(), 30));
+    CHECK(Same(r.back(), 34));
+    CHECK(!std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+TEST_MAIN(TestEncodeDecode, TestReplay, TestTornTail, TestCorruptRecord, TestForeignFiles,
+          TestWriteFailureRetried, TestClear)
@@ -0,0 +1,117 @@
+#include "services/EventRecord.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace {
+// snprintf mit Längenbegrenzung auf den Puffer
+template <typename... A>
+size_t Put(char* buf, size_t n, const char* fmt, A... a) {
+    if (n == 0) return 0;
+    const int r = std::snprintf(buf, n, fmt, a...);
+    return r < 0 ? 0 : std::min(static_cast<size_t>(r), n - 1);
+}
+
+// Dauer in µs wie im Ereignis-Log: "–" (nicht erreicht), µs bzw. ms
+size_t Micros(double us, char* buf, size_t n) {
+    if (us < 0.0)     return Put(buf, n, "%s", "–");
+    if (us >= 1000.0) return Put(buf, n, "%.2f ms", us / 1000.0);
+    return Put(buf, n, "%.0f µs", us);
+}
+} // namespace
+
+StringPool::StringPool() {
+    strings_.emplace_back();
+    ids_.emplace(std::string_view(strings_.front()), 0u);
+}
+
+std::uint32_t StringPool::Intern(std::string_view s) {
+    if (s.empty()) return 0;
+    if (auto it = ids_.find(s); it != ids_.end()) return it->second;
+    const auto id = static_cast<std::uint32_t>(strings_.size());
+    strings_.emplace_back(s);
+    ids_.emplace(std::string_view(strings_.back()), id);
+    return id;
+}
+
+std::uint32_t StringPool::Find(std::string_view s) const {
+    auto it = ids_.find(s);
+    return it != ids_.end() ? it->second : 0u;
+}
+
+const std::string& StringPool::Get(std::uint32_t id) const {
+    return id < strings_.size() ? strings_[id] : strings_.front();
+}
+
+const char* EventFormat::KindName(EventKind k) {
+    switch (k) {
+        case EventKind::SupplyFail:
+        case EventKind::SupplyOk:    return "Versorgung";
+        case EventKind::SignalFail:
+        case EventKind::SignalOk:    return "Signal";
+        case EventKind::CurrentFail:
+        case EventKind::CurrentOk:   return "Strom";
+        case EventKind::NotDetected: return "Sensor Erkannt";
+        case EventKind::Transition:  return "Übergang";
+        default:                     return "";
+    }
+}
+
+const char* EventFormat::SeverityName(std::uint8_t sev) {
+    static const char* const names[] = { "OK", "INFO", "WARN", "ERROR" };
+    return sev < 4 ? names[sev] : "INFO";
+}
+
+size_t EventFormat::Time(std::uint64_t t_ns, char* buf, size_t n) {
+    const auto t = static_cast<std::time_t>(t_ns / 1'000'000'000ull);
+    std::tm tm{};
+#if defined(_WIN32)
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    return n ? std::strftime(buf, n, "%Y-%m-%d %H:%M:%S", &tm) : 0;
+}
+
+size_t EventFormat::Relay(std::uint8_t relay, char* buf, size_t n) {
+    if (relay == EventRecord::kRelayUnknown) return Put(buf, n, "%s", "");
+    if (relay == 0)                          return Put(buf, n, "%s", "OFF");
+    if (relay == EventRecord::kRelayAll)     return Put(buf, n, "%s", "ON");
+    size_t len = 0;
+    for (int p = 0; p < 4; ++p) {
+        if (!(relay & (1u << p))) continue;
+        len += Put(buf + len, n - len, "%sK%d/%d", len ? "+" : "", 2 * p, 2 * p + 1);
+    }
+    return len;
+}
+
+size_t EventFormat::Detail(const EventRecord& e, const StringPool& pool, char* buf, size_t n) {
+    const float* v = e.v;
+    switch (e.kind) {
+        case EventKind::Message:   // Freitext liegt nicht im Pool (LoggerService::Detail)
+            return 0;
+        case EventKind::SupplyFail:
+            return Put(buf, n, "V=%.2f außerhalb [%.2f, %.2f]", v[0], v[1], v[2]);
+        case EventKind::SignalFail:
+            return Put(buf, n, "RedLab=%.2f außerhalb [%g,%g] / [%g,%g]", v[0], v[1], v[2], v[3], v[4]);
+        case EventKind::CurrentFail:
+            return Put(buf, n, "I=%.2f mA jenseits [%.2f, %.2f] mA", v[0], v[1], v[2]);
+        case EventKind::SupplyOk:
+        case EventKind::SignalOk:
+        case EventKind::CurrentOk:
+            return Put(buf, n, "%s", "wieder OK");
+        case EventKind::NotDetected:
+            return Put(buf, n, "%s", "Sensor nicht erkannt");
+        case EventKind::Transition: {
+            char rise[32], settle[32];
+            Micros(v[2], rise, sizeof(rise));
+            Micros(v[3], settle, sizeof(settle));
+            return Put(buf, n, e.aux ? "%s %.2f→%.2f V: Anstieg %s, Einschwingen %s, Überschwingen %.1f %%"
+                                     : "%s %.2f→%.2f mA: Anstieg %s, Einschwingen %s, Überschwingen %.1f %%",
+                       pool.Get(e.text).c_str(), v[0], v[1], rise, settle, v[4]);
+        }
+        default:
+            return Put(buf, n, "%s", "");
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+/**
+ * Kompakter Ereignis-Datensatz (48 Byte, trivial kopierbar).
+ *
+ * Statt fertiger Texte nur Art, Severity, Kanal, Relais-Maske, Zahlen und
+ * Ids internierter Strings (Seriennummer, Kategorie, Messgröße); Freitext von
+ * Meldungen hält der Logger. Der Anzeigetext entsteht erst beim Anzeigen bzw.
+ * Export (EventFormat).
+ */
+enum class EventKind : std::uint8_t {
+    Message = 0,    // Freitext: category + text
+    SupplyFail,     // v: bus_V, min, max
+    SupplyOk,
+    SignalFail,     // v: redlab_V, neg_min, neg_max, pos_min, pos_max
+    SignalOk,
+    CurrentFail,    // v: current_mA, min, max
+    CurrentOk,
+    NotDetected,
+    Transition,     // v: from, to, rise_us, settle_us, overshoot_pct; text = Größe; aux 1 = Volt
+    Count
+};
+
+struct EventRecord {
+    static constexpr std::uint8_t kRelayUnknown = 0xFF;
+    static constexpr std::uint8_t kRelayAll     = 0x0F;   // alle vier Relaispaare
+
+    std::uint64_t t_ns     = 0;       // Wall-Zeit, ns seit Epoch
+    float         v[5]     = {};      // Zahlen je nach kind
+    std::uint32_t serial   = 0;       // StringPool-Ids, 0 = leer
+    std::uint32_t text     = 0;       // Message: Freitext beim Logger (LoggerService::Text)
+    std::uint32_t category = 0;
+    EventKind     kind     = EventKind::Message;
+    std::uint8_t  severity = 1;       // Metrics::Severity
+    std::int8_t   channel  = -1;      // -1 = keiner
+    std::uint8_t  relay    = kRelayUnknown;   // Bit i = Relaispaar i an
+    std::uint8_t  aux      = 0;
+};
+static_assert(std::is_trivially_copyable_v<EventRecord>);
+static_assert(sizeof(EventRecord) == 48);
+
+// Internierte Strings; Adressen bleiben bis zur Zerstörung gültig (auch
+// für andere Threads, die einen Zeiger erhalten haben). Intern() allokiert
+// nur für neue Strings.
+class StringPool {
+public:
+    StringPool();
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    std::uint32_t      Intern(std::string_view s);
+    std::uint32_t      Find(std::string_view s) const;   // 0 = unbekannt (bzw. "")
+    const std::string& Get(std::uint32_t id) const;
+    size_t             Size() const { return strings_.size(); }
+
+private:
+    std::deque<std::string>                         strings_;   // Id = Index, 0 = ""
+    std::unordered_map<std::string_view, std::uint32_t> ids_;   // Schlüssel zeigen in strings_
+};
+
+// Texte zu einem EventRecord, in einen Puffer (kein Heap); Rückgabe = Länge
+struct EventFormat {
+    static const char* KindName(EventKind k);             // Message → ""
+    static const char* SeverityName(std::uint8_t sev);    // OK/INFO/WARN/ERROR
+    static size_t Time(std::uint64_t t_ns, char* buf, size_t n);   // lokal, JJJJ-MM-TT hh:mm:ss
+    static size_t Relay(std::uint8_t relay, char* buf, size_t n);  // ON/OFF/K0/1+…/""
+    static size_t Detail(const EventRecord& e, const StringPool& pool, char* buf, size_t n);
+};
@@ -0,0 +1,212 @@
+#include "services/HistoryRing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr std::int64_t kCodeMin = std::numeric_limits<std::int16_t>::min();
+constexpr std::int64_t kCodeMax = std::numeric_limits<std::int16_t>::max();
+
+// Festkomma mit Sättigung; clipped wird bei Überlauf gesetzt
+std::int16_t Encode(double v, const HistoryRing::Quant& q, bool& clipped) {
+    const double x = q.scale > 0.0 ? (v - q.offset) / q.scale : v - q.offset;
+    if (!std::isfinite(x)) { clipped = true; return 0; }
+    std::int64_t c = std::llround(std::clamp(x, double(kCodeMin) - 1.0, double(kCodeMax) + 1.0));
+    if (c < kCodeMin || c > kCodeMax) { clipped = true; c = std::clamp(c, kCodeMin, kCodeMax); }
+    return static_cast<std::int16_t>(c);
+}
+} // namespace
+
+void HistoryRing::Series::Clear() {
+    t_ms.clear(); bus_V.clear(); current_mA.clear(); power_mW.clear(); redlab_V.clear(); flags.clear();
+}
+
+void HistoryRing::Reset(const Options& opt) {
+    std::lock_guard<std::mutex> lk(m_);
+    opt_ = opt;
+    opt_.channels = std::max(1, opt_.channels);
+
+    const size_t block_bytes = BytesPerCycle(opt_.channels) * kBlockCycles;
+    max_blocks_ = opt_.max_bytes > 0 ? std::max<size_t>(1, opt_.max_bytes / block_bytes)
+                                     : std::numeric_limits<size_t>::max();
+
+    blocks_.clear();
+    spare_.reset();
+    base_ms_   = 0;
+    last_rel_  = 0;
+    have_base_ = false;
+    next_seq_  = 0;
+    clipped_   = 0;
+}
+
+std::unique_ptr<HistoryRing::Block> HistoryRing::NewBlock() {
+    if (spare_) return std::move(spare_);
+    auto b = std::make_unique<Block>();
+    const size_t ch = static_cast<size_t>(opt_.channels);
+    b->t.resize(kBlockCycles);
+    b->code.resize(ch * kQuantities * kBlockCycles);
+    b->flags.resize(ch * kBlockCycles);
+    return b;
+}
+
+void HistoryRing::Trim(std::uint32_t now_rel) {
+    if (opt_.retention_s <= 0.0) return;
+    const auto keep_ms = static_cast<std::uint64_t>(opt_.retention_s * 1000.0);
+    // ganze Blöcke verwerfen, deren jüngstes Sample zu alt ist
+    while (blocks_.size() > 1) {
+        const Block& f = *blocks_.front();
+        if (std::uint64_t(now_rel) - f.t[f.n - 1] <= keep_ms) break;
+        spare_ = std::move(blocks_.front());
+        blocks_.pop_front();
+    }
+}
+
+void HistoryRing::Append(std::uint64_t t_ms, const std::vector<SensorData>& sensors) {
+    std::lock_guard<std::mutex> lk(m_);
+
+    // u32-Zeitbasis reicht ~49 Tage; danach (oder bei Rücksprung vor den
+    // Beginn) neu anfangen statt falsch zu dekodieren
+    if (have_base_ && (t_ms < base_ms_ || t_ms - base_ms_ > std::numeric_limits<std::uint32_t>::max())) {
+        for (auto& b : blocks_) if (!spare_) spare_ = std::move(b);
+        blocks_.clear();
+        have_base_ = false;
+    }
+    if (!have_base_) { base_ms_ = t_ms; last_rel_ = 0; have_base_ = true; }
+    // monoton halten (Uhr-Korrekturen), sonst findet die Bereichssuche nichts
+    const std::uint32_t rel = std::max(last_rel_, static_cast<std::uint32_t>(t_ms - base_ms_));
+    last_rel_ = rel;
+
+    if (blocks_.empty() || blocks_.back()->n == kBlockCycles) {
+        std::unique_ptr<Block> b;
+        if (blocks_.size() >= max_blocks_) {       // Bytegrenze: ältesten wiederverwenden
+            b = std::move(blocks_.front());
+            blocks_.pop_front();
+        } else {
+            b = NewBlock();
+        }
+        b->first_seq = next_seq_;
+        b->n = 0;
+        blocks_.push_back(std::move(b));
+    }
+    Block& b = *blocks_.back();
+    const size_t slot = b.n;
+    b.t[slot] = rel;
+
+    const size_t nch = static_cast<size_t>(opt_.channels);
+    for (size_t ch = 0; ch < nch; ++ch) {
+        std::int16_t* code = b.code.data() + ch * kQuantities * kBlockCycles + slot;
+        std::uint8_t  f    = 0;
+        if (ch < sensors.size()) {
+            const SensorData& s = sensors[ch];
+            bool clipped = false;
+            code[0]                = Encode(s.bus_V,      opt_.quant[0], clipped);
+            code[kBlockCycles]     = Encode(s.current_mA, opt_.quant[1], clipped);
+            code[2 * kBlockCycles] = Encode(s.redlab_V,   opt_.quant[2], clipped);
+            f = static_cast<std::uint8_t>((s.present ? Present : 0) | (s.supply_ok ? SupplyOk : 0) |
+                                          (s.signal_ok ? SignalOk : 0) | (s.stale ? Stale : 0) |
+                                          (clipped ? Clipped : 0));
+            if (clipped) ++clipped_;
+        } else {
+            code[0] = code[kBlockCycles] = code[2 * kBlockCycles] = 0;
+        }
+        b.flags[ch * kBlockCycles + slot] = f;
+    }
+    ++b.n;
+    ++next_seq_;
+    Trim(rel);
+}
+
+size_t HistoryRing::FirstAtOrAfter(std::uint64_t t_ms) const {
+    if (blocks_.empty()) return next_seq_;
+    const std::uint64_t rel = t_ms > base_ms_ ? t_ms - base_ms_ : 0;
+    // Block per Binärsuche über das jeweils letzte Sample, dann im Block
+    auto it = std::partition_point(blocks_.begin(), blocks_.end(),
+                                   [&](const std::unique_ptr<Block>& b) { return b->t[b->n - 1] < rel; });
+    if (it == blocks_.end()) return next_seq_;
+    const Block& b = **it;
+    const auto p = std::lower_bound(b.t.begin(), b.t.begin() + static_cast<std::ptrdiff_t>(b.n), rel);
+    return b.first_seq + static_cast<size_t>(p - b.t.begin());
+}
+
+size_t HistoryRing::Read(int channel, std::uint64_t t0_ms, std::uint64_t t1_ms, Series& out,
+                         size_t max_points) const {
+    if (channel < 0 || t1_ms < t0_ms) return 0;
+
+    std::uint64_t seq, end, stride = 1;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (channel >= opt_.channels || blocks_.empty()) return 0;
+        seq = FirstAtOrAfter(t0_ms);
+        end = t1_ms == std::numeric_limits<std::uint64_t>::max() ? next_seq_ : FirstAtOrAfter(t1_ms + 1);
+        if (seq >= end) return 0;
+        if (max_points > 0 && end - seq > max_points) stride = (end - seq + max_points - 1) / max_points;
+    }
+
+    const size_t expect = static_cast<size_t>((end - seq + stride - 1) / stride);
+    const size_t before = out.Size();
+    out.t_ms.reserve(before + expect);
+    out.bus_V.reserve(before + expect);
+    out.current_mA.reserve(before + expect);
+    out.power_mW.reserve(before + expect);
+    out.redlab_V.reserve(before + expect);
+    out.flags.reserve(before + expect);
+
+    const size_t ch = static_cast<size_t>(channel);
+    // je Block kurz sperren; inzwischen überschriebene Zyklen überspringen
+    while (seq < end) {
+        std::lock_guard<std::mutex> lk(m_);
+        const std::uint64_t first = SeqBegin();
+        if (blocks_.empty() || seq >= next_seq_ || channel >= opt_.channels) break;
+        if (seq < first) seq += (first - seq + stride - 1) / stride * stride;
+        if (seq >= end) break;
+
+        const size_t bi = static_cast<size_t>((seq - first) / kBlockCycles);
+        const Block& b = *blocks_[bi];
+        const std::uint64_t block_end = std::min<std::uint64_t>(end, b.first_seq + b.n);
+        const std::int16_t* bus = b.code.data() + ch * kQuantities * kBlockCycles;
+        const std::int16_t* cur = bus + kBlockCycles;
+        const std::int16_t* red = cur + kBlockCycles;
+        const std::uint8_t* fl  = b.flags.data() + ch * kBlockCycles;
+        const Quant qb = opt_.quant[0], qc = opt_.quant[1], qr = opt_.quant[2];
+
+        for (; seq < block_end; seq += stride) {
+            const size_t i = static_cast<size_t>(seq - b.first_seq);
+            const double v = qb.offset + qb.scale * bus[i];
+            const double c = qc.offset + qc.scale * cur[i];
+            out.t_ms.push_back(base_ms_ + b.t[i]);
+            out.bus_V.push_back(v);
+            out.current_mA.push_back(c);
+            out.power_mW.push_back(v * c);
+            out.redlab_V.push_back(qr.offset + qr.scale * red[i]);
+            out.flags.push_back(fl[i]);
+        }
+    }
+    return out.Size() - before;
+}
+
+size_t HistoryRing::Cycles() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return static_cast<size_t>(next_seq_ - SeqBegin());
+}
+
+size_t HistoryRing::Bytes() const {
+    std::lock_guard<std::mutex> lk(m_);
+    const size_t blocks = blocks_.size() + (spare_ ? 1 : 0);
+    return blocks * BytesPerCycle(opt_.channels) * kBlockCycles;
+}
+
+std::uint64_t HistoryRing::OldestMs() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return blocks_.empty() ? 0 : base_ms_ + blocks_.front()->t[0];
+}
+
+std::uint64_t HistoryRing::NewestMs() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return blocks_.empty() ? 0 : base_ms_ + last_rel_;
+}
+
+std::uint64_t HistoryRing::ClippedSamples() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return clipped_;
+}
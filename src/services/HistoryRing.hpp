@@ -0,0 +1,111 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "app/data/SensorData.hpp"
+
+/**
+ * Kompakter Messwert-Verlauf im Speicher für lange Läufe (72 h+).
+ *
+ * Je Kanal-Sample: drei int16-Festkommawerte (bus_V, current_mA,
+ * redlab_V; Wert = offset + code · scale) und ein Status-Byte
+ * (present, supply_ok, signal_ok, stale, geclippt) = 7 Byte statt ~100
+ * Byte SensorData. power_mW wird beim Lesen als bus_V · current_mA
+ * berechnet. Die Zykluszeit steht einmal je Zyklus (u32 ms seit Beginn).
+ *
+ * Speicher in Blöcken zu kBlockCycles Zyklen (Struct of Arrays je Kanal),
+ * erst bei Bedarf angelegt; ist die Grenze (Zeit oder Bytes) erreicht,
+ * wird der älteste Block wiederverwendet. Lesen dekodiert blockweise und
+ * gibt die Sperre zwischen Blöcken frei – die Erfassung wartet höchstens
+ * auf einen Block.
+ */
+class HistoryRing {
+public:
+    static constexpr size_t kBlockCycles = 4096;
+    static constexpr int    kQuantities  = 3;   // bus_V, current_mA, redlab_V
+
+    enum Flag : std::uint8_t {
+        Present  = 1 << 0,
+        SupplyOk = 1 << 1,
+        SignalOk = 1 << 2,
+        Stale    = 1 << 3,
+        Clipped  = 1 << 4,   // mindestens ein Wert außerhalb des int16-Bereichs
+    };
+
+    struct Quant {
+        double scale  = 1.0;
+        double offset = 0.0;
+    };
+
+    struct Options {
+        int           channels    = kNumChannels;
+        double        retention_s = 72.0 * 3600.0;   // 0 = nur Bytegrenze
+        size_t        max_bytes   = 128u << 20;      // 0 = nur Zeitgrenze
+        // ±32,7 V @ 1 mV; ±655 mA @ 20 µA; ±10 V @ 16-Bit-DAQ-Auflösung
+        std::array<Quant, kQuantities> quant{ { {0.001, 0.0}, {0.02, 0.0}, {10.0 / 32767.0, 0.0} } };
+    };
+
+    // Dekodierter Bereich eines Kanals (Spalten gleicher Länge)
+    struct Series {
+        std::vector<std::uint64_t> t_ms;
+        std::vector<double>        bus_V;
+        std::vector<double>        current_mA;
+        std::vector<double>        power_mW;
+        std::vector<double>        redlab_V;
+        std::vector<std::uint8_t>  flags;
+        void Clear();
+        size_t Size() const { return t_ms.size(); }
+    };
+
+    HistoryRing() = default;
+    HistoryRing(const HistoryRing&) = delete;
+    HistoryRing& operator=(const HistoryRing&) = delete;
+
+    void Reset(const Options& opt);   // verwirft den Verlauf
+    void Append(std::uint64_t t_ms, const std::vector<SensorData>& sensors);
+
+    // Alle Samples mit t0 ≤ t ≤ t1 (angehängt an out). max_points > 0:
+    // gleichmäßig ausgedünnt auf höchstens so viele Punkte (Plots).
+    size_t Read(int channel, std::uint64_t t0_ms, std::uint64_t t1_ms, Series& out,
+                size_t max_points = 0) const;
+
+    size_t        Cycles() const;
+    size_t        Bytes() const;            // belegter Speicher
+    std::uint64_t OldestMs() const;
+    std::uint64_t NewestMs() const;
+    std::uint64_t ClippedSamples() const;
+    const Options& Opts() const { return opt_; }
+
+    static size_t BytesPerCycle(int channels) {
+        return sizeof(std::uint32_t) + static_cast<size_t>(channels) * (kQuantities * sizeof(std::int16_t) + 1);
+    }
+
+private:
+    struct Block {
+        std::uint64_t              first_seq = 0;   // absoluter Zyklusindex von Slot 0
+        size_t                     n = 0;
+        std::vector<std::uint32_t> t;       // ms seit base_ms_
+        std::vector<std::int16_t>  code;    // [Kanal][Größe][Slot]
+        std::vector<std::uint8_t>  flags;   // [Kanal][Slot]
+    };
+
+    std::unique_ptr<Block> NewBlock();
+    void Trim(std::uint32_t now_rel);
+    size_t FirstAtOrAfter(std::uint64_t t_ms) const;   // absoluter Index; m_ gehalten
+    std::uint64_t SeqBegin() const { return blocks_.empty() ? next_seq_ : blocks_.front()->first_seq; }
+
+    Options                opt_;
+    size_t                 max_blocks_ = 1;
+    mutable std::mutex     m_;
+    std::deque<std::unique_ptr<Block>> blocks_;   // älteste zuerst, lückenlos
+    std::unique_ptr<Block> spare_;                // wiederverwendbar (nach Trim)
+    std::uint64_t          base_ms_  = 0;
+    std::uint32_t          last_rel_ = 0;
+    bool                   have_base_ = false;
+    std::uint64_t          next_seq_ = 0;
+    std::uint64_t          clipped_  = 0;
+};
@@ -0,0 +1,377 @@
+#include "services/LiveStreamServer.hpp"
+#include "services/Tracer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+constexpr size_t kMaxChannelsPerFrame = 256;
+constexpr size_t kMaxKind   = 64;    // Bytes, darüber abgeschnitten
+constexpr size_t kMaxDetail = 256;
+constexpr size_t kTextPerRecord = 128;   // Vorbelegung Textpuffer je Datensatz
+
+void PutVarint(std::vector<std::uint8_t>& b, std::uint64_t v) {
+    while (v >= 0x80) { b.push_back(static_cast<std::uint8_t>(v | 0x80)); v >>= 7; }
+    b.push_back(static_cast<std::uint8_t>(v));
+}
+
+void PutZigzag(std::vector<std::uint8_t>& b, std::int64_t v) {
+    PutVarint(b, (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+}
+
+void PutBytes(std::vector<std::uint8_t>& b, const void* p, size_t n) {
+    const auto* c = static_cast<const std::uint8_t*>(p);
+    b.insert(b.end(), c, c + n);
+}
+
+// Datensatz: Typ, Station, Länge, Nutzdaten
+void PutRecord(std::vector<std::uint8_t>& b, char type, std::uint8_t station, const std::vector<std::uint8_t>& payload) {
+    b.push_back(static_cast<std::uint8_t>(type));
+    b.push_back(station);
+    PutVarint(b, payload.size());
+    b.insert(b.end(), payload.begin(), payload.end());
+}
+
+std::int64_t Code(double v, double res) {
+    if (!std::isfinite(v)) return 0;
+    return res > 0.0 ? std::llround(v / res) : std::llround(v);
+}
+} // namespace
+
+void LiveStreamServer::Batch::Reserve(size_t records) {
+    heads.reserve(records);
+    samples.reserve(records * static_cast<size_t>(kNumChannels));
+    text.reserve(records * kTextPerRecord);
+}
+
+// ── Erfassungsseite ───────────────────────────────────────────────────────
+
+bool LiveStreamServer::PublishFrame(int station, std::uint64_t t_ms, const std::vector<SensorData>& sensors) {
+    if (!running_.load(std::memory_order_relaxed)) return false;
+    const size_t n = std::min(sensors.size(), kMaxChannelsPerFrame);
+    const auto& res = opt_.resolution;
+
+    std::lock_guard<std::mutex> lk(in_mtx_);
+    const std::uint64_t seq = ++seq_[static_cast<std::uint8_t>(station)];   // Lücken sichtbar auch bei Verwerfen
+    if (in_.heads.size() >= in_.heads.capacity() || in_.samples.size() + n > in_.samples.capacity()) {
+        stats_.queue_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Head h{};
+    h.type    = 'F';
+    h.station = static_cast<std::uint8_t>(station);
+    h.t_ms    = t_ms;
+    h.seq     = seq;
+    h.first   = static_cast<std::uint32_t>(in_.samples.size());
+    h.count   = static_cast<std::uint32_t>(n);
+    for (size_t i = 0; i < n; ++i) {
+        const SensorData& s = sensors[i];
+        Sample q;
+        q[0] = Code(s.bus_V, res[0]);
+        q[1] = Code(s.current_mA, res[1]);
+        q[2] = Code(s.power_mW, res[2]);
+        q[3] = Code(s.redlab_V, res[3]);
+        q[4] = (s.present ? 1 : 0) | (s.supply_ok ? 2 : 0) | (s.signal_ok ? 4 : 0) | (s.stale ? 8 : 0);
+        q[5] = s.supply_error_counter;
+        q[6] = s.signal_error_counter;
+        q[7] = s.current_error_counter;
+        q[8] = s.retry_count;
+        q[9] = static_cast<std::int64_t>(s.stale_ms);
+        in_.samples.push_back(q);
+    }
+    in_.heads.push_back(h);
+    stats_.published.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool LiveStreamServer::PublishEvent(int station, std::uint64_t t_ms, int channel, int severity,
+                                    std::string_view kind, std::string_view detail) {
+    if (!running_.load(std::memory_order_relaxed)) return false;
+    const size_t nk = std::min(kind.size(), kMaxKind);
+    const size_t nd = std::min(detail.size(), kMaxDetail);
+
+    std::lock_guard<std::mutex> lk(in_mtx_);
+    if (in_.heads.size() >= in_.heads.capacity() || in_.text.size() + nk + nd > in_.text.capacity()) {
+        stats_.queue_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Head h{};
+    h.type     = 'E';
+    h.station  = static_cast<std::uint8_t>(station);
+    h.t_ms     = t_ms;
+    h.first    = static_cast<std::uint32_t>(in_.text.size());
+    h.count    = static_cast<std::uint32_t>(nk);
+    h.count2   = static_cast<std::uint32_t>(nd);
+    h.channel  = channel;
+    h.severity = static_cast<std::uint8_t>(severity);
+    in_.text.insert(in_.text.end(), kind.data(), kind.data() + nk);
+    in_.text.insert(in_.text.end(), detail.data(), detail.data() + nd);
+    in_.heads.push_back(h);
+    stats_.published.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::vector<LiveStreamServer::ClientInfo> LiveStreamServer::Clients() const {
+    std::lock_guard<std::mutex> lk(clients_mtx_);
+    std::vector<ClientInfo> out;
+    out.reserve(clients_.size());
+    for (const auto& c : clients_) {
+        ClientInfo i = c.info;
+        i.buffered = c.out.size() - c.off;
+        out.push_back(i);
+    }
+    return out;
+}
+
+// ── Kodierung je Abonnent ─────────────────────────────────────────────────
+
+void LiveStreamServer::Deliver(const Batch& b) {
+    std::lock_guard<std::mutex> lk(clients_mtx_);
+    for (const Head& h : b.heads)
+        for (auto& c : clients_)
+            if (c.fd >= 0) Append(c, b, h);
+}
+
+void LiveStreamServer::Append(Client& c, const Batch& b, const Head& h) {
+    pay_.clear();
+    rec_.clear();
+
+    StationRef* ref = nullptr;
+    bool key = false;
+    if (h.type == 'F') {
+        if (c.ref.size() <= h.station) c.ref.resize(static_cast<size_t>(h.station) + 1);
+        ref = &c.ref[h.station];
+        key = !ref->valid || ref->last.size() != h.count || ref->since_key >= opt_.keyframe_every;
+
+        static const Sample zero{};
+        pay_.push_back(key ? 1 : 0);
+        PutVarint(pay_, h.seq);
+        PutZigzag(pay_, static_cast<std::int64_t>(h.t_ms - (key ? 0 : ref->t_ms)));
+        PutVarint(pay_, h.count);
+        for (std::uint32_t i = 0; i < h.count; ++i) {
+            const Sample& cur  = b.samples[h.first + i];
+            const Sample& prev = key ? zero : ref->last[i];
+            std::uint32_t mask = 0;
+            for (int f = 0; f < kFields; ++f)
+                if (cur[f] != prev[f]) mask |= 1u << f;
+            PutVarint(pay_, mask);
+            for (int f = 0; f < kFields; ++f)
+                if (mask & (1u << f)) PutZigzag(pay_, cur[f] - prev[f]);
+        }
+    } else {
+        PutVarint(pay_, h.t_ms);
+        PutZigzag(pay_, h.channel);
+        pay_.push_back(h.severity);
+        PutVarint(pay_, h.count);
+        PutBytes(pay_, b.text.data() + h.first, h.count);
+        PutVarint(pay_, h.count2);
+        PutBytes(pay_, b.text.data() + h.first + h.count, h.count2);
+    }
+
+    // Rückstau: Abonnent liest nicht schnell genug → nur für ihn verwerfen
+    if (c.out.size() - c.off + pay_.size() + 16 > opt_.client_buffer) {
+        ++c.gap;
+        ++c.info.dropped;
+        stats_.client_dropped.fetch_add(1, std::memory_order_relaxed);
+        if (ref) ref->valid = false;
+        return;
+    }
+
+    if (c.gap > 0) {
+        std::vector<std::uint8_t> g;
+        PutVarint(g, c.gap);
+        PutRecord(rec_, 'G', h.station, g);
+        c.gap = 0;
+    }
+    PutRecord(rec_, h.type, h.station, pay_);
+    c.out.insert(c.out.end(), rec_.begin(), rec_.end());
+    ++c.info.records;
+
+    if (ref) {
+        ref->last.assign(b.samples.begin() + h.first, b.samples.begin() + h.first + h.count);
+        ref->t_ms      = h.t_ms;
+        ref->valid     = true;
+        ref->since_key = key ? 1 : ref->since_key + 1;
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+
+bool LiveStreamServer::Start(const Options& opt, std::string* err) {
+    Stop();
+    opt_ = opt;
+
+    sockaddr_un addr{};
+    if (opt_.socket_path.empty()) {
+        if (err) *err = "Kein Socket-Pfad für den Live-Datenstrom";
+        return false;
+    }
+    if (opt_.socket_path.size() >= sizeof(addr.sun_path)) {
+        if (err) *err = "Socket-Pfad zu lang: " + opt_.socket_path;
+        return false;
+    }
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        if (err) *err = std::string("socket(AF_UNIX): ") + std::strerror(errno);
+        return false;
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, opt_.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    ::unlink(opt_.socket_path.c_str()); // Rest eines abgestürzten Laufs
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0 ||
+        ::listen(listen_fd_, 4) < 0) {
+        if (err) *err = "bind/listen(" + opt_.socket_path + "): " + std::strerror(errno);
+        ::close(listen_fd_); listen_fd_ = -1;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(in_mtx_);
+        in_.Clear();
+        in_.Reserve(std::max<size_t>(1, opt_.queue_records));
+    }
+    work_.Clear();
+    work_.Reserve(std::max<size_t>(1, opt_.queue_records));
+    stats_.published = 0; stats_.queue_dropped = 0; stats_.client_dropped = 0;
+    stats_.bytes_sent = 0; stats_.clients = 0;
+
+    running_ = true;
+    thread_ = std::thread([this] { Serve(); });
+    return true;
+}
+
+void LiveStreamServer::Stop() {
+    if (!running_.exchange(false)) return;
+    if (thread_.joinable()) thread_.join();
+    {
+        std::lock_guard<std::mutex> lk(clients_mtx_);
+        for (auto& c : clients_) Close(c);
+        clients_.clear();
+    }
+    stats_.clients = 0;
+    if (listen_fd_ >= 0) { ::close(listen_fd_); listen_fd_ = -1; }
+    ::unlink(opt_.socket_path.c_str());
+}
+
+void LiveStreamServer::Close(Client& c) {
+    if (c.fd >= 0) ::close(c.fd);
+    c.fd = -1;
+}
+
+void LiveStreamServer::Accept() {
+    const int fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) return;
+    std::lock_guard<std::mutex> lk(clients_mtx_);
+    if (static_cast<int>(clients_.size()) >= opt_.max_clients) { ::close(fd); return; }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    Client c;
+    c.fd = fd;
+    c.out.reserve(opt_.client_buffer);
+
+    std::vector<std::uint8_t> hello;
+    hello.push_back(static_cast<std::uint8_t>(kVersion & 0xFF));
+    hello.push_back(static_cast<std::uint8_t>(kVersion >> 8));
+    for (double r : opt_.resolution) PutBytes(hello, &r, sizeof r);   // Pi/x86: Little Endian
+    PutRecord(c.out, 'H', 0, hello);
+
+    clients_.push_back(std::move(c));
+    stats_.clients = static_cast<int>(clients_.size());
+}
+
+bool LiveStreamServer::Flush(Client& c) {
+    while (c.off < c.out.size()) {
+#ifdef MSG_NOSIGNAL
+        const ssize_t w = ::send(c.fd, c.out.data() + c.off, c.out.size() - c.off, MSG_NOSIGNAL);
+#else
+        const ssize_t w = ::send(c.fd, c.out.data() + c.off, c.out.size() - c.off, 0);
+#endif
+        if (w > 0) {
+            c.off += static_cast<size_t>(w);
+            c.info.bytes += static_cast<std::uint64_t>(w);
+            stats_.bytes_sent.fetch_add(static_cast<std::uint64_t>(w), std::memory_order_relaxed);
+            continue;
+        }
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+    if (c.off == c.out.size()) { c.out.clear(); c.off = 0; }
+    else if (c.off > c.out.size() / 2) {
+        c.out.erase(c.out.begin(), c.out.begin() + static_cast<std::ptrdiff_t>(c.off));
+        c.off = 0;
+    }
+    return true;
+}
+
+void LiveStreamServer::Serve() {
+    Tracer::Instance().SetThreadName("stream");
+    std::vector<pollfd> fds;
+    while (running_) {
+        fds.clear();
+        fds.push_back(pollfd{listen_fd_, POLLIN, 0});
+        {
+            std::lock_guard<std::mutex> lk(clients_mtx_);
+            for (const auto& c : clients_)
+                fds.push_back(pollfd{c.fd, static_cast<short>(POLLIN | (c.off < c.out.size() ? POLLOUT : 0)), 0});
+        }
+        // Timeout = Sammelintervall; Publish*() weckt bewusst nicht (kein Syscall)
+        ::poll(fds.data(), fds.size(), std::max(1, opt_.flush_ms));
+
+        {
+            std::lock_guard<std::mutex> lk(clients_mtx_);
+            for (size_t i = 1; i < fds.size() && i - 1 < clients_.size(); ++i) {
+                Client& c = clients_[i - 1];
+                if (fds[i].revents & (POLLHUP | POLLERR | POLLNVAL)) { Close(c); continue; }
+                if (fds[i].revents & POLLIN) {
+                    // Clients senden nichts; Lesen nur zum Erkennen des Schließens
+                    char sink[256];
+                    const ssize_t r = ::recv(c.fd, sink, sizeof sink, 0);
+                    if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) Close(c);
+                }
+            }
+        }
+        if (fds[0].revents & POLLIN) Accept();
+
+        {
+            std::lock_guard<std::mutex> lk(in_mtx_);
+            std::swap(in_, work_);   // O(1), Kapazitäten bleiben erhalten
+        }
+        if (!work_.heads.empty()) {
+            SOSESTA_TRACE_SCOPE("LiveStream::Deliver", static_cast<std::int32_t>(work_.heads.size()));
+            Deliver(work_);
+        }
+        work_.Clear();
+
+        std::lock_guard<std::mutex> lk(clients_mtx_);
+        for (auto& c : clients_)
+            if (c.fd >= 0 && !Flush(c)) Close(c);
+        clients_.erase(std::remove_if(clients_.begin(), clients_.end(),
+                                      [](const Client& c) { return c.fd < 0; }), clients_.end());
+        stats_.clients = static_cast<int>(clients_.size());
+    }
+}
+
+#else // ── ohne POSIX-Sockets ──────────────────────────────
+
+bool LiveStreamServer::Start(const Options& opt, std::string* err) {
+    opt_ = opt;
+    if (err) *err = "Live-Datenstrom auf dieser Plattform nicht verfügbar";
+    return false;
+}
+void LiveStreamServer::Stop() {}
+void LiveStreamServer::Close(Client&) {}
+void LiveStreamServer::Accept() {}
+bool LiveStreamServer::Flush(Client&) { return false; }
+void LiveStreamServer::Serve() {}
+
+#endif
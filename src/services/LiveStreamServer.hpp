@@ -0,0 +1,152 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "app/data/SensorData.hpp"
+
+/**
+ * Live-Datenstrom für externe Werkzeuge (MES-Brücke, Wand-Dashboard).
+ *
+ * Jeder ausgewertete Zyklus und jedes Ereignis geht als kompakter
+ * Binärdatensatz an alle Abonnenten eines Unix-Sockets (SOCK_STREAM,
+ * Clients lesen nur).
+ *
+ * Erfassungsseite: Publish*() quantisiert die Werte in einen
+ * vorbelegten Puffer (kurze Sperre, keine Allokation, kein Syscall). Ist
+ * der Puffer voll, weil der Server-Thread hängt, wird verworfen und gezählt.
+ *
+ * Server-Thread: übernimmt den Puffer per Tausch und kodiert je
+ * Abonnent gegen dessen zuletzt gesendeten Stand (Delta). Jeder Abonnent
+ * hat einen begrenzten Sendepuffer; läuft er voll, werden Datensätze für
+ * diesen Abonnenten verworfen, gezählt und beim nächsten Datensatz als
+ * Lücke gemeldet – der folgende Frame ist dann wieder ein Schlüsselbild.
+ *
+ * Format (Little Endian, varint = LEB128, zigzag für vorzeichenbehaftet)
+ *   Datensatz  u8 Typ, u8 Station, varint Länge, Nutzdaten
+ *   'H' Hallo  u16 Version, 4×f64 Auflösung (bus_V, current_mA, power_mW, redlab_V)
+ *   'F' Frame  u8 Schlüssel(1)/Delta(0), varint seq, zigzag t_ms, varint Kanäle,
+ *              je Kanal varint Feldmaske + je gesetztem Feld zigzag Δ;
+ *              Schlüsselbild = Delta gegen Nullzustand
+ *              Felder: 0..3 Messwert-Codes, 4 Flags (present, supply_ok,
+ *              signal_ok, stale), 5..7 Fehlerzähler, 8 retry_count, 9 stale_ms
+ *   'E' Ereig. varint t_ms, zigzag Kanal, u8 Severity (Metrics::Severity),
+ *              varint+Bytes Art, varint+Bytes Detail (UTF-8)
+ *   'G' Lücke  varint verworfene Datensätze seit dem letzten gesendeten
+ */
+class LiveStreamServer {
+public:
+    static constexpr std::uint16_t kVersion = 1;
+    static constexpr int kFields = 10;
+
+    struct Options {
+        std::string socket_path;
+        size_t      queue_records   = 512;          // Erfassung → Server je Takt
+        size_t      client_buffer   = 256 * 1024;   // Sendepuffer je Abonnent
+        int         keyframe_every  = 100;          // Schlüsselbild spätestens alle n Frames
+        int         flush_ms        = 5;            // max. Latenz Erfassung → Socket
+        int         max_clients     = 16;
+        std::array<double, 4> resolution{ 0.001, 0.001, 0.01, 0.0001 };
+    };
+
+    struct Stats {
+        std::atomic<std::uint64_t> published{0};
+        std::atomic<std::uint64_t> queue_dropped{0};   // Server kam nicht nach
+        std::atomic<std::uint64_t> client_dropped{0};  // Summe über Abonnenten
+        std::atomic<std::uint64_t> bytes_sent{0};
+        std::atomic<int>           clients{0};
+    };
+
+    struct ClientInfo {
+        std::uint64_t records  = 0;
+        std::uint64_t dropped  = 0;
+        std::uint64_t bytes    = 0;
+        size_t        buffered = 0;
+    };
+
+    LiveStreamServer() = default;
+    ~LiveStreamServer() { Stop(); }
+
+    LiveStreamServer(const LiveStreamServer&) = delete;
+    LiveStreamServer& operator=(const LiveStreamServer&) = delete;
+
+    bool Start(const Options& opt, std::string* err = nullptr);
+    void Stop();
+    bool IsRunning() const { return running_.load(); }
+
+    // Nie blockierend (außer der kurzen Puffersperre); false = verworfen
+    bool PublishFrame(int station, std::uint64_t t_ms, const std::vector<SensorData>& sensors);
+    bool PublishEvent(int station, std::uint64_t t_ms, int channel, int severity,
+                      std::string_view kind, std::string_view detail);
+
+    const Stats& GetStats() const { return stats_; }
+    std::vector<ClientInfo> Clients() const;
+
+private:
+    // quantisierter Kanal; gleiche Darstellung für Referenz und Delta
+    using Sample = std::array<std::int64_t, kFields>;
+
+    struct Head {
+        char          type;       // 'F' / 'E'
+        std::uint8_t  station;
+        std::uint64_t t_ms;
+        std::uint64_t seq;        // 'F'
+        std::uint32_t first;      // Index in samples bzw. text
+        std::uint32_t count;      // Kanäle bzw. Länge Art
+        std::uint32_t count2;     // Länge Detail
+        std::int32_t  channel;    // 'E'
+        std::uint8_t  severity;   // 'E'
+    };
+
+    struct Batch {
+        std::vector<Head>   heads;
+        std::vector<Sample> samples;
+        std::vector<char>   text;
+        void Reserve(size_t records);
+        void Clear() { heads.clear(); samples.clear(); text.clear(); }
+    };
+
+    struct StationRef {
+        std::vector<Sample> last;
+        std::uint64_t t_ms      = 0;
+        bool          valid     = false;   // false → nächster Frame ist Schlüsselbild
+        int           since_key = 0;
+    };
+
+    struct Client {
+        int                       fd = -1;
+        std::vector<std::uint8_t> out;
+        size_t                    off = 0;
+        std::uint64_t             gap = 0;   // verworfen, noch nicht gemeldet
+        std::vector<StationRef>   ref;       // je Station
+        ClientInfo                info;
+    };
+
+    void Serve();
+    void Accept();
+    void Deliver(const Batch& b);
+    void Append(Client& c, const Batch& b, const Head& h);
+    bool Flush(Client& c);   // false = Verbindung weg
+    void Close(Client& c);
+
+    Options           opt_;
+    int               listen_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread       thread_;
+    Stats             stats_;
+
+    std::mutex                 in_mtx_;     // nur Publish*() ↔ Tausch im Server
+    Batch                      in_;
+    std::array<std::uint64_t, 256> seq_{};  // je Station, unter in_mtx_
+
+    Batch                      work_;       // nur Server-Thread
+    std::vector<std::uint8_t>  rec_;        // Kodierpuffer (Datensatz), nur Server-Thread
+    std::vector<std::uint8_t>  pay_;        // Kodierpuffer (Nutzdaten), nur Server-Thread
+    mutable std::mutex         clients_mtx_;
+    std::vector<Client>        clients_;
+};
@@ -0,0 +1,287 @@
+// Live-Datenstrom: Abonnent am Unix-Socket dekodiert Hallo, Schlüssel-/
+// Delta-Frames, Ereignisse und Lückenmeldungen und vergleicht mit dem
+// Veröffentlichten.
+#include "services/LiveStreamServer.hpp"
+#include "util/TestCheck.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using Sample = std::array<std::int64_t, LiveStreamServer::kFields>;
+
+struct Record {
+    char                      type    = 0;
+    std::uint8_t              station = 0;
+    std::vector<std::uint8_t> payload;
+};
+
+// ── Abonnent ──────────────────────────────────────────────
+class Client {
+public:
+    explicit Client(const std::string& path) {
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un a{};
+        a.sun_family = AF_UNIX;
+        std::strncpy(a.sun_path, path.c_str(), sizeof(a.sun_path) - 1);
+        if (::connect(fd_, reinterpret_cast<sockaddr*>(&a), sizeof a) < 0) { ::close(fd_); fd_ = -1; }
+    }
+    ~Client() { if (fd_ >= 0) ::close(fd_); }
+    bool Ok() const { return fd_ >= 0; }
+
+    // nächster vollständiger Datensatz; false = Zeitüberschreitung/Verbindung weg
+    bool Next(Record& r, int timeout_ms = 3000) {
+        for (;;) {
+            if (Parse(r)) return true;
+            pollfd p{ fd_, POLLIN, 0 };
+            if (::poll(&p, 1, timeout_ms) <= 0) return false;
+            std::uint8_t tmp[4096];
+            const ssize_t n = ::recv(fd_, tmp, sizeof tmp, 0);
+            if (n <= 0) return false;
+            in_.insert(in_.end(), tmp, tmp + n);
+        }
+    }
+
+private:
+    bool Parse(Record& r) {
+        if (in_.size() < 3) return false;
+        size_t at = 2;
+        std::uint64_t len = 0;
+        for (int shift = 0;; shift += 7) {
+            if (at >= in_.size()) return false;
+            const std::uint8_t b = in_[at++];
+            len |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+        }
+        if (in_.size() < at + len) return false;
+        r.type    = static_cast<char>(in_[0]);
+        r.station = in_[1];
+        r.payload.assign(in_.begin() + static_cast<std::ptrdiff_t>(at),
+                         in_.begin() + static_cast<std::ptrdiff_t>(at + len));
+        in_.erase(in_.begin(), in_.begin() + static_cast<std::ptrdiff_t>(at + len));
+        return true;
+    }
+
+    int fd_ = -1;
+    std::vector<std::uint8_t> in_;
+};
+
+struct Reader {
+    const std::vector<std::uint8_t>& b;
+    size_t at = 0;
+    bool   ok = true;
+
+    std::uint8_t U8() { if (at >= b.size()) { ok = false; return 0; } return b[at++]; }
+    std::uint64_t Varint() {
+        std::uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t c = U8();
+            v |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+            if (!(c & 0x80)) return v;
+        }
+        ok = false;
+        return v;
+    }
+    std::int64_t Zigzag() {
+        const std::uint64_t u = Varint();
+        return static_cast<std::int64_t>(u >> 1) ^ -static_cast<std::int64_t>(u & 1);
+    }
+    std::string Bytes() {
+        const auto n = static_cast<size_t>(Varint());
+        if (at + n > b.size()) { ok = false; return {}; }
+        std::string s(reinterpret_cast<const char*>(b.data() + at), n);
+        at += n;
+        return s;
+    }
+    bool Done() const { return ok && at == b.size(); }
+};
+
+// Zustand je Station auf Abonnentenseite
+struct Decoded {
+    bool                key  = false;
+    std::uint64_t       seq  = 0;
+    std::uint64_t       t_ms = 0;
+    std::vector<Sample> ch;
+};
+
+bool DecodeFrame(const Record& r, Decoded& state) {
+    Reader rd{ r.payload };
+    state.key = rd.U8() == 1;
+    state.seq = rd.Varint();
+    const std::int64_t dt = rd.Zigzag();
+    state.t_ms = state.key ? static_cast<std::uint64_t>(dt) : state.t_ms + static_cast<std::uint64_t>(dt);
+    const auto n = static_cast<size_t>(rd.Varint());
+    if (state.key) state.ch.assign(n, Sample{});
+    if (state.ch.size() != n) return false;
+    for (auto& s : state.ch) {
+        const auto mask = rd.Varint();
+        for (int f = 0; f < LiveStreamServer::kFields; ++f)
+            if (mask & (1u << f)) s[static_cast<size_t>(f)] += rd.Zigzag();
+    }
+    return rd.Done();
+}
+
+SensorData Sensor(int k, int c) {
+    SensorData s;
+    s.channel    = c;
+    s.bus_V      = 5.0 + 0.001 * (k % 3);
+    s.current_mA = 100.0 + k + c;
+    s.power_mW   = 0.01 * (k * 7 + c);
+    s.redlab_V   = k % 4 < 2 ? 2.5 : -2.5;
+    s.present    = true;
+    s.supply_ok  = k % 5 != 0;
+    s.signal_ok  = true;
+    s.stale      = c == 1 && k > 6;
+    s.supply_error_counter = k / 5;
+    s.retry_count = static_cast<std::uint32_t>(c);
+    s.stale_ms   = s.stale ? static_cast<std::uint64_t>(k) * 100 : 0;
+    return s;
+}
+
+Sample Expected(const SensorData& s, const std::array<double, 4>& res) {
+    auto code = [](double v, double r) { return static_cast<std::int64_t>(std::llround(v / r)); };
+    return { code(s.bus_V, res[0]), code(s.current_mA, res[1]), code(s.power_mW, res[2]), code(s.redlab_V, res[3]),
+             (s.present ? 1 : 0) | (s.supply_ok ? 2 : 0) | (s.signal_ok ? 4 : 0) | (s.stale ? 8 : 0),
+             s.supply_error_counter, s.signal_error_counter, s.current_error_counter,
+             static_cast<std::int64_t>(s.retry_count), static_cast<std::int64_t>(s.stale_ms) };
+}
+
+LiveStreamServer::Options Opt(const std::string& path) {
+    LiveStreamServer::Options o;
+    o.socket_path    = path;
+    o.keyframe_every = 4;
+    o.flush_ms       = 1;
+    return o;
+}
+
+bool Hello(Client& c, const LiveStreamServer::Options& o) {
+    Record r;
+    if (!c.Next(r) || r.type != 'H' || r.payload.size() != 2 + 4 * 8) return false;
+    std::uint16_t v = 0;
+    std::memcpy(&v, r.payload.data(), 2);
+    std::array<double, 4> res{};
+    std::memcpy(res.data(), r.payload.data() + 2, sizeof res);
+    return v == LiveStreamServer::kVersion && res == o.resolution;
+}
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestFramesAndEvents() {
+    const std::string path = sosesta::test::TempPath("stream.sock");
+    LiveStreamServer srv;
+    const auto opt = Opt(path);
+    std::string err;
+    REQUIRE(srv.Start(opt, &err));
+    Client c(path);
+    REQUIRE(c.Ok());
+    REQUIRE(Hello(c, opt));
+
+    constexpr int kFrames = 10, kCh = 3;
+    std::vector<std::vector<SensorData>> sent;
+    for (int k = 0; k < kFrames; ++k) {
+        std::vector<SensorData> row;
+        for (int ch = 0; ch < kCh; ++ch) row.push_back(Sensor(k, ch));
+        CHECK(srv.PublishFrame(2, 1000 + 100 * static_cast<std::uint64_t>(k), row));
+        sent.push_back(std::move(row));
+        if (k == 4) CHECK(srv.PublishEvent(2, 1450, 1, 3, "SupplyFail", "Versorgung 4.1 V"));
+    }
+
+    Decoded st;
+    int frames = 0, keys = 0, events = 0;
+    Record r;
+    while (frames < kFrames && c.Next(r)) {
+        CHECK(r.station == 2);
+        if (r.type == 'E') {
+            Reader rd{ r.payload };
+            CHECK(rd.Varint() == 1450);
+            CHECK(rd.Zigzag() == 1);
+            CHECK(rd.U8() == 3);
+            CHECK(rd.Bytes() == "SupplyFail");
+            CHECK(rd.Bytes() == "Versorgung 4.1 V");
+            CHECK(rd.Done());
+            CHECK(frames == 5);   // Reihenfolge wie veröffentlicht
+            ++events;
+            continue;
+        }
+        REQUIRE(r.type == 'F');
+        REQUIRE(DecodeFrame(r, st));
+        const auto k = static_cast<size_t>(frames);
+        CHECK(st.seq == k + 1);
+        CHECK(st.t_ms == 1000 + 100 * k);
+        CHECK(st.key == (k % 4 == 0));   // Schlüsselbild alle keyframe_every Frames
+        keys += st.key;
+        REQUIRE(st.ch.size() == kCh);
+        for (size_t ch = 0; ch < kCh; ++ch) CHECK(st.ch[ch] == Expected(sent[k][ch], opt.resolution));
+        ++frames;
+    }
+    CHECK(frames == kFrames);
+    CHECK(keys == 3);
+    CHECK(events == 1);
+    CHECK(srv.GetStats().published.load() == kFrames + 1);
+    srv.Stop();
+    CHECK(!std::filesystem::exists(path));
+}
+
+void TestGapAndResync() {
+    const std::string path = sosesta::test::TempPath("gap.sock");
+    LiveStreamServer srv;
+    auto opt = Opt(path);
+    opt.client_buffer = 160;   // ein großer Frame passt nicht hinein
+    REQUIRE(srv.Start(opt));
+    Client c(path);
+    REQUIRE(c.Ok());
+    REQUIRE(Hello(c, opt));
+
+    std::vector<SensorData> one{ Sensor(1, 0) };
+    std::vector<SensorData> big;
+    for (int ch = 0; ch < 32; ++ch) big.push_back(Sensor(2, ch));
+    CHECK(srv.PublishFrame(0, 100, one));
+    CHECK(srv.PublishFrame(0, 200, big));   // für diesen Abonnenten verworfen
+    CHECK(srv.PublishFrame(0, 300, one));
+
+    Decoded st;
+    Record r;
+    REQUIRE(c.Next(r));
+    REQUIRE(r.type == 'F');
+    REQUIRE(DecodeFrame(r, st));
+    CHECK(st.key && st.seq == 1);
+
+    REQUIRE(c.Next(r));
+    REQUIRE(r.type == 'G');
+    Reader g{ r.payload };
+    CHECK(g.Varint() == 1);
+    CHECK(g.Done());
+
+    // nach der Lücke wieder Schlüsselbild; seq zeigt die Lücke ebenfalls
+    REQUIRE(c.Next(r));
+    REQUIRE(r.type == 'F');
+    REQUIRE(DecodeFrame(r, st));
+    CHECK(st.key);
+    CHECK(st.seq == 3);
+    CHECK(st.t_ms == 300);
+    REQUIRE(st.ch.size() == 1);
+    CHECK(st.ch[0] == Expected(one[0], opt.resolution));
+    CHECK(srv.GetStats().client_dropped.load() == 1);
+    srv.Stop();
+}
+
+void TestNotRunning() {
+    LiveStreamServer srv;
+    std::string err;
+    CHECK(!srv.PublishFrame(0, 0, { SensorData{} }));
+    LiveStreamServer::Options o;
+    CHECK(!srv.Start(o, &err));   // kein Pfad
+    CHECK(!err.empty());
+}
+
+} // namespace
+
+TEST_MAIN(TestFramesAndEvents, TestGapAndResync, TestNotRunning)
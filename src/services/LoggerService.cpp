@@ -1,10 +1,68 @@
 #include "services/LoggerService.hpp"
 #include <wx/datetime.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "services/ArrowIpcWriter.hpp"
+#include "services/Metrics.hpp"
+
+namespace {
+constexpr size_t kReserve = 4096;   // Einträge; danach amortisiert verdoppeln
+constexpr size_t kTextReserve = 64 * kReserve;   // Byte Freitext
+
+// wxString als UTF-8 nach buf (höchstens n Byte, kein Zeichen zerteilt);
+// utf8_str() legte dafür jedes Mal einen Puffer auf dem Heap an
+size_t Utf8(const wxString& s, char* buf, size_t n) {
+    size_t len = 0;
+    for (const wxUniChar c : s) {
+        const std::uint32_t u = c.GetValue();
+        const size_t k = u < 0x80 ? 1 : u < 0x800 ? 2 : u < 0x10000 ? 3 : 4;
+        if (len + k > n) break;
+        char* p = buf + len;
+        switch (k) {
+            case 1: p[0] = static_cast<char>(u); break;
+            case 2: p[0] = static_cast<char>(0xC0 | (u >> 6));
+                    p[1] = static_cast<char>(0x80 | (u & 0x3F)); break;
+            case 3: p[0] = static_cast<char>(0xE0 | (u >> 12));
+                    p[1] = static_cast<char>(0x80 | ((u >> 6) & 0x3F));
+                    p[2] = static_cast<char>(0x80 | (u & 0x3F)); break;
+            default: p[0] = static_cast<char>(0xF0 | (u >> 18));
+                    p[1] = static_cast<char>(0x80 | ((u >> 12) & 0x3F));
+                    p[2] = static_cast<char>(0x80 | ((u >> 6) & 0x3F));
+                    p[3] = static_cast<char>(0x80 | (u & 0x3F)); break;
+        }
+        len += k;
+    }
+    return len;
+}
+
+// CSV-Feld in Anführungszeichen, innere " verdoppelt
+void PutCsv(std::FILE* f, const char* s, size_t n) {
+    std::fputc('"', f);
+    for (size_t i = 0; i < n; ++i) {
+        if (s[i] == '"') std::fputc('"', f);
+        std::fputc(s[i], f);
+    }
+    std::fputc('"', f);
+}
+} // namespace
+
+LoggerService::LoggerService() {
+    entries_.reserve(kReserve);
+    events_.reserve(kReserve);
+    texts_.reserve(kTextReserve);
+}
 
 wxString LoggerService::NowIso() {
     return wxDateTime::Now().FormatISOCombined(' ');
 }
 
+std::uint64_t LoggerService::NowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
 void LoggerService::Log(const wxString& category,
                         const wxString& message,
                         const wxString& severity,
@@ -12,13 +70,159 @@ void LoggerService::Log(const wxString& category,
                         const wxString& serial,
                         const wxString& relay_state)
 {
+    char buf[128];   // Kategorie, SN, Severity, Relais: kurz
     Entry e;
-    e.timestamp   = NowIso();
-    e.category    = category;
-    e.message     = message;
-    e.severity    = severity;
-    e.channel     = channel;
-    e.serial      = serial;
-    e.relay_state = relay_state;
-    entries_.push_back(std::move(e));
+    e.kind     = EventKind::Message;
+    e.category = strings_.Intern(std::string_view(buf, Utf8(category, buf, sizeof(buf))));
+    e.serial   = strings_.Intern(std::string_view(buf, Utf8(serial, buf, sizeof(buf))));
+    buf[Utf8(severity, buf, sizeof(buf) - 1)] = '\0';
+    e.severity = static_cast<std::uint8_t>(Metrics::SeverityFrom(buf));
+    const std::string_view relay(buf, Utf8(relay_state, buf, sizeof(buf)));
+    e.relay    = relay == "ON"  ? Entry::kRelayAll
+               : relay == "OFF" ? std::uint8_t(0) : Entry::kRelayUnknown;
+    e.channel  = static_cast<std::int8_t>(channel);
+
+    // Meldung direkt in den Textspeicher kodieren (UTF-8 höchstens 4 Byte je Zeichen)
+    if (!message.empty()) {
+        const size_t at = texts_.size();
+        texts_.resize(at + 4 * message.length() + 1);
+        const size_t n = Utf8(message, texts_.data() + at, 4 * message.length());
+        texts_.resize(at + n);
+        texts_.push_back('\0');
+        e.text = static_cast<std::uint32_t>(at + 1);
+    }
+    Record(e);
+}
+
+std::uint32_t LoggerService::AddText(std::string_view s) {
+    if (s.empty()) return 0;
+    const size_t at = texts_.size();
+    texts_.insert(texts_.end(), s.begin(), s.end());
+    texts_.push_back('\0');
+    return static_cast<std::uint32_t>(at + 1);
+}
+
+std::string_view LoggerService::Text(const Entry& e) const {
+    if (e.kind != EventKind::Message || e.text == 0 || e.text > texts_.size()) return {};
+    return texts_.data() + (e.text - 1);
+}
+
+void LoggerService::Record(Entry e) {
+    if (e.t_ns == 0) e.t_ns = NowNs();
+    if (e.kind != EventKind::Message) {
+        events_.push_back(static_cast<std::uint32_t>(entries_.size()));
+        index_.Add(e);
+    }
+    entries_.push_back(e);
+
+    auto& m = Metrics::Instance();
+    m.SetQueueDepth(Metrics::Queue::LoggerEntries, static_cast<std::int64_t>(entries_.size()));
+    m.SetQueueDepth(Metrics::Queue::EventRows, static_cast<std::int64_t>(events_.size()));
+}
+
+void LoggerService::Clear() {
+    entries_.clear();
+    events_.clear();
+    texts_.clear();   // Kapazität bleibt für die nächste Sitzung
+    index_.Clear();
+    Metrics::Instance().SetQueueDepth(Metrics::Queue::LoggerEntries, 0);
+    Metrics::Instance().SetQueueDepth(Metrics::Queue::EventRows, 0);
+}
+
+wxString LoggerService::Time(const Entry& e) const {
+    char buf[32];
+    const size_t n = EventFormat::Time(e.t_ns, buf, sizeof(buf));
+    return wxString::FromUTF8(buf, n);
+}
+
+wxString LoggerService::Kind(const Entry& e) const {
+    if (e.kind == EventKind::Message) return wxString::FromUTF8(strings_.Get(e.category).c_str());
+    return wxString::FromUTF8(EventFormat::KindName(e.kind));
+}
+
+wxString LoggerService::Detail(const Entry& e) const {
+    if (e.kind == EventKind::Message) {
+        const std::string_view t = Text(e);
+        return wxString::FromUTF8(t.data(), t.size());
+    }
+    char buf[256];
+    const size_t n = EventFormat::Detail(e, strings_, buf, sizeof(buf));
+    return wxString::FromUTF8(buf, n);
+}
+
+wxString LoggerService::Serial(const Entry& e) const {
+    const std::string& s = strings_.Get(e.serial);
+    return s.empty() ? wxString("-") : wxString::FromUTF8(s.c_str());
+}
+
+wxString LoggerService::Relay(const Entry& e) const {
+    char buf[32];
+    const size_t n = EventFormat::Relay(e.relay, buf, sizeof(buf));
+    return wxString::FromUTF8(buf, n);
+}
+
+wxString LoggerService::Severity(const Entry& e) {
+    return EventFormat::SeverityName(e.severity);
+}
+
+bool LoggerService::ExportEventsCsv(const std::string& path, std::string* err) const {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) { if (err) *err = "fopen(" + path + "): " + std::strerror(errno); return false; }
+
+    static const unsigned char bom[3] = {0xEF, 0xBB, 0xBF};   // Excel-freundlich
+    std::fwrite(bom, 1, 3, f);
+    std::fputs("Zeit,Kanal,SN,Art,Detail,Relais,Severity\n", f);
+
+    char buf[256];
+    for (const std::uint32_t i : events_) {
+        const Entry& e = entries_[i];
+        size_t n = EventFormat::Time(e.t_ns, buf, sizeof(buf));
+        PutCsv(f, buf, n);
+        std::fprintf(f, ",%d,", e.channel + 1);
+        const std::string& sn = strings_.Get(e.serial);
+        PutCsv(f, sn.empty() ? "-" : sn.c_str(), sn.empty() ? 1 : sn.size());
+        std::fputc(',', f);
+        const char* kind = EventFormat::KindName(e.kind);
+        PutCsv(f, kind, std::strlen(kind));
+        std::fputc(',', f);
+        n = EventFormat::Detail(e, strings_, buf, sizeof(buf));
+        PutCsv(f, buf, n);
+        n = EventFormat::Relay(e.relay, buf, sizeof(buf));
+        std::fprintf(f, ",%.*s,%s\n", static_cast<int>(n), buf, EventFormat::SeverityName(e.severity));
+    }
+
+    const bool ok = std::ferror(f) == 0;
+    if (std::fclose(f) != 0 || !ok) {
+        if (err) *err = "Schreiben fehlgeschlagen: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool LoggerService::ExportEventsArrow(const std::string& path, std::string* err) const {
+    using T = ArrowIpcWriter::Type;
+    enum : size_t { kTime, kChannel, kSerial, kKind, kDetail, kRelay, kSeverity, kV0 };
+    std::vector<ArrowIpcWriter::Field> schema = {
+        {"time", T::TimestampNs}, {"channel", T::Int8}, {"serial", T::Utf8}, {"kind", T::Utf8},
+        {"detail", T::Utf8},      {"relay", T::UInt8},  {"severity", T::Utf8},
+    };
+    for (int i = 0; i < 5; ++i) schema.push_back({"v" + std::to_string(i), T::Float32});
+
+    ArrowIpcWriter out;
+    if (!out.Open(path, std::move(schema), 65536, err)) return false;
+
+    char buf[256];
+    for (const std::uint32_t i : events_) {
+        const Entry& e = entries_[i];
+        out.Col(kTime).Int(static_cast<std::int64_t>(e.t_ns));
+        out.Col(kChannel).Int(e.channel + 1);
+        out.Col(kSerial).Str(strings_.Get(e.serial));
+        out.Col(kKind).Str(EventFormat::KindName(e.kind));
+        out.Col(kDetail).Str(std::string_view(buf, EventFormat::Detail(e, strings_, buf, sizeof(buf))));
+        out.Col(kRelay).Int(e.relay);
+        out.Col(kSeverity).Str(EventFormat::SeverityName(e.severity));
+        for (size_t k = 0; k < 5; ++k) out.Col(kV0 + k).Float(e.v[k]);
+        if (!out.EndRow(err)) return false;
+    }
+    return out.Close(err);
 }
@@ -1,25 +1,33 @@
 #pragma once
 #include <wx/string.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "services/EventIndex.hpp"
+#include "services/EventRecord.hpp"
+
 // Kleiner, GUI-freundlicher Logger mit Speicher im RAM.
-// Optional kannst du später einen Sink ins GUI (MainFrame) anbinden.
+//
+// Einträge sind kompakte EventRecords (48 Byte) mit internierten Strings;
+// Text entsteht erst in den Format-Funktionen (Anzeige, Export). Record()
+// und Log() sind allokationsfrei bis auf das amortisierte Wachsen des
+// Speichers. Freitext (Meldungen mit Pfaden, Zahlen …) wird nicht
+// interniert, sondern liegt im Textspeicher, den Clear() mit leert.
+// Ereignisse laufen zusätzlich in einen EventIndex (Filter/Suche).
 class LoggerService {
 public:
-    struct Entry {
-        wxString timestamp;   // ISO "YYYY-MM-DD HH:MM:SS"
-        wxString category;    // z.B. "Config", "Relais", "Test"
-        wxString message;     // Freitext
-        wxString severity;    // "OK", "INFO", "WARN", "ERROR"
-        int      channel = -1; // -1 = keiner, sonst 0..7
-        wxString serial;      // Seriennummer (falls vorhanden)
-        wxString relay_state; // "ON"/"OFF" oder "-"
-    };
-
-    // Hilfsfunktion: aktuelle Zeit im ISO-Format
+    using Entry = EventRecord;
+
+    LoggerService();
+
+    // Hilfsfunktionen: aktuelle Zeit im ISO-Format bzw. ns seit Epoch
     static wxString NowIso();
+    static std::uint64_t NowNs();
 
-    // Eintrag hinzufügen
+    // Freitext-Eintrag: Kategorie und SN werden interniert, die Meldung
+    // kommt in den Textspeicher
     void Log(const wxString& category,
              const wxString& message,
              const wxString& severity,
@@ -27,12 +35,46 @@ public:
              const wxString& serial = wxString(),
              const wxString& relay_state = wxString());
 
-    // Speicher löschen
-    void Clear() { entries_.clear(); }
+    // Typisiertes Ereignis (Ereignis-Log); t_ns = 0 → jetzt
+    void Record(Entry e);
+    std::uint32_t Intern(std::string_view s) { return strings_.Intern(s); }
+    // Freitext ablegen (nicht interniert); Id für Entry::text bei EventKind::Message
+    std::uint32_t AddText(std::string_view s);
+    std::string_view Text(const Entry& e) const;   // Meldung eines Message-Eintrags
+    const StringPool& Strings() const { return strings_; }
+
+    // Speicher und Textspeicher löschen (internierte Namen bleiben)
+    void Clear();
+
+    // Zugriff (read-only); Events() = Indizes der typisierten Einträge
+    const std::vector<Entry>&         Entries() const { return entries_; }
+    const std::vector<std::uint32_t>& Events()  const { return events_; }
+
+    // Gefilterte Ereignis-Zeilen (Positionen in Events(), aufsteigend)
+    void Query(const EventFilter& f, std::vector<std::uint32_t>& rows) const {
+        index_.Query(f, entries_, events_, strings_, rows);
+    }
+    const EventIndex& Index() const { return index_; }
+
+    // Anzeige-/Exporttexte
+    wxString Time(const Entry& e) const;
+    wxString Kind(const Entry& e) const;      // Message → Kategorie
+    wxString Detail(const Entry& e) const;
+    wxString Serial(const Entry& e) const;    // leer → "-"
+    wxString Relay(const Entry& e) const;
+    static wxString Severity(const Entry& e);
 
-    // Zugriff (read-only)
-    const std::vector<Entry>& Entries() const { return entries_; }
+    // Ereignis-Log als CSV (UTF-8 mit BOM)
+    bool ExportEventsCsv(const std::string& path, std::string* err = nullptr) const;
+    // … als Arrow-IPC (Feather v2): time timestamp[ns, UTC], channel int8,
+    // serial/kind/detail/severity utf8, relay uint8 (Maske, 255 = unbekannt),
+    // v0..v4 float32 (Rohwerte je Art)
+    bool ExportEventsArrow(const std::string& path, std::string* err = nullptr) const;
 
 private:
-    std::vector<Entry> entries_;
+    std::vector<Entry>         entries_;
+    std::vector<std::uint32_t> events_;
+    StringPool                 strings_;
+    std::vector<char>          texts_;   // Meldungen, je mit '\0'; Entry::text = Position + 1
+    EventIndex                 index_;
 };
@@ -0,0 +1,213 @@
+#include "services/Metrics.hpp"
+#include "services/StageProfiler.hpp"
+#include "app/data/SensorData.hpp"
+#include <algorithm>
+#include <cstdio>
+
+Metrics& Metrics::Instance() {
+    static Metrics* inst = new Metrics();
+    return *inst;
+}
+
+Metrics::Station* Metrics::At(int station) {
+    if (station < 0 || station >= kMaxStations) return nullptr;
+    int n = num_stations_.load(std::memory_order_relaxed);
+    while (n <= station && !num_stations_.compare_exchange_weak(n, station + 1, std::memory_order_relaxed)) {}
+    return &stations_[static_cast<size_t>(station)];
+}
+
+void Metrics::OnCycle(int station, std::uint64_t start_ns, std::uint64_t dur_ns, std::uint64_t budget_ns) {
+    Station* st = At(station);
+    if (!st) return;
+    st->cycles.fetch_add(1, std::memory_order_relaxed);
+    if (budget_ns && dur_ns > budget_ns) st->overruns.fetch_add(1, std::memory_order_relaxed);
+    st->last_cycle_s.store(static_cast<double>(dur_ns) / 1e9);
+
+    // Ein Schreiber je Station (ihr Zyklus läuft nie parallel zu sich selbst)
+    const std::uint64_t prev = st->last_cycle_start_ns.exchange(start_ns, std::memory_order_relaxed);
+    if (prev && start_ns > prev) {
+        const double hz   = 1e9 / static_cast<double>(start_ns - prev);
+        const double old  = st->cycle_rate_hz.load();
+        st->cycle_rate_hz.store(old == 0.0 ? hz : old + 0.1 * (hz - old));
+    }
+}
+
+void Metrics::PublishChannels(int station, const std::vector<SensorData>& sensors) {
+    Station* st = At(station);
+    if (!st) return;
+    const int n = std::min<int>(static_cast<int>(sensors.size()), kMaxChannels);
+    st->num_channels.store(std::max(n, st->num_channels.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i) {
+        const SensorData& s = sensors[static_cast<size_t>(i)];
+        Channel& c = st->channels[static_cast<size_t>(i)];
+        c.bus_V.store(s.bus_V);
+        c.current_mA.store(s.current_mA);
+        c.power_mW.store(s.power_mW);
+        c.redlab_V.store(s.redlab_V);
+        c.flags.store(static_cast<std::uint8_t>((s.present ? 1 : 0) | (s.supply_ok ? 2 : 0) | (s.signal_ok ? 4 : 0) |
+                                                (s.stale ? 8 : 0)),
+                      std::memory_order_relaxed);
+        c.supply_err.store(static_cast<std::uint32_t>(s.supply_error_counter), std::memory_order_relaxed);
+        c.signal_err.store(static_cast<std::uint32_t>(s.signal_error_counter), std::memory_order_relaxed);
+        c.current_err.store(static_cast<std::uint32_t>(s.current_error_counter), std::memory_order_relaxed);
+        c.retries.store(s.retry_count, std::memory_order_relaxed);
+        c.stale_ms.store(s.stale_ms, std::memory_order_relaxed);
+        c.updated_ms.store(s.timestamp_ms, std::memory_order_relaxed);
+    }
+}
+
+Metrics::Severity Metrics::SeverityFrom(const char* s) {
+    if (!s) return Severity::Info;
+    if (std::strcmp(s, "OK") == 0)    return Severity::Ok;
+    if (std::strcmp(s, "WARN") == 0)  return Severity::Warn;
+    if (std::strcmp(s, "ERROR") == 0) return Severity::Error;
+    return Severity::Info;
+}
+
+std::string Metrics::RenderPrometheus() const {
+    std::string out;
+    out.reserve(16 * 1024);
+    char line[256];
+
+    auto header = [&](const char* name, const char* type, const char* help) {
+        std::snprintf(line, sizeof line, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+        out += line;
+    };
+    auto value = [&](const char* name, const char* labels, double v) {
+        std::snprintf(line, sizeof line, "%s%s %.9g\n", name, labels, v);
+        out += line;
+    };
+
+    // Zyklus (je Station); übersprungene Perioden prozessweit
+    const int ns = num_stations_.load(std::memory_order_relaxed);
+    auto per_station = [&](const char* name, auto get) {
+        for (int k = 0; k < ns; ++k) {
+            char lbl[32];
+            std::snprintf(lbl, sizeof lbl, "{station=\"%d\"}", k + 1);
+            value(name, lbl, get(stations_[static_cast<size_t>(k)]));
+        }
+    };
+    header("sosesta_cycles_total", "counter", "Completed acquisition cycles.");
+    per_station("sosesta_cycles_total", [](const Station& st) {
+        return static_cast<double>(st.cycles.load(std::memory_order_relaxed)); });
+    header("sosesta_cycle_overruns_total", "counter", "Cycles that exceeded their period.");
+    per_station("sosesta_cycle_overruns_total", [](const Station& st) {
+        return static_cast<double>(st.overruns.load(std::memory_order_relaxed)); });
+    header("sosesta_cycle_skipped_periods_total", "counter", "Periods skipped by the acquisition loop after an overrun.");
+    value("sosesta_cycle_skipped_periods_total", "", static_cast<double>(skipped_.load(std::memory_order_relaxed)));
+    header("sosesta_cycle_rate_hz", "gauge", "Smoothed acquisition cycle rate.");
+    per_station("sosesta_cycle_rate_hz", [](const Station& st) { return st.cycle_rate_hz.load(); });
+    header("sosesta_cycle_last_seconds", "gauge", "Duration of the last acquisition cycle.");
+    per_station("sosesta_cycle_last_seconds", [](const Station& st) { return st.last_cycle_s.load(); });
+
+    // Kanäle: f(Label, Kanal) für jeden Kanal jeder Station
+    auto per_channel = [&](auto f) {
+        for (int k = 0; k < ns; ++k) {
+            const Station& st = stations_[static_cast<size_t>(k)];
+            const int n = st.num_channels.load(std::memory_order_relaxed);
+            for (int i = 0; i < n; ++i) {
+                char lbl[48];
+                std::snprintf(lbl, sizeof lbl, "station=\"%d\",channel=\"%d\"", k + 1, i + 1);
+                f(lbl, st.channels[static_cast<size_t>(i)]);
+            }
+        }
+    };
+    auto labels = [](char* buf, size_t n, const char* base, const char* extra) {
+        std::snprintf(buf, n, "{%s%s}", base, extra);
+        return buf;
+    };
+
+    struct Q { const char* name; const char* help; AtomicDouble Channel::* field; };
+    static const Q quantities[] = {
+        {"sosesta_channel_bus_volts",     "Latest INA219 bus voltage.",   &Channel::bus_V},
+        {"sosesta_channel_current_ma",    "Latest INA219 current (mA).",  &Channel::current_mA},
+        {"sosesta_channel_power_mw",      "Latest INA219 power (mW).",    &Channel::power_mW},
+        {"sosesta_channel_redlab_volts",  "Latest RedLab signal voltage.", &Channel::redlab_V},
+    };
+    for (const auto& q : quantities) {
+        header(q.name, "gauge", q.help);
+        per_channel([&](const char* base, const Channel& c) {
+            char lbl[64];
+            value(q.name, labels(lbl, sizeof lbl, base, ""), (c.*q.field).load());
+        });
+    }
+
+    header("sosesta_channel_ok", "gauge", "Channel status flags (1 = true).");
+    per_channel([&](const char* base, const Channel& c) {
+        const unsigned f = c.flags.load(std::memory_order_relaxed);
+        static const char* names[3] = {",check=\"present\"", ",check=\"supply\"", ",check=\"signal\""};
+        for (int b = 0; b < 3; ++b) {
+            char lbl[96];
+            value("sosesta_channel_ok", labels(lbl, sizeof lbl, base, names[b]), (f >> b) & 1u);
+        }
+    });
+
+    header("sosesta_channel_errors_total", "counter", "Per-channel error counters.");
+    per_channel([&](const char* base, const Channel& c) {
+        const std::pair<const char*, std::uint32_t> errs[3] = {
+            {",kind=\"supply\"",  c.supply_err.load(std::memory_order_relaxed)},
+            {",kind=\"signal\"",  c.signal_err.load(std::memory_order_relaxed)},
+            {",kind=\"current\"", c.current_err.load(std::memory_order_relaxed)},
+        };
+        for (const auto& [kind, cnt] : errs) {
+            char lbl[96];
+            value("sosesta_channel_errors_total", labels(lbl, sizeof lbl, base, kind), cnt);
+        }
+    });
+
+    header("sosesta_channel_stale", "gauge", "1 while the channel's device is in retry backoff.");
+    per_channel([&](const char* base, const Channel& c) {
+        char lbl[64];
+        value("sosesta_channel_stale", labels(lbl, sizeof lbl, base, ""), (c.flags.load(std::memory_order_relaxed) >> 3) & 1u);
+    });
+    header("sosesta_channel_stale_seconds", "gauge", "How long the channel has been stale.");
+    per_channel([&](const char* base, const Channel& c) {
+        char lbl[64];
+        value("sosesta_channel_stale_seconds", labels(lbl, sizeof lbl, base, ""),
+              static_cast<double>(c.stale_ms.load(std::memory_order_relaxed)) / 1e3);
+    });
+    header("sosesta_channel_retries_total", "counter", "Failed device accesses retried later.");
+    per_channel([&](const char* base, const Channel& c) {
+        char lbl[64];
+        value("sosesta_channel_retries_total", labels(lbl, sizeof lbl, base, ""), c.retries.load(std::memory_order_relaxed));
+    });
+
+    // Ereignisse
+    header("sosesta_events_total", "counter", "Logged events by severity.");
+    static const char* sev_names[] = {"ok", "info", "warn", "error"};
+    for (size_t i = 0; i < events_.size(); ++i) {
+        char lbl[48];
+        std::snprintf(lbl, sizeof lbl, "{severity=\"%s\"}", sev_names[i]);
+        value("sosesta_events_total", lbl, static_cast<double>(events_[i].load(std::memory_order_relaxed)));
+    }
+
+    // Warteschlangen
+    header("sosesta_queue_depth", "gauge", "Current depth of internal queues.");
+    static const char* queue_names[] = {"logger_entries", "event_rows", "persist_jobs"};
+    for (size_t i = 0; i < queues_.size(); ++i) {
+        char lbl[48];
+        std::snprintf(lbl, sizeof lbl, "{queue=\"%s\"}", queue_names[i]);
+        value("sosesta_queue_depth", lbl, static_cast<double>(queues_[i].load(std::memory_order_relaxed)));
+    }
+
+    // Stufenlatenzen (aus den StageProfiler-Histogrammen)
+    header("sosesta_stage_latency_seconds", "summary", "Acquisition stage latency.");
+    const auto& prof = StageProfiler::Instance();
+    for (int si = 0; si < static_cast<int>(Stage::Count); ++si) {
+        const Stage s   = static_cast<Stage>(si);
+        const auto  sum = prof.Total(s).Summarize();
+        if (sum.count == 0) continue;
+        const std::pair<const char*, double> qs[4] = {
+            {"0.5", sum.p50_ns}, {"0.99", sum.p99_ns}, {"0.999", sum.p999_ns}, {"1", sum.max_ns}};
+        for (const auto& [q, ns] : qs) {
+            char lbl[80];
+            std::snprintf(lbl, sizeof lbl, "{stage=\"%s\",quantile=\"%s\"}", StageId(s), q);
+            value("sosesta_stage_latency_seconds", lbl, ns / 1e9);
+        }
+        char lbl[48];
+        std::snprintf(lbl, sizeof lbl, "{stage=\"%s\"}", StageId(s));
+        value("sosesta_stage_latency_seconds_count", lbl, static_cast<double>(sum.count));
+        value("sosesta_stage_latency_seconds_sum", lbl, sum.mean_ns * static_cast<double>(sum.count) / 1e9);
+    }
+    return out;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct SensorData;
+
+/**
+ * Prozessweite Kennzahlen für den Prometheus-Endpunkt (MetricsServer).
+ *
+ * Schreiber (Erfassung, GUI) nutzen ausschließlich relaxed atomics,
+ * der Scraper liest ohne Sperre. Ein Scrape kann so nie die Erfassung
+ * ausbremsen; dafür sind Werte verschiedener Kanäle nicht zwingend aus
+ * demselben Zyklus.
+ *
+ * Zyklus- und Kanalwerte liegen je Station (Label station="1"…); je
+ * Station gibt es genau einen Schreiber (ihren TestRunner-Zyklus).
+ */
+class Metrics {
+public:
+    static constexpr int kMaxChannels = 64;
+    static constexpr int kMaxStations = 16;   // wie SOSESTA_STATIONS
+
+    enum class Severity : int { Ok = 0, Info, Warn, Error, Count };
+    enum class Queue    : int { LoggerEntries = 0, EventRows, Persist, Count };
+
+    static Metrics& Instance();
+
+    // ── Zyklus ───────────────────────────────────────────
+    // station 0-basiert (außerhalb 0..kMaxStations-1: ignoriert);
+    // dur_ns = Dauer des Zyklus, budget_ns = Soll-Periode (0 = keine Überlaufprüfung)
+    void OnCycle(int station, std::uint64_t start_ns, std::uint64_t dur_ns, std::uint64_t budget_ns);
+    // Erfassungsthread/-Pool hat n Perioden übersprungen (statt zu driften); prozessweit
+    void OnSkippedPeriods(std::uint64_t n) { skipped_.fetch_add(n, std::memory_order_relaxed); }
+
+    // ── Kanäle ───────────────────────────────────────────
+    void PublishChannels(int station, const std::vector<SensorData>& sensors);
+
+    // ── Ereignisse / Warteschlangen ──────────────────────
+    void OnEvent(Severity sev) { events_[static_cast<size_t>(sev)].fetch_add(1, std::memory_order_relaxed); }
+    static Severity SeverityFrom(const char* s);
+    void SetQueueDepth(Queue q, std::int64_t depth) {
+        queues_[static_cast<size_t>(q)].store(depth, std::memory_order_relaxed);
+    }
+
+    // Prometheus-Textformat (version 0.0.4)
+    std::string RenderPrometheus() const;
+
+private:
+    Metrics() = default;
+
+    // double als Bitmuster in einem atomic<uint64_t> (lock-free auf ARM/x86)
+    struct AtomicDouble {
+        std::atomic<std::uint64_t> bits{0};
+        void store(double v) { std::uint64_t b; std::memcpy(&b, &v, sizeof b); bits.store(b, std::memory_order_relaxed); }
+        double load() const { const std::uint64_t b = bits.load(std::memory_order_relaxed); double v; std::memcpy(&v, &b, sizeof v); return v; }
+    };
+
+    struct Channel {
+        AtomicDouble bus_V, current_mA, power_mW, redlab_V;
+        std::atomic<std::uint8_t>  flags{0};   // Bit0 present, Bit1 supply_ok, Bit2 signal_ok, Bit3 stale
+        std::atomic<std::uint32_t> supply_err{0}, signal_err{0}, current_err{0};
+        std::atomic<std::uint32_t> retries{0};
+        std::atomic<std::uint64_t> stale_ms{0};
+        std::atomic<std::uint64_t> updated_ms{0};
+    };
+
+    struct Station {
+        std::atomic<std::uint64_t>        cycles{0};
+        std::atomic<std::uint64_t>        overruns{0};
+        std::atomic<std::uint64_t>        last_cycle_start_ns{0};
+        AtomicDouble                      cycle_rate_hz;    // EWMA über Zyklusabstände
+        AtomicDouble                      last_cycle_s;
+        std::atomic<int>                  num_channels{0};
+        std::array<Channel, kMaxChannels> channels{};
+    };
+
+    std::atomic<std::uint64_t>          skipped_{0};
+    std::atomic<int>                    num_stations_{0};   // höchster gemeldeter Index + 1
+    std::array<Station, kMaxStations>   stations_{};
+    Station* At(int station);
+
+    std::array<std::atomic<std::uint64_t>, static_cast<size_t>(Severity::Count)> events_{};
+    std::array<std::atomic<std::int64_t>,  static_cast<size_t>(Queue::Count)>    queues_{};
+};
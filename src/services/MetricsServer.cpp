@@ -0,0 +1,149 @@
+#include "services/MetricsServer.hpp"
+#include "services/Metrics.hpp"
+#include "services/Tracer.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+bool MetricsServer::Start(const Options& opt, std::string* err) {
+    Stop();
+    opt_ = opt;
+
+    if (!opt_.unix_socket.empty()) {
+        sockaddr_un addr{};
+        if (opt_.unix_socket.size() >= sizeof(addr.sun_path)) {
+            if (err) *err = "Socket-Pfad zu lang: " + opt_.unix_socket;
+            return false;
+        }
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd_ < 0) {
+            if (err) *err = std::string("socket(AF_UNIX): ") + std::strerror(errno);
+            return false;
+        }
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, opt_.unix_socket.c_str(), sizeof(addr.sun_path) - 1);
+        ::unlink(opt_.unix_socket.c_str()); // Rest eines abgestürzten Laufs
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0) {
+            if (err) *err = "bind(" + opt_.unix_socket + "): " + std::strerror(errno);
+            ::close(listen_fd_); listen_fd_ = -1;
+            return false;
+        }
+    } else {
+        if (opt_.port <= 0 || opt_.port > 65535) {
+            if (err) *err = "Ungültiger Metrics-Port: " + std::to_string(opt_.port);
+            return false;
+        }
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd_ < 0) {
+            if (err) *err = std::string("socket(AF_INET): ") + std::strerror(errno);
+            return false;
+        }
+        int one = 1;
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+
+        // Nur lokal: der Endpunkt hat keine Authentifizierung
+        sockaddr_in addr{};
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(static_cast<std::uint16_t>(opt_.port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0) {
+            if (err) *err = "bind(127.0.0.1:" + std::to_string(opt_.port) + "): " + std::strerror(errno);
+            ::close(listen_fd_); listen_fd_ = -1;
+            return false;
+        }
+    }
+
+    if (::listen(listen_fd_, 4) < 0) {
+        if (err) *err = std::string("listen: ") + std::strerror(errno);
+        ::close(listen_fd_); listen_fd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    thread_ = std::thread([this] { Serve(); });
+    return true;
+}
+
+void MetricsServer::Stop() {
+    if (!running_.exchange(false)) return;
+    if (thread_.joinable()) thread_.join();
+    if (listen_fd_ >= 0) { ::close(listen_fd_); listen_fd_ = -1; }
+    if (!opt_.unix_socket.empty()) ::unlink(opt_.unix_socket.c_str());
+}
+
+void MetricsServer::Serve() {
+    Tracer::Instance().SetThreadName("metrics");
+    while (running_) {
+        // kurzer Timeout, damit Stop() ohne Self-Pipe auskommt
+        pollfd p{listen_fd_, POLLIN, 0};
+        const int r = ::poll(&p, 1, 200);
+        if (r <= 0 || !(p.revents & POLLIN)) continue;
+
+        const int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) continue;
+        HandleClient(fd);
+        ::close(fd);
+    }
+}
+
+void MetricsServer::HandleClient(int fd) {
+    // Anfragezeile lesen (Header werden nicht ausgewertet)
+    char req[1024];
+    size_t n = 0;
+    while (n < sizeof(req) - 1) {
+        pollfd p{fd, POLLIN, 0};
+        if (::poll(&p, 1, 1000) <= 0) return;      // langsamer Client → verwerfen
+        const ssize_t r = ::recv(fd, req + n, sizeof(req) - 1 - n, 0);
+        if (r <= 0) return;
+        n += static_cast<size_t>(r);
+        req[n] = '\0';
+        if (std::strstr(req, "\r\n\r\n") || std::strstr(req, "\n\n")) break;
+    }
+    req[n] = '\0';
+
+    std::string status = "404 Not Found";
+    std::string body   = "Nur GET /metrics\n";
+    std::string type   = "text/plain; charset=utf-8";
+    if (std::strncmp(req, "GET /metrics ", 13) == 0 || std::strncmp(req, "GET /metrics?", 13) == 0) {
+        SOSESTA_TRACE_SCOPE("MetricsServer::Scrape");
+        status = "200 OK";
+        body   = Metrics::Instance().RenderPrometheus();
+        type   = "text/plain; version=0.0.4; charset=utf-8";
+    }
+
+    std::string resp = "HTTP/1.1 " + status + "\r\n"
+                       "Content-Type: " + type + "\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: close\r\n\r\n" + body;
+
+    size_t off = 0;
+    while (off < resp.size()) {
+#ifdef MSG_NOSIGNAL
+        const ssize_t w = ::send(fd, resp.data() + off, resp.size() - off, MSG_NOSIGNAL);
+#else
+        const ssize_t w = ::send(fd, resp.data() + off, resp.size() - off, 0);
+#endif
+        if (w <= 0) return;
+        off += static_cast<size_t>(w);
+    }
+}
+
+#else // ── ohne POSIX-Sockets ──────────────────────────────
+
+bool MetricsServer::Start(const Options& opt, std::string* err) {
+    opt_ = opt;
+    if (err) *err = "Metrics-Endpunkt auf dieser Plattform nicht verfügbar";
+    return false;
+}
+void MetricsServer::Stop() {}
+void MetricsServer::Serve() {}
+void MetricsServer::HandleClient(int) {}
+
+#endif
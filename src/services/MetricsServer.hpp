@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * Minimaler HTTP-Listener für Prometheus: GET /metrics → Metrics::RenderPrometheus().
+ *
+ * Bindet entweder an 127.0.0.1:<port> oder an einen Unix-Socket. Ein eigener
+ * Thread bedient die Anfragen nacheinander; die Kennzahlen werden lock-frei
+ * gelesen, ein Scrape blockiert die Erfassung also nicht.
+ */
+class MetricsServer {
+public:
+    struct Options {
+        int         port        = 9105;   // TCP auf 127.0.0.1; 0 = kein TCP
+        std::string unix_socket;          // falls gesetzt: statt TCP
+    };
+
+    MetricsServer() = default;
+    ~MetricsServer() { Stop(); }
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    bool Start(const Options& opt, std::string* err = nullptr);
+    void Stop();
+    bool IsRunning() const { return running_.load(); }
+
+private:
+    void Serve();
+    void HandleClient(int fd);
+
+    Options           opt_;
+    int               listen_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread       thread_;
+};
@@ -0,0 +1,59 @@
+// Metrics: Zyklus- und Kanalwerte je Station (Label station), Stationen
+// schreiben parallel ohne sich zu stören
+#include "services/Metrics.hpp"
+#include "app/data/SensorData.hpp"
+#include "util/TestCheck.hpp"
+
+#include <thread>
+
+namespace {
+
+bool Has(const std::string& text, const std::string& line) {
+    return text.find(line + "\n") != std::string::npos;
+}
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestStationsSeparate() {
+    auto& m = Metrics::Instance();
+    constexpr int kCycles = 2000;
+
+    // Station 1: 1 kHz, Station 2: 100 Hz, je eigener Thread
+    auto run = [&](int station, std::uint64_t period_ns, double bus_V) {
+        std::vector<SensorData> s(static_cast<size_t>(4 + station));
+        for (auto& d : s) d.bus_V = bus_V;
+        for (int k = 0; k < kCycles; ++k) {
+            m.OnCycle(station, (k + 1) * period_ns, 1000, 0);
+            m.PublishChannels(station, s);
+        }
+    };
+    std::thread a(run, 0, 1'000'000ull, 5.0);
+    std::thread b(run, 1, 10'000'000ull, 12.0);
+    a.join();
+    b.join();
+
+    const std::string out = m.RenderPrometheus();
+    CHECK(Has(out, "sosesta_cycles_total{station=\"1\"} 2000"));
+    CHECK(Has(out, "sosesta_cycles_total{station=\"2\"} 2000"));
+    CHECK(Has(out, "sosesta_cycle_rate_hz{station=\"1\"} 1000"));
+    CHECK(Has(out, "sosesta_cycle_rate_hz{station=\"2\"} 100"));
+
+    // jede Station mit eigener Kanalzahl und eigenen Werten
+    CHECK(Has(out, "sosesta_channel_bus_volts{station=\"1\",channel=\"4\"} 5"));
+    CHECK(!Has(out, "sosesta_channel_bus_volts{station=\"1\",channel=\"5\"} 5"));
+    CHECK(Has(out, "sosesta_channel_bus_volts{station=\"2\",channel=\"5\"} 12"));
+    CHECK(Has(out, "sosesta_channel_ok{station=\"2\",channel=\"1\",check=\"supply\"} 0"));
+}
+
+void TestStationOutOfRange() {
+    auto& m = Metrics::Instance();
+    m.OnCycle(-1, 1, 1, 0);
+    m.OnCycle(Metrics::kMaxStations, 1, 1, 0);
+    const std::string out = m.RenderPrometheus();
+    CHECK(out.find("station=\"0\"") == std::string::npos);
+    CHECK(out.find("station=\"" + std::to_string(Metrics::kMaxStations + 1) + "\"") == std::string::npos);
+}
+
+} // namespace
+
+TEST_MAIN(TestStationsSeparate, TestStationOutOfRange)
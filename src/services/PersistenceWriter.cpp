@@ -0,0 +1,77 @@
+#include "services/PersistenceWriter.hpp"
+#include "services/Metrics.hpp"
+#include "services/Tracer.hpp"
+
+#include <algorithm>
+
+void PersistenceWriter::Start(size_t max_queue) {
+    Stop();
+    std::lock_guard<std::mutex> lk(m_);
+    max_queue_ = std::max<size_t>(1, max_queue);
+    running_   = true;
+    thread_    = std::thread([this] { Run(); });
+}
+
+void PersistenceWriter::Stop() {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+bool PersistenceWriter::IsRunning() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return running_;
+}
+
+bool PersistenceWriter::Post(Job job) {
+    size_t depth;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (!running_ || queue_.size() >= max_queue_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queue_.push_back(std::move(job));
+        depth = queue_.size();
+    }
+    cv_.notify_one();
+    Metrics::Instance().SetQueueDepth(Metrics::Queue::Persist, static_cast<std::int64_t>(depth));
+    return true;
+}
+
+void PersistenceWriter::Drain() {
+    std::unique_lock<std::mutex> lk(m_);
+    idle_cv_.wait(lk, [this] { return queue_.empty() && !busy_; });
+}
+
+size_t PersistenceWriter::Depth() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return queue_.size();
+}
+
+void PersistenceWriter::Run() {
+    Tracer::Instance().SetThreadName("persist");
+    std::unique_lock<std::mutex> lk(m_);
+    for (;;) {
+        cv_.wait(lk, [this] { return !running_ || !queue_.empty(); });
+        if (queue_.empty()) break;   // gestoppt und leer
+
+        Job job = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        const auto depth = static_cast<std::int64_t>(queue_.size());
+        lk.unlock();
+
+        Metrics::Instance().SetQueueDepth(Metrics::Queue::Persist, depth);
+        job();
+
+        lk.lock();
+        busy_ = false;
+        if (queue_.empty()) idle_cv_.notify_all();
+    }
+    busy_ = false;
+    idle_cv_.notify_all();
+}
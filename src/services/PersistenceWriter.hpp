@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Gemeinsamer Schreib-Thread für alle Stationen.
+ *
+ * Der Erfassungszyklus stellt Schreibaufträge (Archiv-Append o. Ä.) nur in
+ * die Warteschlange und kehrt sofort zurück; Dateizugriffe laufen
+ * nacheinander auf einem Thread, damit langsame Speicher (SD-Karte) den
+ * Takt der Stationen nicht stören. Ist die Warteschlange voll, wird der
+ * Auftrag verworfen und gezählt statt den Zyklus zu blockieren.
+ */
+class PersistenceWriter {
+public:
+    using Job = std::function<void()>;
+
+    PersistenceWriter() = default;
+    ~PersistenceWriter() { Stop(); }
+
+    PersistenceWriter(const PersistenceWriter&) = delete;
+    PersistenceWriter& operator=(const PersistenceWriter&) = delete;
+
+    void Start(size_t max_queue = 4096);
+    void Stop();   // arbeitet die Warteschlange noch ab
+    bool IsRunning() const;
+
+    // false = nicht gestartet oder Warteschlange voll (Auftrag verworfen)
+    bool Post(Job job);
+    // wartet, bis alle bisher angenommenen Aufträge erledigt sind
+    void Drain();
+
+    size_t        Depth() const;
+    std::uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void Run();
+
+    mutable std::mutex      m_;
+    std::condition_variable cv_;        // neue Aufträge / Stopp
+    std::condition_variable idle_cv_;   // Drain()
+    std::deque<Job>         queue_;
+    size_t                  max_queue_ = 4096;
+    bool                    running_   = false;
+    bool                    busy_      = false;
+    std::thread             thread_;
+    std::atomic<std::uint64_t> dropped_{0};
+};
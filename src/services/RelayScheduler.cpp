@@ -0,0 +1,72 @@
+#include "services/RelayScheduler.hpp"
+#include <algorithm>
+
+void RelayScheduler::Reset(int pairs) {
+    pair_.assign(static_cast<size_t>(std::clamp(pairs, 0, 32)), Pair{});
+    active_ = false;
+}
+
+void RelayScheduler::Start(const Options& opt, std::uint64_t now_ns) {
+    Reset(opt.pairs);
+    const std::uint64_t base = std::max<std::uint64_t>(opt.interval_ns, 1);
+    const std::uint64_t n    = std::max<std::uint64_t>(pair_.size(), 1);
+    for (size_t i = 0; i < pair_.size(); ++i) {
+        Pair& p = pair_[i];
+        p.interval_ns = (i < opt.pair_interval_ns.size() && opt.pair_interval_ns[i] > 0)
+                        ? opt.pair_interval_ns[i] : base;
+        // gleichmäßig im Prüfintervall verteilt; Paar 0 schaltet sofort
+        p.offset_ns = opt.stagger ? base * i / n : 0;
+        p.next_ns   = now_ns + p.offset_ns;
+    }
+    active_ = !pair_.empty();
+}
+
+std::uint32_t RelayScheduler::Due(std::uint64_t now_ns) {
+    if (!active_) return 0;
+    std::uint32_t due = 0;
+    for (size_t i = 0; i < pair_.size(); ++i) {
+        Pair& p = pair_[i];
+        if (now_ns < p.next_ns) continue;
+        due |= 1u << i;
+        // nächster Termin im Raster, auch nach mehreren versäumten
+        const std::uint64_t missed = (now_ns - p.next_ns) / p.interval_ns;
+        p.next_ns += (missed + 1) * p.interval_ns;
+    }
+    return due;
+}
+
+void RelayScheduler::Switched(std::uint32_t pairs) {
+    for (size_t i = 0; i < pair_.size(); ++i)
+        if (pairs & (1u << i)) ++pair_[i].phase;
+}
+
+void RelayScheduler::SetAll(bool on) {
+    for (auto& p : pair_)
+        if (static_cast<bool>(p.phase & 1u) != on) ++p.phase;
+}
+
+std::uint32_t RelayScheduler::Phase(int p) const {
+    return p >= 0 && p < Pairs() ? pair_[static_cast<size_t>(p)].phase : 0;
+}
+
+std::uint32_t RelayScheduler::Mask() const {
+    std::uint32_t m = 0;
+    for (size_t i = 0; i < pair_.size(); ++i)
+        if (pair_[i].phase & 1u) m |= 1u << i;
+    return m;
+}
+
+std::uint64_t RelayScheduler::Offset(int p) const {
+    return p >= 0 && p < Pairs() ? pair_[static_cast<size_t>(p)].offset_ns : 0;
+}
+
+std::uint64_t RelayScheduler::Interval(int p) const {
+    return p >= 0 && p < Pairs() ? pair_[static_cast<size_t>(p)].interval_ns : 0;
+}
+
+std::uint64_t RelayScheduler::NextDue() const {
+    if (!active_) return 0;
+    std::uint64_t next = UINT64_MAX;
+    for (const auto& p : pair_) next = std::min(next, p.next_ns);
+    return next;
+}
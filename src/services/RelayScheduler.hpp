@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * Zeitplan für die Relaispaare eines Prüflaufs.
+ *
+ * Jedes Paar hat eigenen Phasenversatz und eigenes Intervall; bei
+ * stagger liegen die Versätze gleichmäßig im Prüfintervall (Paar i bei
+ * i·Intervall/Paare), sonst schalten alle gemeinsam wie bisher. So
+ * verteilen sich Einschaltstrom, Buslast und Auswertung der Übergänge
+ * über die Periode statt auf einen Zeitpunkt.
+ *
+ * Due() liefert die fälligen Paare und rückt deren Termine weiter; den
+ * Zustand ändert erst Switched(), wenn die Flanke tatsächlich geschaltet
+ * wurde (bei Übergangsmessung erst nach dem Vorlauf). Die Phase eines
+ * Paars zählt die Flanken seit Start/Reset: ungerade = EIN.
+ *
+ * Nicht thread-sicher (TestRunner hält hw_mtx_).
+ */
+class RelayScheduler {
+public:
+    struct Options {
+        int                        pairs       = 4;
+        std::uint64_t              interval_ns = 10'000'000'000ull;   // Prüfintervall
+        std::vector<std::uint64_t> pair_interval_ns;   // je Paar, 0/fehlt = interval_ns
+        bool                       stagger     = true;
+    };
+
+    // Alle Paare AUS, Phase 0, kein Zeitplan
+    void Reset(int pairs);
+
+    // Zeitplan ab now_ns; setzt Zustand wie Reset() (Aufrufer schaltet aus)
+    void Start(const Options& opt, std::uint64_t now_ns);
+    void Stop() { active_ = false; }
+    bool Active() const { return active_; }
+
+    // Bit i = Paar i fällig; versäumte Termine (lange Pause) werden
+    // übersprungen, ohne die Phasenlage zu verschieben
+    std::uint32_t Due(std::uint64_t now_ns);
+
+    // Flanken der Paare in pairs ausgeführt (jeweils umgeschaltet)
+    void Switched(std::uint32_t pairs);
+
+    // Manuelles Schalten aller Paare auf on (nur geänderte zählen als Flanke)
+    void SetAll(bool on);
+
+    int           Pairs() const { return static_cast<int>(pair_.size()); }
+    bool          On(int p) const { return Phase(p) & 1u; }
+    std::uint32_t Phase(int p) const;
+    std::uint32_t Mask() const;   // Bit i = Paar i EIN
+    std::uint64_t Offset(int p) const;
+    std::uint64_t Interval(int p) const;
+    std::uint64_t NextDue() const;   // 0 = kein Zeitplan
+
+private:
+    struct Pair {
+        std::uint64_t offset_ns   = 0;
+        std::uint64_t interval_ns = 0;
+        std::uint64_t next_ns     = 0;
+        std::uint32_t phase       = 0;
+    };
+
+    std::vector<Pair> pair_;
+    bool              active_ = false;
+};
@@ -0,0 +1,127 @@
+// RelayScheduler: Versatz, Fälligkeit, versäumte Termine, Phasen.
+#include "services/RelayScheduler.hpp"
+#include "util/TestCheck.hpp"
+
+namespace {
+
+constexpr std::uint64_t kS  = 1'000'000'000ull;
+constexpr std::uint64_t kT0 = 5 * kS;
+
+RelayScheduler::Options Opt(bool stagger) {
+    RelayScheduler::Options o;
+    o.pairs       = 4;
+    o.interval_ns = 8 * kS;
+    o.stagger     = stagger;
+    return o;
+}
+
+void TestResetAndStart() {
+    RelayScheduler s;
+    CHECK(!s.Active());
+    CHECK(s.NextDue() == 0);
+    CHECK(s.Due(kT0) == 0);
+
+    s.Reset(3);
+    CHECK(s.Pairs() == 3);
+    CHECK(s.Mask() == 0);
+    CHECK(!s.Active());
+
+    s.Start(Opt(true), kT0);
+    CHECK(s.Active());
+    CHECK(s.Pairs() == 4);
+    for (int p = 0; p < 4; ++p) {
+        CHECK(s.Offset(p) == static_cast<std::uint64_t>(p) * 2 * kS);   // gleichmäßig im Intervall
+        CHECK(s.Interval(p) == 8 * kS);
+        CHECK(s.Phase(p) == 0);
+    }
+    CHECK(s.NextDue() == kT0);
+    CHECK(s.Offset(4) == 0 && s.Interval(-1) == 0 && s.Phase(9) == 0);   // außerhalb
+
+    s.Reset(100);
+    CHECK(s.Pairs() == 32);   // Maske hat 32 Bit
+}
+
+void TestStaggeredSchedule() {
+    RelayScheduler s;
+    s.Start(Opt(true), kT0);
+
+    // Paar 0 sofort, dann je 2 s das nächste
+    CHECK(s.Due(kT0) == 0b0001);
+    CHECK(s.Due(kT0) == 0);   // Termin bereits weitergerückt
+    CHECK(s.Due(kT0 + 2 * kS - 1) == 0);
+    CHECK(s.Due(kT0 + 2 * kS) == 0b0010);
+    CHECK(s.Due(kT0 + 4 * kS) == 0b0100);
+    CHECK(s.Due(kT0 + 6 * kS) == 0b1000);
+    CHECK(s.Due(kT0 + 8 * kS) == 0b0001);
+    CHECK(s.NextDue() == kT0 + 10 * kS);
+
+    // gemeinsames Schalten ohne stagger
+    s.Start(Opt(false), kT0);
+    CHECK(s.Due(kT0) == 0b1111);
+    CHECK(s.NextDue() == kT0 + 8 * kS);
+}
+
+void TestMissedDeadlinesKeepPhase() {
+    RelayScheduler s;
+    s.Start(Opt(true), kT0);
+    CHECK(s.Due(kT0) == 0b0001);
+
+    // lange Pause: jedes Paar höchstens einmal fällig, Raster bleibt erhalten
+    const std::uint64_t late = kT0 + 45 * kS;
+    CHECK(s.Due(late) == 0b1111);
+    CHECK(s.Due(late) == 0);
+    // nächste Termine im alten Raster: Paar 3 bei +46 s, Paar 0 bei +48 s
+    CHECK(s.NextDue() == kT0 + 46 * kS);
+    CHECK(s.Due(kT0 + 46 * kS) == 0b1000);
+    CHECK(s.Due(kT0 + 48 * kS) == 0b0001);
+}
+
+void TestPerPairInterval() {
+    RelayScheduler s;
+    auto o = Opt(false);
+    o.pair_interval_ns = { 2 * kS, 0, 4 * kS };   // Paar 1 und 3: Prüfintervall
+    s.Start(o, kT0);
+    CHECK(s.Interval(0) == 2 * kS);
+    CHECK(s.Interval(1) == 8 * kS);
+    CHECK(s.Interval(2) == 4 * kS);
+    CHECK(s.Interval(3) == 8 * kS);
+
+    int flips[4] = {};
+    for (std::uint64_t t = kT0; t < kT0 + 16 * kS; t += kS / 4) {
+        const std::uint32_t due = s.Due(t);
+        for (int p = 0; p < 4; ++p) flips[p] += (due >> p) & 1u;
+    }
+    CHECK(flips[0] == 8);
+    CHECK(flips[1] == 2);
+    CHECK(flips[2] == 4);
+    CHECK(flips[3] == 2);
+}
+
+void TestPhases() {
+    RelayScheduler s;
+    s.Start(Opt(true), kT0);
+    s.Switched(0b0101);
+    CHECK(s.On(0) && !s.On(1) && s.On(2) && !s.On(3));
+    CHECK(s.Mask() == 0b0101);
+    CHECK(s.Phase(0) == 1);
+
+    s.SetAll(true);   // nur geänderte Paare zählen
+    CHECK(s.Mask() == 0b1111);
+    CHECK(s.Phase(0) == 1 && s.Phase(1) == 1);
+    s.SetAll(false);
+    CHECK(s.Mask() == 0);
+    CHECK(s.Phase(0) == 2 && s.Phase(3) == 2);
+
+    s.Switched(0b0001);
+    s.Stop();
+    CHECK(!s.Active());
+    CHECK(s.Due(kT0 + 100 * kS) == 0);
+    CHECK(s.On(0));   // Zustand bleibt nach Stop()
+
+    s.Start(Opt(true), kT0);   // Start setzt zurück
+    CHECK(s.Mask() == 0 && s.Phase(0) == 0);
+}
+
+} // namespace
+
+TEST_MAIN(TestResetAndStart, TestStaggeredSchedule, TestMissedDeadlinesKeepPhase, TestPerPairInterval, TestPhases)
@@ -0,0 +1,276 @@
+#include "services/ReportBuilder.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "app/data/SensorData.hpp"
+#include "config/ConfigSoftware.hpp"
+#include "services/Tracer.hpp"
+
+namespace {
+
+// Zeitformatierung mit Merker für die letzte Sekunde: Episoden liegen
+// zeitlich sortiert, localtime_r() läuft damit nur einmal je Sekunde
+class IsoLocal {
+public:
+    const char* operator()(std::uint64_t t_ms) {
+        if (t_ms == 0) return "-";
+        const std::time_t t = static_cast<std::time_t>(t_ms / 1000);
+        if (t != last_) {
+            std::tm tm{};
+            localtime_r(&t, &tm);
+            std::strftime(buf_, sizeof buf_, "%Y-%m-%d %H:%M:%S", &tm);
+            last_ = t;
+        }
+        return buf_;
+    }
+
+private:
+    std::time_t last_ = -1;
+    char        buf_[32] = {};
+};
+
+bool Inside(double v, const std::array<double, 2>& win) {
+    return v >= win[0] && v <= win[1];
+}
+
+} // namespace
+
+const char* ReportBuilder::KindName(Kind k) {
+    switch (k) {
+        case Kind::Supply:   return "Versorgung";
+        case Kind::Signal:   return "Signal";
+        case Kind::Current:  return "Strom";
+        case Kind::Presence: return "Präsenz";
+        case Kind::Stale:    return "Veraltet";
+    }
+    return "?";
+}
+
+void ReportBuilder::Stat::Add(double x) {
+    if (std::isnan(x)) return;
+    if (n == 0) { min = max = x; }
+    else        { min = std::min(min, x); max = std::max(max, x); }
+    ++n;
+    const double d = x - mean;
+    mean += d / static_cast<double>(n);
+    m2   += d * (x - mean);
+}
+
+double ReportBuilder::Stat::Stddev() const {
+    return n > 1 ? std::sqrt(m2 / static_cast<double>(n - 1)) : 0.0;
+}
+
+void ReportBuilder::Begin(std::uint64_t t_ms, const ConfigSoftware& cfg, const std::vector<std::string>& serials) {
+    std::lock_guard<std::mutex> lk(m_);
+    limits_.supply_V     = cfg.supply_voltage_threshold;
+    limits_.current_mA   = cfg.presence_current_threshold;
+    limits_.redlab_pos_V = cfg.redlab_pos_threshold;
+    limits_.redlab_neg_V = cfg.redlab_neg_threshold;
+
+    ch_.assign(serials.size(), Channel{});
+    for (size_t i = 0; i < ch_.size(); ++i) {
+        ch_[i].serial = serials[i];
+        ch_[i].open.fill(kClosed);
+    }
+    episodes_.clear();
+    episodes_.reserve(1024);
+    dropped_episodes_ = 0;
+
+    start_ms_ = t_ms;
+    end_ms_   = 0;
+    last_ms_  = 0;
+    cycles_   = 0;
+    max_gap_ms_ = 0;
+    active_   = true;
+}
+
+bool ReportBuilder::Active() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return active_;
+}
+
+void ReportBuilder::OpenEpisode(Channel& c, int ch, Kind k, std::uint64_t t_ms, double v) {
+    const size_t ki = static_cast<size_t>(k);
+    ++c.episodes[ki];
+    c.since[ki] = t_ms;
+    if (episodes_.size() >= kMaxEpisodes) {
+        // nur zählen; Fehlerzeit läuft über since[] trotzdem mit
+        c.open[ki] = kUnstored;
+        ++dropped_episodes_;
+        return;
+    }
+    Episode e;
+    e.channel  = ch;
+    e.kind     = k;
+    e.start_ms = t_ms;
+    e.min = e.max = v;
+    c.open[ki] = static_cast<int>(episodes_.size());
+    episodes_.push_back(e);
+}
+
+void ReportBuilder::CloseEpisode(Channel& c, Kind k, std::uint64_t t_ms) {
+    const size_t ki = static_cast<size_t>(k);
+    if (c.open[ki] == kClosed) return;
+    const std::uint64_t end = std::max(t_ms, c.since[ki]);
+    c.error_ms[ki] += end - c.since[ki];
+    if (c.open[ki] >= 0) episodes_[static_cast<size_t>(c.open[ki])].end_ms = end;
+    c.open[ki] = kClosed;
+}
+
+void ReportBuilder::Track(Channel& c, int ch, Kind k, bool bad, std::uint64_t t_ms, double v) {
+    const size_t ki = static_cast<size_t>(k);
+    if (!bad) { CloseEpisode(c, k, t_ms); return; }
+    if (c.open[ki] == kClosed) OpenEpisode(c, ch, k, t_ms, v);
+    if (c.open[ki] < 0) return;
+
+    Episode& e = episodes_[static_cast<size_t>(c.open[ki])];
+    ++e.cycles;
+    e.min = std::min(e.min, v);
+    e.max = std::max(e.max, v);
+}
+
+void ReportBuilder::Observe(std::uint64_t t_ms, const std::vector<SensorData>& sensors) {
+    std::lock_guard<std::mutex> lk(m_);
+    if (!active_) return;
+
+    if (cycles_ > 0 && t_ms > last_ms_) max_gap_ms_ = std::max(max_gap_ms_, t_ms - last_ms_);
+    last_ms_ = t_ms;
+    ++cycles_;
+
+    const size_t n = std::min(sensors.size(), ch_.size());
+    for (size_t i = 0; i < n; ++i) {
+        const SensorData& s = sensors[i];
+        Channel& c = ch_[i];
+        const int ch = static_cast<int>(i);
+        const bool relays_on = RelayOn(s);
+        if (relays_on) ++c.cycles_on;
+
+        // Gerätefehler: alte Werte nicht in Statistik/Bewertung einrechnen
+        Track(c, ch, Kind::Stale, s.stale, t_ms, static_cast<double>(s.stale_ms));
+        if (s.stale) continue;
+
+        // Präsenz und Strom nur bei eingeschalteten Relais prüfbar (ohne
+        // Versorgung zieht der Prüfling keinen Strom und gilt als „fehlt“)
+        if (relays_on) Track(c, ch, Kind::Presence, c.seen_present && !s.present, t_ms, s.current_mA);
+        else           CloseEpisode(c, Kind::Presence, t_ms);
+        if (s.present) {
+            c.seen_present = true;
+            if (relays_on) ++c.cycles_present;
+        }
+        if (!c.seen_present) continue;   // leerer Steckplatz: keine Grenzwertprüfung
+
+        c.bus_V.Add(s.bus_V);
+        (relays_on ? c.redlab_on_V : c.redlab_off_V).Add(s.redlab_V);
+        Track(c, ch, Kind::Supply, !s.supply_ok, t_ms, s.bus_V);
+        Track(c, ch, Kind::Signal, !s.signal_ok, t_ms, s.redlab_V);
+
+        if (relays_on && s.present) {
+            c.current_mA.Add(s.current_mA);
+            Track(c, ch, Kind::Current, !Inside(s.current_mA, limits_.current_mA), t_ms, s.current_mA);
+        } else {
+            CloseEpisode(c, Kind::Current, t_ms);
+        }
+    }
+}
+
+void ReportBuilder::Finish(std::uint64_t t_ms) {
+    std::lock_guard<std::mutex> lk(m_);
+    if (!active_) return;
+    for (auto& c : ch_)
+        for (size_t k = 0; k < kKinds; ++k) CloseEpisode(c, static_cast<Kind>(k), t_ms);
+    end_ms_ = t_ms;
+    active_ = false;
+}
+
+bool ReportBuilder::WriteCsv(const std::string& path, std::string* err) const {
+    SOSESTA_TRACE_SCOPE("ReportBuilder::WriteCsv");
+
+    // Bestand kopieren, Schreiben ohne Sperre (Erfassung läuft weiter)
+    std::vector<Channel> ch;
+    std::vector<Episode> eps;
+    Limits lim;
+    std::uint64_t start, end, cycles, gap, dropped;
+    bool running;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        ch = ch_; eps = episodes_; lim = limits_;
+        start = start_ms_; end = active_ ? last_ms_ : end_ms_;
+        cycles = cycles_; gap = max_gap_ms_; dropped = dropped_episodes_;
+        running = active_;
+    }
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        if (err) *err = "fopen(" + path + "): " + std::strerror(errno);
+        return false;
+    }
+    std::setvbuf(f, nullptr, _IOFBF, 1 << 20);
+    std::fputs("\xEF\xBB\xBF", f);   // UTF-8 BOM (Excel-freundlich)
+
+    const double dur_s = end > start ? static_cast<double>(end - start) / 1000.0 : 0.0;
+    std::fprintf(f, "\"Prüfbericht\"%s\n", running ? ",\"vorläufig (Test läuft)\"" : "");
+    IsoLocal iso, iso_end;
+    std::fprintf(f, "Beginn,\"%s\"\n", iso(start));
+    std::fprintf(f, "Ende,\"%s\"\n", iso(end));
+    std::fprintf(f, "Dauer_s,%.1f\nZyklen,%llu\n", dur_s, static_cast<unsigned long long>(cycles));
+    std::fprintf(f, "Mittlere_Periode_ms,%.2f\nMax_Luecke_ms,%llu\n",
+                 cycles > 1 ? dur_s * 1000.0 / static_cast<double>(cycles - 1) : 0.0,
+                 static_cast<unsigned long long>(gap));
+    std::fprintf(f, "Versorgung_V,%g,%g\nStrom_mA,%g,%g\nRedLab_pos_V,%g,%g\nRedLab_neg_V,%g,%g\n",
+                 lim.supply_V[0], lim.supply_V[1], lim.current_mA[0], lim.current_mA[1],
+                 lim.redlab_pos_V[0], lim.redlab_pos_V[1], lim.redlab_neg_V[0], lim.redlab_neg_V[1]);
+    std::fputs("\n", f);
+
+    std::fputs("Kanal,SN,Bewertung,Praesenz_%,Ep_Versorgung,Ep_Signal,Ep_Strom,Ep_Praesenz,Ep_Veraltet,Fehlerzeit_s,"
+               "Bus_V_Mittel,Bus_V_Std,Bus_V_Min,Bus_V_Max,"
+               "Strom_mA_Mittel,Strom_mA_Std,Strom_mA_Min,Strom_mA_Max,"
+               "RedLab_EIN_V_Mittel,RedLab_EIN_V_Min,RedLab_EIN_V_Max,"
+               "RedLab_AUS_V_Mittel,RedLab_AUS_V_Min,RedLab_AUS_V_Max\n", f);
+    for (size_t i = 0; i < ch.size(); ++i) {
+        const Channel& c = ch[i];
+        std::uint32_t fails = 0;
+        std::uint64_t err_ms = 0;
+        for (Kind k : { Kind::Supply, Kind::Signal, Kind::Current, Kind::Presence }) {
+            fails  += c.episodes[static_cast<size_t>(k)];
+            err_ms += c.error_ms[static_cast<size_t>(k)];
+        }
+        const char* verdict = !c.seen_present ? "leer" : fails ? "FEHLER" : "OK";
+        std::string sn = c.serial.empty() ? "-" : c.serial;
+        std::replace(sn.begin(), sn.end(), '"', '\'');
+        std::fprintf(f, "%zu,\"%s\",%s,%.1f,%u,%u,%u,%u,%u,%.1f,"
+                        "%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                     i + 1, sn.c_str(), verdict,
+                     c.cycles_on ? 100.0 * static_cast<double>(c.cycles_present) / static_cast<double>(c.cycles_on) : 0.0,
+                     c.episodes[0], c.episodes[1], c.episodes[2], c.episodes[3], c.episodes[4],
+                     static_cast<double>(err_ms) / 1000.0,
+                     c.bus_V.mean, c.bus_V.Stddev(), c.bus_V.min, c.bus_V.max,
+                     c.current_mA.mean, c.current_mA.Stddev(), c.current_mA.min, c.current_mA.max,
+                     c.redlab_on_V.mean, c.redlab_on_V.min, c.redlab_on_V.max,
+                     c.redlab_off_V.mean, c.redlab_off_V.min, c.redlab_off_V.max);
+    }
+    std::fputs("\n", f);
+
+    std::fputs("Kanal,Art,Beginn,Ende,Dauer_s,Zyklen,Min,Max\n", f);
+    for (const Episode& e : eps) {
+        const std::uint64_t e_end = e.end_ms ? e.end_ms : end;
+        std::fprintf(f, "%d,%s,\"%s\",\"%s\",%.3f,%u,%.4f,%.4f\n",
+                     e.channel + 1, KindName(e.kind), iso(e.start_ms),
+                     e.end_ms ? iso_end(e.end_ms) : "offen",
+                     static_cast<double>(e_end - std::min(e_end, e.start_ms)) / 1000.0,
+                     e.cycles, e.min, e.max);
+    }
+    if (dropped) std::fprintf(f, "\"%llu weitere Episoden nicht einzeln gespeichert\"\n",
+                              static_cast<unsigned long long>(dropped));
+
+    const bool ok = !std::ferror(f);
+    if (std::fclose(f) != 0 || !ok) {
+        if (err) *err = "Schreiben fehlgeschlagen: " + path;
+        return false;
+    }
+    return true;
+}
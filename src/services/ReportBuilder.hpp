@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ConfigSoftware;
+struct SensorData;
+
+/**
+ * Prüfbericht, der während des Laufs mitwächst.
+ *
+ * Observe() wird je Erfassungszyklus aufgerufen und aktualisiert nur
+ * feste Zustände je Kanal (O(Kanäle)): laufende Statistik (Welford),
+ * Min/Max, offene Fehler-Episoden und Zeitkennzahlen. Beim Stopp schließt
+ * Finish() offene Episoden, WriteCsv() serialisiert nur noch den Bestand –
+ * kein erneutes Durchlaufen der Messdaten.
+ *
+ * Bewertung je Kanal: „leer“ (nie präsent), „OK“ (keine Episode) oder
+ * „FEHLER“ (mindestens eine Versorgungs-, Signal-, Strom- oder
+ * Präsenz-Episode). Präsenz und Strom werden nur bei eingeschaltetem
+ * Relais des Kanals geprüft (RelayOn(), Paare schalten versetzt). Veraltete Werte (Gerätefehler) werden gezählt, ändern
+ * die Bewertung aber nicht.
+ */
+class ReportBuilder {
+public:
+    enum class Kind : std::uint8_t { Supply, Signal, Current, Presence, Stale };
+    static constexpr size_t kKinds = 5;
+    static const char* KindName(Kind k);
+
+    struct Stat {
+        std::uint64_t n    = 0;
+        double        mean = 0.0;
+        double        m2   = 0.0;
+        double        min  = 0.0;
+        double        max  = 0.0;
+
+        void   Add(double x);
+        double Stddev() const;
+    };
+
+    struct Episode {
+        int           channel  = 0;
+        Kind          kind     = Kind::Supply;
+        std::uint64_t start_ms = 0;
+        std::uint64_t end_ms   = 0;   // 0 = noch offen
+        std::uint32_t cycles   = 0;
+        double        min      = 0.0; // Messwert während der Episode
+        double        max      = 0.0;
+    };
+
+    struct Channel {
+        std::string   serial;
+        bool          seen_present   = false;
+        std::uint64_t cycles_on      = 0;   // Zyklen mit Relais EIN (Präsenzbasis)
+        std::uint64_t cycles_present = 0;   // bei Relais EIN
+        Stat          bus_V, current_mA, redlab_on_V, redlab_off_V;
+        std::array<std::uint32_t, kKinds> episodes{};
+        std::array<std::uint64_t, kKinds> error_ms{};
+        std::array<int, kKinds>           open{};   // Index in episodes_ bzw. kClosed/kUnstored
+        std::array<std::uint64_t, kKinds> since{};  // Beginn der offenen Episode
+    };
+
+    // Schwellen beim Start (Editor kann sie im Lauf ändern)
+    struct Limits {
+        std::array<double, 2> supply_V{};
+        std::array<double, 2> current_mA{};
+        std::array<double, 2> redlab_pos_V{};
+        std::array<double, 2> redlab_neg_V{};
+    };
+
+    static constexpr size_t kMaxEpisodes = 20000;  // darüber nur noch zählen (Stopp bleibt schnell)
+    static constexpr int    kClosed   = -1;
+    static constexpr int    kUnstored = -2;            // offen, aber nicht gespeichert
+
+    void Begin(std::uint64_t t_ms, const ConfigSoftware& cfg, const std::vector<std::string>& serials);
+    void Observe(std::uint64_t t_ms, const std::vector<SensorData>& sensors);
+    void Finish(std::uint64_t t_ms);
+
+    bool Active() const;
+
+    // Bericht als CSV (UTF-8 mit BOM): Kopf, Kanaltabelle, Episodenliste
+    bool WriteCsv(const std::string& path, std::string* err = nullptr) const;
+
+private:
+    void OpenEpisode(Channel& c, int ch, Kind k, std::uint64_t t_ms, double v);
+    void CloseEpisode(Channel& c, Kind k, std::uint64_t t_ms);
+    void Track(Channel& c, int ch, Kind k, bool bad, std::uint64_t t_ms, double v);
+
+    mutable std::mutex    m_;
+    bool                  active_ = false;
+    Limits                limits_;
+    std::vector<Channel>  ch_;
+    std::vector<Episode>  episodes_;
+    std::uint64_t         dropped_episodes_ = 0;
+
+    // Zeitkennzahlen
+    std::uint64_t start_ms_ = 0;
+    std::uint64_t end_ms_   = 0;
+    std::uint64_t last_ms_  = 0;
+    std::uint64_t cycles_   = 0;
+    std::uint64_t max_gap_ms_ = 0;
+};
@@ -0,0 +1,115 @@
+#include "services/SamplingScheduler.hpp"
+#include "config/ConfigSoftware.hpp"
+#include "app/data/SensorData.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Abstand zum nächsten Rand des Fensters [lo, hi], normiert auf die Breite.
+// Außerhalb des Fensters zählt der Abstand ebenfalls (Rückkehr wird erkannt).
+double WindowMargin(double v, const std::array<double,2>& w) {
+    const double width = w[1] - w[0];
+    if (!(width > 0.0)) return 1.0;
+    return std::min(std::fabs(v - w[0]), std::fabs(w[1] - v)) / width;
+}
+
+std::uint8_t Flags(const SensorData& s) {
+    return static_cast<std::uint8_t>((s.present ? 1 : 0) | (s.supply_ok ? 2 : 0) | (s.signal_ok ? 4 : 0));
+}
+
+} // namespace
+
+void SamplingScheduler::Reset() {
+    ch_.clear();
+    mask_.clear();
+    cycle_ = 0;
+    last_planned_ = 0;
+    deferred_ = 0;
+}
+
+int SamplingScheduler::Period(int ch) const {
+    return (ch >= 0 && static_cast<size_t>(ch) < ch_.size()) ? ch_[static_cast<size_t>(ch)].period : 1;
+}
+
+bool SamplingScheduler::Hot(int ch) const {
+    return ch >= 0 && static_cast<size_t>(ch) < ch_.size() && ch_[static_cast<size_t>(ch)].hot_left > 0;
+}
+
+double SamplingScheduler::Margin(const SensorData& s, const ConfigSoftware& cfg) {
+    // Signal: Fenster von unterer Negativ- bis oberer Positivschwelle (wie Auswertung)
+    const std::array<double,2> signal{ cfg.redlab_neg_threshold[0], cfg.redlab_pos_threshold[1] };
+    double m = std::min(WindowMargin(s.bus_V, cfg.supply_voltage_threshold),
+                        WindowMargin(s.redlab_V, signal));
+    if (s.present) m = std::min(m, WindowMargin(s.current_mA, cfg.presence_current_threshold));
+    return m;
+}
+
+const std::vector<bool>& SamplingScheduler::Plan(int num_channels, const ConfigSoftware& cfg) {
+    const size_t n = static_cast<size_t>(std::max(0, num_channels));
+    if (ch_.size() != n) { ch_.assign(n, Channel{}); }
+    mask_.assign(n, false);
+    ++cycle_;
+
+    // fällige Kanäle mit Priorität sammeln
+    struct Cand { int ch; double prio; };
+    std::vector<Cand> due;
+    due.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const Channel& c = ch_[i];
+        if (c.hot_left == 0 && c.due > cycle_) continue;
+        const double overdue = c.due < cycle_ ? static_cast<double>(cycle_ - c.due) : 0.0;
+        const double prio = (c.hot_left > 0 ? 1000.0 : 0.0) + overdue * 10.0 + 1.0 / c.period;
+        due.push_back({static_cast<int>(i), prio});
+    }
+    std::stable_sort(due.begin(), due.end(), [](const Cand& a, const Cand& b) { return a.prio > b.prio; });
+
+    // Budget: mindestens ein Kanal je Zyklus, sonst bis das Budget verbraucht ist
+    const double budget = cfg.sample_budget_us;
+    double spent = 0.0;
+    int planned = 0;
+    for (const Cand& c : due) {
+        if (planned > 0 && budget > 0.0 && cost_us_ > 0.0 && spent + cost_us_ > budget) {
+            ++deferred_;
+            continue;
+        }
+        mask_[static_cast<size_t>(c.ch)] = true;
+        spent += cost_us_;
+        ++planned;
+    }
+    last_planned_ = planned;
+    return mask_;
+}
+
+void SamplingScheduler::Observe(const std::vector<SensorData>& sensors, double read_us, const ConfigSoftware& cfg) {
+    if (last_planned_ > 0 && read_us > 0.0) {
+        const double per = read_us / last_planned_;
+        cost_us_ = cost_us_ == 0.0 ? per : cost_us_ + 0.2 * (per - cost_us_);
+    }
+
+    const int max_period = std::max(1, cfg.sample_max_period);
+    const size_t n = std::min(sensors.size(), ch_.size());
+    for (size_t i = 0; i < n; ++i) {
+        if (i >= mask_.size() || !mask_[i]) continue;
+        Channel& c = ch_[i];
+        const SensorData& s = sensors[i];
+        const std::uint8_t f = Flags(s);
+
+        const bool changed = c.last_flags != 0xFF && c.last_flags != f;
+        const bool near    = s.present && Margin(s, cfg) < cfg.sample_near_fraction;
+        c.last_flags = f;
+
+        if (changed || near) {
+            c.hot_left = std::max(1, cfg.sample_hot_cycles);
+            c.period   = 1;
+        } else if (c.hot_left > 0) {
+            --c.hot_left;
+            c.period = 1;
+        } else if (!s.present) {
+            c.period = max_period;                        // leerer Steckplatz
+        } else {
+            c.period = std::min(c.period * 2, max_period); // stabil: zurückfahren
+        }
+        c.due = cycle_ + static_cast<std::uint64_t>(c.period);
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+struct ConfigSoftware;
+struct SensorData;
+
+/**
+ * Adaptive Abtastplanung je Kanal.
+ *
+ * Jeder Kanal hat eine Periode in Zyklen (1 = jeden Zyklus). Kanäle nahe an
+ * einer Schwelle oder mit frischem Zustandswechsel werden "heiß" und jeden
+ * Zyklus gelesen; stabile Kanäle verdoppeln ihre Periode bis
+ * sample_max_period, leere Steckplätze stehen direkt auf dem Maximum.
+ *
+ * Plan() wählt die fälligen Kanäle nach Priorität (heiß vor überfällig vor
+ * planmäßig), bis das Buszeit-Budget verbraucht ist. Zurückgestellte Kanäle
+ * bleiben fällig und steigen mit jedem Zyklus in der Priorität – es
+ * verhungert also keiner.
+ *
+ * Schwellen und Budget kommen je Aufruf aus dem Konfigurations-Schnappschuss
+ * des Erfassungszyklus (TestRunner::ApplyConfig), nicht aus der GUI-Konfig.
+ */
+class SamplingScheduler {
+public:
+    SamplingScheduler() = default;
+
+    // Maske für den nächsten Zyklus (true = lesen)
+    const std::vector<bool>& Plan(int num_channels, const ConfigSoftware& cfg);
+
+    // Nach dem Lesen: Zustand der gelesenen Kanäle auswerten.
+    // read_us = gemessene Dauer des Hardwarezugriffs für alle gelesenen Kanäle.
+    void Observe(const std::vector<SensorData>& sensors, double read_us, const ConfigSoftware& cfg);
+
+    void Reset();
+
+    // Diagnose
+    int    Period(int ch) const;
+    bool   Hot(int ch) const;
+    int    LastPlanned() const { return last_planned_; }
+    double CostUsPerChannel() const { return cost_us_; }
+    std::uint64_t Deferred() const { return deferred_; }  // wegen Budget verschoben
+
+private:
+    struct Channel {
+        int           period    = 1;
+        std::uint64_t due       = 0;   // Zyklusnummer, ab der gelesen werden soll
+        int           hot_left  = 0;
+        std::uint8_t  last_flags = 0xFF; // 0xFF = noch nie gelesen
+    };
+
+    // Kleinster normierter Abstand zu einer Schwelle (0 = auf der Schwelle)
+    static double Margin(const SensorData& s, const ConfigSoftware& cfg);
+
+    std::vector<Channel>  ch_;
+    std::vector<bool>     mask_;
+    std::uint64_t         cycle_ = 0;
+    int                   last_planned_ = 0;
+    double                cost_us_ = 0.0;   // EWMA je gelesenem Kanal
+    std::uint64_t         deferred_ = 0;
+};
@@ -0,0 +1,827 @@
+#include "services/SessionArchive.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "services/Tracer.hpp"
+
+using namespace session_archive;
+
+namespace {
+
+constexpr std::uint32_t kFileMagic    = 0x52415353; // "SSAR"
+constexpr std::uint32_t kChunkMagic   = 0x4B435353; // "SSCK"
+constexpr std::uint32_t kIndexMagic   = 0x58495353; // "SSIX"
+constexpr std::uint16_t kVersion      = 1;
+constexpr size_t        kFileHeader   = 4 + 2 + 2 + 4 + 8 * kQuantities;
+constexpr size_t        kIndexEntry   = 8 + 8 + 8 + 4;
+constexpr size_t        kTrailer      = 4 + 8 + 4;
+constexpr int           kMaxChannels  = 64;
+constexpr std::int64_t  kNanCode      = std::numeric_limits<std::int64_t>::min();
+
+size_t ChunkHeaderSize(int channels) { return 4 + 4 + 8 + 8 + 4 + 4 * static_cast<size_t>(channels); }
+
+// Abtastzahl aus dem Chunk-Kopf vor dem resize() prüfen: muss zum Index
+// passen, und jeder Wert braucht im Strom mindestens ein Bit
+bool SamplesPlausible(std::uint32_t n, std::uint32_t indexed, std::uint64_t stream_bytes) {
+    return n == indexed && n <= stream_bytes * 8;
+}
+
+// ── Little-Endian ─────────────────────────────────────────────────────────
+template <typename T>
+void PutLE(std::vector<std::uint8_t>& b, T v) {
+    std::uint64_t u;
+    if constexpr (std::is_same_v<T, double>) u = std::bit_cast<std::uint64_t>(v);
+    else u = static_cast<std::uint64_t>(v);
+    for (size_t i = 0; i < sizeof(T); ++i) b.push_back(static_cast<std::uint8_t>(u >> (8 * i)));
+}
+
+template <typename T>
+T GetLE(const std::uint8_t*& p) {
+    std::uint64_t u = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) u |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+    p += sizeof(T);
+    if constexpr (std::is_same_v<T, double>) return std::bit_cast<double>(u);
+    else return static_cast<T>(u);
+}
+
+// ── Vorzeichenbehaftete Werte in Gorilla-Stufen: 0 | 10+7 | 110+9 | 1110+12 | 11110+32 | 11111+64
+constexpr int kBucketBits[] = { 0, 7, 9, 12, 32, 64 };
+
+void PutSigned(BitWriter& w, std::int64_t d) {
+    const std::uint64_t zz = (static_cast<std::uint64_t>(d) << 1) ^ static_cast<std::uint64_t>(d >> 63);
+    if (zz == 0) { w.Put(0, 1); return; }
+    for (int n = 1; n <= 5; ++n) {
+        if (n == 5 || zz < (std::uint64_t{1} << kBucketBits[n])) {
+            // n Einsen, bei n < 5 abgeschlossen durch eine Null
+            w.Put(n < 5 ? ((std::uint64_t{1} << n) - 1) << 1 : 0x1F, n < 5 ? n + 1 : 5);
+            w.Put(zz, kBucketBits[n]);
+            return;
+        }
+    }
+}
+
+std::int64_t GetSigned(BitReader& r) {
+    int n = 0;
+    while (n < 5 && r.Get(1)) ++n;
+    if (n == 0) return 0;
+    const std::uint64_t zz = r.Get(kBucketBits[n]);
+    return static_cast<std::int64_t>(zz >> 1) ^ -static_cast<std::int64_t>(zz & 1);
+}
+
+std::int64_t ToCode(double v, double res) {
+    if (!std::isfinite(v)) return kNanCode;
+    return std::llround(v / res);
+}
+
+double FromCode(std::int64_t code, double res) {
+    if (code == kNanCode) return std::numeric_limits<double>::quiet_NaN();
+    return static_cast<double>(code) * res;
+}
+
+std::string Errno(const char* what, const std::string& path) {
+    return std::string(what) + "(" + path + "): " + std::strerror(errno);
+}
+
+} // namespace
+
+// ── BitWriter / BitReader ─────────────────────────────────────────────────
+void BitWriter::Put(std::uint64_t v, int bits) {
+    if (bits > 32) {
+        Put(v >> 32, bits - 32);
+        v &= 0xFFFFFFFFull;
+        bits = 32;
+    }
+    // acc_ hält < 8 Bit Rest → nach dem Schieben höchstens 40 Bit
+    acc_  = (acc_ << bits) | (v & ((std::uint64_t{1} << bits) - 1));
+    nacc_ += bits;
+    while (nacc_ >= 8) {
+        nacc_ -= 8;
+        buf_.push_back(static_cast<std::uint8_t>(acc_ >> nacc_));
+    }
+    acc_ &= (std::uint64_t{1} << nacc_) - 1;
+}
+
+void BitWriter::Flush() {
+    if (nacc_ > 0) buf_.push_back(static_cast<std::uint8_t>(acc_ << (8 - nacc_)));
+    acc_ = 0;
+    nacc_ = 0;
+}
+
+std::uint64_t BitReader::Get(int bits) {
+    if (bits > 32) {
+        const std::uint64_t hi = Get(bits - 32);
+        return (hi << 32) | Get(32);
+    }
+    while (nacc_ < bits) {
+        acc_ <<= 8;
+        if (p_ < end_) acc_ |= *p_++;
+        else ok_ = false;
+        nacc_ += 8;
+    }
+    nacc_ -= bits;
+    const std::uint64_t v = (acc_ >> nacc_) & ((std::uint64_t{1} << bits) - 1);
+    acc_ &= (std::uint64_t{1} << nacc_) - 1;
+    return v;
+}
+
+// ── Spalten-Codecs ────────────────────────────────────────────────────────
+void TimeCodec::Encode(BitWriter& w, std::uint64_t t) {
+    if (first) {
+        w.Put(t, 64);
+        prev = t; prev_delta = 0; first = false;
+        return;
+    }
+    const auto delta = static_cast<std::int64_t>(t - prev);
+    PutSigned(w, delta - prev_delta);
+    prev = t;
+    prev_delta = delta;
+}
+
+std::uint64_t TimeCodec::Decode(BitReader& r) {
+    if (first) {
+        prev = r.Get(64); prev_delta = 0; first = false;
+        return prev;
+    }
+    prev_delta += GetSigned(r);
+    prev += static_cast<std::uint64_t>(prev_delta);
+    return prev;
+}
+
+void XorCodec::Encode(BitWriter& w, std::uint64_t word) {
+    if (first) {
+        w.Put(word, 64);
+        prev = word; first = false;
+        return;
+    }
+    const std::uint64_t x = word ^ prev;
+    prev = word;
+    if (x == 0) { w.Put(0, 1); return; }
+
+    const int l = std::min(std::countl_zero(x), 31);
+    const int t = std::countr_zero(x);
+    if (lead >= 0 && l >= lead && t >= trail) {
+        // passt ins bisherige Fenster
+        w.Put(0b10, 2);
+        w.Put(x >> trail, 64 - lead - trail);
+    } else {
+        const int sig = 64 - l - t;
+        w.Put(0b11, 2);
+        w.Put(static_cast<std::uint64_t>(l), 5);
+        w.Put(static_cast<std::uint64_t>(sig - 1), 6);
+        w.Put(x >> t, sig);
+        lead = l; trail = t;
+    }
+}
+
+std::uint64_t XorCodec::Decode(BitReader& r) {
+    if (first) {
+        prev = r.Get(64); first = false;
+        return prev;
+    }
+    if (!r.Get(1)) return prev;
+    if (!r.Get(1)) {
+        if (lead < 0) return prev;   // defekter Strom: Fenster ohne Vorgabe
+        prev ^= r.Get(64 - lead - trail) << trail;
+    } else {
+        lead = static_cast<int>(r.Get(5));
+        const int sig = static_cast<int>(r.Get(6)) + 1;
+        trail = std::max(0, 64 - lead - sig);
+        prev ^= r.Get(sig) << trail;
+    }
+    return prev;
+}
+
+void DeltaCodec::Encode(BitWriter& w, std::int64_t code) {
+    if (first) {
+        w.Put(static_cast<std::uint64_t>(code), 64);
+        prev = code; first = false;
+        return;
+    }
+    const auto d = static_cast<std::int64_t>(static_cast<std::uint64_t>(code) - static_cast<std::uint64_t>(prev));
+    prev = code;
+    const std::uint64_t zz = (static_cast<std::uint64_t>(d) << 1) ^ static_cast<std::uint64_t>(d >> 63);
+    if (zz == 0) { w.Put(0, 1); return; }
+
+    // Fenster wiederverwenden, solange es höchstens 2 Bit zu breit ist
+    const int bw = std::bit_width(zz);
+    if (width > 0 && bw <= width && bw + 2 >= width) {
+        w.Put(0b10, 2);
+        w.Put(zz, width);
+    } else {
+        w.Put(0b11, 2);
+        w.Put(static_cast<std::uint64_t>(bw - 1), 6);
+        w.Put(zz, bw);
+        width = bw;
+    }
+}
+
+std::int64_t DeltaCodec::Decode(BitReader& r) {
+    if (first) {
+        prev = static_cast<std::int64_t>(r.Get(64)); first = false;
+        return prev;
+    }
+    if (!r.Get(1)) return prev;
+    if (r.Get(1)) width = static_cast<int>(r.Get(6)) + 1;
+    if (width <= 0) return prev;   // defekter Strom: Fenster ohne Vorgabe
+    const std::uint64_t zz = r.Get(width);
+    const std::int64_t  d  = static_cast<std::int64_t>(zz >> 1) ^ -static_cast<std::int64_t>(zz & 1);
+    prev = static_cast<std::int64_t>(static_cast<std::uint64_t>(prev) + static_cast<std::uint64_t>(d));
+    return prev;
+}
+
+void ChannelCodec::Encode(BitWriter& w, const SensorData& s, const std::array<double, kQuantities>& res) {
+    const auto f = static_cast<std::uint8_t>((s.present ? 1 : 0) | (s.supply_ok ? 2 : 0)
+                                           | (s.signal_ok ? 4 : 0) | (s.stale ? 8 : 0));
+    if (f == flags) w.Put(0, 1);
+    else { w.Put(1, 1); w.Put(f, 4); flags = f; }
+
+    const double v[kQuantities] = { s.bus_V, s.current_mA, s.power_mW, s.redlab_V };
+    for (size_t q = 0; q < kQuantities; ++q) {
+        if (res[q] > 0.0) code[q].Encode(w, ToCode(v[q], res[q]));
+        else              raw[q].Encode(w, std::bit_cast<std::uint64_t>(v[q]));
+    }
+
+    const std::uint32_t c[4] = { static_cast<std::uint32_t>(s.supply_error_counter),
+                                 static_cast<std::uint32_t>(s.signal_error_counter),
+                                 static_cast<std::uint32_t>(s.current_error_counter),
+                                 s.retry_count };
+    for (size_t i = 0; i < 4; ++i) {
+        if (c[i] == counters[i]) { w.Put(0, 1); continue; }
+        w.Put(1, 1);
+        PutSigned(w, static_cast<std::int64_t>(c[i]) - static_cast<std::int64_t>(counters[i]));
+        counters[i] = c[i];
+    }
+}
+
+void ChannelCodec::Decode(BitReader& r, SensorData& s, const std::array<double, kQuantities>& res) {
+    if (r.Get(1)) flags = static_cast<std::uint8_t>(r.Get(4));
+    s.present   = flags & 1;
+    s.supply_ok = flags & 2;
+    s.signal_ok = flags & 4;
+    s.stale     = flags & 8;
+
+    double* v[kQuantities] = { &s.bus_V, &s.current_mA, &s.power_mW, &s.redlab_V };
+    for (size_t q = 0; q < kQuantities; ++q) {
+        if (res[q] > 0.0) *v[q] = FromCode(code[q].Decode(r), res[q]);
+        else              *v[q] = std::bit_cast<double>(raw[q].Decode(r));
+    }
+
+    for (size_t i = 0; i < 4; ++i)
+        if (r.Get(1)) counters[i] = static_cast<std::uint32_t>(static_cast<std::int64_t>(counters[i]) + GetSigned(r));
+    s.supply_error_counter  = static_cast<int>(counters[0]);
+    s.signal_error_counter  = static_cast<int>(counters[1]);
+    s.current_error_counter = static_cast<int>(counters[2]);
+    s.retry_count           = counters[3];
+}
+
+// ── Writer ────────────────────────────────────────────────────────────────
+bool SessionArchiveWriter::Open(const std::string& path, const Options& opt, std::string* err) {
+    Close();
+    if (opt.channels <= 0 || opt.channels > kMaxChannels) { if (err) *err = "Archiv: ungültige Kanalzahl"; return false; }
+    if (opt.chunk_ms == 0)                                 { if (err) *err = "Archiv: Chunk-Dauer 0"; return false; }
+
+    f_ = std::fopen(path.c_str(), "wb");
+    if (!f_) { if (err) *err = Errno("fopen", path); return false; }
+    opt_     = opt;
+    path_    = path;
+    bytes_   = 0;
+    samples_ = 0;
+    index_.clear();
+
+    std::vector<std::uint8_t> h;
+    PutLE(h, kFileMagic);
+    PutLE(h, kVersion);
+    PutLE(h, static_cast<std::uint16_t>(opt_.channels));
+    PutLE(h, opt_.chunk_ms);
+    for (double r : opt_.resolution) PutLE(h, r);
+    if (!Write(h.data(), h.size(), err)) { std::fclose(f_); f_ = nullptr; return false; }
+
+    ts_buf_.Clear();
+    ts_codec_ = {};
+    ch_buf_.assign(static_cast<size_t>(opt_.channels), BitWriter{});
+    ch_codec_.assign(static_cast<size_t>(opt_.channels), ChannelCodec{});
+    chunk_n_ = 0;
+    return true;
+}
+
+bool SessionArchiveWriter::Append(std::uint64_t t_ms, const std::vector<SensorData>& sensors, std::string* err) {
+    if (!f_) { if (err) *err = "Archiv nicht geöffnet"; return false; }
+
+    // Zeit im Archiv nie rückwärts (Index-Suche setzt Monotonie voraus)
+    if (chunk_n_ > 0 && t_ms < chunk_t1_) t_ms = chunk_t1_;
+    if (chunk_n_ > 0 && t_ms - chunk_t0_ >= opt_.chunk_ms && !FlushChunk(err)) return false;
+    if (chunk_n_ == 0) {
+        if (!index_.empty()) t_ms = std::max(t_ms, index_.back().t_last_ms);
+        chunk_t0_ = t_ms;
+    }
+
+    ts_codec_.Encode(ts_buf_, t_ms);
+    const SensorData empty{};
+    for (size_t c = 0; c < ch_codec_.size(); ++c)
+        ch_codec_[c].Encode(ch_buf_[c], c < sensors.size() ? sensors[c] : empty, opt_.resolution);
+
+    chunk_t1_ = t_ms;
+    ++chunk_n_;
+    ++samples_;
+    return true;
+}
+
+bool SessionArchiveWriter::FlushChunk(std::string* err) {
+    if (chunk_n_ == 0) return true;
+    SOSESTA_TRACE_SCOPE("SessionArchive::FlushChunk");
+
+    ts_buf_.Flush();
+    for (auto& b : ch_buf_) b.Flush();
+
+    std::vector<std::uint8_t> h;
+    h.reserve(ChunkHeaderSize(opt_.channels));
+    PutLE(h, kChunkMagic);
+    PutLE(h, chunk_n_);
+    PutLE(h, chunk_t0_);
+    PutLE(h, chunk_t1_);
+    PutLE(h, static_cast<std::uint32_t>(ts_buf_.Bytes().size()));
+    for (const auto& b : ch_buf_) PutLE(h, static_cast<std::uint32_t>(b.Bytes().size()));
+
+    ChunkInfo ci;
+    ci.offset     = bytes_;
+    ci.t_first_ms = chunk_t0_;
+    ci.t_last_ms  = chunk_t1_;
+    ci.samples    = chunk_n_;
+
+    bool ok = Write(h.data(), h.size(), err) && Write(ts_buf_.Bytes().data(), ts_buf_.Bytes().size(), err);
+    for (const auto& b : ch_buf_) ok = ok && Write(b.Bytes().data(), b.Bytes().size(), err);
+    // fertige Chunks sofort auf die Platte: Absturz kostet höchstens den laufenden
+    if (ok && std::fflush(f_) != 0) { if (err) *err = Errno("fflush", path_); ok = false; }
+    if (ok) index_.push_back(ci);
+
+    ts_buf_.Clear();
+    ts_codec_ = {};
+    for (auto& b : ch_buf_) b.Clear();
+    for (auto& c : ch_codec_) c = {};
+    chunk_n_ = 0;
+    return ok;
+}
+
+bool SessionArchiveWriter::Write(const void* p, size_t n, std::string* err) {
+    if (n && std::fwrite(p, 1, n, f_) != n) { if (err) *err = Errno("fwrite", path_); return false; }
+    bytes_ += n;
+    return true;
+}
+
+bool SessionArchiveWriter::Close(std::string* err) {
+    if (!f_) return true;
+    bool ok = FlushChunk(err);
+
+    std::vector<std::uint8_t> b;
+    const std::uint64_t footer = bytes_;
+    for (const auto& ci : index_) {
+        PutLE(b, ci.offset);
+        PutLE(b, ci.t_first_ms);
+        PutLE(b, ci.t_last_ms);
+        PutLE(b, ci.samples);
+    }
+    PutLE(b, static_cast<std::uint32_t>(index_.size()));
+    PutLE(b, footer);
+    PutLE(b, kIndexMagic);
+    ok = ok && Write(b.data(), b.size(), err);
+
+    if (std::fclose(f_) != 0 && ok) { if (err) *err = Errno("fclose", path_); ok = false; }
+    f_ = nullptr;
+    return ok;
+}
+
+// ── Reader ────────────────────────────────────────────────────────────────
+bool SessionArchiveReader::Open(const std::string& path, std::string* err) {
+    Close();
+    f_ = std::fopen(path.c_str(), "rb");
+    if (!f_) { if (err) *err = Errno("fopen", path); return false; }
+
+    std::uint8_t h[kFileHeader];
+    if (std::fread(h, 1, sizeof h, f_) != sizeof h) { if (err) *err = "Archiv: Kopf unvollständig"; Close(); return false; }
+    const std::uint8_t* p = h;
+    const auto magic   = GetLE<std::uint32_t>(p);
+    const auto version = GetLE<std::uint16_t>(p);
+    channels_          = GetLE<std::uint16_t>(p);
+    chunk_ms_          = GetLE<std::uint32_t>(p);
+    for (auto& r : resolution_) r = GetLE<double>(p);
+    if (magic != kFileMagic)   { if (err) *err = "Archiv: keine SSAR-Datei"; Close(); return false; }
+    if (version != kVersion)   { if (err) *err = "Archiv: Version " + std::to_string(version) + " nicht unterstützt"; Close(); return false; }
+    if (channels_ <= 0 || channels_ > kMaxChannels) { if (err) *err = "Archiv: ungültige Kanalzahl"; Close(); return false; }
+    data_start_ = kFileHeader;
+
+    if (!ReadIndex(err) && !ScanChunks(err)) { Close(); return false; }
+    return true;
+}
+
+void SessionArchiveReader::Close() {
+    if (f_) std::fclose(f_);
+    f_ = nullptr;
+    index_.clear();
+    recovered_ = false;
+}
+
+bool SessionArchiveReader::ReadIndex(std::string* err) {
+    if (fseeko(f_, 0, SEEK_END) != 0) return false;
+    const auto size = static_cast<std::uint64_t>(ftello(f_));
+    if (size < data_start_ + kTrailer) return false;
+
+    std::uint8_t t[kTrailer];
+    if (fseeko(f_, static_cast<off_t>(size - kTrailer), SEEK_SET) != 0 || std::fread(t, 1, kTrailer, f_) != kTrailer) return false;
+    const std::uint8_t* p = t;
+    const auto n      = GetLE<std::uint32_t>(p);
+    const auto footer = GetLE<std::uint64_t>(p);
+    const auto magic  = GetLE<std::uint32_t>(p);
+    if (magic != kIndexMagic || footer + std::uint64_t(n) * kIndexEntry + kTrailer != size) return false;
+
+    std::vector<std::uint8_t> b(std::size_t(n) * kIndexEntry);
+    if (fseeko(f_, static_cast<off_t>(footer), SEEK_SET) != 0 || std::fread(b.data(), 1, b.size(), f_) != b.size()) {
+        if (err) *err = "Archiv: Index unvollständig";
+        return false;
+    }
+    p = b.data();
+    index_.resize(n);
+    for (auto& ci : index_) {
+        ci.offset     = GetLE<std::uint64_t>(p);
+        ci.t_first_ms = GetLE<std::uint64_t>(p);
+        ci.t_last_ms  = GetLE<std::uint64_t>(p);
+        ci.samples    = GetLE<std::uint32_t>(p);
+    }
+    return true;
+}
+
+bool SessionArchiveReader::ScanChunks(std::string* err) {
+    // Wiederherstellung: Chunk-Köpfe hintereinander lesen, bis es nicht mehr passt
+    index_.clear();
+    const size_t hs = ChunkHeaderSize(channels_);
+    std::vector<std::uint8_t> h(hs);
+    std::uint64_t off = data_start_;
+    for (;;) {
+        if (fseeko(f_, static_cast<off_t>(off), SEEK_SET) != 0 || std::fread(h.data(), 1, hs, f_) != hs) break;
+        const std::uint8_t* p = h.data();
+        if (GetLE<std::uint32_t>(p) != kChunkMagic) break;
+        ChunkInfo ci;
+        ci.offset     = off;
+        ci.samples    = GetLE<std::uint32_t>(p);
+        ci.t_first_ms = GetLE<std::uint64_t>(p);
+        ci.t_last_ms  = GetLE<std::uint64_t>(p);
+        std::uint64_t payload = GetLE<std::uint32_t>(p);
+        for (int c = 0; c < channels_; ++c) payload += GetLE<std::uint32_t>(p);
+
+        // nur vollständige Chunks übernehmen
+        if (fseeko(f_, 0, SEEK_END) != 0 || static_cast<std::uint64_t>(ftello(f_)) < off + hs + payload) break;
+        index_.push_back(ci);
+        off += hs + payload;
+    }
+    recovered_ = true;
+    if (index_.empty() && err) *err = "Archiv: keine lesbaren Chunks";
+    return true;   // leeres Archiv ist gültig
+}
+
+bool SessionArchiveReader::Read(std::uint64_t t0_ms, std::uint64_t t1_ms, int channel,
+                                std::vector<Record>& out, std::string* err)
+{
+    if (!f_) { if (err) *err = "Archiv nicht geöffnet"; return false; }
+    if (channel >= channels_) { if (err) *err = "Archiv: Kanal außerhalb"; return false; }
+    SOSESTA_TRACE_SCOPE("SessionArchive::Read");
+
+    auto it = std::lower_bound(index_.begin(), index_.end(), t0_ms,
+                               [](const ChunkInfo& ci, std::uint64_t t) { return ci.t_last_ms < t; });
+    for (; it != index_.end() && it->t_first_ms <= t1_ms; ++it)
+        if (!DecodeChunk(*it, channel, t0_ms, t1_ms, out, err)) return false;
+    return true;
+}
+
+bool SessionArchiveReader::ReadChunk(size_t i, int channel, std::vector<Record>& out, std::string* err) {
+    if (!f_) { if (err) *err = "Archiv nicht geöffnet"; return false; }
+    if (channel >= channels_) { if (err) *err = "Archiv: Kanal außerhalb"; return false; }
+    if (i >= index_.size()) { if (err) *err = "Archiv: Chunk außerhalb"; return false; }
+    return DecodeChunk(index_[i], channel, 0, UINT64_MAX, out, err);
+}
+
+bool SessionArchiveReader::DecodeChunk(const ChunkInfo& ci, int channel, std::uint64_t t0_ms, std::uint64_t t1_ms,
+                                       std::vector<Record>& out, std::string* err)
+{
+    const size_t hs = ChunkHeaderSize(channels_);
+    std::vector<std::uint8_t> h(hs), buf;
+    std::vector<std::uint64_t> ts;
+    std::vector<std::vector<SensorData>> cols;
+
+    if (fseeko(f_, static_cast<off_t>(ci.offset), SEEK_SET) != 0 || std::fread(h.data(), 1, hs, f_) != hs) {
+        if (err) *err = "Archiv: Chunk-Kopf nicht lesbar";
+        return false;
+    }
+    const std::uint8_t* p = h.data();
+    if (GetLE<std::uint32_t>(p) != kChunkMagic) { if (err) *err = "Archiv: Chunk-Kennung fehlt"; return false; }
+    const auto n = GetLE<std::uint32_t>(p);
+    p += 16;   // t_first, t_last stehen schon im Index
+    const auto ts_bytes = GetLE<std::uint32_t>(p);
+    std::vector<std::uint32_t> ch_bytes(static_cast<size_t>(channels_));
+    for (auto& b : ch_bytes) b = GetLE<std::uint32_t>(p);
+    if (!SamplesPlausible(n, ci.samples, ts_bytes)) { if (err) *err = "Archiv: Abtastzahl im Chunk-Kopf unplausibel"; return false; }
+
+    // Zeitstrom
+    buf.resize(ts_bytes);
+    if (std::fread(buf.data(), 1, ts_bytes, f_) != ts_bytes) { if (err) *err = "Archiv: Zeitstrom unvollständig"; return false; }
+    BitReader tr(buf.data(), buf.size());
+    TimeCodec tc;
+    ts.resize(n);
+    for (auto& t : ts) t = tc.Decode(tr);
+
+    // nur die angeforderten Kanalströme lesen
+    const int c_begin = channel < 0 ? 0 : channel;
+    const int c_end   = channel < 0 ? channels_ : channel + 1;
+    cols.resize(static_cast<size_t>(c_end - c_begin));
+    std::uint64_t off = ci.offset + hs + ts_bytes;
+    for (int c = 0; c < c_begin; ++c) off += ch_bytes[size_t(c)];
+    for (int c = c_begin; c < c_end; ++c) {
+        const std::uint32_t nb = ch_bytes[size_t(c)];
+        if (!SamplesPlausible(n, ci.samples, nb)) { if (err) *err = "Archiv: Kanalstrom zu kurz für Abtastzahl"; return false; }
+        buf.resize(nb);
+        if (fseeko(f_, static_cast<off_t>(off), SEEK_SET) != 0 || std::fread(buf.data(), 1, nb, f_) != nb) {
+            if (err) *err = "Archiv: Kanalstrom unvollständig";
+            return false;
+        }
+        off += nb;
+        BitReader r(buf.data(), buf.size());
+        ChannelCodec cc;
+        auto& col = cols[size_t(c - c_begin)];
+        col.resize(n);
+        for (std::uint32_t k = 0; k < n; ++k) {
+            col[k] = SensorData{};
+            col[k].channel      = c;
+            col[k].timestamp_ms = ts[k];
+            cc.Decode(r, col[k], resolution_);
+        }
+        if (!r.Ok()) { if (err) *err = "Archiv: Kanalstrom beschädigt"; return false; }
+    }
+
+    for (std::uint32_t k = 0; k < n; ++k) {
+        if (ts[k] < t0_ms || ts[k] > t1_ms) continue;
+        for (const auto& col : cols) out.push_back(Record{ ts[k], col[k] });
+    }
+    return true;
+}
+
+// ── View (Speicherabbildung) ──────────────────────────────────────────────
+bool SessionArchiveView::Open(const std::string& path, std::string* err) {
+    Close();
+#if defined(_WIN32)
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                           OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (f == INVALID_HANDLE_VALUE) { if (err) *err = "Archiv: " + path + " nicht lesbar"; return false; }
+    file_ = f;
+    LARGE_INTEGER sz{};
+    if (GetFileSizeEx(f, &sz)) size_ = static_cast<std::uint64_t>(sz.QuadPart);
+    if (size_ >= kFileHeader) {
+        map_ = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (map_) base_ = static_cast<const std::uint8_t*>(MapViewOfFile(map_, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { if (err) *err = Errno("open", path); return false; }
+    struct stat st{};
+    if (::fstat(fd, &st) == 0) size_ = static_cast<std::uint64_t>(st.st_size);
+    if (size_ >= kFileHeader) {
+        void* m = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (m != MAP_FAILED) {
+            base_ = static_cast<const std::uint8_t*>(m);
+            ::madvise(m, size_, MADV_RANDOM);   // kein Vorauslesen fremder Chunks
+        }
+    }
+    ::close(fd);   // Abbildung bleibt bestehen
+#endif
+    if (!base_) {
+        if (err) *err = size_ < kFileHeader ? "Archiv: Kopf unvollständig" : "Archiv: Abbildung fehlgeschlagen";
+        Close();
+        return false;
+    }
+
+    const std::uint8_t* p = base_;
+    const auto magic   = GetLE<std::uint32_t>(p);
+    const auto version = GetLE<std::uint16_t>(p);
+    channels_          = GetLE<std::uint16_t>(p);
+    chunk_ms_          = GetLE<std::uint32_t>(p);
+    for (auto& r : resolution_) r = GetLE<double>(p);
+    if (magic != kFileMagic)   { if (err) *err = "Archiv: keine SSAR-Datei"; Close(); return false; }
+    if (version != kVersion)   { if (err) *err = "Archiv: Version " + std::to_string(version) + " nicht unterstützt"; Close(); return false; }
+    if (channels_ <= 0 || channels_ > kMaxChannels) { if (err) *err = "Archiv: ungültige Kanalzahl"; Close(); return false; }
+
+    // Index im Footer: nur Trailer prüfen, Einträge bleiben in der Abbildung
+    if (size_ >= kFileHeader + kTrailer) {
+        p = base_ + size_ - kTrailer;
+        const auto n      = GetLE<std::uint32_t>(p);
+        const auto footer = GetLE<std::uint64_t>(p);
+        if (GetLE<std::uint32_t>(p) == kIndexMagic && footer >= kFileHeader
+            && footer + std::uint64_t(n) * kIndexEntry + kTrailer == size_) {
+            footer_ = footer;
+            chunks_ = n;
+        }
+    }
+    if (footer_ == 0 && !ScanChunks(err)) { Close(); return false; }
+    cache_.reserve(std::max<size_t>(opt_.cache_blocks, 1));
+    return true;
+}
+
+void SessionArchiveView::Close() {
+#if defined(_WIN32)
+    if (base_) UnmapViewOfFile(base_);
+    if (map_)  CloseHandle(map_);
+    if (file_) CloseHandle(file_);
+    map_  = nullptr;
+    file_ = nullptr;
+#else
+    if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+#endif
+    base_      = nullptr;
+    size_      = 0;
+    channels_  = 0;
+    chunks_    = 0;
+    footer_    = 0;
+    recovered_ = false;
+    scanned_.clear();
+    cache_.clear();
+}
+
+bool SessionArchiveView::ScanChunks(std::string* err) {
+    // wie SessionArchiveReader: Chunk-Köpfe ablaufen, nur vollständige übernehmen
+    const size_t hs = ChunkHeaderSize(channels_);
+    std::uint64_t off = kFileHeader;
+    while (off + hs <= size_) {
+        const std::uint8_t* p = base_ + off;
+        if (GetLE<std::uint32_t>(p) != kChunkMagic) break;
+        ChunkInfo ci;
+        ci.offset     = off;
+        ci.samples    = GetLE<std::uint32_t>(p);
+        ci.t_first_ms = GetLE<std::uint64_t>(p);
+        ci.t_last_ms  = GetLE<std::uint64_t>(p);
+        std::uint64_t payload = GetLE<std::uint32_t>(p);
+        for (int c = 0; c < channels_; ++c) payload += GetLE<std::uint32_t>(p);
+        if (off + hs + payload > size_) break;
+        scanned_.push_back(ci);
+        off += hs + payload;
+    }
+    chunks_    = scanned_.size();
+    recovered_ = true;
+    if (scanned_.empty() && err) *err = "Archiv: keine lesbaren Chunks";
+    return true;   // leeres Archiv ist gültig
+}
+
+ChunkInfo SessionArchiveView::Chunk(size_t i) const {
+    if (i >= chunks_) return {};
+    if (recovered_) return scanned_[i];
+    const std::uint8_t* p = base_ + footer_ + i * kIndexEntry;
+    ChunkInfo ci;
+    ci.offset     = GetLE<std::uint64_t>(p);
+    ci.t_first_ms = GetLE<std::uint64_t>(p);
+    ci.t_last_ms  = GetLE<std::uint64_t>(p);
+    ci.samples    = GetLE<std::uint32_t>(p);
+    return ci;
+}
+
+std::uint64_t SessionArchiveView::FirstMs() const { return chunks_ ? Chunk(0).t_first_ms : 0; }
+std::uint64_t SessionArchiveView::LastMs()  const { return chunks_ ? Chunk(chunks_ - 1).t_last_ms : 0; }
+
+std::pair<size_t, size_t> SessionArchiveView::FindChunks(std::uint64_t t0_ms, std::uint64_t t1_ms) const {
+    // Binärsuche direkt über die Index-Einträge der Abbildung
+    const auto all = std::views::iota(size_t{0}, chunks_);
+    const size_t first = *std::ranges::partition_point(all, [&](size_t i) { return Chunk(i).t_last_ms < t0_ms; });
+    const size_t last  = *std::ranges::partition_point(all, [&](size_t i) { return Chunk(i).t_first_ms <= t1_ms; });
+    return {first, std::max(first, last)};
+}
+
+const SessionArchiveView::Block* SessionArchiveView::Decode(size_t chunk, int channel, std::string* err) {
+    for (auto& b : cache_)
+        if (b->chunk == chunk && b->channel == channel) { b->used = ++tick_; b->pinned = scan_; return b.get(); }
+
+    SOSESTA_TRACE_SCOPE("SessionArchiveView::Decode");
+    const ChunkInfo ci = Chunk(chunk);
+    const size_t hs = ChunkHeaderSize(channels_);
+    if (ci.offset + hs > size_) { if (err) *err = "Archiv: Chunk-Kopf außerhalb"; return nullptr; }
+    const std::uint8_t* p = base_ + ci.offset;
+    if (GetLE<std::uint32_t>(p) != kChunkMagic) { if (err) *err = "Archiv: Chunk-Kennung fehlt"; return nullptr; }
+    const auto n = GetLE<std::uint32_t>(p);
+    p += 16;   // t_first, t_last stehen schon im Index
+    const auto ts_bytes = GetLE<std::uint32_t>(p);
+    std::uint64_t off = ci.offset + hs + ts_bytes;
+    for (int c = 0; c < channel; ++c) off += GetLE<std::uint32_t>(p);
+    const auto nb = GetLE<std::uint32_t>(p);
+    if (off + nb > size_) { if (err) *err = "Archiv: Kanalstrom unvollständig"; return nullptr; }
+    if (!SamplesPlausible(n, ci.samples, ts_bytes) || !SamplesPlausible(n, ci.samples, nb)) {
+        if (err) *err = "Archiv: Abtastzahl im Chunk-Kopf unplausibel";
+        return nullptr;
+    }
+
+    // freier Platz oder am längsten unbenutzter Block, der nicht zum laufenden
+    // Scan() gehört (dessen Spans hat der Aufrufer evtl. noch); sonst wachsen
+    Block* b = nullptr;
+    if (cache_.size() < std::max<size_t>(opt_.cache_blocks, 1)) {
+        b = cache_.emplace_back(std::make_unique<Block>()).get();
+    } else {
+        for (auto& c : cache_)
+            if (c->pinned != scan_ && (!b || c->used < b->used)) b = c.get();
+        if (!b) b = cache_.emplace_back(std::make_unique<Block>()).get();
+    }
+    b->chunk   = chunk;
+    b->channel = -1;   // erst nach fehlerfreiem Dekodieren gültig
+    b->used    = ++tick_;
+    b->pinned  = scan_;
+
+    BitReader tr(base_ + ci.offset + hs, ts_bytes);
+    TimeCodec tc;
+    b->t_ms.resize(n);
+    for (auto& t : b->t_ms) t = tc.Decode(tr);
+
+    BitReader r(base_ + off, nb);
+    ChannelCodec cc;
+    SensorData s;
+    for (auto& v : b->v) v.resize(n);
+    for (std::uint32_t k = 0; k < n; ++k) {
+        cc.Decode(r, s, resolution_);
+        b->v[0][k] = s.bus_V;
+        b->v[1][k] = s.current_mA;
+        b->v[2][k] = s.power_mW;
+        b->v[3][k] = s.redlab_V;
+    }
+    if (!tr.Ok() || !r.Ok()) { if (err) *err = "Archiv: Kanalstrom beschädigt"; return nullptr; }
+    b->channel = channel;
+    return b;
+}
+
+bool SessionArchiveView::Scan(int channel, Quantity q, std::uint64_t t0_ms, std::uint64_t t1_ms,
+                              const std::function<bool(const Span&)>& fn, std::string* err)
+{
+    if (!base_) { if (err) *err = "Archiv nicht geöffnet"; return false; }
+    if (channel < 0 || channel >= channels_) { if (err) *err = "Archiv: Kanal außerhalb"; return false; }
+    const auto qi = static_cast<size_t>(q);
+    if (qi >= kQuantities) { if (err) *err = "Archiv: Messgröße unbekannt"; return false; }
+    SOSESTA_TRACE_SCOPE("SessionArchiveView::Scan");
+
+    // Spans des vorigen Scans verfallen hier: Überhang abbauen, neu pinnen
+    TrimCache();
+    ++scan_;
+
+    const auto [first, last] = FindChunks(t0_ms, t1_ms);
+    for (size_t i = first; i < last; ++i) {
+        const Block* b = Decode(i, channel, err);
+        if (!b) return false;
+        // Zeiten im Chunk aufsteigend: Grenzen per Binärsuche
+        const auto lo = std::lower_bound(b->t_ms.begin(), b->t_ms.end(), t0_ms) - b->t_ms.begin();
+        const auto hi = std::upper_bound(b->t_ms.begin(), b->t_ms.end(), t1_ms) - b->t_ms.begin();
+        if (lo >= hi) continue;
+        const auto len = static_cast<size_t>(hi - lo);
+        Span s;
+        s.chunk  = i;
+        s.t_ms   = std::span<const std::uint64_t>(b->t_ms).subspan(static_cast<size_t>(lo), len);
+        s.values = std::span<const double>(b->v[qi]).subspan(static_cast<size_t>(lo), len);
+        if (!fn(s)) break;
+    }
+    return true;
+}
+
+bool SessionArchiveView::Read(int channel, Quantity q, std::uint64_t t0_ms, std::uint64_t t1_ms,
+                              std::vector<std::uint64_t>& t_ms, std::vector<double>& values, std::string* err)
+{
+    t_ms.clear();
+    values.clear();
+    return Scan(channel, q, t0_ms, t1_ms, [&](const Span& s) {
+        t_ms.insert(t_ms.end(), s.t_ms.begin(), s.t_ms.end());
+        values.insert(values.end(), s.values.begin(), s.values.end());
+        return true;
+    }, err);
+}
+
+void SessionArchiveView::TrimCache() {
+    const size_t cap = std::max<size_t>(opt_.cache_blocks, 1);
+    if (cache_.size() <= cap) return;
+    // jüngste cap Blöcke behalten
+    std::ranges::sort(cache_, std::ranges::greater{}, [](const auto& b) { return b->used; });
+    cache_.resize(cap);
+}
+
+size_t SessionArchiveView::CacheBytes() const {
+    size_t n = 0;
+    for (const auto& b : cache_) {
+        n += b->t_ms.capacity() * sizeof(std::uint64_t);
+        for (const auto& v : b->v) n += v.capacity() * sizeof(double);
+    }
+    return n;
+}
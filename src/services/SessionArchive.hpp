@@ -0,0 +1,313 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "app/data/SensorData.hpp"
+
+/**
+ * Sitzungsarchiv (*.ssa): kompakte, durchsuchbare Aufzeichnung aller Zyklen.
+ *
+ * Aufbau
+ *   Kopf    'SSAR', Version, Kanäle, Chunk-Dauer, Auflösung je Messgröße
+ *   Chunks  je chunk_ms ein Block, unabhängig dekodierbar:
+ *           Kopf (Anzahl, t_first, t_last, Bytes je Strom),
+ *           Zeitstrom + je Kanal ein eigener Bitstrom
+ *   Footer  Index (Offset, t_first, t_last, Anzahl je Chunk) + Trailer 'SSIX'
+ *
+ * Kodierung
+ *   Zeit    Delta-of-Delta (Gorilla): konstanter Takt → 1 Bit je Zyklus
+ *   Werte   auf die Auflösung gerundete Ganzzahl-Codes als Delta zum Vorwert
+ *           in einem wiederverwendeten Bitbreiten-Fenster; resolution = 0 →
+ *           rohe double-Bits per XOR mit Leading/Trailing-Zero-Fenster (Gorilla)
+ *   Flags   present/supply_ok/signal_ok/stale als 4 Bit, nur bei Änderung
+ *   Zähler  Fehler-/Retry-Zähler als Delta, nur bei Änderung
+ *
+ * Ohne Footer (Absturz während der Aufnahme) liest der Reader die Chunks
+ * sequentiell; verloren ist höchstens der nicht geschriebene letzte Chunk.
+ */
+namespace session_archive {
+
+inline constexpr int kQuantities = 4;   // bus_V, current_mA, power_mW, redlab_V
+
+// Messgröße in Archiv-Reihenfolge
+enum class Quantity : std::uint8_t { BusV = 0, CurrentMa, PowerMw, RedlabV };
+
+struct ChunkInfo {
+    std::uint64_t offset     = 0;
+    std::uint64_t t_first_ms = 0;
+    std::uint64_t t_last_ms  = 0;
+    std::uint32_t samples    = 0;
+};
+
+struct Record {
+    std::uint64_t t_ms = 0;
+    SensorData    data;   // data.channel gesetzt, timestamp_ms = t_ms
+};
+
+// ── Bitströme (MSB zuerst) ────────────────────────────────────────────────
+class BitWriter {
+public:
+    void Put(std::uint64_t v, int bits);   // 1..64 Bit
+    void Flush();                          // letztes Byte mit Nullen auffüllen
+    void Clear() { buf_.clear(); acc_ = 0; nacc_ = 0; }
+    const std::vector<std::uint8_t>& Bytes() const { return buf_; }
+
+private:
+    std::vector<std::uint8_t> buf_;
+    std::uint64_t acc_  = 0;
+    int           nacc_ = 0;
+};
+
+class BitReader {
+public:
+    BitReader(const std::uint8_t* p, size_t n) : p_(p), end_(p + n) {}
+    std::uint64_t Get(int bits);           // 1..64 Bit
+    bool Ok() const { return ok_; }        // false = über das Ende gelesen
+
+private:
+    const std::uint8_t* p_;
+    const std::uint8_t* end_;
+    std::uint64_t acc_  = 0;
+    int           nacc_ = 0;
+    bool          ok_   = true;
+};
+
+// ── Kodierer je Spalte; Zustand beginnt in jedem Chunk neu ───────────────
+struct TimeCodec {
+    std::uint64_t prev       = 0;
+    std::int64_t  prev_delta = 0;
+    bool          first      = true;
+
+    void Encode(BitWriter& w, std::uint64_t t);
+    std::uint64_t Decode(BitReader& r);
+};
+
+// double-Bits: XOR zum Vorwert (Gorilla)
+struct XorCodec {
+    std::uint64_t prev  = 0;
+    int           lead  = -1;   // -1 = noch kein Fenster
+    int           trail = 0;
+    bool          first = true;
+
+    void Encode(BitWriter& w, std::uint64_t word);
+    std::uint64_t Decode(BitReader& r);
+};
+
+// Ganzzahl-Codes: Delta im Bitbreiten-Fenster (bei Rauschen deutlich
+// kompakter als XOR, weil Vorzeichen-/Zweierpotenz-Wechsel nicht durchschlagen)
+struct DeltaCodec {
+    std::int64_t prev  = 0;
+    int          width = 0;   // 0 = noch kein Fenster
+    bool         first = true;
+
+    void Encode(BitWriter& w, std::int64_t code);
+    std::int64_t Decode(BitReader& r);
+};
+
+// Alle Spalten eines Kanals: Flags, vier Messgrößen, vier Zähler
+struct ChannelCodec {
+    std::array<DeltaCodec, kQuantities> code;   // resolution > 0
+    std::array<XorCodec, kQuantities>   raw;    // resolution = 0
+    std::uint8_t                 flags = 0xFF;    // 0xFF = noch nichts geschrieben
+    std::array<std::uint32_t, 4> counters{};
+
+    void Encode(BitWriter& w, const SensorData& s, const std::array<double, kQuantities>& res);
+    void Decode(BitReader& r, SensorData& s, const std::array<double, kQuantities>& res);
+};
+
+} // namespace session_archive
+
+class SessionArchiveWriter {
+public:
+    struct Options {
+        int           channels = kNumChannels;
+        std::uint32_t chunk_ms = 10000;
+        // Rundung vor der Kompression (bus_V, current_mA, power_mW, redlab_V);
+        // Standard: feiner als die Auflösung von INA219 bzw. 16-Bit-DAQ
+        std::array<double, session_archive::kQuantities> resolution{ 0.001, 0.001, 0.01, 0.0001 };
+    };
+
+    SessionArchiveWriter() = default;
+    ~SessionArchiveWriter() { Close(); }
+
+    SessionArchiveWriter(const SessionArchiveWriter&) = delete;
+    SessionArchiveWriter& operator=(const SessionArchiveWriter&) = delete;
+
+    bool Open(const std::string& path, const Options& opt, std::string* err = nullptr);
+    bool Append(std::uint64_t t_ms, const std::vector<SensorData>& sensors, std::string* err = nullptr);
+    bool Close(std::string* err = nullptr);   // schreibt letzten Chunk + Index
+
+    bool IsOpen() const { return f_ != nullptr; }
+    const std::string& Path() const { return path_; }
+    std::uint64_t Samples() const { return samples_; }
+    std::uint64_t BytesWritten() const { return bytes_; }
+
+private:
+    bool FlushChunk(std::string* err);
+    bool Write(const void* p, size_t n, std::string* err);
+
+    Options      opt_;
+    std::string  path_;
+    std::FILE*   f_ = nullptr;
+    std::uint64_t bytes_   = 0;
+    std::uint64_t samples_ = 0;
+
+    // laufender Chunk
+    session_archive::BitWriter                 ts_buf_;
+    session_archive::TimeCodec                 ts_codec_;
+    std::vector<session_archive::BitWriter>    ch_buf_;
+    std::vector<session_archive::ChannelCodec> ch_codec_;
+    std::uint32_t chunk_n_  = 0;
+    std::uint64_t chunk_t0_ = 0;
+    std::uint64_t chunk_t1_ = 0;
+
+    std::vector<session_archive::ChunkInfo> index_;
+};
+
+class SessionArchiveReader {
+public:
+    SessionArchiveReader() = default;
+    ~SessionArchiveReader() { Close(); }
+
+    SessionArchiveReader(const SessionArchiveReader&) = delete;
+    SessionArchiveReader& operator=(const SessionArchiveReader&) = delete;
+
+    bool Open(const std::string& path, std::string* err = nullptr);
+    void Close();
+
+    int Channels() const { return channels_; }
+    const std::vector<session_archive::ChunkInfo>& Index() const { return index_; }
+    bool Recovered() const { return recovered_; }   // ohne Footer gelesen
+
+    // Alle Zyklen mit t0 ≤ t ≤ t1; channel < 0 = alle Kanäle. Dekodiert
+    // nur die betroffenen Chunks und darin nur die angeforderten Kanäle.
+    bool Read(std::uint64_t t0_ms, std::uint64_t t1_ms, int channel,
+              std::vector<session_archive::Record>& out, std::string* err = nullptr);
+
+    // Ein Chunk (Index()[i]) vollständig, z. B. für Export in Blöcken
+    bool ReadChunk(size_t i, int channel,
+                   std::vector<session_archive::Record>& out, std::string* err = nullptr);
+
+private:
+    bool ReadIndex(std::string* err);
+    bool DecodeChunk(const session_archive::ChunkInfo& ci, int channel, std::uint64_t t0_ms, std::uint64_t t1_ms,
+                     std::vector<session_archive::Record>& out, std::string* err);
+    bool ScanChunks(std::string* err);
+
+    std::FILE*  f_ = nullptr;
+    int         channels_ = 0;
+    std::uint32_t chunk_ms_ = 0;
+    std::array<double, session_archive::kQuantities> resolution_{};
+    std::uint64_t data_start_ = 0;
+    std::vector<session_archive::ChunkInfo> index_;
+    bool recovered_ = false;
+};
+
+/**
+ * Wahlfreier Zugriff auf ein Sitzungsarchiv über eine Speicherabbildung.
+ *
+ * Open() bildet die Datei ab und prüft nur Kopf und Trailer; der Index
+ * wird direkt im Footer der Abbildung gesucht (kein Einlesen) – auch
+ * mehrtägige Sitzungen öffnen in Millisekunden. Ohne Footer werden die
+ * Chunk-Köpfe einmal abgelaufen (wie SessionArchiveReader).
+ *
+ * Scan() liefert je betroffenem Chunk typisierte Spans (Zeit, Werte) für
+ * einen Kanal und eine Messgröße. Dekodiert wird nur der Kanalstrom dieses
+ * Chunks (Bitstrom, alle Größen verschränkt); andere Kanäle und Chunks
+ * werden nicht berührt. Dekodierte Blöcke liegen spaltenweise in einem
+ * LRU-Cache fester Größe – Speicher wächst nur mit dem, was gelesen wird.
+ *
+ * Blöcke, die ein Scan() berührt, sind bis zu dessen Ende vor dem Verdrängen
+ * geschützt (der Cache wächst dafür notfalls über cache_blocks und wird beim
+ * nächsten Scan() wieder gekürzt). Spans bleiben daher bis zum nächsten
+ * Scan()/Read()/DropCache()/Close() gültig.
+ * Nicht thread-sicher (Cache); je Thread eine eigene Sicht öffnen.
+ */
+class SessionArchiveView {
+public:
+    struct Options {
+        size_t cache_blocks = 64;   // dekodierte (Chunk, Kanal)-Blöcke
+    };
+
+    struct Span {
+        size_t                         chunk = 0;
+        std::span<const std::uint64_t> t_ms;
+        std::span<const double>        values;
+    };
+
+    SessionArchiveView() = default;
+    explicit SessionArchiveView(const Options& opt) : opt_(opt) {}
+    ~SessionArchiveView() { Close(); }
+
+    SessionArchiveView(const SessionArchiveView&) = delete;
+    SessionArchiveView& operator=(const SessionArchiveView&) = delete;
+
+    bool Open(const std::string& path, std::string* err = nullptr);
+    void Close();
+    bool IsOpen() const { return base_ != nullptr; }
+
+    int Channels() const { return channels_; }
+    std::uint32_t ChunkMs() const { return chunk_ms_; }
+    std::uint64_t FileBytes() const { return size_; }
+    bool Recovered() const { return recovered_; }
+
+    size_t Chunks() const { return chunks_; }
+    session_archive::ChunkInfo Chunk(size_t i) const;
+    std::uint64_t FirstMs() const;   // 0 = leer
+    std::uint64_t LastMs() const;
+
+    // Chunks, die [t0, t1] überlappen, als [first, last)
+    std::pair<size_t, size_t> FindChunks(std::uint64_t t0_ms, std::uint64_t t1_ms) const;
+
+    // Je Chunk ein Span mit t0 ≤ t ≤ t1 (aufsteigend); fn → false bricht ab
+    bool Scan(int channel, session_archive::Quantity q, std::uint64_t t0_ms, std::uint64_t t1_ms,
+              const std::function<bool(const Span&)>& fn, std::string* err = nullptr);
+
+    // Bequemlichkeit: alle Spans aneinandergehängt (kopiert)
+    bool Read(int channel, session_archive::Quantity q, std::uint64_t t0_ms, std::uint64_t t1_ms,
+              std::vector<std::uint64_t>& t_ms, std::vector<double>& values, std::string* err = nullptr);
+
+    size_t CacheBytes() const;
+    void DropCache() { cache_.clear(); }
+
+private:
+    struct Block {
+        size_t        chunk   = 0;
+        int           channel = -1;
+        std::uint64_t used    = 0;   // LRU-Zeitstempel
+        std::uint64_t pinned  = 0;   // == scan_: vom laufenden Scan() benutzt
+        std::vector<std::uint64_t> t_ms;
+        std::array<std::vector<double>, session_archive::kQuantities> v;
+    };
+
+    bool ScanChunks(std::string* err);
+    const Block* Decode(size_t chunk, int channel, std::string* err);
+    void TrimCache();
+
+    Options opt_;
+    const std::uint8_t* base_ = nullptr;
+    std::uint64_t       size_ = 0;
+#if defined(_WIN32)
+    void* file_ = nullptr;   // HANDLE
+    void* map_  = nullptr;   // HANDLE
+#endif
+    int           channels_ = 0;
+    std::uint32_t chunk_ms_ = 0;
+    std::array<double, session_archive::kQuantities> resolution_{};
+
+    size_t        chunks_   = 0;
+    std::uint64_t footer_   = 0;   // Index-Einträge in der Abbildung
+    std::vector<session_archive::ChunkInfo> scanned_;   // nur ohne Footer
+    bool          recovered_ = false;
+
+    std::vector<std::unique_ptr<Block>> cache_;   // Blöcke wandern nie im Speicher
+    std::uint64_t      tick_ = 0;
+    std::uint64_t      scan_ = 0;
+};
@@ -0,0 +1,329 @@
+// Rundlauf und Beschädigung des Sitzungsarchivs (*.ssa): Kodierer, Writer,
+// Reader (Index und Wiederherstellung ohne Footer) und View.
+#include "services/SessionArchive.hpp"
+#include "util/TestCheck.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+
+using namespace session_archive;
+
+namespace {
+
+constexpr int           kChannels = 3;
+constexpr std::uint32_t kChunkMs  = 1000;
+constexpr size_t        kHeader   = 4 + 2 + 2 + 4 + 8 * kQuantities;   // Dateikopf
+
+SessionArchiveWriter::Options Opt() {
+    SessionArchiveWriter::Options o;
+    o.channels = kChannels;
+    o.chunk_ms = kChunkMs;
+    o.resolution = { 0.001, 0.001, 0.01, 0.0 };   // redlab_V roh (XOR-Pfad)
+    return o;
+}
+
+// Zyklus k, Kanal c: Rauschen, Sprünge, Flags und Zähler
+SensorData Sample(int k, int c, std::mt19937& g) {
+    std::normal_distribution<double> n(0.0, 1.0);
+    SensorData s;
+    s.channel    = c;
+    s.bus_V      = 5.0 + 0.01 * n(g);
+    s.current_mA = (k / 20 % 2 ? 120.0 : 4.0) + 0.5 * n(g);
+    s.power_mW   = s.bus_V * s.current_mA;
+    s.redlab_V   = (k / 20 % 2 ? 2.5 : -2.5) + 0.001 * n(g);
+    s.present    = k % 7 != 0;
+    s.supply_ok  = true;
+    s.signal_ok  = k % 11 != 0;
+    s.stale      = k % 13 == 0;
+    s.supply_error_counter  = k / 50;
+    s.signal_error_counter  = k / 11;
+    s.current_error_counter = c;
+    s.retry_count           = static_cast<std::uint32_t>(k / 13);
+    return s;
+}
+
+struct Written {
+    std::vector<std::uint64_t>           t;
+    std::vector<std::vector<SensorData>> rows;
+};
+
+Written WriteArchive(const std::string& path, int cycles) {
+    Written w;
+    std::mt19937 g(7);
+    SessionArchiveWriter wr;
+    std::string err;
+    if (!wr.Open(path, Opt(), &err)) { CHECK(!"Open"); return w; }
+    std::uint64_t t = 1'700'000'000'000ull;
+    for (int k = 0; k < cycles; ++k) {
+        t += k % 17 == 0 ? 137 : 100;   // meist konstanter Takt, gelegentlich Jitter
+        std::vector<SensorData> row;
+        for (int c = 0; c < kChannels; ++c) row.push_back(Sample(k, c, g));
+        CHECK(wr.Append(t, row, &err));
+        w.t.push_back(t);
+        w.rows.push_back(std::move(row));
+    }
+    CHECK(wr.Close(&err));
+    CHECK(wr.Samples() == static_cast<std::uint64_t>(cycles));
+    return w;
+}
+
+bool Same(const SensorData& a, const SensorData& b) {
+    return std::fabs(a.bus_V - b.bus_V) <= 0.0005 + 1e-12
+        && std::fabs(a.current_mA - b.current_mA) <= 0.0005 + 1e-12
+        && std::fabs(a.power_mW - b.power_mW) <= 0.005 + 1e-12
+        && a.redlab_V == b.redlab_V   // roh: bitgenau
+        && a.present == b.present && a.supply_ok == b.supply_ok
+        && a.signal_ok == b.signal_ok && a.stale == b.stale
+        && a.supply_error_counter == b.supply_error_counter
+        && a.signal_error_counter == b.signal_error_counter
+        && a.current_error_counter == b.current_error_counter
+        && a.retry_count == b.retry_count;
+}
+
+// out (alle Kanäle, zeilenweise) gegen die geschriebenen Zyklen [first, first + n)
+void CheckRecords(const std::vector<Record>& out, const Written& w, size_t first, size_t n) {
+    REQUIRE(out.size() == n * kChannels);
+    for (size_t i = 0; i < n; ++i) {
+        for (int c = 0; c < kChannels; ++c) {
+            const Record& r = out[i * kChannels + static_cast<size_t>(c)];
+            CHECK(r.t_ms == w.t[first + i]);
+            CHECK(r.data.channel == c);
+            CHECK(Same(r.data, w.rows[first + i][static_cast<size_t>(c)]));
+        }
+    }
+}
+
+std::vector<char> Load(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>() };
+}
+
+void Store(const std::string& path, const std::vector<char>& b, size_t n) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f.write(b.data(), static_cast<std::streamsize>(n));
+}
+
+// ── Tests ─────────────────────────────────────────────────
+
+void TestCodecs() {
+    std::mt19937_64 g(1);
+    BitWriter w;
+    TimeCodec tc;
+    DeltaCodec dc;
+    XorCodec xc;
+    std::vector<std::uint64_t> ts, xs;
+    std::vector<std::int64_t>  ds;
+    std::uint64_t t = 0;
+    for (int k = 0; k < 2000; ++k) {
+        t += k % 100 == 0 ? g() % 100000 : 100;
+        ts.push_back(t);
+        // kleine Deltas, gelegentlich Extremwerte (volle Breite)
+        std::int64_t d = static_cast<std::int64_t>(g() % 64) - 32;
+        if (k % 97 == 0) d = k % 2 ? std::numeric_limits<std::int64_t>::max() : std::numeric_limits<std::int64_t>::min();
+        ds.push_back(d);
+        const double v[] = { 0.0, -0.0, 1.0 / 3.0, 1e300, -1e-300, std::numeric_limits<double>::quiet_NaN() };
+        xs.push_back(std::bit_cast<std::uint64_t>(v[g() % 6]));
+    }
+    for (size_t i = 0; i < ts.size(); ++i) {
+        tc.Encode(w, ts[i]);
+        dc.Encode(w, ds[i]);
+        xc.Encode(w, xs[i]);
+    }
+    w.Flush();
+
+    BitReader r(w.Bytes().data(), w.Bytes().size());
+    TimeCodec tc2;
+    DeltaCodec dc2;
+    XorCodec xc2;
+    bool same = true;
+    for (size_t i = 0; i < ts.size(); ++i) {
+        same = same && tc2.Decode(r) == ts[i];
+        same = same && dc2.Decode(r) == ds[i];
+        same = same && xc2.Decode(r) == xs[i];
+    }
+    CHECK(same);
+    CHECK(r.Ok());
+
+    // über das Ende lesen wird erkannt
+    BitReader r2(w.Bytes().data(), 1);
+    r2.Get(8);
+    CHECK(r2.Ok());
+    r2.Get(1);
+    CHECK(!r2.Ok());
+}
+
+void TestRoundTrip() {
+    const std::string path = sosesta::test::TempPath("roundtrip.ssa");
+    const Written w = WriteArchive(path, 450);
+
+    SessionArchiveReader rd;
+    std::string err;
+    REQUIRE(rd.Open(path, &err));
+    CHECK(!rd.Recovered());
+    CHECK(rd.Channels() == kChannels);
+    CHECK(rd.Index().size() >= 4);
+
+    std::vector<Record> out;
+    CHECK(rd.Read(0, UINT64_MAX, -1, out, &err));
+    CheckRecords(out, w, 0, w.t.size());
+
+    // Zeitfenster mitten in einem Chunk, ein Kanal
+    out.clear();
+    CHECK(rd.Read(w.t[100], w.t[199], 2, out, &err));
+    REQUIRE(out.size() == 100);
+    for (size_t i = 0; i < out.size(); ++i) {
+        CHECK(out[i].t_ms == w.t[100 + i]);
+        CHECK(Same(out[i].data, w.rows[100 + i][2]));
+    }
+
+    // Chunkweise gelesen ergibt dieselbe Folge
+    std::vector<Record> all;
+    for (size_t i = 0; i < rd.Index().size(); ++i) CHECK(rd.ReadChunk(i, -1, all, &err));
+    CheckRecords(all, w, 0, w.t.size());
+
+    CHECK(!rd.Read(0, UINT64_MAX, kChannels, out, &err));   // Kanal außerhalb
+    std::filesystem::remove(path);
+}
+
+void TestView() {
+    const std::string path = sosesta::test::TempPath("view.ssa");
+    const Written w = WriteArchive(path, 450);
+
+    SessionArchiveView::Options vo;
+    vo.cache_blocks = 2;   // kleiner als die Chunkzahl: Scan muss Blöcke festhalten
+    SessionArchiveView v(vo);
+    std::string err;
+    REQUIRE(v.Open(path, &err));
+    CHECK(!v.Recovered());
+    CHECK(v.FirstMs() == w.t.front());
+    CHECK(v.LastMs() == w.t.back());
+
+    std::vector<SessionArchiveView::Span> spans;
+    CHECK(v.Scan(1, Quantity::CurrentMa, 0, UINT64_MAX,
+                 [&](const SessionArchiveView::Span& s) { spans.push_back(s); return true; }, &err));
+    size_t k = 0;
+    bool same = true;
+    for (const auto& s : spans)   // Spans müssen bis zum Ende des Scans gültig bleiben
+        for (size_t i = 0; i < s.t_ms.size(); ++i, ++k)
+            same = same && k < w.t.size() && s.t_ms[i] == w.t[k]
+                        && std::fabs(s.values[i] - w.rows[k][1].current_mA) <= 0.0005 + 1e-12;
+    CHECK(same);
+    CHECK(k == w.t.size());
+
+    std::vector<std::uint64_t> t;
+    std::vector<double> vals;
+    CHECK(v.Read(0, Quantity::RedlabV, w.t[10], w.t[20], t, vals, &err));
+    REQUIRE(vals.size() == 11);
+    for (size_t i = 0; i < vals.size(); ++i) CHECK(vals[i] == w.rows[10 + i][0].redlab_V);
+    std::filesystem::remove(path);
+}
+
+void TestRecoveryWithoutFooter() {
+    const std::string path = sosesta::test::TempPath("recover.ssa");
+    const Written w = WriteArchive(path, 450);
+
+    SessionArchiveReader rd;
+    std::string err;
+    REQUIRE(rd.Open(path, &err));
+    const auto index = rd.Index();
+    rd.Close();
+    REQUIRE(index.size() >= 2);
+    const auto b = Load(path);
+
+    // Absturz nach dem letzten Chunk: Footer fehlt, alle Daten lesbar
+    const size_t data_end = b.size() - (index.size() * (8 + 8 + 8 + 4) + 4 + 8 + 4);
+    Store(path, b, data_end);
+    REQUIRE(rd.Open(path, &err));
+    CHECK(rd.Recovered());
+    CHECK(rd.Index().size() == index.size());
+    std::vector<Record> out;
+    CHECK(rd.Read(0, UINT64_MAX, -1, out, &err));
+    CheckRecords(out, w, 0, w.t.size());
+    rd.Close();
+
+    SessionArchiveView v;
+    REQUIRE(v.Open(path, &err));
+    CHECK(v.Recovered());
+    CHECK(v.Chunks() == index.size());
+    v.Close();
+
+    // Absturz mitten im letzten Chunk: nur dieser fehlt
+    Store(path, b, static_cast<size_t>(index.back().offset) + 10);
+    REQUIRE(rd.Open(path, &err));
+    CHECK(rd.Recovered());
+    CHECK(rd.Index().size() == index.size() - 1);
+    out.clear();
+    CHECK(rd.Read(0, UINT64_MAX, -1, out, &err));
+    size_t kept = 0;
+    for (size_t i = 0; i + 1 < index.size(); ++i) kept += index[i].samples;
+    CheckRecords(out, w, 0, kept);
+    rd.Close();
+
+    // nur der Kopf: gültiges, leeres Archiv
+    Store(path, b, kHeader);
+    REQUIRE(rd.Open(path, &err));
+    CHECK(rd.Index().empty());
+    std::filesystem::remove(path);
+}
+
+void TestCorruption() {
+    const std::string path = sosesta::test::TempPath("corrupt.ssa");
+    WriteArchive(path, 450);
+    const auto b = Load(path);
+    SessionArchiveReader rd;
+    std::string err;
+
+    // falsche Kennung / Version / Kanalzahl / abgeschnittener Kopf
+    for (size_t at : { size_t(0), size_t(4), size_t(6) }) {
+        auto c = b;
+        c[at] = static_cast<char>(c[at] ^ 0x5A);
+        Store(path, c, c.size());
+        err.clear();
+        CHECK(!rd.Open(path, &err));
+        CHECK(!err.empty());
+    }
+    Store(path, b, kHeader - 1);
+    CHECK(!rd.Open(path, &err));
+
+    // Abtastzahl im ersten Chunk-Kopf verfälscht: Lesen scheitert sauber
+    {
+        auto c = b;
+        const std::uint32_t n = 0x7FFFFFFF;
+        std::memcpy(c.data() + kHeader + 4, &n, sizeof n);
+        Store(path, c, c.size());
+        REQUIRE(rd.Open(path, &err));
+        std::vector<Record> out;
+        err.clear();
+        CHECK(!rd.Read(0, UINT64_MAX, -1, out, &err));
+        CHECK(!err.empty());
+        rd.Close();
+
+        SessionArchiveView v;
+        REQUIRE(v.Open(path, &err));
+        std::vector<std::uint64_t> t;
+        std::vector<double> vals;
+        CHECK(!v.Read(0, Quantity::BusV, 0, UINT64_MAX, t, vals, &err));
+    }
+
+    // Trailer kaputt: Index wird ignoriert, Chunks werden abgelaufen
+    {
+        auto c = b;
+        c[c.size() - 1] = static_cast<char>(c[c.size() - 1] ^ 0xFF);
+        Store(path, c, c.size());
+        REQUIRE(rd.Open(path, &err));
+        CHECK(rd.Recovered());
+        CHECK(!rd.Index().empty());
+        rd.Close();
+    }
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+TEST_MAIN(TestCodecs, TestRoundTrip, TestView, TestRecoveryWithoutFooter, TestCorruption)
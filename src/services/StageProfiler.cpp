@@ -0,0 +1,162 @@
+#include "services/StageProfiler.hpp"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+const char* StageName(Stage s) {
+    switch (s) {
+        case Stage::Cycle:      return "Zyklus";
+        case Stage::MuxSelect:  return "MUX-Select";
+        case Stage::InaBusV:    return "INA Bus-V";
+        case Stage::InaCurrent: return "INA Strom";
+        case Stage::InaPower:   return "INA Leistung";
+        case Stage::DaqRead:    return "RedLab ulAIn";
+        case Stage::Evaluate:   return "Auswertung";
+        case Stage::LedShow:    return "LED show";
+        case Stage::GuiUpdate:  return "GUI-Update";
+        case Stage::Wakeup:     return "Weck-Jitter";
+        case Stage::Count:      break;
+    }
+    return "?";
+}
+
+const char* StageId(Stage s) {
+    switch (s) {
+        case Stage::Cycle:      return "cycle";
+        case Stage::MuxSelect:  return "mux_select";
+        case Stage::InaBusV:    return "ina_bus_v";
+        case Stage::InaCurrent: return "ina_current";
+        case Stage::InaPower:   return "ina_power";
+        case Stage::DaqRead:    return "daq_read";
+        case Stage::Evaluate:   return "evaluate";
+        case Stage::LedShow:    return "led_show";
+        case Stage::GuiUpdate:  return "gui_update";
+        case Stage::Wakeup:     return "wakeup_lateness";
+        case Stage::Count:      break;
+    }
+    return "unknown";
+}
+
+// ── LatencyHistogram ──────────────────────────────────────
+
+double LatencyHistogram::BucketMid(int idx) {
+    if (idx < 2 * kSubCount) return static_cast<double>(idx); // exakt
+    const int g     = idx / kSubCount;
+    const int sub   = idx % kSubCount;
+    const int shift = g - 1;
+    const double lo = static_cast<double>(static_cast<std::uint64_t>(kSubCount + sub) << shift);
+    const double w  = static_cast<double>(std::uint64_t{1} << shift);
+    return lo + 0.5 * w;
+}
+
+void LatencyHistogram::Snapshot::Merge(const Snapshot& o) {
+    for (size_t i = 0; i < counts.size(); ++i) counts[i] += o.counts[i];
+    if (o.max_ns > max_ns) max_ns = o.max_ns;
+}
+
+std::uint64_t LatencyHistogram::Snapshot::Count() const {
+    std::uint64_t n = 0;
+    for (auto c : counts) n += c;
+    return n;
+}
+
+double LatencyHistogram::Snapshot::Percentile(double q) const {
+    const std::uint64_t n = Count();
+    if (n == 0) return 0.0;
+    const auto target = static_cast<std::uint64_t>(q * static_cast<double>(n - 1)) + 1;
+    const double mx = static_cast<double>(max_ns);
+    std::uint64_t acc = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        acc += counts[static_cast<size_t>(i)];
+        if (acc >= target) {
+            // nie über dem gemessenen Maximum berichten
+            const double v = BucketMid(i);
+            return v < mx ? v : mx;
+        }
+    }
+    return mx;
+}
+
+LatencyHistogram::Summary LatencyHistogram::Snapshot::Summarize() const {
+    Summary s;
+    double sum = 0.0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        const auto c = counts[static_cast<size_t>(i)];
+        s.count += c;
+        sum += static_cast<double>(c) * BucketMid(i);
+    }
+    if (s.count == 0) return s;
+    s.mean_ns = sum / static_cast<double>(s.count);
+    s.p50_ns  = Percentile(0.50);
+    s.p99_ns  = Percentile(0.99);
+    s.p999_ns = Percentile(0.999);
+    s.max_ns  = static_cast<double>(max_ns);
+    return s;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Snap() const {
+    Snapshot s;
+    for (size_t i = 0; i < buckets_.size(); ++i) s.counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    s.max_ns = max_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+// ── StageProfiler ─────────────────────────────────────────
+
+StageProfiler& StageProfiler::Instance() {
+    // Heap statt static-Objekt: ~1 MB Zähler gehören nicht ins .bss des Hauptprogramms
+    static StageProfiler* inst = new StageProfiler();
+    return *inst;
+}
+
+LatencyHistogram::Snapshot StageProfiler::Total(Stage s) const {
+    const auto si = static_cast<size_t>(s);
+    LatencyHistogram::Snapshot snap = unassigned_[si].Snap();
+    for (const auto& h : per_channel_[si]) snap.Merge(h.Snap());
+    return snap;
+}
+
+void StageProfiler::Reset() {
+    for (auto& h : unassigned_) h.Reset();
+    for (auto& row : per_channel_)
+        for (auto& h : row) h.Reset();
+}
+
+bool StageProfiler::DumpToFile(const std::string& path, std::string* err) const {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        if (err) *err = "fopen(" + path + "): " + std::strerror(errno);
+        return false;
+    }
+
+    auto row = [f](const char* stage, const char* ch, const LatencyHistogram::Summary& s) {
+        std::fprintf(f, "%-14s %-6s %10llu %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+                     stage, ch, static_cast<unsigned long long>(s.count),
+                     s.mean_ns / 1e3, s.p50_ns / 1e3, s.p99_ns / 1e3, s.p999_ns / 1e3, s.max_ns / 1e3);
+    };
+
+    std::fprintf(f, "%-14s %-6s %10s %10s %10s %10s %10s %10s\n",
+                 "stage", "ch", "count", "mean_us", "p50_us", "p99_us", "p99.9_us", "max_us");
+    for (size_t si = 0; si < kStages; ++si) {
+        const Stage s = static_cast<Stage>(si);
+        const auto tot = Total(s).Summarize();
+        if (tot.count == 0) continue;
+        row(StageName(s), "all", tot);
+        for (int ch = 0; ch < kMaxChannels; ++ch) {
+            const auto cs = per_channel_[si][static_cast<size_t>(ch)].Snap().Summarize();
+            if (cs.count == 0) continue;
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "%d", ch + 1);
+            row(StageName(s), buf, cs);
+        }
+    }
+
+    const bool ok = std::fclose(f) == 0;
+    if (!ok && err) *err = "fclose(" + path + "): " + std::strerror(errno);
+    return ok;
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
+
+// Stufen eines Erfassungszyklus (Reihenfolge = Anzeigereihenfolge)
+enum class Stage : int {
+    Cycle = 0,    // gesamter TestRunner::Step
+    MuxSelect,    // TCA9548A-Kanalwahl
+    InaBusV,      // INA219 Bus-Voltage-Register
+    InaCurrent,   // INA219 Current-Register
+    InaPower,     // INA219 Power-Register
+    DaqRead,      // RedLab ulAIn
+    Evaluate,     // Schwellen/Status/Fehlerzähler
+    LedShow,      // WS281x show()
+    GuiUpdate,    // StationPanel::OnUiTick
+    Wakeup,       // Verspätung des Erfassungsthreads gegenüber der Deadline (Jitter)
+    Count
+};
+
+const char* StageName(Stage s);   // Anzeige (deutsch)
+const char* StageId(Stage s);     // maschinenlesbar, z. B. für Metrik-Labels
+
+/**
+ * Lock-freies Latenz-Histogramm (HDR-artig, log-linear).
+ *
+ * 16 Unterbuckets je Zweierpotenz → relativer Fehler ≤ 6,25 %,
+ * Bereich 1 ns … ~68 s. Record() ist wartefrei: ein fetch_add auf den
+ * Bucket, das Maximum nur bei neuem Höchstwert. Anzahl und Mittelwert
+ * werden beim Lesen aus den Buckets abgeleitet (Schnappschuss ohne Sperre).
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits    = 4;
+    static constexpr int kSubCount   = 1 << kSubBits;
+    static constexpr int kMaxBits    = 36;
+    static constexpr int kNumBuckets = (kMaxBits - kSubBits + 1) * kSubCount;
+
+    struct Summary {
+        std::uint64_t count = 0;
+        double mean_ns = 0, p50_ns = 0, p99_ns = 0, p999_ns = 0, max_ns = 0;
+    };
+
+    // Kopie der Zähler; mehrere Snapshots lassen sich zusammenführen
+    struct Snapshot {
+        std::array<std::uint64_t, kNumBuckets> counts{};
+        std::uint64_t max_ns = 0;
+
+        void          Merge(const Snapshot& o);
+        std::uint64_t Count() const;
+        double        Percentile(double q) const; // Bucket-Mitte, q in 0..1
+        Summary       Summarize() const;
+    };
+
+    void Record(std::uint64_t ns) {
+        buckets_[static_cast<size_t>(BucketOf(ns))].fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t m = max_.load(std::memory_order_relaxed);
+        while (ns > m && !max_.compare_exchange_weak(m, ns, std::memory_order_relaxed)) {}
+    }
+
+    Snapshot Snap() const;
+    void     Reset();
+
+    static int BucketOf(std::uint64_t ns) {
+        if (ns < kSubCount) return static_cast<int>(ns);
+        const int msb   = 63 - __builtin_clzll(ns);
+        const int shift = msb - kSubBits;
+        const int idx   = (shift + 1) * kSubCount + static_cast<int>((ns >> shift) - kSubCount);
+        return idx < kNumBuckets ? idx : kNumBuckets - 1;
+    }
+    static double BucketMid(int idx);
+
+private:
+    std::array<std::atomic<std::uint32_t>, kNumBuckets> buckets_{};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+/**
+ * Prozessweite Stufen-Histogramme (je Stufe gesamt + je Kanal).
+ *
+ * Schreiber: Erfassung (beliebige Threads). Leser: Diagnosedialog, Dump.
+ */
+class StageProfiler {
+public:
+    static constexpr int kMaxChannels = 64;
+
+    static StageProfiler& Instance();
+
+    static std::uint64_t NowNs() { return sosesta::util::MonoNs(); }
+
+    bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void SetEnabled(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+
+    // Schreibt genau ein Histogramm: Kanal oder (channel < 0) "ohne Kanal".
+    // Die Gesamtsicht einer Stufe entsteht erst beim Lesen.
+    void Record(Stage s, int channel, std::uint64_t ns) {
+        const auto si = static_cast<size_t>(s);
+        if (channel >= 0 && channel < kMaxChannels)
+            per_channel_[si][static_cast<size_t>(channel)].Record(ns);
+        else
+            unassigned_[si].Record(ns);
+    }
+
+    // Gesamt über alle Kanäle + Messungen ohne Kanal
+    LatencyHistogram::Snapshot Total(Stage s) const;
+    LatencyHistogram::Snapshot Channel(Stage s, int ch) const {
+        return per_channel_[static_cast<size_t>(s)][static_cast<size_t>(ch)].Snap();
+    }
+
+    void Reset();
+
+    // Textdatei: Stufe, Kanal, N, Mittel, p50, p99, p99.9, max (µs)
+    bool DumpToFile(const std::string& path, std::string* err = nullptr) const;
+
+private:
+    StageProfiler() = default;
+
+    static constexpr size_t kStages = static_cast<size_t>(Stage::Count);
+
+    std::atomic<bool> enabled_{true};
+    std::array<LatencyHistogram, kStages> unassigned_{};
+    std::array<std::array<LatencyHistogram, kMaxChannels>, kStages> per_channel_{};
+};
+
+// Misst die Lebensdauer des Objekts und trägt sie in die Stufe ein.
+// Bei aktivem Tracer entsteht mit denselben Zeitstempeln ein Trace-Event.
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(Stage s, int channel = -1)
+        : s_(s), ch_(channel)
+        , t0_((StageProfiler::Instance().Enabled() || Tracer::Instance().Enabled())
+                  ? StageProfiler::NowNs() : 0) {}
+
+    ~ScopedStageTimer() {
+        if (!t0_) return;
+        const std::uint64_t t1 = StageProfiler::NowNs();
+        auto& prof = StageProfiler::Instance();
+        if (prof.Enabled()) prof.Record(s_, ch_, t1 - t0_);
+        auto& tr = Tracer::Instance();
+        if (tr.Enabled()) tr.Complete(StageName(s_), t0_, t1, ch_);
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    Stage         s_;
+    int           ch_;
+    std::uint64_t t0_;
+};
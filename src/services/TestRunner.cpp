@@ -1,18 +1,54 @@
 #include "services/TestRunner.hpp"
 #include <algorithm>
+#include <chrono>
 
 #include "config/ConfigSoftware.hpp"
 #include "services/LoggerService.hpp"
 #include "app/data/SensorData.hpp"
 #include "hw/IHardware.hpp"
+#include "services/AcquisitionLoop.hpp"
+#include "services/AcquisitionPool.hpp"
+#include "services/ArrowExport.hpp"
+#include "services/LiveStreamServer.hpp"
+#include "services/Metrics.hpp"
+#include "services/PersistenceWriter.hpp"
+#include "services/SamplingScheduler.hpp"
+#include "services/StageProfiler.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
 
 using sosesta::hw::IHardware;
 
+namespace {
+std::uint64_t WallMs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+}
+
 TestRunner::TestRunner(ConfigSoftware& cfg, LoggerService& log)
     : cfg_(cfg)
     , log_(log)
+    , sampler_(std::make_unique<SamplingScheduler>())
+    , capture_(std::make_unique<TransitionCapture>())
+    , loop_(std::make_unique<AcquisitionLoop>())
 {
     EnsureSensorsSize();
+    relays_.Reset(kNumPairs);
+    ApplyConfig();
+    arch_slots_.resize(kArchiveSlots);
+    for (auto& slot : arch_slots_) slot.rec.resize(static_cast<size_t>(kNumChannels));
+}
+
+void TestRunner::ApplyConfig() {
+    live_cfg_.store(std::make_shared<const ConfigSoftware>(cfg_), std::memory_order_release);
+}
+
+TestRunner::~TestRunner() {
+    // Threads und Schreibaufträge greifen auf *this zu
+    capture_->Stop();
+    StopAcquisition();
+    if (writer_) writer_->Drain();
 }
 
 void TestRunner::SetHardware(const std::shared_ptr<IHardware>& hw) {
@@ -20,36 +56,365 @@ void TestRunner::SetHardware(const std::shared_ptr<IHardware>& hw) {
 }
 
 void TestRunner::EnsureSensorsSize() {
+    work_.resize(static_cast<size_t>(kNumChannels));
+    std::lock_guard<std::mutex> lk(data_mtx_);
     sensors_.resize(static_cast<size_t>(kNumChannels));
 }
 
+std::vector<SensorData> TestRunner::Sensors() const {
+    std::lock_guard<std::mutex> lk(data_mtx_);
+    return sensors_;
+}
+
+bool TestRunner::LoopActive() const {
+    return loop_->IsRunning() || pool_job_ != AcquisitionPool::kNoJob;
+}
+
+void TestRunner::StopAcquisition() {
+    loop_->Stop();
+    if (pool_ && pool_job_ != AcquisitionPool::kNoJob) {
+        pool_->Remove(pool_job_);   // wartet auf einen laufenden Zyklus
+        pool_job_ = AcquisitionPool::kNoJob;
+    }
+}
+
 void TestRunner::Start() {
-    auto hw = hw_.lock();
-    if (!hw) { running_ = true; relays_on_ = false; return; }
-    hw->Initialize();
-    running_   = true;
-    relays_on_ = false;
+    capture_->Stop();
+    StopAcquisition();
+    ApplyConfig();
+    sampler_->Reset();
+    if (auto hw = hw_.lock()) {
+        std::lock_guard<std::mutex> lk(hw_mtx_);
+        hw->Initialize();
+        relays_.Reset(kNumPairs);   // Hardware startet mit allen Relais AUS
+        relay_mask_.store(0, std::memory_order_relaxed);
+    }
+    history_on_ = cfg_.history_enabled;
+    if (history_on_) {
+        HistoryRing::Options ho;
+        ho.channels    = kNumChannels;
+        ho.retention_s = std::max(cfg_.history_retention_h, 0.0) * 3600.0;
+        ho.max_bytes   = static_cast<size_t>(std::max(cfg_.history_max_mb, 0)) << 20;
+        history_.Reset(ho);
+    }
+    running_ = true;
+    StartCapture();
+    cycle_budget_ns_ = static_cast<std::uint64_t>(std::max(cfg_.update_interval_ms, 0)) * 1000000ull;
+
+    if (!cfg_.acq_thread) return;
+
+    const std::uint64_t period_ns = static_cast<std::uint64_t>(std::max(cfg_.acq_period_us, 100)) * 1000ull;
+    if (pool_ && pool_->IsRunning()) {
+        std::string err;
+        pool_job_ = pool_->Add(period_ns, [this](std::uint64_t) { Step(); }, &err);
+        if (pool_job_ != AcquisitionPool::kNoJob) {
+            cycle_budget_ns_ = period_ns;
+        } else {
+            log_.Log("Erfassung", wxString::FromUTF8("Erfassung nicht im Pool angemeldet: " + err), "ERROR");
+        }
+        return;
+    }
+
+    AcquisitionLoop::Options o;
+    o.period_ns   = period_ns;
+    o.rt_priority = cfg_.acq_rt_priority;
+    o.cpu         = cfg_.acq_cpu;
+    o.lock_memory = cfg_.acq_mlock;
+
+    std::string warn, err;
+    if (loop_->Start(o, [this](std::uint64_t) { Step(); }, &warn, &err)) {
+        cycle_budget_ns_ = o.period_ns;
+        if (!warn.empty()) log_.Log("Erfassung", wxString::FromUTF8(warn), "WARN");
+    } else {
+        // Rückfall: Zyklus im GUI-Takt
+        log_.Log("Erfassung", wxString::FromUTF8("Erfassungsthread nicht gestartet: " + err), "ERROR");
+    }
 }
 
 void TestRunner::Stop() {
-    if (auto hw = hw_.lock()) { hw->Shutdown(); }
+    capture_->Stop();
+    StopAcquisition();
+    if (auto hw = hw_.lock()) {
+        std::lock_guard<std::mutex> lk(hw_mtx_);
+        hw->Shutdown();
+        relays_.Stop();
+    }
     running_ = false;
 }
 
 void TestRunner::Step() {
     if (!running_) return;
-    EnsureSensorsSize();
+    const std::uint64_t t0 = sosesta::util::MonoNs();
+    const auto cfg = live_cfg_.load(std::memory_order_acquire);   // hält den Schnappschuss für den Zyklus
+    SwitchDueRelays(t0);
+    {
+        ScopedStageTimer t(Stage::Cycle);
+        work_.resize(static_cast<size_t>(kNumChannels));
 
-    if (auto hw = hw_.lock()) {
-        hw->UpdateSensors(sensors_);
+        if (auto hw = hw_.lock()) {
+            std::lock_guard<std::mutex> lk(hw_mtx_);
+            if (cfg->adaptive_sampling) {
+                // nur fällige Kanäle lesen; Rest behält den letzten Wert
+                const auto& mask = sampler_->Plan(static_cast<int>(work_.size()), *cfg);
+                const std::uint64_t r0 = sosesta::util::MonoNs();
+                {
+                    SOSESTA_TRACE_SCOPE("hw.UpdateChannels", sampler_->LastPlanned());
+                    hw->UpdateChannels(work_, mask);
+                }
+                sampler_->Observe(work_, static_cast<double>(sosesta::util::MonoNs() - r0) / 1e3, *cfg);
+            } else {
+                SOSESTA_TRACE_SCOPE("hw.UpdateSensors");
+                hw->UpdateSensors(work_);
+            }
+            for (size_t ch = 0; ch < work_.size(); ++ch)
+                work_[ch].relay_phase = relays_.Phase(static_cast<int>(ch / 2));
+        } else {
+            std::fill(work_.begin(), work_.end(), SensorData{});
+        }
+
+        {
+            // veröffentlichen: GUI hält data_mtx_ nur für die Kopie
+            std::lock_guard<std::mutex> lk(data_mtx_);
+            sensors_ = work_;
+        }
+
+        const std::uint64_t now_ms = WallMs();
+        if (stream_) stream_->PublishFrame(stream_station_, now_ms, work_);   // nur Kopie in Puffer
+        report_.Observe(now_ms, work_);   // O(Kanäle), nur während eines Berichts
+        if (history_on_) history_.Append(now_ms, work_);   // ~60 Byte je Zyklus, selten ein neuer Block
+
+        if (writer_) {
+            // Schreiben auf dem gemeinsamen Writer: Zyklus in einen festen Slot
+            // kopieren (keine Allokation), höchstens ein Leer-Auftrag offen
+            bool open;
+            {
+                std::lock_guard<std::mutex> lk(archive_mtx_);
+                open = archive_.IsOpen();
+            }
+            if (open) QueueArchive(now_ms);
+        } else {
+            std::lock_guard<std::mutex> lk(archive_mtx_);
+            AppendArchive(now_ms, work_);
+        }
+    }
+
+    // Kennzahlen für /metrics; Soll-Periode = Erfassungstakt bzw. GUI-Takt
+    auto& m = Metrics::Instance();
+    m.OnCycle(metrics_station_, t0, sosesta::util::MonoNs() - t0, cycle_budget_ns_);
+    m.PublishChannels(metrics_station_, work_);
+}
+
+void TestRunner::QueueArchive(std::uint64_t t_ms) {
+    const char* fail = nullptr;
+    const size_t head = arch_head_.load(std::memory_order_relaxed);
+    if (head - arch_tail_.load(std::memory_order_acquire) == arch_slots_.size()) {
+        fail = "Archiv-Puffer voll – Zyklen nicht archiviert";
     } else {
-        std::fill(sensors_.begin(), sensors_.end(), SensorData{});
+        ArchiveSlot& slot = arch_slots_[head % arch_slots_.size()];
+        slot.t_ms = t_ms;
+        std::copy(work_.begin(), work_.end(), slot.rec.begin());
+        arch_head_.store(head + 1);   // seq_cst: paart sich mit DrainArchive()
+        // Nur ein Auftrag gleichzeitig; ein laufender sieht den neuen Slot
+        if (!arch_posted_.exchange(true) && !writer_->Post([this] { DrainArchive(); })) {
+            arch_posted_.store(false);   // Slot bleibt, nächster Zyklus versucht es erneut
+            fail = "Schreib-Warteschlange voll – Archiv verzögert";
+        }
+    }
+    if (fail) {
+        std::lock_guard<std::mutex> lk(archive_mtx_);
+        if (archive_err_.empty()) archive_err_ = fail;
     }
 }
 
+void TestRunner::DrainArchive() {
+    arch_posted_.store(false);   // vor dem Lesen von head: später belegte Slots posten neu
+    const size_t head = arch_head_.load();
+    size_t tail = arch_tail_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lk(archive_mtx_);
+    for (; tail != head; ++tail) {
+        const ArchiveSlot& slot = arch_slots_[tail % arch_slots_.size()];
+        AppendArchive(slot.t_ms, slot.rec);
+    }
+    arch_tail_.store(tail, std::memory_order_release);
+}
+
+void TestRunner::AppendArchive(std::uint64_t t_ms, const std::vector<SensorData>& sensors) {
+    if (!archive_.IsOpen()) return;
+    std::string err;
+    if (!archive_.Append(t_ms, sensors, &err)) {
+        // Rest der Sitzung nicht aufzeichnen; Meldung über EndArchive()
+        archive_err_ = err;
+        archive_.Close();
+    }
+}
+
+void TestRunner::StartCapture() {
+    if (!cfg_.capture_transitions) return;
+    auto hw = hw_.lock();
+    if (!hw) return;
+    const double max_hz = hw->TransientMaxRateHz();
+    if (max_hz <= 0.0) {
+        log_.Log("Übergang", wxString::FromUTF8("Hardware ohne Schnellpfad – Übergangsmessung aus"), "WARN");
+        return;
+    }
+
+    TransitionCapture::Options o;
+    o.rate_hz     = std::min(cfg_.capture_rate_hz, max_hz);
+    o.pre_ms      = cfg_.capture_pre_ms;
+    o.post_ms     = cfg_.capture_post_ms;
+    o.settle_band = cfg_.capture_settle_band;
+
+    // je Abtastung kurz sperren: der Erfassungszyklus läuft im Fenster weiter
+    auto sample = [this](std::vector<double>& red, std::vector<double>& cur) {
+        auto hw = hw_.lock();
+        if (!hw) return false;
+        std::lock_guard<std::mutex> lk(hw_mtx_);
+        return hw->SampleTransient(red, cur);
+    };
+
+    std::string err;
+    if (!capture_->Start(o, kNumChannels, sample, &err))
+        log_.Log("Übergang", wxString::FromUTF8("Übergangsmessung nicht gestartet: " + err), "ERROR");
+}
+
+bool TestRunner::BeginArchive(const std::string& path, std::string* err) {
+    SessionArchiveWriter::Options o;
+    o.channels = kNumChannels;
+    o.chunk_ms = static_cast<std::uint32_t>(std::max(cfg_.archive_chunk_ms, 100));
+
+    std::lock_guard<std::mutex> lk(archive_mtx_);
+    archive_.Close();
+    archive_err_.clear();
+    return archive_.Open(path, o, err);
+}
+
+bool TestRunner::EndArchive(ArchiveInfo* info, std::string* err) {
+    if (writer_) writer_->Drain();   // ausstehende Zyklen noch anhängen
+    std::lock_guard<std::mutex> lk(archive_mtx_);
+    if (info) {
+        info->path    = archive_.Path();
+        info->samples = archive_.Samples();
+    }
+    bool ok = archive_.Close(err);
+    if (info) info->bytes = archive_.BytesWritten();
+    if (!archive_err_.empty()) {
+        if (err) *err = archive_err_;
+        ok = false;
+    }
+    return ok;
+}
+
+bool TestRunner::BeginArrowExport(const std::string& ssa_path, const std::string& arrow_path, std::string* err) {
+    // läuft bei langen Sitzungen Sekunden – nie im GUI-Thread
+    auto job = [this, ssa_path, arrow_path] {
+        ArrowExportInfo r;
+        r.path = arrow_path;
+        r.ok   = ExportSessionArrow(ssa_path, arrow_path, &r.rows, &r.err);
+        std::lock_guard<std::mutex> lk(arrow_mtx_);
+        arrow_done_.push_back(std::move(r));
+    };
+    if (!writer_) {
+        job();
+        return true;
+    }
+    if (!writer_->Post(std::move(job))) {
+        if (err) *err = "Schreib-Warteschlange voll";
+        return false;
+    }
+    return true;
+}
+
+bool TestRunner::TakeArrowExport(ArrowExportInfo* out) {
+    std::lock_guard<std::mutex> lk(arrow_mtx_);
+    if (arrow_done_.empty()) return false;
+    *out = std::move(arrow_done_.front());
+    arrow_done_.erase(arrow_done_.begin());
+    return true;
+}
+
+void TestRunner::BeginReport(const std::vector<std::string>& serials) {
+    std::vector<std::string> sn(serials);
+    sn.resize(static_cast<size_t>(kNumChannels));
+    report_.Begin(WallMs(), cfg_, sn);
+}
+
+bool TestRunner::EndReport(const std::string& path, std::string* err) {
+    report_.Finish(WallMs());
+    return report_.WriteCsv(path, err);
+}
+
+bool TestRunner::Streaming() const {
+    return stream_ && stream_->IsRunning();
+}
+
+void TestRunner::PublishEvent(int channel, int severity, std::string_view kind, std::string_view detail) {
+    if (stream_) stream_->PublishEvent(stream_station_, WallMs(), channel, severity, kind, detail);
+}
+
+std::vector<TransitionCapture::Result> TestRunner::TakeTransitions() {
+    return capture_->TakeResults();
+}
+
 void TestRunner::ToggleRelays() {
-    if (auto hw = hw_.lock()) {
-        if (relays_on_) { hw->TurnAllRelaysOff(); relays_on_ = false; }
-        else            { hw->TurnAllRelaysOn();  relays_on_ = true;  }
+    SOSESTA_TRACE_SCOPE("TestRunner::ToggleRelays");
+    auto toggle = [this] {
+        if (auto hw = hw_.lock()) {
+            std::lock_guard<std::mutex> lk(hw_mtx_);
+            // ein Paar EIN → alle AUS, sonst alle EIN
+            const bool on = relays_.Mask() == 0;
+            if (on) hw->TurnAllRelaysOn();
+            else    hw->TurnAllRelaysOff();
+            relays_.SetAll(on);
+            relay_mask_.store(relays_.Mask(), std::memory_order_relaxed);
+            Tracer::Instance().Instant(on ? "Relais EIN" : "Relais AUS");
+        }
+    };
+    // mit Übergangsmessung schaltet der Capture-Thread nach dem Vorlauf;
+    // läuft noch ein Fenster, wird ohne Messung direkt geschaltet
+    if (!capture_->Trigger(toggle)) toggle();
+}
+
+void TestRunner::StartRelaySchedule() {
+    RelayScheduler::Options o;
+    o.pairs       = kNumPairs;
+    o.interval_ns = static_cast<std::uint64_t>(std::max(cfg_.test_interval_sec, 1)) * 1000000000ull;
+    o.stagger     = cfg_.relay_stagger;
+    for (int sec : cfg_.relay_interval_sec)
+        o.pair_interval_ns.push_back(static_cast<std::uint64_t>(std::max(sec, 0)) * 1000000000ull);
+
+    auto hw = hw_.lock();
+    std::lock_guard<std::mutex> lk(hw_mtx_);
+    if (hw) hw->TurnAllRelaysOff();
+    relays_.Start(o, sosesta::util::MonoNs());
+    relay_mask_.store(0, std::memory_order_relaxed);
+    Tracer::Instance().Instant("Relais-Zeitplan Start");
+}
+
+void TestRunner::StopRelaySchedule() {
+    std::lock_guard<std::mutex> lk(hw_mtx_);
+    relays_.Stop();   // Relais bleiben, wie sie sind
+}
+
+void TestRunner::SwitchDueRelays(std::uint64_t now_ns) {
+    std::uint32_t due;
+    {
+        std::lock_guard<std::mutex> lk(hw_mtx_);
+        due = relays_.Due(now_ns);
     }
+    if (!due) return;
+
+    auto sw = [this, due] {
+        auto hw = hw_.lock();
+        if (!hw) return;
+        std::lock_guard<std::mutex> lk(hw_mtx_);
+        for (int p = 0; p < relays_.Pairs(); ++p)
+            if (due & (1u << p)) hw->ToggleRelay(p, !relays_.On(p));
+        relays_.Switched(due);
+        relay_mask_.store(relays_.Mask(), std::memory_order_relaxed);
+        Tracer::Instance().Instant("Relais-Phase", static_cast<std::int32_t>(due));
+    };
+    // Übergangsmessung nur über die Kanäle der schaltenden Paare
+    std::vector<bool> mask(static_cast<size_t>(kNumChannels));
+    for (size_t ch = 0; ch < mask.size(); ++ch) mask[ch] = (due >> (ch / 2)) & 1u;
+    if (!capture_->Trigger(sw, mask)) sw();
 }
@@ -1,35 +1,164 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "services/HistoryRing.hpp"
+#include "services/RelayScheduler.hpp"
+#include "services/ReportBuilder.hpp"
+#include "services/SessionArchive.hpp"
+#include "services/TransitionCapture.hpp"
+
 struct ConfigSoftware;        // Konfiguration der Software
 class LoggerService;          // Protokollierungsdienst
 struct SensorData;            // Sensordaten
+class SamplingScheduler;      // adaptive Abtastplanung
+class AcquisitionLoop;        // Erfassungsthread mit festem Takt
+class AcquisitionPool;        // gemeinsamer Erfassungs-Pool (mehrere Stationen)
+class PersistenceWriter;      // gemeinsamer Schreib-Thread
+class LiveStreamServer;       // Live-Datenstrom (Unix-Socket)
 
 namespace sosesta { namespace hw { struct IHardware; } }  // Hardware-Interface
 
 class TestRunner {
 public:
     explicit TestRunner(ConfigSoftware& cfg, LoggerService& log);
+    ~TestRunner();
 
     void SetHardware(const std::shared_ptr<sosesta::hw::IHardware>& hw);    // Setzt die Hardware (Mock oder Real)
 
+    // Mehrere Stationen (StationManager): Zyklus als Job im gemeinsamen Pool
+    // statt eigenem Thread, Archiv-Schreiben über den gemeinsamen Writer.
+    // Vor Start() setzen; beide müssen den TestRunner überleben.
+    void SetPool(AcquisitionPool* pool) { pool_ = pool; }
+    void SetWriter(PersistenceWriter* writer) { writer_ = writer; }
+    // Index der Station für /metrics (Label station = Index + 1)
+    void SetMetricsStation(int station) { metrics_station_ = station; }
+    // Live-Datenstrom: jeder Zyklus als Frame, Ereignisse über PublishEvent()
+    void SetStream(LiveStreamServer* stream, int station) { stream_ = stream; stream_station_ = station; }
+    bool Streaming() const;   // Datenstrom läuft → Ereignistext lohnt sich
+    void PublishEvent(int channel, int severity, std::string_view kind, std::string_view detail);
+
+    // Start() startet bei cfg.acq_thread den Erfassungsthread bzw. meldet
+    // den Zyklus im Pool an; sonst ruft der Aufrufer Step() selbst im
+    // eigenen Takt (GUI-Timer).
     void Start();
     void Stop();
     void Step();
-    void ToggleRelays();
-    const std::vector<SensorData>& Sensors() const { return sensors_; }
+
+    // Konfiguration übernehmen (GUI-Thread, nach Änderung): der Erfassungs-
+    // zyklus liest nur diesen unveränderlichen Schnappschuss, nie cfg direkt.
+    // Start() übernimmt selbst.
+    void ApplyConfig();
+    void ToggleRelays();   // manuell: alle Paare gemeinsam umschalten
+
+    // Prüflauf: Relaispaare nach Zeitplan (cfg.relay_*) schalten; Start
+    // schaltet zuerst alle AUS, die Flanken fallen im Erfassungszyklus
+    void StartRelaySchedule();
+    void StopRelaySchedule();
+    std::uint32_t RelayMask() const { return relay_mask_.load(std::memory_order_relaxed); }   // Bit i = Paar i EIN
+
+    bool LoopActive() const;
+    const AcquisitionLoop& Loop() const { return *loop_; }
+
+    // Kopie des zuletzt veröffentlichten Zyklus (thread-sicher)
+    std::vector<SensorData> Sensors() const;
+    int Channels() const { return kNumChannels; }   // Kanäle dieser Station (= Sensors().size())
+    const SamplingScheduler& Sampling() const { return *sampler_; }
+
+    // Sitzungsarchiv: ab BeginArchive() hängt jeder Zyklus einen Datensatz an
+    struct ArchiveInfo {
+        std::string   path;
+        std::uint64_t samples = 0;
+        std::uint64_t bytes   = 0;
+    };
+    bool BeginArchive(const std::string& path, std::string* err = nullptr);
+    bool EndArchive(ArchiveInfo* info = nullptr, std::string* err = nullptr);
+
+    // Arrow-Export eines geschlossenen Archivs auf dem Schreib-Thread (ohne
+    // Writer: sofort); Ergebnis holt die GUI im Takt mit TakeArrowExport()
+    struct ArrowExportInfo {
+        std::string   path;
+        std::uint64_t rows = 0;
+        bool          ok   = false;
+        std::string   err;
+    };
+    bool BeginArrowExport(const std::string& ssa_path, const std::string& arrow_path, std::string* err = nullptr);
+    bool TakeArrowExport(ArrowExportInfo* out);   // true = ein Export ist fertig (einmalig)
+
+    // Prüfbericht: wächst je Zyklus mit; EndReport() schließt offene
+    // Episoden und schreibt nur noch den Bestand (kein erneuter Durchlauf)
+    void BeginReport(const std::vector<std::string>& serials);
+    bool EndReport(const std::string& path, std::string* err = nullptr);
+    const ReportBuilder& Report() const { return report_; }
+
+    // Ergebnisse der Übergangsmessungen seit dem letzten Aufruf (GUI-Thread)
+    std::vector<TransitionCapture::Result> TakeTransitions();
+    const TransitionCapture& Capture() const { return *capture_; }
+
+    // Verlauf im Speicher (cfg.history_*), ab Start(); thread-sicher lesbar
+    const HistoryRing& History() const { return history_; }
 
 private:
     void EnsureSensorsSize();   // Stellt sicher, dass der Sensorvektor die richtige Größe hat
+    void StartCapture();
+    void StopAcquisition();
+    void AppendArchive(std::uint64_t t_ms, const std::vector<SensorData>& sensors);   // archive_mtx_ gehalten
+    void QueueArchive(std::uint64_t t_ms);   // Erfassungszyklus: work_ in den nächsten Slot
+    void DrainArchive();                     // Schreib-Thread: belegte Slots anhängen
+    void SwitchDueRelays(std::uint64_t now_ns);
 
-    ConfigSoftware& cfg_;
+    ConfigSoftware& cfg_;         // GUI-Thread
+    std::atomic<std::shared_ptr<const ConfigSoftware>> live_cfg_;   // Erfassungszyklus
     LoggerService&  log_;
 
     std::weak_ptr<sosesta::hw::IHardware> hw_; // Nicht-besitzend, da IHardware nicht kopierbar 
-    bool running_   = false;
-    bool relays_on_ = false;
+    bool running_ = false;
 
+    // work_ gehört dem Erfassungszyklus, sensors_ ist der veröffentlichte Stand
+    std::mutex              hw_mtx_;    // serialisiert Hardwarezugriffe (Zyklus vs. Relais)
+    mutable std::mutex      data_mtx_;  // schützt sensors_
+    std::vector<SensorData> work_;
     std::vector<SensorData> sensors_;
+    std::uint64_t           cycle_budget_ns_ = 0;
+    RelayScheduler          relays_;            // hw_mtx_
+    std::atomic<std::uint32_t> relay_mask_{0};  // Abbild für GUI/Ereignisse
+
+    ReportBuilder        report_;        // eigene Sperre
+    std::mutex           archive_mtx_;   // Zyklus hängt an, GUI öffnet/schließt
+    SessionArchiveWriter archive_;
+    std::string          archive_err_;   // erster Schreibfehler im Zyklus
+
+    // Zyklen für den Writer: Ring fester Slots (ein Erzeuger, ein Leser);
+    // gepostet wird nur ein Leer-Auftrag, solange keiner offen ist
+    struct ArchiveSlot {
+        std::uint64_t           t_ms = 0;
+        std::vector<SensorData> rec;    // kNumChannels, einmal angelegt
+    };
+    std::vector<ArchiveSlot> arch_slots_;
+    std::atomic<size_t>      arch_head_{0};   // nächster freier Slot (Erfassungszyklus)
+    std::atomic<size_t>      arch_tail_{0};   // nächster zu schreibender (Writer)
+    std::atomic<bool>        arch_posted_{false};
+    HistoryRing          history_;       // eigene Sperre
+    std::mutex                     arrow_mtx_;      // Schreib-Thread legt ab, GUI holt
+    std::vector<ArrowExportInfo>   arrow_done_;
+    bool                 history_on_ = false;
+
+    AcquisitionPool*   pool_     = nullptr;
+    int                pool_job_ = -1;     // AcquisitionPool::kNoJob
+    PersistenceWriter* writer_   = nullptr;
+    int                metrics_station_ = 0;
+    LiveStreamServer*  stream_         = nullptr;
+    int                stream_station_ = 0;
+
+    std::unique_ptr<SamplingScheduler> sampler_;
+    std::unique_ptr<TransitionCapture> capture_;
+    std::unique_ptr<AcquisitionLoop>   loop_;   // zuletzt: wird zuerst zerstört
     static constexpr int kNumChannels = 8;
+    static constexpr int kNumPairs    = kNumChannels / 2;
+    static constexpr size_t kArchiveSlots = 1024;   // ~1 s bei 1 kHz, ~50 s bei 20 Hz
 };
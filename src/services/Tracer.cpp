@@ -0,0 +1,137 @@
+#include "services/Tracer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+thread_local Tracer* tls_owner = nullptr;
+thread_local void*   tls_buffer = nullptr;
+
+void WriteJsonString(std::FILE* f, const char* s) {
+    std::fputc('"', f);
+    for (; s && *s; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') { std::fputc('\\', f); std::fputc(c, f); }
+        else if (c < 0x20)         { std::fprintf(f, "\\u%04x", c); }
+        else                       { std::fputc(c, f); }
+    }
+    std::fputc('"', f);
+}
+}
+
+Tracer& Tracer::Instance() {
+    static Tracer* inst = new Tracer();
+    return *inst;
+}
+
+Tracer::ThreadBuffer& Tracer::Local() {
+    if (tls_owner == this) return *static_cast<ThreadBuffer*>(tls_buffer);
+
+    // Erstes Event dieses Threads: Puffer anlegen und registrieren.
+    // Der Puffer überlebt den Thread (shared_ptr in buffers_), damit ein
+    // späterer Flush auch Events beendeter Threads enthält.
+    auto buf = std::make_shared<ThreadBuffer>();
+    {
+        std::scoped_lock lk(reg_mtx_);
+        buf->tid  = next_tid_++;
+        buf->name = "thread-" + std::to_string(buf->tid);
+        buffers_.push_back(buf);
+    }
+    tls_owner  = this;
+    tls_buffer = buf.get();
+    return *buf;
+}
+
+void Tracer::SetThreadName(const char* name) {
+    ThreadBuffer& b = Local();
+    std::scoped_lock lk(reg_mtx_);
+    b.name = name ? name : "";
+}
+
+void Tracer::Push(char ph, const char* name, std::uint64_t ts, std::uint64_t dur, std::int32_t arg) {
+    ThreadBuffer& b = Local();
+    const std::uint64_t h = b.head.load(std::memory_order_relaxed);
+    Slot& s = b.ring[h & (kRingSize - 1)];
+    s.ts_ns.store(ts, std::memory_order_relaxed);
+    s.dur_ns.store(dur, std::memory_order_relaxed);
+    s.name.store(name, std::memory_order_relaxed);
+    s.arg.store(arg, std::memory_order_relaxed);
+    s.ph.store(ph, std::memory_order_relaxed);
+    b.head.store(h + 1, std::memory_order_release);
+}
+
+void Tracer::Complete(const char* name, std::uint64_t t0_ns, std::uint64_t t1_ns, std::int32_t arg) {
+    if (!Enabled()) return;
+    Push('X', name, t0_ns, t1_ns > t0_ns ? t1_ns - t0_ns : 0, arg);
+}
+
+void Tracer::Instant(const char* name, std::int32_t arg) {
+    if (!Enabled()) return;
+    Push('i', name, sosesta::util::MonoNs(), 0, arg);
+}
+
+void Tracer::Clear() {
+    std::scoped_lock lk(reg_mtx_);
+    // Nur der Besitzer-Thread schreibt head; hier genügt es, die Leseseite
+    // zu verschieben: alles vor 'head' gilt als verworfen.
+    for (auto& b : buffers_) b->cleared = b->head.load(std::memory_order_acquire);
+}
+
+bool Tracer::WriteChromeJson(const std::string& path, std::string* err) const {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        if (err) *err = "fopen(" + path + "): " + std::strerror(errno);
+        return false;
+    }
+
+    struct Ev { std::uint64_t ts, dur; const char* name; std::int32_t arg; char ph; };
+
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", f);
+    bool first = true;
+    auto sep = [&]{ if (!first) std::fputs(",\n", f); first = false; };
+
+    std::scoped_lock lk(reg_mtx_);
+    for (const auto& b : buffers_) {
+        sep();
+        std::fprintf(f, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", b->tid);
+        WriteJsonString(f, b->name.c_str());
+        std::fputs("}}", f);
+
+        const std::uint64_t head = b->head.load(std::memory_order_acquire);
+        std::uint64_t from = head > kRingSize ? head - kRingSize : 0;
+        from = std::max(from, b->cleared);
+
+        std::vector<Ev> evs;
+        evs.reserve(static_cast<size_t>(head - from));
+        for (std::uint64_t i = from; i < head; ++i) {
+            const Slot& s = b->ring[i & (kRingSize - 1)];
+            evs.push_back({ s.ts_ns.load(std::memory_order_relaxed), s.dur_ns.load(std::memory_order_relaxed),
+                            s.name.load(std::memory_order_relaxed), s.arg.load(std::memory_order_relaxed),
+                            s.ph.load(std::memory_order_relaxed) });
+        }
+
+        // Während des Kopierens überschriebene Slots verwerfen
+        const std::uint64_t head2 = b->head.load(std::memory_order_acquire);
+        const std::uint64_t valid = head2 >= kRingSize ? head2 - kRingSize + 1 : 0;
+        const size_t skip = valid > from ? static_cast<size_t>(std::min<std::uint64_t>(valid - from, evs.size())) : 0;
+
+        for (size_t i = skip; i < evs.size(); ++i) {
+            const Ev& e = evs[i];
+            if (!e.name) continue;
+            sep();
+            std::fprintf(f, "{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", e.ph, b->tid, double(e.ts) / 1e3);
+            if (e.ph == 'X') std::fprintf(f, ",\"dur\":%.3f", double(e.dur) / 1e3);
+            if (e.ph == 'i') std::fputs(",\"s\":\"t\"", f);
+            std::fputs(",\"name\":", f);
+            WriteJsonString(f, e.name);
+            if (e.arg >= 0) std::fprintf(f, ",\"args\":{\"ch\":%d}", e.arg + 1);
+            std::fputc('}', f);
+        }
+    }
+    std::fputs("\n]}\n", f);
+
+    const bool ok = std::fclose(f) == 0;
+    if (!ok && err) *err = "fclose(" + path + "): " + std::strerror(errno);
+    return ok;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "util/Clock.hpp"
+
+/**
+ * Opt-in-Tracer für Chrome trace_event / Perfetto.
+ *
+ * Jeder Thread schreibt in einen eigenen Ringpuffer (kein Lock, keine
+ * Allokation nach dem ersten Event). Scopes werden als "complete events"
+ * (ph "X") abgelegt: ein Slot pro Scope statt Begin+End. Läuft der Ring
+ * über, werden die ältesten Events überschrieben – die letzten
+ * kRingSize Events je Thread bleiben also immer erhalten.
+ *
+ * Namen müssen statische Strings sein (Literale, StageName()).
+ */
+class Tracer {
+public:
+    static constexpr std::uint32_t kRingSize = 1u << 15; // Events je Thread
+
+    static Tracer& Instance();
+
+    bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void SetEnabled(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+
+    // Name des aufrufenden Threads in der Trace-Ansicht
+    void SetThreadName(const char* name);
+
+    // Scope [t0, t1) als complete event; arg < 0 = ohne Argument (z. B. Kanal)
+    void Complete(const char* name, std::uint64_t t0_ns, std::uint64_t t1_ns, std::int32_t arg = -1);
+    // Zeitpunkt-Ereignis (ph "i"), z. B. Relais geschaltet
+    void Instant(const char* name, std::int32_t arg = -1);
+
+    // Alle Ringe als JSON schreiben (darf während der Aufzeichnung laufen;
+    // gerade überschriebene Slots werden verworfen)
+    bool WriteChromeJson(const std::string& path, std::string* err = nullptr) const;
+
+    // Bisherige Events verwerfen (Puffer bleiben registriert)
+    void Clear();
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t>  ts_ns{0};
+        std::atomic<std::uint64_t>  dur_ns{0};
+        std::atomic<const char*>    name{nullptr};
+        std::atomic<std::int32_t>   arg{-1};
+        std::atomic<char>           ph{0};
+    };
+
+    struct ThreadBuffer {
+        std::uint32_t              tid = 0;
+        std::string                name;
+        std::atomic<std::uint64_t> head{0}; // Anzahl je geschriebener Events
+        std::uint64_t              cleared = 0; // Events davor gelten als verworfen (Clear)
+        std::unique_ptr<Slot[]>    ring{new Slot[kRingSize]};
+    };
+
+    Tracer() = default;
+    ThreadBuffer& Local();
+    void Push(char ph, const char* name, std::uint64_t ts, std::uint64_t dur, std::int32_t arg);
+
+    std::atomic<bool> enabled_{false};
+
+    mutable std::mutex                         reg_mtx_; // nur für Registrierung/Flush
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    std::uint32_t                              next_tid_ = 1;
+};
+
+// RAII-Scope; kostet bei abgeschaltetem Tracer nur einen relaxed load.
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, std::int32_t arg = -1)
+        : name_(name), arg_(arg)
+        , t0_(Tracer::Instance().Enabled() ? sosesta::util::MonoNs() : 0) {}
+
+    ~TraceScope() {
+        if (t0_) Tracer::Instance().Complete(name_, t0_, sosesta::util::MonoNs(), arg_);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char*   name_;
+    std::int32_t  arg_;
+    std::uint64_t t0_;
+};
+
+#define SOSESTA_TRACE_CAT2(a, b) a##b
+#define SOSESTA_TRACE_CAT(a, b)  SOSESTA_TRACE_CAT2(a, b)
+#define SOSESTA_TRACE_SCOPE(...) TraceScope SOSESTA_TRACE_CAT(trace_scope_, __LINE__)(__VA_ARGS__)
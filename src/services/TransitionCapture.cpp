@@ -0,0 +1,216 @@
+#include "services/TransitionCapture.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "services/AcquisitionLoop.hpp"
+#include "services/Tracer.hpp"
+#include "util/Clock.hpp"
+
+namespace {
+constexpr size_t kMaxPendingResults = 1024; // GUI holt nicht ab → älteste verwerfen
+}
+
+bool TransitionCapture::Start(const Options& opt, int channels, SampleFn sample, std::string* err) {
+    Stop();
+    if (!sample)                         { if (err) *err = "Übergangsmessung ohne Schnellpfad"; return false; }
+    if (channels <= 0)                   { if (err) *err = "Übergangsmessung ohne Kanäle"; return false; }
+    if (!(opt.rate_hz > 0.0))            { if (err) *err = "Abtastrate muss > 0 Hz sein"; return false; }
+    if (opt.pre_ms < 0.0 || !(opt.post_ms > 0.0)) { if (err) *err = "Fenster ungültig (pre ≥ 0, post > 0)"; return false; }
+
+    opt_       = opt;
+    sample_    = std::move(sample);
+    period_ns_ = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(1e9 / opt_.rate_hz));
+    pre_n_     = static_cast<size_t>(std::ceil(opt_.pre_ms * 1e6 / static_cast<double>(period_ns_)));
+    post_n_    = std::max<size_t>(1, static_cast<size_t>(std::ceil(opt_.post_ms * 1e6 / static_cast<double>(period_ns_))));
+
+    // alles vorbelegen: im Fenster keine Allokation
+    const size_t C = static_cast<size_t>(channels);
+    const size_t N = pre_n_ + post_n_;
+    trace_.channels    = channels;
+    trace_.pre_samples = pre_n_;
+    trace_.t_ns.assign(N, 0);
+    trace_.redlab_V.assign(N * C, 0.0);
+    trace_.current_mA.assign(N * C, 0.0);
+    trace_.mask.assign(C, true);
+    row_red_.assign(C, 0.0);
+    row_cur_.assign(C, 0.0);
+
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        busy_ = false;
+        pending_ = nullptr;
+        results_.clear();
+    }
+    running_ = true;
+    thread_ = std::thread([this] { Run(); });
+    return true;
+}
+
+void TransitionCapture::Stop() {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+
+    // angenommene, aber nicht mehr ausgeführte Schaltaktion nachholen
+    ActionFn left;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        left.swap(pending_);
+        busy_ = false;
+    }
+    if (left) left();
+}
+
+bool TransitionCapture::Trigger(ActionFn action, const std::vector<bool>& mask) {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (!running_ || busy_) return false;
+        busy_         = true;
+        pending_      = std::move(action);
+        pending_mask_ = mask;
+    }
+    cv_.notify_one();
+    return true;
+}
+
+std::vector<TransitionCapture::Result> TransitionCapture::TakeResults() {
+    std::lock_guard<std::mutex> lk(m_);
+    std::vector<Result> out;
+    out.swap(results_);
+    return out;
+}
+
+TransitionCapture::Trace TransitionCapture::LastTrace() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return last_;
+}
+
+const char* TransitionCapture::QuantityName(Quantity q) {
+    return q == Quantity::Signal ? "Signal" : "Strom";
+}
+
+void TransitionCapture::Run() {
+    Tracer::Instance().SetThreadName("capture");
+    std::unique_lock<std::mutex> lk(m_);
+    for (;;) {
+        cv_.wait(lk, [this] { return !running_ || pending_; });
+        if (!running_) break;
+
+        ActionFn action;
+        action.swap(pending_);
+        const size_t C = static_cast<size_t>(trace_.channels);
+        for (size_t c = 0; c < C; ++c)
+            trace_.mask[c] = pending_mask_.empty() || (c < pending_mask_.size() && pending_mask_[c]);
+        lk.unlock();
+
+        CaptureWindow(action);
+        std::vector<Result> res = Analyze(trace_, opt_);
+
+        lk.lock();
+        results_.insert(results_.end(), res.begin(), res.end());
+        if (results_.size() > kMaxPendingResults)
+            results_.erase(results_.begin(), results_.end() - static_cast<std::ptrdiff_t>(kMaxPendingResults));
+        last_ = trace_;
+        busy_ = false;
+    }
+}
+
+void TransitionCapture::CaptureWindow(ActionFn& action) {
+    SOSESTA_TRACE_SCOPE("TransitionCapture::Window");
+    const size_t C   = static_cast<size_t>(trace_.channels);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    std::uint64_t next = sosesta::util::MonoNs();
+    auto take = [&](size_t k) {
+        AcquisitionLoop::SleepUntilNs(next);
+        const bool ok = sample_(row_red_, row_cur_);
+        trace_.t_ns[k] = sosesta::util::MonoNs();
+        for (size_t c = 0; c < C; ++c) {
+            trace_.redlab_V[k * C + c]   = ok && c < row_red_.size() ? row_red_[c] : nan;
+            trace_.current_mA[k * C + c] = ok && c < row_cur_.size() ? row_cur_[c] : nan;
+        }
+        // verpasste Rasterpunkte überspringen; Auswertung nutzt echte Zeitstempel
+        next += period_ns_;
+        if (next < trace_.t_ns[k]) next = trace_.t_ns[k];
+    };
+
+    for (size_t k = 0; k < pre_n_; ++k) take(k);
+
+    action();
+    trace_.trigger_ns = sosesta::util::MonoNs();
+    Tracer::Instance().Instant("Übergang Trigger");
+    next = trace_.trigger_ns + period_ns_;
+
+    for (size_t k = pre_n_; k < pre_n_ + post_n_; ++k) take(k);
+}
+
+std::vector<TransitionCapture::Result> TransitionCapture::Analyze(const Trace& tr, const Options& opt) {
+    std::vector<Result> out;
+    const size_t C = static_cast<size_t>(tr.channels);
+    const size_t N = tr.t_ns.size();
+    if (C == 0 || N <= tr.pre_samples) return out;
+
+    const size_t pre  = tr.pre_samples;
+    const size_t tail = std::max<size_t>(1, (N - pre) / 10);
+
+    auto mean = [C](const std::vector<double>& v, size_t c, size_t k0, size_t k1, double* m) {
+        double sum = 0.0;
+        size_t n = 0;
+        for (size_t k = k0; k < k1; ++k) {
+            const double x = v[k * C + c];
+            if (!std::isnan(x)) { sum += x; ++n; }
+        }
+        if (n) *m = sum / static_cast<double>(n);
+        return n > 0;
+    };
+
+    for (size_t c = 0; c < C; ++c) {
+        if (c < tr.mask.size() && !tr.mask[c]) continue;
+        for (Quantity q : { Quantity::Signal, Quantity::Current }) {
+            const std::vector<double>& v = q == Quantity::Signal ? tr.redlab_V : tr.current_mA;
+            const double min_step = q == Quantity::Signal ? opt.min_step_V : opt.min_step_mA;
+
+            Result r;
+            r.channel    = static_cast<int>(c);
+            r.quantity   = q;
+            r.trigger_ns = tr.trigger_ns;
+            // ohne Vorlauf: erster Wert nach dem Trigger als Ausgangswert
+            if (!mean(v, c, 0, pre, &r.from) && !mean(v, c, pre, pre + 1, &r.from)) continue;
+            if (!mean(v, c, N - tail, N, &r.to)) continue;
+
+            const double step = r.to - r.from;
+            if (std::fabs(step) < min_step) continue;
+
+            // normiert: 0 = Ausgangswert, 1 = Endwert (Richtung egal)
+            std::int64_t t10 = -1, t90 = -1;
+            double y_max = -std::numeric_limits<double>::infinity();
+            size_t last_out = 0;
+            bool   any_out  = false;
+            for (size_t k = pre; k < N; ++k) {
+                const double x = v[k * C + c];
+                if (std::isnan(x)) continue;
+                const double y = (x - r.from) / step;
+                const auto   t = static_cast<std::int64_t>(tr.t_ns[k]);
+                if (t10 < 0 && y >= 0.1) t10 = t;
+                if (t90 < 0 && y >= 0.9) t90 = t;
+                y_max = std::max(y_max, y);
+                if (std::fabs(y - 1.0) > opt.settle_band) { last_out = k; any_out = true; }
+            }
+
+            if (t10 >= 0 && t90 >= 0) r.rise_us = static_cast<double>(t90 - t10) / 1e3;
+            r.overshoot_pct = std::max(0.0, y_max - 1.0) * 100.0;
+            const auto since_trigger_us = [&](size_t k) {
+                return static_cast<double>(tr.t_ns[k] - std::min(tr.t_ns[k], tr.trigger_ns)) / 1e3;
+            };
+            if (!any_out)              r.settle_us = since_trigger_us(pre);
+            else if (last_out + 1 < N) r.settle_us = since_trigger_us(last_out + 1);
+            out.push_back(r);
+        }
+    }
+    return out;
+}
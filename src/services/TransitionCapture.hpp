@@ -0,0 +1,107 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Getriggerte Schnellerfassung rund um einen Relais-Wechsel.
+ *
+ * Trigger() übergibt die Schaltaktion an den Capture-Thread. Der füllt
+ * zuerst den Vorlauf (pre_ms) mit Schnellpfad-Abtastungen, führt dann die
+ * Schaltaktion aus und tastet den Nachlauf (post_ms) mit fester Rate auf
+ * absoluten Deadlines ab. Der Puffer für Vor- und Nachlauf ist beim Start
+ * vorbelegt; im Fenster wird nichts alloziert.
+ *
+ * Danach wertet Analyze() je Kanal und Messgröße aus:
+ *  - Anstiegszeit 10 % → 90 % des Sprungs,
+ *  - Einschwingzeit ab Trigger bis zum letzten Verlassen des Bands
+ *    ±settle_band·|Sprung| um den Endwert,
+ *  - Überschwingen in % des Sprungs.
+ * Die Ergebnisse holt der GUI-Thread mit TakeResults() ab.
+ */
+class TransitionCapture {
+public:
+    struct Options {
+        double rate_hz      = 10000.0; // Abtastrate im Fenster
+        double pre_ms       = 2.0;     // Vorlauf vor dem Schalten
+        double post_ms      = 30.0;    // Nachlauf nach dem Schalten
+        double settle_band  = 0.05;    // Einschwingband, Anteil des Sprungs
+        double min_step_V   = 0.5;     // kleinere Sprünge gelten nicht als Übergang
+        double min_step_mA  = 1.0;
+    };
+
+    enum class Quantity { Signal, Current };
+
+    struct Result {
+        int           channel    = 0;
+        Quantity      quantity   = Quantity::Signal;
+        double        from       = 0.0;   // Mittel des Vorlaufs
+        double        to         = 0.0;   // Mittel der letzten 10 % des Nachlaufs
+        double        rise_us    = -1.0;  // < 0: 90 % nie erreicht
+        double        settle_us  = -1.0;  // < 0: im Fenster nicht eingeschwungen
+        double        overshoot_pct = 0.0;
+        std::uint64_t trigger_ns = 0;
+    };
+
+    // Rohdaten eines Fensters; Werte [abtastung·channels + kanal]
+    struct Trace {
+        int                        channels    = 0;
+        size_t                     pre_samples = 0;
+        std::uint64_t              trigger_ns  = 0;
+        std::vector<std::uint64_t> t_ns;
+        std::vector<double>        redlab_V;
+        std::vector<double>        current_mA;
+        std::vector<bool>          mask;
+    };
+
+    // Schnellpfad: eine Abtastung aller Kanäle; false = Lesefehler
+    using SampleFn = std::function<bool(std::vector<double>& redlab_V, std::vector<double>& current_mA)>;
+    using ActionFn = std::function<void()>;
+
+    TransitionCapture() = default;
+    ~TransitionCapture() { Stop(); }
+
+    TransitionCapture(const TransitionCapture&) = delete;
+    TransitionCapture& operator=(const TransitionCapture&) = delete;
+
+    bool Start(const Options& opt, int channels, SampleFn sample, std::string* err = nullptr);
+    void Stop();
+    bool IsRunning() const { return running_; }
+
+    // false = Fenster läuft noch → Aufrufer schaltet selbst (ohne Messung)
+    bool Trigger(ActionFn action, const std::vector<bool>& mask = {});
+
+    std::vector<Result> TakeResults();
+    Trace LastTrace() const;
+
+    static std::vector<Result> Analyze(const Trace& tr, const Options& opt);
+    static const char* QuantityName(Quantity q);
+
+private:
+    void Run();
+    void CaptureWindow(ActionFn& action);
+
+    Options  opt_;
+    SampleFn sample_;
+    size_t   pre_n_  = 0;
+    size_t   post_n_ = 0;
+    std::uint64_t period_ns_ = 0;
+
+    Trace               trace_;      // gehört dem Thread während eines Fensters
+    std::vector<double> row_red_, row_cur_;
+
+    mutable std::mutex      m_;
+    std::condition_variable cv_;
+    std::atomic<bool>       running_{false};
+    bool                    busy_    = false;
+    ActionFn                pending_;
+    std::vector<bool>       pending_mask_;
+    std::vector<Result>     results_;
+    Trace                   last_;
+    std::thread             thread_;
+};
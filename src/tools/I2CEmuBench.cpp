@@ -0,0 +1,66 @@
+// tools/I2CEmuBench.cpp
+// Treibt die echten I2C-Treiber (TCA9548A, INA219, MuxedIna219) gegen den
+// Emulator und gibt Syscalls/Transaktionen/Drahtzeit pro Messzyklus aus.
+//
+//   sosesta_i2c_bench [zyklen] [i2c_hz]
+#include "i2c/EmulatedI2CBus.hpp"
+#include "mux/TCA9548A.hpp"
+#include "power/INA219.hpp"
+#include "power/MuxedIna219.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char** argv) {
+    const int    cycles = argc > 1 ? std::atoi(argv[1]) : 1000;
+    EmuBusTiming timing;
+    if (argc > 2) timing.clock_hz = std::atof(argv[2]);
+
+    EmulatedI2CBus bus(timing);
+    EmuTCA9548A    emu_mux;
+    std::array<EmuINA219, 8> emu_ina;
+    bus.attachMux(0x70, &emu_mux);
+    for (int ch = 0; ch < 8; ++ch) {
+        emu_mux.attach(ch, 0x40, &emu_ina[ch]);
+        emu_ina[ch].setLoad(5.0, 0.010 + 0.001 * ch);
+    }
+
+    std::string err;
+    TCA9548A mux;
+    INA219   ina;
+    if (!mux.init(&bus, 0x70, &err)) { std::fprintf(stderr, "mux: %s\n", err.c_str()); return 1; }
+    if (!ina.init(&bus, 0x40, 0.1f, 0.4f, &err)) { std::fprintf(stderr, "ina: %s\n", err.c_str()); return 1; }
+    for (int ch = 0; ch < 8; ++ch) {
+        if (!mux.select(ch, &err) || !ina.applyProfile("16V_400mA", &err)) {
+            std::fprintf(stderr, "configure ch%d: %s\n", ch, err.c_str());
+            return 1;
+        }
+    }
+    bus.advanceUs(2000.0); // erste Konvertierung abwarten
+    bus.resetStats();
+
+    MuxedIna219 reader(mux, ina);
+    InaReading  r;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int c = 0; c < cycles; ++c) {
+        for (int ch = 0; ch < 8; ++ch) {
+            if (!reader.read(ch, r, &err)) { std::fprintf(stderr, "read ch%d: %s\n", ch, err.c_str()); return 1; }
+        }
+    }
+    const double wall_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+    const auto& s = bus.stats();
+    const double n = double(cycles);
+    std::printf("cycles            %d (8 channels, %.0f Hz)\n", cycles, timing.clock_hz);
+    std::printf("syscalls/cycle    %.1f\n", double(s.syscalls) / n);
+    std::printf("ioctl/cycle       %.1f\n", double(s.slave_switches) / n);
+    std::printf("transactions/cyc  %.1f\n", double(s.transactions) / n);
+    std::printf("bytes/cycle       %.1f w, %.1f r\n", double(s.bytes_written) / n, double(s.bytes_read) / n);
+    std::printf("bus time/cycle    %.1f us\n", s.bus_time_us / n);
+    std::printf("cpu time/cycle    %.2f us (driver + emulator)\n", wall_us / n);
+    std::printf("last ch7          %.3f V %.3f mA %.3f mW\n", r.bus_V, r.current_mA, r.power_mW);
+    return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace sosesta::util {
+// Monotone Zeit in ns (steady_clock, auf Linux vDSO clock_gettime)
+inline std::uint64_t MonoNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}
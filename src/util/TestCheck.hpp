@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>   // getpid
+
+// Minimale Prüfhilfen für die *_test.cpp neben den Quellen (ctest).
+// CHECK zählt Fehler und läuft weiter; TEST_MAIN meldet das Ergebnis
+// als Exit-Code.
+namespace sosesta::test {
+
+inline int& Failures() {
+    static int n = 0;
+    return n;
+}
+
+inline void Fail(const char* file, int line, const char* what) {
+    std::fprintf(stderr, "%s:%d: CHECK fehlgeschlagen: %s\n", file, line, what);
+    ++Failures();
+}
+
+// Eindeutiger Pfad im Temp-Verzeichnis; vorhandene Datei wird gelöscht
+inline std::string TempPath(const std::string& name) {
+    const auto p = std::filesystem::temp_directory_path() /
+                   ("sosesta_" + std::to_string(::getpid()) + "_" + name);
+    std::error_code ec;
+    std::filesystem::remove(p, ec);
+    return p.string();
+}
+
+} // namespace sosesta::test
+
+#define CHECK(cond) \
+    do { if (!(cond)) ::sosesta::test::Fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_NEAR(a, b, tol) \
+    do { if (!(((a) - (b)) <= (tol) && ((b) - (a)) <= (tol))) \
+        ::sosesta::test::Fail(__FILE__, __LINE__, #a " ≈ " #b); } while (0)
+
+// Fortsetzen ohne Sinn (z. B. Datei nicht geöffnet): Test abbrechen
+#define REQUIRE(cond) \
+    do { if (!(cond)) { ::sosesta::test::Fail(__FILE__, __LINE__, #cond); return; } } while (0)
+
+#define TEST_MAIN(...)                                                        \
+    int main() {                                                              \
+        for (auto* t : {__VA_ARGS__}) t();                                    \
+        if (::sosesta::test::Failures())                                      \
+            std::fprintf(stderr, "%d Prüfung(en) fehlgeschlagen\n",          \
+                         ::sosesta::test::Failures());                        \
+        return ::sosesta::test::Failures() ? 1 : 0;                           \
+    }